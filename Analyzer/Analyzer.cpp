@@ -736,6 +736,14 @@ std::shared_ptr<Analyzer::Expr> Expr::add_cast(const SQLTypeInfo& new_type_info)
        new_type_info.get_comp_param() == TRANSIENT_DICT(type_info.get_comp_param()))) {
     return shared_from_this();
   }
+  if (new_type_info.is_fsst_string() || type_info.is_fsst_string()) {
+    // FSST encoded strings are none encoded strings stored compressed.
+    auto none_encoded_type_info = new_type_info;
+    none_encoded_type_info.set_comp_param(type_info.get_comp_param());
+    if (none_encoded_type_info == type_info) {
+      return shared_from_this();
+    }
+  }
   if (!type_info.is_castable(new_type_info)) {
     if (type_info.is_string() && (new_type_info.is_number() || new_type_info.is_time())) {
       throw std::runtime_error("Cannot CAST from " + type_info.get_type_name() + " to " +
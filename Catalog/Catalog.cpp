@@ -312,6 +312,12 @@ void Catalog::updateTableDescriptorSchema() {
       string queryString("ALTER TABLE mapd_tables ADD is_system_table BOOLEAN DEFAULT 0");
       sqliteConnector_.query(queryString);
     }
+    if (std::find(cols.begin(), cols.end(), std::string("storage_compression")) ==
+        cols.end()) {
+      string queryString(
+          "ALTER TABLE mapd_tables ADD storage_compression TEXT DEFAULT ''");
+      sqliteConnector_.query(queryString);
+    }
   } catch (std::exception& e) {
     sqliteConnector_.query("ROLLBACK TRANSACTION");
     throw;
@@ -1131,7 +1137,8 @@ void Catalog::reloadTableMetadataUnlocked(int table_id) {
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, "
       "max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, "
       "num_shards, key_metainfo, userid, sort_column_id, storage_type, "
-      "max_rollback_epochs, is_system_table from mapd_tables WHERE tableid = " +
+      "max_rollback_epochs, is_system_table, storage_compression from mapd_tables "
+      "WHERE tableid = " +
       std::to_string(table_id));
   sqliteConnector_.query(tableQuery);
   numRows = sqliteConnector_.getNumRows();
@@ -1180,6 +1187,7 @@ void Catalog::reloadTableMetadataUnlocked(int table_id) {
   }
   td->maxRollbackEpochs = sqliteConnector_.getData<int>(0, 18);
   td->is_system_table = sqliteConnector_.getData<bool>(0, 19);
+  td->storageCompression = sqliteConnector_.getData<string>(0, 20);
   td->hasDeletedCol = false;
 
   if (auto tableDescIt = tableDescriptorMapById_.find(table_id);
@@ -1344,8 +1352,8 @@ void Catalog::buildTablesMapUnlocked() {
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, "
       "max_chunk_size, frag_page_size, "
       "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, userid, "
-      "sort_column_id, storage_type, max_rollback_epochs, is_system_table "
-      "from mapd_tables");
+      "sort_column_id, storage_type, max_rollback_epochs, is_system_table, "
+      "storage_compression from mapd_tables");
   sqliteConnector_.query(tableQuery);
   auto numRows = sqliteConnector_.getNumRows();
   for (size_t r = 0; r < numRows; ++r) {
@@ -1391,6 +1399,7 @@ void Catalog::buildTablesMapUnlocked() {
     }
     td->maxRollbackEpochs = sqliteConnector_.getData<int>(r, 18);
     td->is_system_table = sqliteConnector_.getData<bool>(r, 19);
+    td->storageCompression = sqliteConnector_.getData<string>(r, 20);
     td->hasDeletedCol = false;
 
     tableDescriptorMap_[to_upper(td->tableName)] = td;
@@ -2764,7 +2773,7 @@ void Catalog::createTable(
   if (td.persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     try {
       sqliteConnector_.query_with_text_params(
-          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, is_system_table, key_metainfo) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
+          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, is_system_table, key_metainfo, storage_compression) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
           std::vector<std::string>{td.tableName,
                                    std::to_string(td.userId),
                                    std::to_string(td.nColumns),
@@ -2783,7 +2792,8 @@ void Catalog::createTable(
                                    td.storageType,
                                    std::to_string(td.maxRollbackEpochs),
                                    std::to_string(td.is_system_table),
-                                   td.keyMetainfo});
+                                   td.keyMetainfo,
+                                   td.storageCompression});
 
       // now get the auto generated tableid
       sqliteConnector_.query_with_text_param(
@@ -3426,6 +3436,7 @@ void Catalog::setTableEpoch(const int db_id, const int table_id, int new_epoch)
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.epoch = new_epoch;
   file_mgr_params.max_rollback_epochs = td->maxRollbackEpochs;
+  file_mgr_params.storage_compression = td->storageCompression;
 
   const auto physical_tables = getPhysicalTablesDescriptors(td, false);
   CHECK(!physical_tables.empty());
@@ -3513,6 +3524,7 @@ void Catalog::setMaxRollbackEpochs(const int32_t table_id,
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.epoch = -1;  // Use existing epoch
   file_mgr_params.max_rollback_epochs = max_rollback_epochs;
+  file_mgr_params.storage_compression = td->storageCompression;
   setTableFileMgrParams(table_id, file_mgr_params);
   alterTableMetadata(td, table_update_params);
 }
@@ -3552,6 +3564,7 @@ void Catalog::setUncappedTableEpoch(const std::string& table_name) {
   alterTableMetadata(td, table_update_params);
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.max_rollback_epochs = -1;
+  file_mgr_params.storage_compression = td->storageCompression;
   setTableFileMgrParams(td->tableId, file_mgr_params);
 }
 
@@ -3616,6 +3629,7 @@ void Catalog::setTableEpochs(const int32_t db_id,
   CHECK(td);
   File_Namespace::FileMgrParams file_mgr_params;
   file_mgr_params.max_rollback_epochs = td->maxRollbackEpochs;
+  file_mgr_params.storage_compression = td->storageCompression;
 
   for (const auto& table_epoch_info : table_epochs) {
     removeChunks(table_epoch_info.table_id);
@@ -5096,7 +5110,12 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
           // and the first cd of a dict will become root of the dict
           if (dict_root_cds.end() == dict_root_cds.find(dict_name)) {
             dict_root_cds[dict_name] = cd;
-            os << " ENCODING " << ti.get_compression_name() << "(" << (size * 8) << ")";
+            if (ti.is_run_length_dict_string()) {
+              os << " ENCODING RL";
+            } else {
+              os << " ENCODING " << ti.get_compression_name() << "(" << (size * 8)
+                 << ")";
+            }
           } else {
             const auto dict_root_cd = dict_root_cds[dict_name];
             shared_dicts.push_back("SHARED DICTIONARY (" + cd->columnName +
@@ -5104,13 +5123,17 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
             // "... shouldn't specify an encoding, it borrows from the referenced
             // column"
           }
+        } else if (ti.is_fsst_string()) {
+          os << " ENCODING FSST";
         } else {
           os << " ENCODING NONE";
         }
-      } else if (ti.is_date_in_days() ||
+      } else if (ti.is_date_in_days() || ti.is_bit_packed() ||
                  (ti.get_size() > 0 && ti.get_size() != ti.get_logical_size())) {
         const auto comp_param = ti.get_comp_param() ? ti.get_comp_param() : 32;
         os << " ENCODING " << ti.get_compression_name() << "(" << comp_param << ")";
+      } else if (ti.is_block_encoded()) {
+        os << " ENCODING " << ti.get_compression_name();
       } else if (ti.is_geometry()) {
         if (ti.get_compression() == kENCODING_GEOINT) {
           os << " ENCODING " << ti.get_compression_name() << "(" << ti.get_comp_param()
@@ -5155,6 +5178,9 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
                            std::to_string(td->maxRollbackEpochs));
   }
+  if (!td->storageCompression.empty()) {
+    with_options.push_back("STORAGE_COMPRESSION='" + td->storageCompression + "'");
+  }
   os << ") WITH (" + boost::algorithm::join(with_options, ", ") + ");";
   return os.str();
 }
@@ -5263,15 +5289,21 @@ std::string Catalog::dumpCreateTableUnlocked(const TableDescriptor* td,
         //    from the referenced column"
         if (ti.is_string() || (ti.is_array() && ti.get_subtype() == kTEXT)) {
           auto size = ti.is_array() ? ti.get_logical_size() : ti.get_size();
-          if (ti.get_compression() == kENCODING_DICT) {
+          if (ti.is_run_length_dict_string()) {
+            os << " ENCODING RL";
+          } else if (ti.get_compression() == kENCODING_DICT) {
             os << " ENCODING " << ti.get_compression_name() << "(" << (size * 8) << ")";
+          } else if (ti.is_fsst_string()) {
+            os << " ENCODING FSST";
           } else {
             os << " ENCODING NONE";
           }
-        } else if (ti.is_date_in_days() ||
+        } else if (ti.is_date_in_days() || ti.is_bit_packed() ||
                    (ti.get_size() > 0 && ti.get_size() != ti.get_logical_size())) {
           const auto comp_param = ti.get_comp_param() ? ti.get_comp_param() : 32;
           os << " ENCODING " << ti.get_compression_name() << "(" << comp_param << ")";
+        } else if (ti.is_block_encoded()) {
+          os << " ENCODING " << ti.get_compression_name();
         } else if (ti.is_geometry()) {
           if (ti.get_compression() == kENCODING_GEOINT) {
             os << " ENCODING " << ti.get_compression_name() << "(" << ti.get_comp_param()
@@ -5328,6 +5360,9 @@ std::string Catalog::dumpCreateTableUnlocked(const TableDescriptor* td,
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
                            std::to_string(td->maxRollbackEpochs));
   }
+  if (!foreign_table && !td->storageCompression.empty()) {
+    with_options.push_back("STORAGE_COMPRESSION='" + td->storageCompression + "'");
+  }
   if (!foreign_table && (dump_defaults || !td->hasDeletedCol)) {
     with_options.emplace_back(td->hasDeletedCol ? "VACUUM='DELAYED'"
                                                 : "VACUUM='IMMEDIATE'");
@@ -530,7 +530,8 @@ std::pair<std::string, std::string> DdlCommandExecutor::getSessionParameter() co
   enum SetParameterType { String_t, Numeric_t };
   static const std::unordered_map<std::string, SetParameterType>
       session_set_parameters_map = {{"EXECUTOR_DEVICE", SetParameterType::String_t},
-                                    {"CURRENT_DATABASE", SetParameterType::String_t}};
+                                    {"CURRENT_DATABASE", SetParameterType::String_t},
+                                    {"CPU_KERNEL_WEIGHT", SetParameterType::Numeric_t}};
 
   auto& ddl_payload = extractPayload(*ddl_data_);
   CHECK(ddl_payload.HasMember("sessionParameter"));
@@ -545,7 +546,7 @@ std::pair<std::string, std::string> DdlCommandExecutor::getSessionParameter() co
     throw std::runtime_error(parameter_name + " is not a settable session parameter.");
   }
   if (param_it->second == SetParameterType::Numeric_t) {
-    if (!std::regex_match(parameter_value, std::regex("[(-|+)|][0-9]+"))) {
+    if (!std::regex_match(parameter_value, std::regex("[-+]?[0-9]+"))) {
       throw std::runtime_error("The value of session parameter " + param_it->first +
                                " should be a numeric.");
     }
@@ -75,6 +75,7 @@ struct TableDescriptor {
   std::string storageType;          // foreign/local storage
 
   int32_t maxRollbackEpochs;
+  std::string storageCompression;  // blosc compressor for data pages, empty if none
   bool is_system_table;
   bool is_in_memory_system_table;
 
@@ -78,6 +78,26 @@ class AbstractBufferMgr {
   virtual void fetchBuffer(const ChunkKey& key,
                            AbstractBuffer* destBuffer,
                            const size_t numBytes = 0) = 0;
+
+  // Batched versions of getBuffer and fetchBuffer for distinct keys. Managers that can
+  // read several chunks at once override these so that the reads are issued together.
+  virtual std::vector<AbstractBuffer*> getBuffers(const std::vector<ChunkKey>& keys,
+                                                  const std::vector<size_t>& numBytes) {
+    std::vector<AbstractBuffer*> buffers;
+    buffers.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      buffers.emplace_back(getBuffer(keys[i], numBytes[i]));
+    }
+    return buffers;
+  }
+  virtual void fetchBuffers(const std::vector<ChunkKey>& keys,
+                            const std::vector<AbstractBuffer*>& destBuffers,
+                            const std::vector<size_t>& numBytes) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      fetchBuffer(keys[i], destBuffers[i], numBytes[i]);
+    }
+  }
+
   virtual AbstractBuffer* putBuffer(const ChunkKey& key,
                                     AbstractBuffer* srcBuffer,
                                     const size_t numBytes = 0) = 0;
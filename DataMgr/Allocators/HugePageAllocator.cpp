@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HugePageAllocator.h"
+
+#include "Logger/Logger.h"
+#include "OSDependent/heavyai_huge_pages.h"
+
+HugePageArena::HugePageArena(size_t huge_page_size, size_t size_limit)
+    : huge_page_size_(huge_page_size)
+    , size_limit_(size_limit)
+    , size_(0)
+    , warned_about_fallback_(false) {}
+
+HugePageArena::~HugePageArena() {
+  for (const auto& allocation : allocations_) {
+    heavyai::munmap_pages(allocation.ptr, allocation.num_bytes);
+  }
+}
+
+void* HugePageArena::allocate(const size_t num_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_limit_ != 0 && size_ + num_bytes > size_limit_) {
+    throw OutOfHostMemory(num_bytes);
+  }
+  void* ptr = nullptr;
+  // Explicit huge pages are mapped whole, so they are only used when no memory would be
+  // wasted, which is the case for the default slab sizes.
+  if (huge_page_size_ && num_bytes % huge_page_size_ == 0) {
+    ptr = heavyai::mmap_huge_pages(num_bytes, huge_page_size_);
+  }
+  const bool explicit_huge_pages = ptr != nullptr;
+  if (!ptr) {
+    if (huge_page_size_ && !warned_about_fallback_) {
+      LOG(WARNING) << "Could not map " << num_bytes << " bytes with huge pages of "
+                   << huge_page_size_
+                   << " bytes, falling back to transparent huge pages. The size must be "
+                      "a multiple of the huge page size and enough huge pages must be "
+                      "reserved.";
+      warned_about_fallback_ = true;
+    }
+    ptr = heavyai::mmap_transparent_huge_pages(num_bytes);
+  }
+  if (!ptr) {
+    throw OutOfHostMemory(num_bytes);
+  }
+  size_ += num_bytes;
+  allocations_.push_back({ptr, num_bytes, explicit_huge_pages});
+  return ptr;
+}
+
+size_t HugePageArena::bytesUsed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+size_t HugePageArena::hugePageBytesUsed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t huge_page_bytes = 0;
+  std::vector<std::pair<void*, size_t>> transparent_huge_page_ranges;
+  for (const auto& allocation : allocations_) {
+    if (allocation.explicit_huge_pages) {
+      huge_page_bytes += allocation.num_bytes;
+    } else {
+      transparent_huge_page_ranges.emplace_back(allocation.ptr, allocation.num_bytes);
+    }
+  }
+  if (!transparent_huge_page_ranges.empty()) {
+    huge_page_bytes +=
+        heavyai::get_transparent_huge_page_bytes(transparent_huge_page_ranges);
+  }
+  return huge_page_bytes;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "ArenaAllocator.h"
+
+// An arena allocator that maps its allocations with huge pages, which cuts the number of
+// page faults taken when the memory is first touched and the TLB misses when it is
+// scanned. Allocations are backed by explicit huge pages of huge_page_size bytes when
+// their size is a multiple of it and enough huge pages are reserved, and by transparent
+// huge pages otherwise. Memory is only unmapped on destruction.
+class HugePageArena : public Arena {
+ public:
+  // A huge_page_size of 0 only uses transparent huge pages. A size_limit of 0 does not
+  // limit the number of bytes mapped.
+  explicit HugePageArena(size_t huge_page_size, size_t size_limit = 0);
+
+  ~HugePageArena() override;
+
+  void* allocate(const size_t num_bytes) override;
+
+  // Mapped memory is zeroed by the kernel.
+  void* allocateAndZero(const size_t num_bytes) override { return allocate(num_bytes); }
+
+  size_t bytesUsed() const override;
+
+  MemoryType getMemoryType() const override { return MemoryType::DRAM; }
+
+  // Returns the number of allocated bytes currently backed by explicit or transparent
+  // huge pages.
+  size_t hugePageBytesUsed() const;
+
+ private:
+  struct Allocation {
+    void* ptr;
+    size_t num_bytes;
+    bool explicit_huge_pages;
+  };
+
+  const size_t huge_page_size_;
+  const size_t size_limit_;
+  size_t size_;
+  bool warned_about_fallback_;
+  std::vector<Allocation> allocations_;
+  mutable std::mutex mutex_;
+};
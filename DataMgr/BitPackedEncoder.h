@@ -0,0 +1,445 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BIT_PACKED_ENCODER_H
+#define BIT_PACKED_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+#include "Shared/BitPacking.h"
+#include "Shared/Iteration.h"
+
+namespace bit_packing {
+
+inline size_t byte_size(const int64_t num_rows, const int32_t bit_width) {
+  return num_words(num_rows, bit_width) * sizeof(uint64_t);
+}
+
+// ORs the values into words, starting bit_pos bits into them. The bits past bit_pos must
+// be zero. Values out of the bit_width range are truncated.
+template <typename T>
+void pack(const T* values,
+          const size_t num_values,
+          const int32_t bit_width,
+          uint64_t* words,
+          uint64_t bit_pos) {
+  const auto value_mask = mask(bit_width);
+  for (size_t i = 0; i < num_values; ++i, bit_pos += bit_width) {
+    const int64_t val =
+        values[i] == inline_int_null_value<T>() ? null_bits(bit_width) : values[i];
+    const auto bits = static_cast<uint64_t>(val) & value_mask;
+    const auto word = bit_pos / kWordBits;
+    const auto shift = bit_pos % kWordBits;
+    words[word] |= bits << shift;
+    if (shift + bit_width > kWordBits) {
+      words[word + 1] |= bits >> (kWordBits - shift);
+    }
+  }
+}
+
+// Encodes the values into dst, which must have room for byte_size(num_values,
+// bit_width) bytes. Returns that size.
+template <typename T>
+size_t encode(const T* values,
+              const size_t num_values,
+              const int32_t bit_width,
+              int8_t* dst) {
+  auto words = reinterpret_cast<uint64_t*>(dst);
+  std::fill(words, words + num_words(num_values, bit_width), uint64_t(0));
+  pack(values, num_values, bit_width, words, 0);
+  return byte_size(num_values, bit_width);
+}
+
+// Unpacks the 64 rows held by the BitWidth words of a block. The bit width being a
+// constant, the loop unrolls into straight shifts and masks which the compiler turns into
+// vector instructions for the target.
+template <int32_t BitWidth>
+void unpack_block(const uint64_t* words, int64_t* dst) {
+  for (int64_t i = 0; i < kBlockRows; ++i) {
+    const uint64_t bit_pos = i * BitWidth;
+    const auto word = bit_pos / kWordBits;
+    const auto shift = bit_pos % kWordBits;
+    const auto low = words[word] >> shift;
+    const auto high = (words[word + 1] << 1) << (kWordBits - 1 - shift);
+    dst[i] = static_cast<int64_t>((low | high) << (kWordBits - BitWidth)) >>
+             (kWordBits - BitWidth);
+  }
+}
+
+using UnpackBlockFn = void (*)(const uint64_t*, int64_t*);
+
+template <size_t... BitWidthsMinusOne>
+constexpr std::array<UnpackBlockFn, sizeof...(BitWidthsMinusOne)> make_unpack_blocks(
+    std::index_sequence<BitWidthsMinusOne...>) {
+  return {&unpack_block<static_cast<int32_t>(BitWidthsMinusOne) + 1>...};
+}
+
+// Block unpacking for bit widths 1 to 63, indexed by the bit width minus one.
+inline constexpr auto kUnpackBlock = make_unpack_blocks(std::make_index_sequence<63>{});
+
+// Writes the values of rows [start_row, start_row + num_rows) to dst. Whole blocks are
+// unpacked at once into a local buffer, the rows around them one at a time.
+template <typename T>
+void decode_rows(const int8_t* byte_stream,
+                 const int32_t bit_width,
+                 const size_t start_row,
+                 const size_t num_rows,
+                 T* dst) {
+  CHECK_GT(bit_width, 0);
+  CHECK_LT(bit_width, kWordBits);
+  constexpr auto null_val = inline_int_null_value<T>();
+  const auto stored_null = null_bits(bit_width);
+  size_t i = 0;
+  for (; i < num_rows && (start_row + i) % kBlockRows; ++i) {
+    dst[i] = static_cast<T>(decode(byte_stream, bit_width, start_row + i, null_val));
+  }
+  const auto unpack_block_fn = kUnpackBlock[bit_width - 1];
+  const auto words = reinterpret_cast<const uint64_t*>(byte_stream);
+  int64_t block[kBlockRows];
+  for (; i + kBlockRows <= num_rows; i += kBlockRows) {
+    unpack_block_fn(words + (start_row + i) / kBlockRows * bit_width, block);
+    for (int64_t j = 0; j < kBlockRows; ++j) {
+      dst[i + j] = block[j] == stored_null ? null_val : static_cast<T>(block[j]);
+    }
+  }
+  for (; i < num_rows; ++i) {
+    dst[i] = static_cast<T>(decode(byte_stream, bit_width, start_row + i, null_val));
+  }
+}
+
+// Writes the values of the first num_rows rows to dst, value_width bytes each.
+inline void expand(const int8_t* byte_stream,
+                   const int32_t bit_width,
+                   const int32_t value_width,
+                   const size_t num_rows,
+                   int8_t* dst) {
+  switch (value_width) {
+    case 2:
+      decode_rows(byte_stream, bit_width, 0, num_rows, reinterpret_cast<int16_t*>(dst));
+      break;
+    case 4:
+      decode_rows(byte_stream, bit_width, 0, num_rows, reinterpret_cast<int32_t*>(dst));
+      break;
+    case 8:
+      decode_rows(byte_stream, bit_width, 0, num_rows, reinterpret_cast<int64_t*>(dst));
+      break;
+    default:
+      UNREACHABLE() << "Unexpected bit packed value width " << value_width;
+  }
+}
+
+// Concatenates buffers holding consecutive row ranges into dst, which must have room for
+// byte_size() of all their rows. Returns the number of bytes written.
+inline size_t concatenate(const std::vector<const int8_t*>& byte_streams,
+                          const std::vector<size_t>& byte_streams_num_rows,
+                          const int32_t bit_width,
+                          int8_t* dst) {
+  CHECK_EQ(byte_streams.size(), byte_streams_num_rows.size());
+  size_t total_rows = 0;
+  for (const auto num_rows : byte_streams_num_rows) {
+    total_rows += num_rows;
+  }
+  auto words = reinterpret_cast<uint64_t*>(dst);
+  std::fill(words, words + num_words(total_rows, bit_width), uint64_t(0));
+  uint64_t bit_pos = 0;
+  std::vector<int64_t> values;
+  for (size_t i = 0; i < byte_streams.size(); ++i) {
+    values.resize(byte_streams_num_rows[i]);
+    decode_rows(byte_streams[i], bit_width, 0, values.size(), values.data());
+    pack(values.data(), values.size(), bit_width, words, bit_pos);
+    bit_pos += values.size() * bit_width;
+  }
+  return byte_size(total_rows, bit_width);
+}
+
+// Removes the given rows, sorted in ascending order, from the buffer of num_rows rows
+// in place and returns its new size in bytes.
+inline size_t remove_rows(int8_t* byte_stream,
+                          const int32_t bit_width,
+                          const size_t num_rows,
+                          const std::vector<uint64_t>& rows) {
+  std::vector<int64_t> values(num_rows);
+  decode_rows(byte_stream, bit_width, 0, num_rows, values.data());
+  size_t rows_out = 0;
+  auto row_it = rows.begin();
+  for (size_t row = 0; row < num_rows; ++row) {
+    if (row_it != rows.end() && *row_it == row) {
+      ++row_it;
+      continue;
+    }
+    values[rows_out++] = values[row];
+  }
+  return encode(values.data(), rows_out, bit_width, byte_stream);
+}
+
+}  // namespace bit_packing
+
+/**
+ * @class BitPackedEncoder
+ * @brief Stores an integer column on the bit width given by its FIXED(n) parameter.
+ *
+ * T is the logical storage type of the column. Appends pack their rows after the
+ * existing ones, only the word holding the end of the chunk is read back. See
+ * Shared/BitPacking.h for the buffer layout.
+ */
+template <typename T>
+class BitPackedEncoder : public Encoder {
+ public:
+  BitPackedEncoder(Data_Namespace::AbstractBuffer* buffer, const int32_t bit_width)
+      : Encoder(buffer), bit_width_(bit_width) {
+    CHECK_GT(bit_width_, 0);
+    CHECK_LT(bit_width_, static_cast<int32_t>(sizeof(T) * 8));
+    resetChunkStats();
+  }
+
+  size_t getNumElemsForBytesEncodedDataAtIndices(const int8_t* index_data,
+                                                 const std::vector<size_t>& selected_idx,
+                                                 const size_t byte_limit) override {
+    UNREACHABLE()
+        << "getNumElemsForBytesEncodedDataAtIndices unexpectedly called for non varlen"
+           " encoder";
+    return {};
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedDataAtIndices(
+      const int8_t*,
+      int8_t* data,
+      const std::vector<size_t>& selected_idx) override {
+    std::shared_ptr<ChunkMetadata> chunk_metadata;
+    shared::execute_over_contiguous_indices(
+        selected_idx, [&](const size_t start_pos, const size_t end_pos) {
+          chunk_metadata = appendEncodedData(
+              nullptr, data, selected_idx[start_pos], end_pos - start_pos);
+        });
+    return chunk_metadata;
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedData(const int8_t*,
+                                                   int8_t* data,
+                                                   const size_t start_idx,
+                                                   const size_t num_elements) override {
+    std::vector<T> decoded_data(num_elements);
+    bit_packing::decode_rows(
+        data, bit_width_, start_idx, num_elements, decoded_data.data());
+    auto decoded_ptr = reinterpret_cast<int8_t*>(decoded_data.data());
+    return appendData(decoded_ptr, num_elements, SQLTypeInfo{});
+  }
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= num_elems_) {
+      // we're rewriting entire buffer so fully recompute metadata
+      resetChunkStats();
+      num_elems_ = 0;
+      buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Bit packed chunks can only be appended to or rewritten entirely.");
+    }
+
+    const auto unencoded_data = reinterpret_cast<const T*>(src_data);
+    std::vector<T> values(num_elems_to_append);
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      values[i] = unencoded_data[replicating ? 0 : i];
+      updateStatsWithValue(values[i]);
+    }
+
+    // Only the word holding the end of the chunk and the padding word change.
+    const uint64_t end_bit = num_elems_ * bit_width_;
+    const auto first_word = end_bit / bit_packing::kWordBits;
+    const auto num_words =
+        bit_packing::num_words(num_elems_ + num_elems_to_append, bit_width_);
+    std::vector<uint64_t> words(num_words - first_word);
+    const auto first_word_offset = first_word * sizeof(uint64_t);
+    if (num_elems_) {
+      buffer_->read(
+          reinterpret_cast<int8_t*>(words.data()), sizeof(uint64_t), first_word_offset);
+    }
+    bit_packing::pack(values.data(),
+                      values.size(),
+                      bit_width_,
+                      words.data(),
+                      end_bit % bit_packing::kWordBits);
+    buffer_->write(reinterpret_cast<int8_t*>(words.data()),
+                   words.size() * sizeof(uint64_t),
+                   first_word_offset);
+    num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsWithValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    std::vector<T> values(num_elements);
+    bit_packing::decode_rows(dst_data, bit_width_, 0, num_elements, values.data());
+    for (const auto value : values) {
+      updateStatsWithValue(value);
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto that_typed = static_cast<const BitPackedEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const BitPackedEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  void resetChunkStats() override {
+    dataMin = std::numeric_limits<T>::max();
+    dataMax = std::numeric_limits<T>::lowest();
+    has_nulls = false;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  void updateStatsWithValue(const T value) {
+    if (value == inline_int_null_value<T>()) {
+      has_nulls = true;
+      return;
+    }
+    const auto min_val = bit_packing::null_bits(bit_width_) + 1;
+    const auto max_val = -bit_packing::null_bits(bit_width_) - 1;
+    if (value < min_val || value > max_val) {
+      decimal_overflow_validator_.validate(value);
+      LOG(ERROR) << "Fixed encoding failed, Unencoded: " + std::to_string(value) +
+                        " does not fit in " + std::to_string(bit_width_) + " bits";
+      return;
+    }
+    dataMin = std::min(dataMin, value);
+    dataMax = std::max(dataMax, value);
+  }
+
+  const int32_t bit_width_;
+};  // BitPackedEncoder
+
+#endif  // BIT_PACKED_ENCODER_H
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/BufferMgr/BufferEvictionPolicy.h"
+
+#include "DataMgr/BufferMgr/Buffer.h"
+#include "Logger/Logger.h"
+
+std::string g_buffer_eviction_policy{"score"};
+
+namespace Buffer_Namespace {
+
+namespace {
+bool is_evictable(const BufferList::iterator& seg_it) {
+  return seg_it->mem_status == USED && seg_it->buffer &&
+         seg_it->buffer->getPinCount() == 0;
+}
+
+// Appends the evictable segments, least recently used first. Pinned segments are
+// skipped; they are only pinned while a query uses them.
+void append_least_recent_evictable(
+    const std::list<BufferList::iterator>& segments,
+    std::vector<BufferList::iterator>& evictable_segments) {
+  for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+    if (is_evictable(*it)) {
+      evictable_segments.emplace_back(*it);
+    }
+  }
+}
+}  // namespace
+
+void LruBufferEvictionPolicy::addSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(segments_map_.find(&*seg_it) == segments_map_.end());
+  segments_.emplace_front(seg_it);
+  segments_map_[&*seg_it] = segments_.begin();
+}
+
+void LruBufferEvictionPolicy::touchSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = segments_map_.find(&*seg_it);
+  if (it != segments_map_.end()) {
+    segments_.splice(segments_.begin(), segments_, it->second);
+  }
+}
+
+void LruBufferEvictionPolicy::removeSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = segments_map_.find(&*seg_it);
+  if (it != segments_map_.end()) {
+    segments_.erase(it->second);
+    segments_map_.erase(it);
+  }
+}
+
+std::vector<BufferList::iterator> LruBufferEvictionPolicy::getSegmentsToEvict() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<BufferList::iterator> evictable_segments;
+  append_least_recent_evictable(segments_, evictable_segments);
+  return evictable_segments;
+}
+
+void LruBufferEvictionPolicy::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  segments_.clear();
+  segments_map_.clear();
+}
+
+void SegmentedLruBufferEvictionPolicy::addSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(segments_map_.find(&*seg_it) == segments_map_.end());
+  probationary_segments_.emplace_front(seg_it);
+  segments_map_[&*seg_it] = {probationary_segments_.begin(), seg_it->num_pages, false};
+}
+
+void SegmentedLruBufferEvictionPolicy::touchSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = segments_map_.find(&*seg_it);
+  if (it == segments_map_.end()) {
+    return;
+  }
+  auto& entry = it->second;
+  if (entry.is_protected) {
+    protected_segments_.splice(
+        protected_segments_.begin(), protected_segments_, entry.list_it);
+    return;
+  }
+  protected_segments_.splice(
+      protected_segments_.begin(), probationary_segments_, entry.list_it);
+  entry.is_protected = true;
+  protected_num_pages_ += entry.num_pages;
+  demoteProtectedSegments();
+}
+
+void SegmentedLruBufferEvictionPolicy::removeSegment(BufferList::iterator seg_it) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = segments_map_.find(&*seg_it);
+  if (it == segments_map_.end()) {
+    return;
+  }
+  auto& entry = it->second;
+  if (entry.is_protected) {
+    protected_segments_.erase(entry.list_it);
+    protected_num_pages_ -= entry.num_pages;
+  } else {
+    probationary_segments_.erase(entry.list_it);
+  }
+  segments_map_.erase(it);
+}
+
+std::vector<BufferList::iterator> SegmentedLruBufferEvictionPolicy::getSegmentsToEvict() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<BufferList::iterator> evictable_segments;
+  append_least_recent_evictable(probationary_segments_, evictable_segments);
+  append_least_recent_evictable(protected_segments_, evictable_segments);
+  return evictable_segments;
+}
+
+void SegmentedLruBufferEvictionPolicy::setPoolNumPages(const size_t num_pages) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_protected_num_pages_ = static_cast<size_t>(num_pages * kProtectedFraction);
+  demoteProtectedSegments();
+}
+
+void SegmentedLruBufferEvictionPolicy::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  probationary_segments_.clear();
+  protected_segments_.clear();
+  segments_map_.clear();
+  protected_num_pages_ = 0;
+}
+
+// Assumes mutex_ is held.
+void SegmentedLruBufferEvictionPolicy::demoteProtectedSegments() {
+  // Always keep the most recently promoted segment protected.
+  while (protected_num_pages_ > max_protected_num_pages_ &&
+         protected_segments_.size() > 1) {
+    auto list_it = std::prev(protected_segments_.end());
+    auto& entry = segments_map_.at(&**list_it);
+    probationary_segments_.splice(
+        probationary_segments_.begin(), protected_segments_, list_it);
+    entry.is_protected = false;
+    protected_num_pages_ -= entry.num_pages;
+  }
+}
+
+std::unique_ptr<BufferEvictionPolicy> create_buffer_eviction_policy(
+    const std::string& policy_name) {
+  if (policy_name == "score") {
+    return nullptr;
+  }
+  if (policy_name == "lru") {
+    return std::make_unique<LruBufferEvictionPolicy>();
+  }
+  if (policy_name == "slru") {
+    return std::make_unique<SegmentedLruBufferEvictionPolicy>();
+  }
+  throw std::runtime_error("Unknown buffer eviction policy \"" + policy_name +
+                           "\", expected one of score, lru or slru.");
+}
+
+}  // namespace Buffer_Namespace
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file BufferEvictionPolicy.h
+ * @brief
+ *
+ * This file includes the class specification for the replacement policies that a
+ * BufferMgr can use to pick the buffers to evict when its pool is full. A policy is
+ * told about every slab segment that holds a buffer and about every access to it, with
+ * constant time bookkeeping, and can be queried for the next segment to evict.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DataMgr/BufferMgr/BufferSeg.h"
+
+extern std::string g_buffer_eviction_policy;
+
+namespace Buffer_Namespace {
+
+class BufferEvictionPolicy {
+ public:
+  virtual ~BufferEvictionPolicy() {}
+  // Starts tracking a slab segment that now holds a buffer.
+  virtual void addSegment(BufferList::iterator seg_it) = 0;
+  // Updates the policy knowing that the buffer of this segment was accessed.
+  virtual void touchSegment(BufferList::iterator seg_it) = 0;
+  // Stops tracking a segment if present.
+  virtual void removeSegment(BufferList::iterator seg_it) = 0;
+  // Returns the unpinned segments in the order they should be evicted. Segments remain
+  // tracked until they are removed.
+  virtual std::vector<BufferList::iterator> getSegmentsToEvict() = 0;
+  // Updates the policy with the number of pages currently allocated to the pool.
+  virtual void setPoolNumPages(const size_t num_pages) {}
+  virtual void clear() = 0;
+};
+
+/**
+ * Least recently used segments are evicted first.
+ */
+class LruBufferEvictionPolicy : public BufferEvictionPolicy {
+ public:
+  void addSegment(BufferList::iterator seg_it) override;
+  void touchSegment(BufferList::iterator seg_it) override;
+  void removeSegment(BufferList::iterator seg_it) override;
+  std::vector<BufferList::iterator> getSegmentsToEvict() override;
+  void clear() override;
+
+ private:
+  std::list<BufferList::iterator> segments_;
+  std::unordered_map<const BufferSeg*, std::list<BufferList::iterator>::iterator>
+      segments_map_;
+  std::mutex mutex_;
+};
+
+/**
+ * Segmented LRU: new segments start out in a probationary queue and only move to a
+ * protected queue when they are accessed again. Segments of a one-off scan are therefore
+ * evicted before segments that are reused across queries, e.g. dimension tables. The
+ * protected queue holds at most kProtectedFraction of the pool; its least recently used
+ * segments are moved back to the probationary queue when it grows beyond that.
+ */
+class SegmentedLruBufferEvictionPolicy : public BufferEvictionPolicy {
+ public:
+  void addSegment(BufferList::iterator seg_it) override;
+  void touchSegment(BufferList::iterator seg_it) override;
+  void removeSegment(BufferList::iterator seg_it) override;
+  std::vector<BufferList::iterator> getSegmentsToEvict() override;
+  void setPoolNumPages(const size_t num_pages) override;
+  void clear() override;
+
+  static constexpr double kProtectedFraction{0.8};
+
+ private:
+  struct Entry {
+    std::list<BufferList::iterator>::iterator list_it;
+    size_t num_pages;
+    bool is_protected;
+  };
+
+  void demoteProtectedSegments();
+
+  std::list<BufferList::iterator> probationary_segments_;
+  std::list<BufferList::iterator> protected_segments_;
+  std::unordered_map<const BufferSeg*, Entry> segments_map_;
+  size_t protected_num_pages_{0};
+  size_t max_protected_num_pages_{0};
+  std::mutex mutex_;
+};
+
+// Returns the policy for the given name, or nullptr for the default "score" policy, which
+// scans the slabs for the cheapest run of segments to evict.
+std::unique_ptr<BufferEvictionPolicy> create_buffer_eviction_policy(
+    const std::string& policy_name);
+
+}  // namespace Buffer_Namespace
@@ -24,6 +24,8 @@
 #include <iomanip>
 #include <limits>
 
+#include <boost/functional/hash.hpp>
+
 #include "DataMgr/BufferMgr/Buffer.h"
 #include "DataMgr/ForeignStorage/ForeignStorageException.h"
 #include "Logger/Logger.h"
@@ -59,7 +61,8 @@ BufferMgr::BufferMgr(const int device_id,
     , allocations_capped_(false)
     , parent_mgr_(parent_mgr)
     , max_buffer_id_(0)
-    , buffer_epoch_(0) {
+    , buffer_epoch_(0)
+    , eviction_policy_(create_buffer_eviction_policy(g_buffer_eviction_policy)) {
   CHECK(max_buffer_pool_size_ > 0);
   CHECK(page_size_ > 0);
   // TODO change checks on run-time configurable slab size variables to exceptions
@@ -88,22 +91,32 @@ void BufferMgr::reinit() {
       max_num_pages_per_slab_;  // current_max_slab_page_size_ will drop as allocations
                                 // fail - this is the high water mark
   allocations_capped_ = false;
+  if (eviction_policy_) {
+    eviction_policy_->setPoolNumPages(num_pages_allocated_);
+  }
 }
 
 void BufferMgr::clear() {
-  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto chunk_index_locks = lockChunkIndexShards();
+  heavyai::unique_lock<heavyai::shared_mutex> slabs_lock(slabs_mutex_);
   std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
 
-  for (auto& buf : chunk_index_) {
-    delete buf.second->buffer;
+  for (auto& shard : chunk_index_shards_) {
+    for (auto& buf : shard.chunk_index) {
+      delete buf.second->buffer;
+    }
+    shard.chunk_index.clear();
   }
 
-  chunk_index_.clear();
   slabs_.clear();
   slab_segments_.clear();
+  slab_mutexes_.clear();
+  released_slabs_.clear();
   unsized_segs_.clear();
   buffer_epoch_ = 0;
+  if (eviction_policy_) {
+    eviction_policy_->clear();
+  }
 }
 
 /// Throws a runtime_error if the Chunk already exists
@@ -117,36 +130,41 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunk_key,
   }
 
   // chunk_page_size is just for recording dirty pages
+  auto& shard = getChunkIndexShard(chunk_key);
+  BufferList::iterator seg_it;
   {
-    std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-    CHECK(chunk_index_.find(chunk_key) == chunk_index_.end());
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    CHECK(shard.chunk_index.find(chunk_key) == shard.chunk_index.end());
     BufferSeg buffer_seg(BufferSeg(-1, 0, USED));
     buffer_seg.chunk_key = chunk_key;
     std::lock_guard<std::mutex> unsizedSegsLock(unsized_segs_mutex_);
     unsized_segs_.push_back(buffer_seg);  // race condition?
-    chunk_index_[chunk_key] =
-        std::prev(unsized_segs_.end(),
-                  1);  // need to do this before allocating Buffer because doing so could
-                       // change the segment used
+    seg_it = std::prev(unsized_segs_.end(), 1);
+    shard.chunk_index[chunk_key] =
+        seg_it;  // need to do this before allocating Buffer because doing so could
+                 // change the segment used
   }
   // following should be safe outside the lock b/c first thing Buffer
   // constructor does is pin (and its still in unsized segs at this point
   // so can't be evicted)
   try {
-    allocateBuffer(chunk_index_[chunk_key], actual_chunk_page_size, initial_size);
+    allocateBuffer(seg_it, actual_chunk_page_size, initial_size);
   } catch (const OutOfMemory&) {
-    auto buffer_it = chunk_index_.find(chunk_key);
-    CHECK(buffer_it != chunk_index_.end());
-    buffer_it->second->buffer =
-        nullptr;  // constructor failed for the buffer object so make sure to mark it null
-                  // so deleteBuffer doesn't try to delete it
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto buffer_it = shard.chunk_index.find(chunk_key);
+      CHECK(buffer_it != shard.chunk_index.end());
+      buffer_it->second->buffer =
+          nullptr;  // constructor failed for the buffer object so make sure to mark it
+                    // null so deleteBuffer doesn't try to delete it
+    }
     deleteBuffer(chunk_key);
     throw;
   }
-  CHECK(initial_size == 0 || chunk_index_[chunk_key]->buffer->getMemoryPtr());
-  // chunk_index_[chunk_key]->buffer->pin();
-  std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-  return chunk_index_[chunk_key]->buffer;
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto buffer = shard.chunk_index[chunk_key]->buffer;
+  CHECK(initial_size == 0 || buffer->getMemoryPtr());
+  return buffer;
 }
 
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
@@ -163,8 +181,11 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
       CHECK(evict_it->buffer->getPinCount() < 1);
     }
     num_pages += evict_it->num_pages;
+    if (evict_it->mem_status == USED && eviction_policy_) {
+      eviction_policy_->removeSegment(evict_it);
+    }
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
-      chunk_index_.erase(evict_it->chunk_key);
+      getChunkIndexShard(evict_it->chunk_key).chunk_index.erase(evict_it->chunk_key);
     }
     if (evict_it->buffer != nullptr) {
       // If we don't delete buffers here then we lose reference to them later and cause a
@@ -209,6 +230,7 @@ BufferList::iterator BufferMgr::reserveBuffer(
   // First check for free segment after seg_it
   int slab_num = seg_it->slab_num;
   if (slab_num >= 0) {  // not dummy page
+    auto segment_lock = lockSegment(seg_it);
     BufferList::iterator next_it = std::next(seg_it);
     if (next_it != slab_segments_[slab_num].end() && next_it->mem_status == FREE &&
         next_it->num_pages >= num_pages_extra_needed) {
@@ -222,11 +244,14 @@ BufferList::iterator BufferMgr::reserveBuffer(
   }
   // If we're here then we couldn't keep buffer in existing slot
   // need to find new segment, copy data over, and then delete old
-  auto new_seg_it = findFreeBuffer(num_bytes);
+  auto new_seg_it = findFreeBuffer(num_bytes, seg_it->chunk_key);
 
   // Below should be in copy constructor for BufferSeg?
-  new_seg_it->buffer = seg_it->buffer;
-  new_seg_it->chunk_key = seg_it->chunk_key;
+  {
+    auto segment_lock = lockSegment(new_seg_it);
+    new_seg_it->buffer = seg_it->buffer;
+    new_seg_it->chunk_key = seg_it->chunk_key;
+  }
   int8_t* old_mem = new_seg_it->buffer->mem_;
   new_seg_it->buffer->mem_ =
       slabs_[new_seg_it->slab_num] + new_seg_it->start_page * page_size_;
@@ -240,11 +265,17 @@ BufferList::iterator BufferMgr::reserveBuffer(
                                   new_seg_it->buffer->getType(),
                                   device_id_);
   }
+  // Point the chunk index to the new segment before the old one is freed, so that
+  // lookups never find a freed segment
+  {
+    auto& shard = getChunkIndexShard(new_seg_it->chunk_key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.chunk_index[new_seg_it->chunk_key] = new_seg_it;
+  }
   // Decrement pin count to reverse effect above
-  removeSegment(seg_it);
   {
-    std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-    chunk_index_[new_seg_it->chunk_key] = new_seg_it;
+    auto segment_lock = lockSegment(seg_it);
+    removeSegment(seg_it);
   }
 
   return new_seg_it;
@@ -256,21 +287,7 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
        buffer_it != slab_segments_[slab_num].end();
        ++buffer_it) {
     if (buffer_it->mem_status == FREE && buffer_it->num_pages >= num_pages_requested) {
-      // startPage doesn't change
-      size_t excess_pages = buffer_it->num_pages - num_pages_requested;
-      buffer_it->num_pages = num_pages_requested;
-      buffer_it->mem_status = USED;
-      buffer_it->last_touched = buffer_epoch_++;
-      buffer_it->slab_num = slab_num;
-      if (excess_pages > 0) {
-        BufferSeg free_seg(
-            buffer_it->start_page + num_pages_requested, excess_pages, FREE);
-        auto temp_it = buffer_it;  // this should make a copy and not be a reference
-        // - as we do not want to increment buffer_it
-        temp_it++;
-        slab_segments_[slab_num].insert(temp_it, free_seg);
-      }
-      return buffer_it;
+      return useFreeSegment(buffer_it, slab_num, num_pages_requested);
     }
   }
   // If here then we did not find a free buffer of sufficient size in this slab,
@@ -278,23 +295,46 @@ BufferList::iterator BufferMgr::findFreeBufferInSlab(const size_t slab_num,
   return slab_segments_[slab_num].end();
 }
 
-BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
-  size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
-  if (num_pages_requested > max_num_pages_per_slab_) {
-    throw TooBigForSlab(num_bytes);
+BufferList::iterator BufferMgr::useFreeSegment(BufferList::iterator& seg_it,
+                                               const size_t slab_num,
+                                               const size_t num_pages_requested) {
+  CHECK(seg_it->mem_status == FREE);
+  CHECK_GE(seg_it->num_pages, num_pages_requested);
+  // startPage doesn't change
+  size_t excess_pages = seg_it->num_pages - num_pages_requested;
+  seg_it->num_pages = num_pages_requested;
+  seg_it->mem_status = USED;
+  seg_it->last_touched = buffer_epoch_++;
+  seg_it->slab_num = slab_num;
+  if (excess_pages > 0) {
+    BufferSeg free_seg(seg_it->start_page + num_pages_requested, excess_pages, FREE);
+    slab_segments_[slab_num].insert(std::next(seg_it), free_seg);
   }
+  if (eviction_policy_) {
+    eviction_policy_->addSegment(seg_it);
+  }
+  return seg_it;
+}
 
-  size_t num_slabs = slab_segments_.size();
-
-  for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
-    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
-    if (seg_it != slab_segments_[slab_num].end()) {
-      return seg_it;
+std::optional<size_t> BufferMgr::addSlabForRequest(const size_t num_pages_requested) {
+  // Released slabs keep their address range, so they are reused before new slabs are
+  // allocated.
+  for (auto it = released_slabs_.begin(); it != released_slabs_.end(); ++it) {
+    const auto [slab_num, num_pages] = *it;
+    if (num_pages >= num_pages_requested &&
+        num_pages_allocated_ + num_pages <= max_buffer_pool_num_pages_) {
+      released_slabs_.erase(it);
+      reuseSlabMemory(slab_num, num_pages * page_size_);
+      slab_segments_[slab_num].push_back(BufferSeg(0, num_pages));
+      num_pages_allocated_ += num_pages;
+      if (eviction_policy_) {
+        eviction_policy_->setPoolNumPages(num_pages_allocated_);
+      }
+      LOG(INFO) << "ALLOCATION reused released slab " << slab_num << " of " << num_pages
+                << " pages " << getStringMgrType() << ":" << device_id_;
+      return slab_num;
     }
   }
-
-  // If we're here then we didn't find a free segment of sufficient size
-  // First we see if we can add another slab
   while (!allocations_capped_ && num_pages_allocated_ < max_buffer_pool_num_pages_) {
     try {
       size_t pagesLeft = max_buffer_pool_num_pages_ - num_pages_allocated_;
@@ -313,11 +353,12 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
         break;
       }
       // if here then addSlab succeeded
+      slab_mutexes_.emplace_back(std::make_unique<std::mutex>());
       num_pages_allocated_ += current_max_slab_page_size_;
-      return findFreeBufferInSlab(
-          num_slabs,
-          num_pages_requested);  // has to succeed since we made sure to request a slab
-                                 // big enough to accomodate request
+      if (eviction_policy_) {
+        eviction_policy_->setPoolNumPages(num_pages_allocated_);
+      }
+      return slab_segments_.size() - 1;
     } catch (std::runtime_error& error) {  // failed to allocate slab
       LOG(INFO) << "ALLOCATION Attempted slab of " << current_max_slab_page_size_
                 << " pages (" << current_max_slab_page_size_ * page_size_ << "B) failed "
@@ -343,12 +384,142 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
       }
     }
   }
+  return std::nullopt;
+}
+
+void BufferMgr::allocateSlabs() {
+  auto chunk_index_locks = lockChunkIndexShards();
+  heavyai::unique_lock<heavyai::shared_mutex> slabs_lock(slabs_mutex_);
+  while (addSlabForRequest(1)) {
+  }
+}
+
+size_t BufferMgr::releaseSlabs(const size_t num_bytes, const size_t min_pool_size) {
+  auto chunk_index_locks = lockChunkIndexShards();
+  heavyai::unique_lock<heavyai::shared_mutex> slabs_lock(slabs_mutex_);
+
+  // Slabs that only hold unpinned and clean buffers, with the last time one of their
+  // buffers was used.
+  std::vector<std::pair<unsigned int, size_t>> releasable_slabs;
+  for (size_t slab_num = 0; slab_num < slab_segments_.size(); ++slab_num) {
+    if (slab_segments_[slab_num].empty()) {
+      continue;  // already released
+    }
+    bool releasable = true;
+    unsigned int last_touched = 0;
+    for (const auto& segment : slab_segments_[slab_num]) {
+      if (segment.mem_status == FREE) {
+        continue;
+      }
+      // A used segment without a buffer is being reserved.
+      if (!segment.buffer || segment.buffer->getPinCount() > 0 ||
+          segment.buffer->isDirty()) {
+        releasable = false;
+        break;
+      }
+      last_touched = std::max(last_touched, segment.last_touched);
+    }
+    if (releasable) {
+      releasable_slabs.emplace_back(last_touched, slab_num);
+    }
+  }
+  std::sort(releasable_slabs.begin(), releasable_slabs.end());
+
+  size_t num_bytes_released = 0;
+  for (const auto& [last_touched, slab_num] : releasable_slabs) {
+    if (num_bytes_released >= num_bytes) {
+      break;
+    }
+    auto& segments = slab_segments_[slab_num];
+    size_t num_pages = 0;
+    for (const auto& segment : segments) {
+      num_pages += segment.num_pages;
+    }
+    if ((num_pages_allocated_ - num_pages) * page_size_ < min_pool_size) {
+      continue;  // a smaller slab may still fit
+    }
+    for (auto seg_it = segments.begin(); seg_it != segments.end(); ++seg_it) {
+      if (seg_it->mem_status == FREE) {
+        continue;
+      }
+      getChunkIndexShard(seg_it->chunk_key).chunk_index.erase(seg_it->chunk_key);
+      if (eviction_policy_) {
+        eviction_policy_->removeSegment(seg_it);
+      }
+      delete seg_it->buffer;
+    }
+    segments.clear();
+    releaseSlabMemory(slab_num, num_pages * page_size_);
+    released_slabs_[slab_num] = num_pages;
+    num_pages_allocated_ -= num_pages;
+    num_bytes_released += num_pages * page_size_;
+    LOG(INFO) << "Released slab " << slab_num << " of " << num_pages * page_size_
+              << "B " << getStringMgrType() << ":" << device_id_;
+  }
+  if (eviction_policy_ && num_bytes_released > 0) {
+    eviction_policy_->setPoolNumPages(num_pages_allocated_);
+  }
+  return num_bytes_released;
+}
+
+void BufferMgr::releaseSlabMemory(const size_t slab_num, const size_t slab_size) {
+  UNREACHABLE() << "Slabs cannot be released from " << getStringMgrType();
+}
+
+BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes,
+                                               const ChunkKey& chunk_key) {
+  size_t num_pages_requested = (num_bytes + page_size_ - 1) / page_size_;
+  if (num_pages_requested > max_num_pages_per_slab_) {
+    throw TooBigForSlab(num_bytes);
+  }
+
+  {
+    heavyai::shared_lock<heavyai::shared_mutex> slabs_lock(slabs_mutex_);
+    for (const bool preferred_slabs : {true, false}) {
+      for (size_t slab_num = 0; slab_num != slab_segments_.size(); ++slab_num) {
+        if (isPreferredSlab(slab_num, chunk_key) != preferred_slabs) {
+          continue;
+        }
+        std::lock_guard<std::mutex> slab_lock(*slab_mutexes_[slab_num]);
+        auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+        if (seg_it != slab_segments_[slab_num].end()) {
+          return seg_it;
+        }
+      }
+    }
+  }
+
+  // If we're here then we didn't find a free segment of sufficient size. Adding a slab
+  // or evicting needs exclusive access to the whole pool.
+  auto chunk_index_locks = lockChunkIndexShards();
+  heavyai::unique_lock<heavyai::shared_mutex> slabs_lock(slabs_mutex_);
+  size_t num_slabs = slab_segments_.size();
+
+  // Segments may have been freed while the locks were released
+  for (size_t slab_num = 0; slab_num != num_slabs; ++slab_num) {
+    auto seg_it = findFreeBufferInSlab(slab_num, num_pages_requested);
+    if (seg_it != slab_segments_[slab_num].end()) {
+      return seg_it;
+    }
+  }
+
+  // First we see if we can add another slab
+  if (const auto slab_num = addSlabForRequest(num_pages_requested)) {
+    // has to succeed since we made sure to request a slab big enough to accomodate
+    // request
+    return findFreeBufferInSlab(*slab_num, num_pages_requested);
+  }
 
   if (num_pages_allocated_ == 0 && allocations_capped_) {
     throw FailedToCreateFirstSlab(num_bytes);
   }
 
   // If here then we can't add a slab - so we need to evict
+  if (eviction_policy_) {
+    if (auto seg_it = evictWithPolicy(num_pages_requested, num_bytes)) {
+      return *seg_it;
+    }
+  }
 
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
@@ -376,7 +547,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
         // pinCount should never go up - only down because we have
         // global lock on buffer pool and pin count only increments
         // on getChunk
-        if (evict_it->mem_status == USED && evict_it->buffer->getPinCount() > 0) {
+        // Segments without a buffer yet are being reserved by another thread.
+        if (evict_it->mem_status == USED &&
+            (!evict_it->buffer || evict_it->buffer->getPinCount() > 0)) {
           break;
         }
         page_count += evict_it->num_pages;
@@ -427,6 +600,44 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   return best_eviction_start;
 }
 
+std::optional<BufferList::iterator> BufferMgr::evictWithPolicy(
+    const size_t num_pages_requested,
+    const size_t num_bytes) {
+  const auto is_reusable = [](const BufferSeg& seg) {
+    return seg.mem_status == FREE ||
+           (seg.buffer != nullptr && seg.buffer->getPinCount() == 0);
+  };
+  for (auto seg_it : eviction_policy_->getSegmentsToEvict()) {
+    CHECK_GE(seg_it->slab_num, 0);
+    const int slab_num = seg_it->slab_num;
+    auto& segments = slab_segments_[slab_num];
+    // Grow a run of free and evictable segments around the candidate, so that only the
+    // candidate and its neighbours are evicted.
+    auto evict_start = seg_it;
+    size_t num_pages = seg_it->num_pages;
+    for (auto next_it = std::next(seg_it);
+         num_pages < num_pages_requested && next_it != segments.end() &&
+         is_reusable(*next_it);
+         ++next_it) {
+      num_pages += next_it->num_pages;
+    }
+    while (num_pages < num_pages_requested && evict_start != segments.begin() &&
+           is_reusable(*std::prev(evict_start))) {
+      --evict_start;
+      num_pages += evict_start->num_pages;
+    }
+    if (num_pages >= num_pages_requested) {
+      LOG(INFO) << "ALLOCATION failed to find " << num_bytes
+                << "B free. Evicting using the " << g_buffer_eviction_policy
+                << " policy. Eviction start " << evict_start->start_page
+                << " Number pages requested " << num_pages_requested << " Slab "
+                << slab_num << " " << getStringMgrType() << ":" << device_id_;
+      return evict(evict_start, num_pages_requested, slab_num);
+    }
+  }
+  return std::nullopt;
+}
+
 std::string BufferMgr::printSlab(size_t slab_num) {
   std::ostringstream tss;
   // size_t lastEnd = 0;
@@ -549,8 +760,12 @@ std::string BufferMgr::printMap() {
   tss << std::endl
       << "Map Contents: "
       << " " << getStringMgrType() << ":" << device_id_ << std::endl;
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  for (auto seg_it = chunk_index_.begin(); seg_it != chunk_index_.end();
+  auto chunk_index_locks = lockChunkIndexShards();
+  std::map<ChunkKey, BufferList::iterator> chunk_index;
+  for (auto& shard : chunk_index_shards_) {
+    chunk_index.insert(shard.chunk_index.begin(), shard.chunk_index.end());
+  }
+  for (auto seg_it = chunk_index.begin(); seg_it != chunk_index.end();
        ++seg_it, ++seg_num) {
     //    tss << "Map Entry " << seg_num << ": ";
     //    for (auto vec_it = seg_it->first.begin(); vec_it != seg_it->first.end();
@@ -585,8 +800,9 @@ void BufferMgr::printSegs() {
 }
 
 bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
-  std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
-  if (chunk_index_.find(key) == chunk_index_.end()) {
+  auto& shard = getChunkIndexShard(key);
+  std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+  if (shard.chunk_index.find(key) == shard.chunk_index.end()) {
     return false;
   } else {
     return true;
@@ -596,15 +812,16 @@ bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
 /// This method throws a runtime_error when deleting a Chunk that does not exist.
 void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
   // Note: purge is unused
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::mutex> chunk_index_lock(shard.mutex);
 
-  // lookup the buffer for the Chunk in chunk_index_
-  auto buffer_it = chunk_index_.find(key);
-  CHECK(buffer_it != chunk_index_.end());
+  // lookup the buffer for the Chunk in the chunk index
+  auto buffer_it = shard.chunk_index.find(key);
+  CHECK(buffer_it != shard.chunk_index.end());
   auto seg_it = buffer_it->second;
-  chunk_index_.erase(buffer_it);
+  shard.chunk_index.erase(buffer_it);
   chunk_index_lock.unlock();
-  std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
+  auto segment_lock = lockSegment(seg_it);
   if (seg_it->buffer) {
     delete seg_it->buffer;  // Delete Buffer for segment
     seg_it->buffer = 0;
@@ -614,36 +831,31 @@ void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
 
 void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool) {
   // Note: purge is unused
-  // lookup the buffer for the Chunk in chunk_index_
-  std::lock_guard<std::mutex> sized_segs_lock(
-      sized_segs_mutex_);  // Take this lock early to prevent deadlock with
-                           // reserveBuffer which needs segs_mutex_ and then
-                           // chunk_index_mutex_
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto startChunkIt = chunk_index_.lower_bound(key_prefix);
-  if (startChunkIt == chunk_index_.end()) {
-    return;
-  }
-
-  auto buffer_it = startChunkIt;
-  while (buffer_it != chunk_index_.end() &&
-         std::search(buffer_it->first.begin(),
-                     buffer_it->first.begin() + key_prefix.size(),
-                     key_prefix.begin(),
-                     key_prefix.end()) != buffer_it->first.begin() + key_prefix.size()) {
-    auto seg_it = buffer_it->second;
-    if (seg_it->buffer) {
-      if (seg_it->buffer->getPinCount() != 0) {
-        // leave the buffer and buffer segment in place, they are in use elsewhere. once
-        // unpinned, the buffer will be inaccessible and evicted
-        buffer_it++;
-        continue;
+  // lookup the buffer for the Chunk in every shard of the chunk index
+  for (auto& shard : chunk_index_shards_) {
+    std::lock_guard<std::mutex> chunk_index_lock(shard.mutex);
+    auto buffer_it = shard.chunk_index.lower_bound(key_prefix);
+    while (buffer_it != shard.chunk_index.end() &&
+           std::search(buffer_it->first.begin(),
+                       buffer_it->first.begin() + key_prefix.size(),
+                       key_prefix.begin(),
+                       key_prefix.end()) !=
+               buffer_it->first.begin() + key_prefix.size()) {
+      auto seg_it = buffer_it->second;
+      auto segment_lock = lockSegment(seg_it);
+      if (seg_it->buffer) {
+        if (seg_it->buffer->getPinCount() != 0) {
+          // leave the buffer and buffer segment in place, they are in use elsewhere.
+          // once unpinned, the buffer will be inaccessible and evicted
+          buffer_it++;
+          continue;
+        }
+        delete seg_it->buffer;  // Delete Buffer for segment
+        seg_it->buffer = nullptr;
       }
-      delete seg_it->buffer;  // Delete Buffer for segment
-      seg_it->buffer = nullptr;
+      removeSegment(seg_it);
+      shard.chunk_index.erase(buffer_it++);
     }
-    removeSegment(seg_it);
-    chunk_index_.erase(buffer_it++);
   }
 }
 
@@ -652,9 +864,11 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
   int slab_num = seg_it->slab_num;
   // cout << "Slab num: " << slabNum << endl;
   if (slab_num < 0) {
-    std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
     unsized_segs_.erase(seg_it);
   } else {
+    if (eviction_policy_) {
+      eviction_policy_->removeSegment(seg_it);
+    }
     if (seg_it != slab_segments_[slab_num].begin()) {
       auto prev_it = std::prev(seg_it);
       // LOG(INFO) << "PrevIt: " << " " << getStringMgrType() << ":" << device_id_;
@@ -680,73 +894,118 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
 
 void BufferMgr::checkpoint() {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
-  std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
 
-  for (auto& chunk_itr : chunk_index_) {
-    // checks that buffer is actual chunk (not just buffer) and is dirty
-    auto& buffer_itr = chunk_itr.second;
-    if (buffer_itr->chunk_key[0] != -1 && buffer_itr->buffer->isDirty()) {
-      parent_mgr_->putBuffer(buffer_itr->chunk_key, buffer_itr->buffer);
-      buffer_itr->buffer->clearDirtyBits();
+  for (auto& shard : chunk_index_shards_) {
+    std::lock_guard<std::mutex> chunkIndexLock(shard.mutex);
+    for (auto& chunk_itr : shard.chunk_index) {
+      // checks that buffer is actual chunk (not just buffer) and is dirty
+      auto& buffer_itr = chunk_itr.second;
+      if (buffer_itr->chunk_key[0] != -1 && buffer_itr->buffer->isDirty()) {
+        parent_mgr_->putBuffer(buffer_itr->chunk_key, buffer_itr->buffer);
+        buffer_itr->buffer->clearDirtyBits();
+      }
     }
   }
 }
 
 void BufferMgr::checkpoint(const int db_id, const int tb_id) {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
 
   ChunkKey key_prefix;
   key_prefix.push_back(db_id);
   key_prefix.push_back(tb_id);
-  auto start_chunk_it = chunk_index_.lower_bound(key_prefix);
-  if (start_chunk_it == chunk_index_.end()) {
-    return;
+  for (auto& shard : chunk_index_shards_) {
+    std::lock_guard<std::mutex> chunk_index_lock(shard.mutex);
+    auto buffer_it = shard.chunk_index.lower_bound(key_prefix);
+    while (buffer_it != shard.chunk_index.end() &&
+           std::search(buffer_it->first.begin(),
+                       buffer_it->first.begin() + key_prefix.size(),
+                       key_prefix.begin(),
+                       key_prefix.end()) !=
+               buffer_it->first.begin() + key_prefix.size()) {
+      if (buffer_it->second->chunk_key[0] != -1 &&
+          buffer_it->second->buffer->isDirty()) {  // checks that buffer is actual chunk
+                                                   // (not just buffer) and is dirty
+
+        parent_mgr_->putBuffer(buffer_it->second->chunk_key, buffer_it->second->buffer);
+        buffer_it->second->buffer->clearDirtyBits();
+      }
+      buffer_it++;
+    }
   }
+}
 
-  auto buffer_it = start_chunk_it;
-  while (buffer_it != chunk_index_.end() &&
-         std::search(buffer_it->first.begin(),
-                     buffer_it->first.begin() + key_prefix.size(),
-                     key_prefix.begin(),
-                     key_prefix.end()) != buffer_it->first.begin() + key_prefix.size()) {
-    if (buffer_it->second->chunk_key[0] != -1 &&
-        buffer_it->second->buffer->isDirty()) {  // checks that buffer is actual chunk
-                                                 // (not just buffer) and is dirty
+BufferMgr::ChunkIndexShard& BufferMgr::getChunkIndexShard(const ChunkKey& key) {
+  return chunk_index_shards_[boost::hash_range(key.begin(), key.end()) %
+                             kNumChunkIndexShards];
+}
 
-      parent_mgr_->putBuffer(buffer_it->second->chunk_key, buffer_it->second->buffer);
-      buffer_it->second->buffer->clearDirtyBits();
-    }
-    buffer_it++;
+std::vector<std::unique_lock<std::mutex>> BufferMgr::lockChunkIndexShards() {
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(kNumChunkIndexShards);
+  for (auto& shard : chunk_index_shards_) {
+    locks.emplace_back(shard.mutex);
   }
+  return locks;
+}
+
+BufferMgr::SegmentLock BufferMgr::lockSegment(const BufferList::iterator& seg_it) {
+  SegmentLock segment_lock;
+  if (seg_it->slab_num < 0) {
+    segment_lock.segments_lock = std::unique_lock<std::mutex>(unsized_segs_mutex_);
+  } else {
+    segment_lock.slabs_lock =
+        heavyai::shared_lock<heavyai::shared_mutex>(slabs_mutex_);
+    segment_lock.segments_lock =
+        std::unique_lock<std::mutex>(*slab_mutexes_[seg_it->slab_num]);
+  }
+  return segment_lock;
+}
+
+Buffer* BufferMgr::findAndPinBuffer(const ChunkKey& key, const bool include_unsized) {
+  auto& shard = getChunkIndexShard(key);
+  std::lock_guard<std::mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.chunk_index.find(key);
+  if (buffer_it == shard.chunk_index.end()) {
+    return nullptr;
+  }
+  auto seg_it = buffer_it->second;
+  if (seg_it->slab_num < 0 && !include_unsized) {
+    return nullptr;
+  }
+  // Evictions lock every shard, so the buffer cannot be evicted before it is pinned.
+  CHECK(seg_it->buffer);
+  seg_it->buffer->pin();
+  seg_it->last_touched = buffer_epoch_++;
+  if (eviction_policy_) {
+    eviction_policy_->touchSegment(seg_it);
+  }
+  return seg_it->buffer;
 }
 
 /// Returns a pointer to the Buffer holding the chunk, if it exists; otherwise,
 /// throws a runtime_error.
 AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes) {
-  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
-
-  std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
-  chunk_index_lock.unlock();
-  if (found_buffer) {
-    CHECK(buffer_it->second->buffer);
-    buffer_it->second->buffer->pin();
-    sized_segs_lock.unlock();
-
-    buffer_it->second->last_touched = buffer_epoch_++;  // race
+  // Chunks that are fully in the pool are returned without serializing on
+  // global_mutex_.
+  AbstractBuffer* buffer = findAndPinBuffer(key, false);
+  if (buffer && buffer->size() >= num_bytes) {
+    return buffer;
+  }
 
-    if (buffer_it->second->buffer->size() < num_bytes) {
+  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+  if (!buffer) {
+    buffer = findAndPinBuffer(key, true);
+  }
+  if (buffer) {
+    if (buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
-      parent_mgr_->fetchBuffer(key, buffer_it->second->buffer, num_bytes);
+      parent_mgr_->fetchBuffer(key, buffer, num_bytes);
     }
-    return buffer_it->second->buffer;
+    return buffer;
   } else {  // If wasn't in pool then we need to fetch it
-    sized_segs_lock.unlock();
     // createChunk pins for us
-    AbstractBuffer* buffer = createBuffer(key, page_size_, num_bytes);
+    buffer = createBuffer(key, page_size_, num_bytes);
     try {
       parent_mgr_->fetchBuffer(
           key, buffer, num_bytes);  // this should put buffer in a BufferSegment
@@ -763,36 +1022,105 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
   }
 }
 
+std::vector<AbstractBuffer*> BufferMgr::getBuffers(const std::vector<ChunkKey>& keys,
+                                                   const std::vector<size_t>& num_bytes) {
+  CHECK_EQ(keys.size(), num_bytes.size());
+  std::vector<AbstractBuffer*> buffers(keys.size(), nullptr);
+  std::vector<size_t> missing_indices;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    buffers[i] = findAndPinBuffer(keys[i], false);
+    if (!buffers[i] || buffers[i]->size() < num_bytes[i]) {
+      missing_indices.emplace_back(i);
+    }
+  }
+  if (missing_indices.empty()) {
+    return buffers;
+  }
+
+  std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+  std::vector<bool> created(keys.size(), false);
+  const auto release_buffers = [&]() {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (created[i]) {
+        deleteBuffer(keys[i]);  // buffer failed to load, ensure it is cleaned up
+      } else if (buffers[i]) {
+        buffers[i]->unPin();
+      }
+    }
+  };
+  std::vector<ChunkKey> fetch_keys;
+  std::vector<AbstractBuffer*> fetch_buffers;
+  std::vector<size_t> fetch_num_bytes;
+  try {
+    for (const auto i : missing_indices) {
+      if (!buffers[i]) {
+        buffers[i] = findAndPinBuffer(keys[i], true);
+      }
+      if (!buffers[i]) {
+        // createBuffer pins for us
+        buffers[i] = createBuffer(keys[i], page_size_, num_bytes[i]);
+        created[i] = true;
+      } else if (buffers[i]->size() >= num_bytes[i]) {
+        continue;
+      }
+      fetch_keys.emplace_back(keys[i]);
+      fetch_buffers.emplace_back(buffers[i]);
+      fetch_num_bytes.emplace_back(num_bytes[i]);
+    }
+  } catch (...) {
+    release_buffers();
+    throw;
+  }
+  try {
+    parent_mgr_->fetchBuffers(fetch_keys, fetch_buffers, fetch_num_bytes);
+  } catch (const foreign_storage::ForeignStorageException& error) {
+    release_buffers();
+    LOG(WARNING) << "Get chunks - Could not load chunks from foreign storage. Error was "
+                 << error.what();
+    throw error;
+  } catch (const std::exception& error) {
+    LOG(FATAL) << "Get chunks - Could not find chunks in buffer pool or parent buffer "
+                  "pools. Error was "
+               << error.what();
+  }
+  return buffers;
+}
+
+void BufferMgr::fetchBuffers(const std::vector<ChunkKey>& keys,
+                             const std::vector<AbstractBuffer*>& dest_buffers,
+                             const std::vector<size_t>& num_bytes) {
+  CHECK_EQ(keys.size(), dest_buffers.size());
+  const auto buffers = getBuffers(keys, num_bytes);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    buffers[i]->copyTo(dest_buffers[i], num_bytes[i]);
+    buffers[i]->unPin();
+  }
+}
+
 void BufferMgr::fetchBuffer(const ChunkKey& key,
                             AbstractBuffer* dest_buffer,
                             const size_t num_bytes) {
-  std::unique_lock<std::mutex> lock(global_mutex_);  // granular lock
-  std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
-
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
-  chunk_index_lock.unlock();
-  AbstractBuffer* buffer;
-  if (!found_buffer) {
-    sized_segs_lock.unlock();
-    CHECK(parent_mgr_ != 0);
-    buffer = createBuffer(key, page_size_, num_bytes);  // will pin buffer
-    try {
-      parent_mgr_->fetchBuffer(key, buffer, num_bytes);
-    } catch (const foreign_storage::ForeignStorageException& error) {
-      deleteBuffer(key);  // buffer failed to load, ensure it is cleaned up
-      LOG(WARNING) << "Could not fetch parent chunk " << keyToString(key)
-                   << " from foreign storage. Error was " << error.what();
-      throw error;
-    } catch (std::runtime_error& error) {
-      LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key)
-                 << " error: " << error.what();
+  AbstractBuffer* buffer = findAndPinBuffer(key, false);
+  if (!buffer || num_bytes > buffer->size()) {
+    std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
+    if (!buffer) {
+      buffer = findAndPinBuffer(key, true);
     }
-  } else {
-    buffer = buffer_it->second->buffer;
-    buffer->pin();
-    if (num_bytes > buffer->size()) {
+    if (!buffer) {
+      CHECK(parent_mgr_ != 0);
+      buffer = createBuffer(key, page_size_, num_bytes);  // will pin buffer
+      try {
+        parent_mgr_->fetchBuffer(key, buffer, num_bytes);
+      } catch (const foreign_storage::ForeignStorageException& error) {
+        deleteBuffer(key);  // buffer failed to load, ensure it is cleaned up
+        LOG(WARNING) << "Could not fetch parent chunk " << keyToString(key)
+                     << " from foreign storage. Error was " << error.what();
+        throw error;
+      } catch (std::runtime_error& error) {
+        LOG(FATAL) << "Could not fetch parent buffer " << keyToString(key)
+                   << " error: " << error.what();
+      }
+    } else if (num_bytes > buffer->size()) {
       try {
         parent_mgr_->fetchBuffer(key, buffer, num_bytes);
       } catch (const foreign_storage::ForeignStorageException& error) {
@@ -804,9 +1132,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
                    << " error: " << error.what();
       }
     }
-    sized_segs_lock.unlock();
   }
-  lock.unlock();
   buffer->copyTo(dest_buffer, num_bytes);
   buffer->unPin();
 }
@@ -814,9 +1140,10 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
 AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key,
                                      AbstractBuffer* src_buffer,
                                      const size_t num_bytes) {
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.chunk_index.find(key);
+  bool found_buffer = buffer_it != shard.chunk_index.end();
   chunk_index_lock.unlock();
   AbstractBuffer* buffer;
   if (!found_buffer) {
@@ -872,8 +1199,12 @@ void BufferMgr::free(AbstractBuffer* buffer) {
 }
 
 size_t BufferMgr::getNumChunks() {
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  return chunk_index_.size();
+  size_t num_chunks = 0;
+  for (auto& shard : chunk_index_shards_) {
+    std::lock_guard<std::mutex> chunk_index_lock(shard.mutex);
+    num_chunks += shard.chunk_index.size();
+  }
+  return num_chunks;
 }
 
 size_t BufferMgr::size() {
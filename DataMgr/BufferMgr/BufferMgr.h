@@ -26,15 +26,21 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
+#include "DataMgr/BufferMgr/BufferEvictionPolicy.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
 #include "Shared/boost_stacktrace.hpp"
+#include "Shared/heavyai_shared_mutex.h"
 #include "Shared/types.h"
 
 class OutOfMemory : public std::runtime_error {
@@ -138,6 +144,11 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   /// Returns the a pointer to the chunk with the specified key.
   AbstractBuffer* getBuffer(const ChunkKey& key, const size_t num_bytes = 0) override;
 
+  /// Pins the buffers for keys, fetching the missing ones with a single request to the
+  /// parent buffer manager.
+  std::vector<AbstractBuffer*> getBuffers(const std::vector<ChunkKey>& keys,
+                                          const std::vector<size_t>& num_bytes) override;
+
   /**
    * @brief Puts the contents of d into the Buffer with ChunkKey key.
    * @param key - Unique identifier for a Chunk.
@@ -148,6 +159,9 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void fetchBuffer(const ChunkKey& key,
                    AbstractBuffer* dest_buffer,
                    const size_t num_bytes = 0) override;
+  void fetchBuffers(const std::vector<ChunkKey>& keys,
+                    const std::vector<AbstractBuffer*>& dest_buffers,
+                    const std::vector<size_t>& num_bytes) override;
   AbstractBuffer* putBuffer(const ChunkKey& key,
                             AbstractBuffer* d,
                             const size_t num_bytes = 0) override;
@@ -168,6 +182,21 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunk_metadata_vec,
                                        const ChunkKey& key_prefix) override;
 
+  /// Adds slabs until the pool reaches its maximum size, so that their memory is not
+  /// allocated while running queries.
+  void allocateSlabs();
+
+  /**
+   * @brief Frees whole slabs, least recently used first, until num_bytes are freed or
+   * the pool would shrink below min_pool_size bytes. Slabs holding pinned or dirty
+   * buffers are skipped, the buffers of the other slabs are evicted.
+   *
+   * Released slabs keep their slab number and are reused before new slabs are added.
+   *
+   * @return The number of bytes freed.
+   */
+  size_t releaseSlabs(const size_t num_bytes, const size_t min_pool_size);
+
  protected:
   const size_t
       max_buffer_pool_size_;    /// max number of bytes allocated for the buffer pool
@@ -183,24 +212,68 @@ class BufferMgr : public AbstractBufferMgr {  // implements
  private:
   BufferMgr(const BufferMgr&);             // private copy constructor
   BufferMgr& operator=(const BufferMgr&);  // private assignment
+  // Holds the lock of the slab, or of the unsized segments, that contains a segment.
+  struct SegmentLock {
+    heavyai::shared_lock<heavyai::shared_mutex> slabs_lock;
+    std::unique_lock<std::mutex> segments_lock;
+  };
+
+  struct alignas(64) ChunkIndexShard {
+    std::mutex mutex;
+    std::map<ChunkKey, BufferList::iterator> chunk_index;
+  };
+
+  static constexpr size_t kNumChunkIndexShards{64};
+
+  ChunkIndexShard& getChunkIndexShard(const ChunkKey& key);
+  // Locks every chunk index shard, in shard order.
+  std::vector<std::unique_lock<std::mutex>> lockChunkIndexShards();
+  SegmentLock lockSegment(const BufferList::iterator& seg_it);
+  // Returns the pinned buffer of the chunk, or nullptr if the chunk is not in the pool.
+  // Chunks that are not in a slab yet may still be being created, so they are only
+  // returned with include_unsized, which requires global_mutex_ to be held.
+  Buffer* findAndPinBuffer(const ChunkKey& key, const bool include_unsized);
+  // Assumes the segment is locked, see lockSegment(), or that all slabs are locked.
   void removeSegment(BufferList::iterator& seg_it);
   BufferList::iterator findFreeBufferInSlab(const size_t slab_num,
                                             const size_t num_pages_requested);
+  BufferList::iterator useFreeSegment(BufferList::iterator& seg_it,
+                                      const size_t slab_num,
+                                      const size_t num_pages_requested);
   int getBufferId();
+  // Free segments of preferred slabs are used before those of other slabs.
+  virtual bool isPreferredSlab(const size_t slab_num, const ChunkKey& chunk_key) const {
+    return true;
+  }
   virtual void addSlab(const size_t slab_size) = 0;
+  // Returns the memory of a released slab to the OS, see releaseSlabs().
+  virtual void releaseSlabMemory(const size_t slab_num, const size_t slab_size);
+  // Prepares the memory of a released slab to be used again.
+  virtual void reuseSlabMemory(const size_t slab_num, const size_t slab_size) {}
   virtual void freeAllMem() = 0;
   virtual void allocateBuffer(BufferList::iterator seg_it,
                               const size_t page_size,
                               const size_t num_bytes) = 0;
   void clear();
 
-  std::mutex chunk_index_mutex_;
-  std::mutex sized_segs_mutex_;
+  /*
+   * Lock order: global_mutex_, chunk index shards, slabs_mutex_, slab_mutexes_ (or
+   * unsized_segs_mutex_).
+   *
+   * Lookups of cached chunks only lock the shard of the chunk, so they do not contend
+   * with each other. Allocations from a free segment lock slabs_mutex_ shared and the
+   * mutex of the slab. Adding slabs and evicting take every shard lock and slabs_mutex_
+   * exclusively, so no buffer can be pinned through the chunk index while it is chosen
+   * for eviction.
+   */
+  std::array<ChunkIndexShard, kNumChunkIndexShards> chunk_index_shards_;
+  heavyai::shared_mutex slabs_mutex_;
+  std::vector<std::unique_ptr<std::mutex>> slab_mutexes_;
   std::mutex unsized_segs_mutex_;
   std::mutex buffer_id_mutex_;
+  // Serializes loading chunks from the parent buffer manager and checkpoints.
   std::mutex global_mutex_;
 
-  std::map<ChunkKey, BufferList::iterator> chunk_index_;
   size_t max_buffer_pool_num_pages_;  // max number of pages for buffer pool
   size_t num_pages_allocated_;
   size_t min_num_pages_per_slab_;
@@ -209,13 +282,36 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   bool allocations_capped_;
   AbstractBufferMgr* parent_mgr_;
   int max_buffer_id_;
-  unsigned int buffer_epoch_;
+  std::atomic<unsigned int> buffer_epoch_;
 
   BufferList unsized_segs_;
+  // Number of pages of each released slab, by slab number. Released slabs have no
+  // segments.
+  std::map<size_t, size_t> released_slabs_;
+  // Picks the buffers to evict, unless the default score based eviction is used.
+  std::unique_ptr<BufferEvictionPolicy> eviction_policy_;
 
+  /**
+   * @brief Adds a slab that can hold num_pages_requested pages, unless the pool cannot
+   * grow anymore. The slab size is halved on failed allocations, down to the minimum
+   * slab size.
+   *
+   * @return The number of the added slab, if any. Released slabs are reused first.
+   *
+   * Assumes every chunk index shard and slabs_mutex_ are locked.
+   */
+  std::optional<size_t> addSlabForRequest(const size_t num_pages_requested);
   BufferList::iterator evict(BufferList::iterator& evict_start,
                              const size_t num_pages_requested,
                              const int slab_num);
+  /**
+   * @brief Evicts the first segment in eviction_policy_ order that, together with its
+   * free or evictable neighbours, forms a run of the required size, and returns an
+   * iterator to the reserved segment as in findFreeBuffer. Returns nothing if no such
+   * run exists, in which case the scan for the cheapest run of segments is used.
+   */
+  std::optional<BufferList::iterator> evictWithPolicy(const size_t num_pages_requested,
+                                                      const size_t num_bytes);
   /**
    * @brief Gets a buffer of required size and returns an iterator to it
    *
@@ -228,8 +324,9 @@ class BufferMgr : public AbstractBufferMgr {  // implements
    * buffer won't be evicted by PINNING it - caller should change this to
    * USED if applicable
    *
+   * Must not be called with a chunk index shard locked.
    */
-  BufferList::iterator findFreeBuffer(size_t num_bytes);
+  BufferList::iterator findFreeBuffer(size_t num_bytes, const ChunkKey& chunk_key);
 };
 
 }  // namespace Buffer_Namespace
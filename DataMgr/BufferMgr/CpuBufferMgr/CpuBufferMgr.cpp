@@ -16,12 +16,53 @@
 
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 
+#include <cstring>
+#include <thread>
+
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
+#include "DataMgr/Allocators/HugePageAllocator.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
+#include "OSDependent/heavyai_fs.h"
+#include "OSDependent/heavyai_huge_pages.h"
+#include "OSDependent/heavyai_numa.h"
+
+bool g_enable_numa_aware_placement{false};
+std::string g_cpu_buffer_huge_pages{"none"};
+bool g_prefault_cpu_buffer_pool{false};
 
 namespace Buffer_Namespace {
 
+namespace {
+// Slabs are mapped with huge pages of the size given by g_cpu_buffer_huge_pages, which is
+// one of "none", "thp" (transparent huge pages only), "2mb" or "1gb".
+std::unique_ptr<Arena> create_slab_allocator(const size_t max_slab_size,
+                                             const size_t max_buffer_pool_size) {
+  if (g_cpu_buffer_huge_pages == "none") {
+    return std::make_unique<DramArena>(max_slab_size + kArenaBlockOverhead);
+  }
+  size_t huge_page_size;
+  if (g_cpu_buffer_huge_pages == "thp") {
+    huge_page_size = 0;
+  } else if (g_cpu_buffer_huge_pages == "2mb") {
+    huge_page_size = heavyai::kHugePageSize2MB;
+  } else if (g_cpu_buffer_huge_pages == "1gb") {
+    huge_page_size = heavyai::kHugePageSize1GB;
+  } else {
+    throw std::runtime_error("Unknown CPU buffer huge page mode \"" +
+                             g_cpu_buffer_huge_pages +
+                             "\", expected one of none, thp, 2mb or 1gb.");
+  }
+  // The mapped memory never exceeds the size of the buffer pool.
+  return std::make_unique<HugePageArena>(huge_page_size, max_buffer_pool_size);
+}
+}  // namespace
+
+size_t get_numa_node_for_fragment(const int fragment_id) {
+  CHECK_GE(fragment_id, 0);
+  return static_cast<size_t>(fragment_id) % heavyai::get_num_numa_nodes();
+}
+
 void CpuBufferMgr::addSlab(const size_t slab_size) {
   CHECK(allocator_);
   slabs_.resize(slabs_.size() + 1);
@@ -34,6 +75,73 @@ void CpuBufferMgr::addSlab(const size_t slab_size) {
   slab_segments_.resize(slab_segments_.size() + 1);
   slab_segments_[slab_segments_.size() - 1].push_back(
       BufferSeg(0, slab_size / page_size_));
+  placeSlabOnNumaNode(slabs_.size() - 1, slab_size);
+  prefaultSlab(slabs_.size() - 1, slab_size);
+}
+
+void CpuBufferMgr::releaseSlabMemory(const size_t slab_num, const size_t slab_size) {
+  heavyai::release_pages(slabs_[slab_num], slab_size);
+}
+
+void CpuBufferMgr::reuseSlabMemory(const size_t slab_num, const size_t slab_size) {
+  // The pages were returned to the OS, so they are placed and faulted in again.
+  placeSlabOnNumaNode(slab_num, slab_size);
+  prefaultSlab(slab_num, slab_size);
+}
+
+void CpuBufferMgr::placeSlabOnNumaNode(const size_t slab_num, const size_t slab_size) {
+  if (slab_numa_nodes_.size() <= slab_num) {
+    slab_numa_nodes_.resize(slab_num + 1);
+  }
+  slab_numa_nodes_[slab_num] = kNoNumaNode;
+  const auto num_numa_nodes = heavyai::get_num_numa_nodes();
+  if (!g_enable_numa_aware_placement || num_numa_nodes < 2) {
+    return;
+  }
+  const size_t numa_node = slab_num % num_numa_nodes;
+  // Pages are placed on the node of the thread that first touches them, so fault the
+  // slab in from a thread bound to the node.
+  bool placed = false;
+  std::thread([&] {
+    if (heavyai::bind_thread_to_numa_node(numa_node)) {
+      std::memset(slabs_[slab_num], 0, slab_size);
+      placed = true;
+    }
+  }).join();
+  if (placed) {
+    slab_numa_nodes_[slab_num] = numa_node;
+    VLOG(1) << "Placed slab " << slab_num << " on NUMA node " << numa_node;
+  } else {
+    LOG(WARNING) << "Could not place slab " << slab_num << " on NUMA node "
+                 << numa_node;
+  }
+}
+
+void CpuBufferMgr::prefaultSlab(const size_t slab_num, const size_t slab_size) {
+  // Slabs placed on a NUMA node were already faulted in.
+  if (!g_prefault_cpu_buffer_pool || slab_numa_nodes_[slab_num] != kNoNumaNode) {
+    return;
+  }
+  const size_t os_page_size = heavyai::get_page_size();
+  volatile int8_t* slab = slabs_[slab_num];
+  for (size_t offset = 0; offset < slab_size; offset += os_page_size) {
+    slab[offset] = 0;
+  }
+}
+
+size_t CpuBufferMgr::getHugePageBytes() const {
+  auto huge_page_allocator = dynamic_cast<const HugePageArena*>(allocator_.get());
+  return huge_page_allocator ? huge_page_allocator->hugePageBytesUsed() : 0;
+}
+
+bool CpuBufferMgr::isPreferredSlab(const size_t slab_num,
+                                   const ChunkKey& chunk_key) const {
+  if (slab_num >= slab_numa_nodes_.size() || slab_numa_nodes_[slab_num] == kNoNumaNode ||
+      chunk_key.size() <= CHUNK_KEY_FRAGMENT_IDX || chunk_key[0] < 0) {
+    return true;
+  }
+  return slab_numa_nodes_[slab_num] ==
+         get_numa_node_for_fragment(chunk_key[CHUNK_KEY_FRAGMENT_IDX]);
 }
 
 void CpuBufferMgr::freeAllMem() {
@@ -56,7 +164,7 @@ void CpuBufferMgr::allocateBuffer(BufferList::iterator seg_it,
 }
 
 void CpuBufferMgr::initializeMem() {
-  allocator_.reset(new DramArena(max_slab_size_ + kArenaBlockOverhead));
+  allocator_ = create_slab_allocator(max_slab_size_, max_buffer_pool_size_);
 }
 
 }  // namespace Buffer_Namespace
@@ -20,12 +20,22 @@
 
 #include "DataMgr/Allocators/ArenaAllocator.h"
 
+#include <limits>
+
 namespace CudaMgr_Namespace {
 class CudaMgr;
 }
 
+extern bool g_enable_numa_aware_placement;
+extern std::string g_cpu_buffer_huge_pages;
+extern bool g_prefault_cpu_buffer_pool;
+
 namespace Buffer_Namespace {
 
+// Returns the NUMA node that holds the chunks of a fragment, and that runs its kernels,
+// when NUMA aware placement is enabled.
+size_t get_numa_node_for_fragment(const int fragment_id);
+
 class CpuBufferMgr : public BufferMgr {
  public:
   CpuBufferMgr(const int device_id,
@@ -52,18 +62,33 @@ class CpuBufferMgr : public BufferMgr {
   inline MgrType getMgrType() override { return CPU_MGR; }
   inline std::string getStringMgrType() override { return ToString(CPU_MGR); }
 
+  // Returns the number of bytes of the slabs that are backed by huge pages.
+  size_t getHugePageBytes() const;
+
  protected:
   void addSlab(const size_t slab_size) override;
+  void releaseSlabMemory(const size_t slab_num, const size_t slab_size) override;
+  void reuseSlabMemory(const size_t slab_num, const size_t slab_size) override;
   void freeAllMem() override;
   void allocateBuffer(BufferList::iterator segment_iter,
                       const size_t page_size,
                       const size_t initial_size) override;
   virtual void initializeMem();
+  bool isPreferredSlab(const size_t slab_num, const ChunkKey& chunk_key) const override;
+  // Places the pages of a new slab on the NUMA node assigned to it, if NUMA aware
+  // placement is enabled. Slabs are assigned to the nodes round robin.
+  void placeSlabOnNumaNode(const size_t slab_num, const size_t slab_size);
+  // Faults in the pages of a new slab if the pool is pre-faulted, so that queries do not
+  // take the page faults when they first touch the slab.
+  void prefaultSlab(const size_t slab_num, const size_t slab_size);
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
+  // NUMA node of each slab, or kNoNumaNode for slabs not placed on a node.
+  std::vector<size_t> slab_numa_nodes_;
+  static constexpr size_t kNoNumaNode{std::numeric_limits<size_t>::max()};
 
  private:
-  std::unique_ptr<DramArena> allocator_;
+  std::unique_ptr<Arena> allocator_;
 };
 
 }  // namespace Buffer_Namespace
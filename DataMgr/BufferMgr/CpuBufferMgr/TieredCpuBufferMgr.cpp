@@ -95,6 +95,13 @@ void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
     slab_segments_.resize(slab_segments_.size() + 1);
     slab_segments_[slab_segments_.size() - 1].push_back(
         BufferSeg(0, slab_size / page_size_));
+    if (last_tier == CpuTier::DRAM) {
+      placeSlabOnNumaNode(slabs_.size() - 1, slab_size);
+      prefaultSlab(slabs_.size() - 1, slab_size);
+    } else {
+      slab_numa_nodes_.resize(slabs_.size());
+      slab_numa_nodes_.back() = kNoNumaNode;
+    }
     LOG(INFO) << "Allocated slab using " << tier_to_string(last_tier) << ".";
   } else {
     // None of the allocators allocated a slab, so revert to original size and throw.
@@ -103,6 +110,19 @@ void TieredCpuBufferMgr::addSlab(const size_t slab_size) {
   }
 }
 
+void TieredCpuBufferMgr::releaseSlabMemory(const size_t slab_num,
+                                           const size_t slab_size) {
+  if (getAllocatorForSlab(slab_num)->getMemoryType() == Arena::MemoryType::DRAM) {
+    CpuBufferMgr::releaseSlabMemory(slab_num, slab_size);
+  }
+}
+
+void TieredCpuBufferMgr::reuseSlabMemory(const size_t slab_num, const size_t slab_size) {
+  if (getAllocatorForSlab(slab_num)->getMemoryType() == Arena::MemoryType::DRAM) {
+    CpuBufferMgr::reuseSlabMemory(slab_num, slab_size);
+  }
+}
+
 void TieredCpuBufferMgr::freeAllMem() {
   CHECK(!allocators_.empty());
   CHECK(allocators_.begin()->first.get() != nullptr);
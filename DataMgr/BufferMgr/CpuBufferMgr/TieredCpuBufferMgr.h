@@ -57,6 +57,9 @@ class TieredCpuBufferMgr : public CpuBufferMgr {
 
  private:
   void addSlab(const size_t slab_size) override;
+  // Only the memory of DRAM slabs is returned to the OS.
+  void releaseSlabMemory(const size_t slab_num, const size_t slab_size) override;
+  void reuseSlabMemory(const size_t slab_num, const size_t slab_size) override;
   void freeAllMem() override;
   void initializeMem() override;
 
@@ -50,6 +50,48 @@ std::shared_ptr<Chunk> Chunk::getChunk(const ColumnDescriptor* cd,
   return chunkp;
 }
 
+std::vector<std::shared_ptr<Chunk>> Chunk::getChunks(
+    const std::vector<ChunkRequest>& requests,
+    DataMgr* data_mgr,
+    const MemoryLevel mem_level,
+    const int device_id) {
+  std::vector<ChunkKey> keys;
+  std::vector<size_t> num_bytes;
+  for (const auto& request : requests) {
+    if (request.cd->columnType.is_varlen() &&
+        !request.cd->columnType.is_fixlen_array()) {
+      ChunkKey data_key = request.chunk_key;
+      data_key.push_back(1);
+      ChunkKey index_key = request.chunk_key;
+      index_key.push_back(2);
+      keys.emplace_back(std::move(data_key));
+      num_bytes.emplace_back(request.num_bytes);
+      keys.emplace_back(std::move(index_key));
+      num_bytes.emplace_back((request.num_elements + 1) * sizeof(StringOffsetT));
+    } else {
+      keys.emplace_back(request.chunk_key);
+      num_bytes.emplace_back(request.num_bytes);
+    }
+  }
+  const auto buffers = data_mgr->getChunkBuffers(keys, mem_level, device_id, num_bytes);
+  std::vector<std::shared_ptr<Chunk>> chunks;
+  chunks.reserve(requests.size());
+  size_t buffer_idx = 0;
+  for (const auto& request : requests) {
+    if (request.cd->columnType.is_varlen() &&
+        !request.cd->columnType.is_fixlen_array()) {
+      chunks.emplace_back(
+          getChunk(request.cd, buffers[buffer_idx], buffers[buffer_idx + 1]));
+      buffer_idx += 2;
+    } else {
+      chunks.emplace_back(getChunk(request.cd, buffers[buffer_idx], nullptr));
+      ++buffer_idx;
+    }
+  }
+  CHECK_EQ(buffer_idx, buffers.size());
+  return chunks;
+}
+
 bool Chunk::isChunkOnDevice(DataMgr* data_mgr,
                             const ChunkKey& key,
                             const MemoryLevel mem_level,
@@ -340,8 +382,14 @@ ChunkIter Chunk::begin_iterator(const std::shared_ptr<ChunkMetadata>& chunk_meta
     it.current_pos = it.start_pos = buffer_->getMemoryPtr() + start_idx * it.skip_size;
     it.end_pos = buffer_->getMemoryPtr() + buffer_->size();
     it.second_buf = nullptr;
+    if (column_desc_->columnType.is_block_encoded()) {
+      // positions are row offsets from the buffer start, see ChunkIter
+      it.end_pos = buffer_->getMemoryPtr() + chunk_metadata->numElements * it.skip_size;
+      it.second_buf = buffer_->getMemoryPtr();
+    }
   }
   it.num_elems = chunk_metadata->numElements;
+  it.decode_cursor = 0;
   return it;
 }
 
@@ -38,6 +38,14 @@ using Data_Namespace::MemoryLevel;
 
 namespace Chunk_NS {
 
+// A chunk to get with Chunk::getChunks, sized as in Chunk::getChunk.
+struct ChunkRequest {
+  const ColumnDescriptor* cd;
+  ChunkKey chunk_key;
+  size_t num_bytes;
+  size_t num_elements;
+};
+
 class Chunk {
  public:
   Chunk(bool pinnable = true)
@@ -119,6 +127,16 @@ class Chunk {
                                          const size_t num_elems,
                                          const bool pinnable = true);
 
+  /**
+   * @brief Get the chunks for requests of distinct keys, fetching the buffers missing
+   * at mem_level with a single batch of reads from the parent level.
+   */
+  static std::vector<std::shared_ptr<Chunk>> getChunks(
+      const std::vector<ChunkRequest>& requests,
+      DataMgr* data_mgr,
+      const MemoryLevel mem_level,
+      const int device_id);
+
   /**
    * @brief Compose a chunk from components and return it
    *
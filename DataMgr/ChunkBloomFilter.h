@@ -0,0 +1,95 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkBloomFilter.h
+ * @brief   Bloom filter of the values of an integer, date or dictionary encoded string
+ *          chunk, kept next to its metadata to skip fragments on equality predicates.
+ *
+ * The filter is blocked: every value sets kNumProbes bits of a single 64-bit word, so
+ * adding or looking up a value touches one word. It has a fixed size so that it fits in
+ * the metadata page of the chunk, which makes it selective up to a couple thousand
+ * distinct values per chunk. Past kMaxBitsSet bits it is considered saturated and isn't
+ * used anymore.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstdio>
+
+class ChunkBloomFilter {
+ public:
+  static constexpr int32_t kWordIndexBits{8};
+  static constexpr size_t kNumWords{size_t(1) << kWordIndexBits};
+  static constexpr int32_t kNumProbes{3};
+  static constexpr size_t kMaxBitsSet{kNumWords * 64 / 2};
+  static constexpr size_t kSerializedBytes{kNumWords * sizeof(uint64_t)};
+
+  void add(const int64_t val) {
+    const auto h = hash(val);
+    words_[h >> (64 - kWordIndexBits)] |= mask(h);
+  }
+
+  bool mayContain(const int64_t val) const {
+    const auto h = hash(val);
+    const auto m = mask(h);
+    return (words_[h >> (64 - kWordIndexBits)] & m) == m;
+  }
+
+  void merge(const ChunkBloomFilter& that) {
+    for (size_t i = 0; i < kNumWords; ++i) {
+      words_[i] |= that.words_[i];
+    }
+  }
+
+  bool isSaturated() const {
+    size_t bits_set = 0;
+    for (const auto word : words_) {
+      bits_set += std::bitset<64>(word).count();
+    }
+    return bits_set > kMaxBitsSet;
+  }
+
+  void write(FILE* f) const { fwrite(words_.data(), sizeof(uint64_t), kNumWords, f); }
+
+  void read(FILE* f) { fread(words_.data(), sizeof(uint64_t), kNumWords, f); }
+
+ private:
+  // Finalizer of MurmurHash3, mixes every bit of the value into every bit of the hash.
+  static uint64_t hash(const int64_t val) {
+    auto h = static_cast<uint64_t>(val);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  // The bit positions are taken from the low bits, the word index from the high ones.
+  static uint64_t mask(const uint64_t h) {
+    uint64_t m = 0;
+    for (int32_t probe = 0; probe < kNumProbes; ++probe) {
+      m |= uint64_t(1) << ((h >> (6 * probe)) & 63);
+    }
+    return m;
+  }
+
+  std::array<uint64_t, kNumWords> words_{};
+};
@@ -18,7 +18,10 @@
 
 #include <cstddef>
 #include <iostream>
+#include <memory>
 
+#include "ChunkBloomFilter.h"
+#include "ChunkZoneMap.h"
 #include "Logger/Logger.h"
 #include "Shared/StringTransform.h"
 #include "Shared/sqltypes.h"
@@ -35,6 +38,10 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // Values of the chunk, when its encoder keeps track of them. See ChunkBloomFilter.h.
+  std::shared_ptr<const ChunkBloomFilter> bloomFilter;
+  // Value ranges of blocks of rows of the chunk, see ChunkZoneMap.h.
+  std::shared_ptr<const ChunkZoneMap> zoneMap;
 
   ChunkMetadata(const SQLTypeInfo& sql_type,
                 const size_t num_bytes,
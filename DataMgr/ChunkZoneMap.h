@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkZoneMap.h
+ * @brief   Min and max of the values of consecutive blocks of rows of an integer, decimal
+ *          or date/time chunk, kept next to its metadata to skip parts of fragments.
+ *
+ * Zones start with kMinBlockRows rows. When the chunk grows past kMaxZones zones, pairs
+ * of consecutive zones are merged and the block size doubles, so the zone map of a chunk
+ * of n rows always has blocks of blockRows(n) rows and fits in the metadata page.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+class ChunkZoneMap {
+ public:
+  static constexpr size_t kMinBlockRows{65536};
+  static constexpr size_t kMaxZones{64};
+  static constexpr size_t kSerializedBytes{sizeof(size_t) + sizeof(int32_t) +
+                                           kMaxZones * 2 * sizeof(int64_t)};
+
+  static size_t blockRows(const size_t num_rows) {
+    size_t block_rows = kMinBlockRows;
+    while (num_rows > block_rows * kMaxZones) {
+      block_rows *= 2;
+    }
+    return block_rows;
+  }
+
+  // Records the non null value of rows [first_row, first_row + num_rows).
+  void add(const size_t first_row, const size_t num_rows, const int64_t val) {
+    if (!num_rows) {
+      return;
+    }
+    const auto last_row = first_row + num_rows - 1;
+    while (last_row >= block_rows_ * kMaxZones) {
+      coarsen();
+    }
+    const auto last_zone = last_row / block_rows_;
+    if (zones_.size() <= last_zone) {
+      zones_.resize(last_zone + 1, kEmptyZone);
+    }
+    for (auto zone = first_row / block_rows_; zone <= last_zone; ++zone) {
+      zones_[zone].first = std::min(zones_[zone].first, val);
+      zones_[zone].second = std::max(zones_[zone].second, val);
+    }
+  }
+
+  // Min and max of the non null values of rows [begin, end), nullopt when all are null.
+  std::optional<std::pair<int64_t, int64_t>> getRange(const size_t begin,
+                                                      const size_t end) const {
+    auto range = kEmptyZone;
+    const auto end_zone = std::min((end + block_rows_ - 1) / block_rows_, zones_.size());
+    for (auto zone = begin / block_rows_; zone < end_zone; ++zone) {
+      range.first = std::min(range.first, zones_[zone].first);
+      range.second = std::max(range.second, zones_[zone].second);
+    }
+    if (range.first > range.second) {
+      return std::nullopt;
+    }
+    return range;
+  }
+
+  size_t blockRows() const { return block_rows_; }
+
+  void write(FILE* f) const {
+    const int32_t num_zones = zones_.size();
+    fwrite(&block_rows_, sizeof(size_t), 1, f);
+    fwrite(&num_zones, sizeof(int32_t), 1, f);
+    fwrite(zones_.data(), 2 * sizeof(int64_t), num_zones, f);
+  }
+
+  // Returns false when the section read isn't a valid zone map.
+  bool read(FILE* f) {
+    int32_t num_zones{0};
+    fread(&block_rows_, sizeof(size_t), 1, f);
+    fread(&num_zones, sizeof(int32_t), 1, f);
+    if (block_rows_ < kMinBlockRows || num_zones < 0 ||
+        static_cast<size_t>(num_zones) > kMaxZones) {
+      return false;
+    }
+    zones_.resize(num_zones);
+    fread(zones_.data(), 2 * sizeof(int64_t), num_zones, f);
+    return true;
+  }
+
+ private:
+  static constexpr std::pair<int64_t, int64_t> kEmptyZone{
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min()};
+
+  void coarsen() {
+    for (size_t zone = 0; zone < zones_.size(); zone += 2) {
+      auto merged = zones_[zone];
+      if (zone + 1 < zones_.size()) {
+        merged.first = std::min(merged.first, zones_[zone + 1].first);
+        merged.second = std::max(merged.second, zones_[zone + 1].second);
+      }
+      zones_[zone / 2] = merged;
+    }
+    zones_.resize((zones_.size() + 1) / 2);
+    block_rows_ *= 2;
+  }
+
+  size_t block_rows_{kMinBlockRows};
+  std::vector<std::pair<int64_t, int64_t>> zones_;
+};
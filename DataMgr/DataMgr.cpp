@@ -27,6 +27,7 @@
 #include "DataMgr/Allocators/CudaAllocator.h"
 #include "FileMgr/GlobalFileMgr.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
+#include "Shared/measure.h"
 
 #ifdef __APPLE__
 #include <sys/sysctl.h>
@@ -36,10 +37,17 @@
 #include <boost/filesystem.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <limits>
+#include <optional>
 
 extern bool g_enable_fsi;
 
+bool g_enable_cpu_buffer_pool_reclaim{false};
+size_t g_cpu_buffer_pool_reclaim_floor{0};
+double g_cpu_buffer_pool_reclaim_stall_percent{10.0};
+size_t g_cpu_buffer_pool_reclaim_min_available_percent{5};
+
 #ifdef ENABLE_MEMKIND
 bool g_enable_tiered_cpu_mem{false};
 std::string g_pmem_path{};
@@ -78,9 +86,20 @@ DataMgr::DataMgr(const std::string& dataDir,
 
   populateMgrs(system_parameters, numReaderThreads, cache_config);
   createTopLevelMetadata();
+  if (g_enable_cpu_buffer_pool_reclaim) {
+    reclaim_thread_ = std::thread([this] { backgroundReclaimLoop(); });
+  }
 }
 
 DataMgr::~DataMgr() {
+  {
+    std::lock_guard<std::mutex> lock(reclaim_mutex_);
+    stop_reclaim_ = true;
+  }
+  reclaim_cv_.notify_all();
+  if (reclaim_thread_.joinable()) {
+    reclaim_thread_.join();
+  }
   int numLevels = bufferMgrs_.size();
   for (int level = numLevels - 1; level >= 0; --level) {
     for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
@@ -146,6 +165,124 @@ DataMgr::SystemMemoryUsage DataMgr::getSystemMemoryUsage() const {
   return usage;
 }
 
+namespace {
+#ifdef __linux__
+// Returns the cgroup v2 directory of the process, or an empty string if the process is
+// not in a cgroup v2 hierarchy.
+std::string get_cgroup_dir() {
+  std::ifstream cgroup("/proc/self/cgroup");
+  std::string line;
+  while (std::getline(cgroup, line)) {
+    if (line.rfind("0::", 0) == 0) {
+      return "/sys/fs/cgroup" + line.substr(3);
+    }
+  }
+  return {};
+}
+
+// Returns the value of a cgroup file holding a single number, or of a key of a cgroup
+// file holding "key value" lines. Missing and unlimited ("max") values are not returned.
+std::optional<size_t> read_cgroup_value(const std::string& path,
+                                        const std::string& key = {}) {
+  std::ifstream f(path);
+  std::string name, value;
+  if (key.empty()) {
+    f >> value;
+  } else {
+    while (f >> name >> value && name != key) {
+    }
+  }
+  if (!f || value == "max") {
+    return std::nullopt;
+  }
+  return std::stoull(value);
+}
+
+// Returns the "some avg10" field of a PSI file, see
+// https://docs.kernel.org/accounting/psi.html.
+double read_stall_percent(const std::string& path) {
+  std::ifstream f(path);
+  std::string line;
+  while (std::getline(f, line)) {
+    const auto pos = line.find("avg10=");
+    if (line.rfind("some ", 0) == 0 && pos != std::string::npos) {
+      return std::stod(line.substr(pos + 6));
+    }
+  }
+  return 0;
+}
+#endif
+}  // namespace
+
+DataMgr::MemoryPressure DataMgr::getMemoryPressure() const {
+  MemoryPressure pressure{0, 0, 0};
+#ifdef __linux__
+  ProcMeminfoParser mi;
+  pressure.available = mi["MemAvailable"];
+  pressure.limit = mi["MemTotal"];
+  std::string psi_path{"/proc/pressure/memory"};
+  const auto cgroup_dir = get_cgroup_dir();
+  if (!cgroup_dir.empty()) {
+    const auto limit = read_cgroup_value(cgroup_dir + "/memory.max");
+    const auto current = read_cgroup_value(cgroup_dir + "/memory.current");
+    if (limit && current && *limit < pressure.limit) {
+      // Inactive page cache is reclaimed by the kernel before the limit is hit.
+      const auto inactive_file =
+          read_cgroup_value(cgroup_dir + "/memory.stat", "inactive_file").value_or(0);
+      const auto used = *current - std::min(*current, inactive_file);
+      pressure.limit = *limit;
+      pressure.available = *limit - std::min(*limit, used);
+    }
+    if (boost::filesystem::exists(cgroup_dir + "/memory.pressure")) {
+      psi_path = cgroup_dir + "/memory.pressure";
+    }
+  }
+  pressure.stall_percent = read_stall_percent(psi_path);
+#endif
+  return pressure;
+}
+
+void DataMgr::backgroundReclaimLoop() {
+  constexpr std::chrono::milliseconds reclaim_interval{1000};
+  while (true) {
+    try {
+      reclaimCpuBufferPool();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "CPU buffer pool reclaim pass failed: " << e.what();
+    }
+    std::unique_lock<std::mutex> lock(reclaim_mutex_);
+    if (reclaim_cv_.wait_for(lock, reclaim_interval, [this] { return stop_reclaim_; })) {
+      return;
+    }
+  }
+}
+
+void DataMgr::reclaimCpuBufferPool() {
+  const auto pressure = getMemoryPressure();
+  const size_t min_available =
+      pressure.limit * g_cpu_buffer_pool_reclaim_min_available_percent / 100;
+  size_t num_bytes = 0;
+  if (pressure.available < min_available) {
+    num_bytes = min_available - pressure.available;
+  } else if (pressure.stall_percent >= g_cpu_buffer_pool_reclaim_stall_percent) {
+    // Stalls do not tell how much memory is needed, so free a single slab per pass.
+    num_bytes = 1;
+  }
+  if (num_bytes == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  const auto num_bytes_released =
+      getCpuBufferMgr()->releaseSlabs(num_bytes, g_cpu_buffer_pool_reclaim_floor);
+  if (num_bytes_released > 0) {
+    LOG(INFO) << "Released " << num_bytes_released
+              << " bytes of the CPU buffer pool under memory pressure, "
+              << pressure.available << " of " << pressure.limit
+              << " bytes were available and tasks stalled on memory "
+              << pressure.stall_percent << "% of the time.";
+  }
+}
+
 size_t DataMgr::getTotalSystemMemory() {
 #ifdef __APPLE__
   int mib[2];
@@ -175,41 +312,55 @@ void DataMgr::allocateCpuBufferMgr(int32_t device_id,
                                    size_t maxCpuSlabSize,
                                    size_t page_size,
                                    const CpuTierSizeVector& cpu_tier_sizes) {
+  Buffer_Namespace::CpuBufferMgr* cpu_buffer_mgr{nullptr};
 #ifdef ENABLE_MEMKIND
   if (g_enable_tiered_cpu_mem) {
-    bufferMgrs_[1].push_back(new Buffer_Namespace::TieredCpuBufferMgr(0,
-                                                                      total_cpu_size,
-                                                                      cudaMgr_.get(),
-                                                                      minCpuSlabSize,
-                                                                      maxCpuSlabSize,
-                                                                      page_size,
-                                                                      cpu_tier_sizes,
-                                                                      bufferMgrs_[0][0]));
-    return;
-  }
-#endif
-
-  bufferMgrs_[1].push_back(new Buffer_Namespace::CpuBufferMgr(0,
+    cpu_buffer_mgr = new Buffer_Namespace::TieredCpuBufferMgr(0,
                                                               total_cpu_size,
                                                               cudaMgr_.get(),
                                                               minCpuSlabSize,
                                                               maxCpuSlabSize,
                                                               page_size,
-                                                              bufferMgrs_[0][0]));
+                                                              cpu_tier_sizes,
+                                                              bufferMgrs_[0][0]);
+  }
+#endif
+
+  if (!cpu_buffer_mgr) {
+    cpu_buffer_mgr = new Buffer_Namespace::CpuBufferMgr(0,
+                                                        total_cpu_size,
+                                                        cudaMgr_.get(),
+                                                        minCpuSlabSize,
+                                                        maxCpuSlabSize,
+                                                        page_size,
+                                                        bufferMgrs_[0][0]);
+  }
+  bufferMgrs_[1].push_back(cpu_buffer_mgr);
+  if (g_prefault_cpu_buffer_pool) {
+    // Pay for allocating and faulting in the pool at startup rather than on the first
+    // queries.
+    auto prefault_ms = measure<>::execution([&]() { cpu_buffer_mgr->allocateSlabs(); });
+    LOG(INFO) << "Pre-faulted " << cpu_buffer_mgr->getAllocated()
+              << " bytes of CPU buffer pool in " << prefault_ms << " ms";
+  }
 }
 
 // This function exists for testing purposes so that we can test a reset of the cache.
 void DataMgr::resetPersistentStorage(const File_Namespace::DiskCacheConfig& cache_config,
                                      const size_t num_reader_threads,
                                      const SystemParameters& sys_params) {
-  int numLevels = bufferMgrs_.size();
-  for (int level = numLevels - 1; level >= 0; --level) {
-    for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
-      delete bufferMgrs_[level][device];
+  {
+    // Keeps the reclaim thread away from the buffer managers while they are replaced.
+    std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+    int numLevels = bufferMgrs_.size();
+    for (int level = numLevels - 1; level >= 0; --level) {
+      for (size_t device = 0; device < bufferMgrs_[level].size(); device++) {
+        delete bufferMgrs_[level][device];
+      }
     }
+    bufferMgrs_.clear();
+    populateMgrs(sys_params, num_reader_threads, cache_config);
   }
-  bufferMgrs_.clear();
-  populateMgrs(sys_params, num_reader_threads, cache_config);
   createTopLevelMetadata();
 }
 
@@ -365,6 +516,7 @@ std::vector<MemoryInfo> DataMgr::getMemoryInfoUnlocked(
     mi.maxNumPages = cpu_buffer->getMaxSize() / mi.pageSize;
     mi.isAllocationCapped = cpu_buffer->isAllocationCapped();
     mi.numPageAllocated = cpu_buffer->getAllocated() / mi.pageSize;
+    mi.hugePageBytesAllocated = cpu_buffer->getHugePageBytes();
 
     const auto& slab_segments = cpu_buffer->getSlabSegments();
     for (size_t slab_num = 0; slab_num < slab_segments.size(); ++slab_num) {
@@ -489,6 +641,18 @@ AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
   return bufferMgrs_[level][deviceId]->getBuffer(key, numBytes);
 }
 
+std::vector<AbstractBuffer*> DataMgr::getChunkBuffers(
+    const std::vector<ChunkKey>& keys,
+    const MemoryLevel memoryLevel,
+    const int deviceId,
+    const std::vector<size_t>& numBytes) {
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+  const auto level = static_cast<size_t>(memoryLevel);
+  CHECK_LT(level, levelSizes_.size());     // make sure we have a legit buffermgr
+  CHECK_LT(deviceId, levelSizes_[level]);  // make sure we have a legit buffermgr
+  return bufferMgrs_[level][deviceId]->getBuffers(keys, numBytes);
+}
+
 void DataMgr::deleteChunksWithPrefix(const ChunkKey& keyPrefix) {
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
 
@@ -33,14 +33,22 @@
 #include "OSDependent/heavyai_fs.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
 
+#include <condition_variable>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+extern bool g_enable_cpu_buffer_pool_reclaim;
+extern size_t g_cpu_buffer_pool_reclaim_floor;
+extern double g_cpu_buffer_pool_reclaim_stall_percent;
+extern size_t g_cpu_buffer_pool_reclaim_min_available_percent;
+
 namespace File_Namespace {
 class FileBuffer;
 class GlobalFileMgr;
@@ -73,6 +81,7 @@ struct MemoryInfo {
   size_t maxNumPages;
   size_t numPageAllocated;
   bool isAllocationCapped;
+  size_t hugePageBytesAllocated{0};
   std::vector<MemoryData> nodeMemoryData;
 };
 
@@ -193,6 +202,11 @@ class DataMgr {
                                  const MemoryLevel memoryLevel,
                                  const int deviceId = 0,
                                  const size_t numBytes = 0);
+  // Gets the buffers for distinct keys, fetching the missing ones in a single batch.
+  std::vector<AbstractBuffer*> getChunkBuffers(const std::vector<ChunkKey>& keys,
+                                               const MemoryLevel memoryLevel,
+                                               const int deviceId,
+                                               const std::vector<size_t>& numBytes);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix);
   void deleteChunksWithPrefix(const ChunkKey& keyPrefix, const MemoryLevel memLevel);
   AbstractBuffer* alloc(const MemoryLevel memoryLevel,
@@ -244,6 +258,15 @@ class DataMgr {
   SystemMemoryUsage getSystemMemoryUsage() const;
   static size_t getTotalSystemMemory();
 
+  struct MemoryPressure {
+    double stall_percent;  // share of the last 10 seconds in which some tasks stalled
+                           // waiting for memory, from PSI
+    size_t available;      // bytes that can be allocated before reaching the limit
+    size_t limit;          // memory limit of the cgroup of the process, or of the host
+  };
+
+  MemoryPressure getMemoryPressure() const;
+
   PersistentStorageMgr* getPersistentStorageMgr() const;
   void resetPersistentStorage(const File_Namespace::DiskCacheConfig& cache_config,
                               const size_t num_reader_threads,
@@ -268,6 +291,10 @@ class DataMgr {
                             size_t maxCpuSlabSize,
                             size_t page_size,
                             const std::vector<size_t>& cpu_tier_sizes);
+  void backgroundReclaimLoop();
+  // Frees slabs of the CPU buffer pool if the host or the cgroup of the process is under
+  // memory pressure, see g_enable_cpu_buffer_pool_reclaim.
+  void reclaimCpuBufferPool();
 
   std::vector<std::vector<AbstractBufferMgr*>> bufferMgrs_;
   std::unique_ptr<CudaMgr_Namespace::CudaMgr> cudaMgr_;
@@ -275,6 +302,11 @@ class DataMgr {
   bool hasGpus_;
   size_t reservedGpuMem_;
   mutable std::mutex buffer_access_mutex_;
+
+  std::thread reclaim_thread_;
+  std::mutex reclaim_mutex_;
+  std::condition_variable reclaim_cv_;
+  bool stop_reclaim_{false};
 };
 
 std::ostream& operator<<(std::ostream& os, const DataMgr::SystemMemoryUsage&);
@@ -92,6 +92,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -103,6 +104,7 @@ class DateDaysEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -139,6 +141,7 @@ class DateDaysEncoder : public Encoder {
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceSkippingIndexes(that);
   }
 
   void copyMetadata(const Encoder* copyFromEncoder) override {
@@ -147,6 +150,7 @@ class DateDaysEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copySkippingIndexes(*copyFromEncoder);
   }
 
   void writeMetadata(FILE* f) override {
@@ -183,6 +187,7 @@ class DateDaysEncoder : public Encoder {
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
+    resetSkippingIndexes();
   }
 
   T dataMin;
@@ -235,6 +240,10 @@ class DateDaysEncoder : public Encoder {
       buffer_->write(reinterpret_cast<int8_t*>(data_to_write),
                      num_elems_to_append * sizeof(V),
                      static_cast<size_t>(offset));
+      if (offset > 0) {
+        // The rows before the offset may not have been added to the skipping indexes.
+        resetSkippingIndexes();
+      }
     }
 
     auto chunk_metadata = std::make_shared<ChunkMetadata>();
@@ -245,10 +254,12 @@ class DateDaysEncoder : public Encoder {
   void updateStatsWithAlreadyEncoded(const V& encoded_data) {
     if (encoded_data == std::numeric_limits<V>::min()) {
       has_nulls = true;
+      updateSkippingIndexes(0, true);
     } else {
       const T data = DateConverters::get_epoch_seconds_from_days(encoded_data);
       dataMax = std::max(dataMax, data);
       dataMin = std::min(dataMin, data);
+      updateSkippingIndexes(data, false);
     }
   }
 
@@ -257,12 +268,14 @@ class DateDaysEncoder : public Encoder {
     if (unencoded_data == std::numeric_limits<V>::min()) {
       has_nulls = true;
       encoded_data = static_cast<V>(unencoded_data);
+      updateSkippingIndexes(0, true);
     } else {
       date_days_overflow_validator_.validate(unencoded_data);
       encoded_data = DateConverters::get_epoch_days_from_seconds(unencoded_data);
       const T data = DateConverters::get_epoch_seconds_from_days(encoded_data);
       dataMax = std::max(dataMax, data);
       dataMin = std::min(dataMin, data);
+      updateSkippingIndexes(data, false);
     }
     return encoded_data;
   }
@@ -0,0 +1,424 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DIFF_ENCODER_H
+#define DIFF_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+#include "Shared/DiffEncoding.h"
+#include "Shared/Iteration.h"
+
+namespace diff_encoding {
+
+// Smallest bit width holding the deltas of [min_val, max_val] and the null delta.
+inline int32_t bit_width_for(const int64_t min_val, const int64_t max_val) {
+  if (max_val < min_val) {
+    return 1;  // nulls only
+  }
+  const auto range = static_cast<uint64_t>(max_val) - static_cast<uint64_t>(min_val);
+  int32_t bits = 1;
+  while (bits < kWordBits && null_delta(bits) <= range) {
+    ++bits;
+  }
+  return bits;
+}
+
+// Whether the non null values in [min_val, max_val] can be added to the buffer without
+// changing its base or bit width.
+inline bool fits(const int8_t* byte_stream,
+                 const int64_t min_val,
+                 const int64_t max_val) {
+  if (max_val < min_val) {
+    return true;
+  }
+  const auto frame_base = base(byte_stream);
+  return min_val >= frame_base &&
+         static_cast<uint64_t>(max_val) - static_cast<uint64_t>(frame_base) <
+             null_delta(bit_width(byte_stream));
+}
+
+inline size_t byte_size(const int64_t num_rows, const int32_t bit_width) {
+  return kHeaderBytes + num_words(num_rows, bit_width) * sizeof(uint64_t);
+}
+
+// ORs the deltas of the values into words, starting bit_pos bits into them. The bits past
+// bit_pos must be zero.
+inline void pack(const int64_t* values,
+                 const size_t num_values,
+                 const int64_t base,
+                 const int32_t bit_width,
+                 uint64_t* words,
+                 uint64_t bit_pos) {
+  const auto null_d = null_delta(bit_width);
+  for (size_t i = 0; i < num_values; ++i, bit_pos += bit_width) {
+    const auto d = values[i] == inline_int_null_value<int64_t>()
+                       ? null_d
+                       : static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(base);
+    const auto word = bit_pos / kWordBits;
+    const auto shift = bit_pos % kWordBits;
+    words[word] |= d << shift;
+    if (shift + bit_width > kWordBits) {
+      words[word + 1] |= d >> (kWordBits - shift);
+    }
+  }
+}
+
+// The base and bit width of the tightest frame holding the values.
+inline std::pair<int64_t, int32_t> frame_of(const int64_t* values,
+                                            const size_t num_values) {
+  auto min_val = std::numeric_limits<int64_t>::max();
+  auto max_val = std::numeric_limits<int64_t>::lowest();
+  for (size_t i = 0; i < num_values; ++i) {
+    if (values[i] != inline_int_null_value<int64_t>()) {
+      min_val = std::min(min_val, values[i]);
+      max_val = std::max(max_val, values[i]);
+    }
+  }
+  return {max_val < min_val ? 0 : min_val, bit_width_for(min_val, max_val)};
+}
+
+// Encodes the values into dst, which must have room for byte_size(num_values, bit_width)
+// bytes. Returns that size.
+inline size_t encode(const int64_t* values,
+                     const size_t num_values,
+                     const int64_t base,
+                     const int32_t bit_width,
+                     int8_t* dst) {
+  auto header = reinterpret_cast<int64_t*>(dst);
+  header[0] = base;
+  header[1] = bit_width;
+  auto words = reinterpret_cast<uint64_t*>(dst + kHeaderBytes);
+  std::fill(words, words + num_words(num_values, bit_width), uint64_t(0));
+  pack(values, num_values, base, bit_width, words, 0);
+  return byte_size(num_values, bit_width);
+}
+
+// Writes the values of rows [start_row, start_row + num_rows) to dst.
+inline void decode_rows(const int8_t* byte_stream,
+                        const size_t start_row,
+                        const size_t num_rows,
+                        int64_t* dst) {
+  for (size_t i = 0; i < num_rows; ++i) {
+    dst[i] = decode(byte_stream, start_row + i, inline_int_null_value<int64_t>());
+  }
+}
+
+inline void expand(const int8_t* byte_stream, const size_t num_rows, int8_t* dst) {
+  decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int64_t*>(dst));
+}
+
+// Removes the given rows, sorted in ascending order, from the buffer of num_rows rows
+// in place and returns its new size in bytes. The remaining rows are encoded in their
+// own tightest frame.
+inline size_t remove_rows(int8_t* byte_stream,
+                          const size_t num_rows,
+                          const std::vector<uint64_t>& rows) {
+  std::vector<int64_t> values;
+  values.reserve(num_rows - std::min(num_rows, rows.size()));
+  auto row_it = rows.begin();
+  for (size_t row = 0; row < num_rows; ++row) {
+    if (row_it != rows.end() && *row_it == row) {
+      ++row_it;
+      continue;
+    }
+    values.push_back(decode(byte_stream, row, inline_int_null_value<int64_t>()));
+  }
+  const auto [frame_base, frame_bit_width] = frame_of(values.data(), values.size());
+  return encode(values.data(), values.size(), frame_base, frame_bit_width, byte_stream);
+}
+
+}  // namespace diff_encoding
+
+/**
+ * @class DiffEncoder
+ * @brief Stores a 64-bit integer column as bit packed deltas from a per chunk base.
+ *
+ * The base is the minimum of the chunk stats and the bit width is just enough for the
+ * range of the chunk. Appends that stay within that frame pack their deltas after the
+ * existing ones; otherwise the chunk is encoded again in the wider frame. See
+ * Shared/DiffEncoding.h for the buffer layout.
+ */
+class DiffEncoder : public Encoder {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
+    resetChunkStats();
+  }
+
+  size_t getNumElemsForBytesEncodedDataAtIndices(const int8_t* index_data,
+                                                 const std::vector<size_t>& selected_idx,
+                                                 const size_t byte_limit) override {
+    UNREACHABLE()
+        << "getNumElemsForBytesEncodedDataAtIndices unexpectedly called for non varlen"
+           " encoder";
+    return {};
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedDataAtIndices(
+      const int8_t*,
+      int8_t* data,
+      const std::vector<size_t>& selected_idx) override {
+    std::shared_ptr<ChunkMetadata> chunk_metadata;
+    shared::execute_over_contiguous_indices(
+        selected_idx, [&](const size_t start_pos, const size_t end_pos) {
+          chunk_metadata = appendEncodedData(
+              nullptr, data, selected_idx[start_pos], end_pos - start_pos);
+        });
+    return chunk_metadata;
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedData(const int8_t*,
+                                                   int8_t* data,
+                                                   const size_t start_idx,
+                                                   const size_t num_elements) override {
+    std::vector<int64_t> decoded_data(num_elements);
+    diff_encoding::decode_rows(data, start_idx, num_elements, decoded_data.data());
+    auto decoded_ptr = reinterpret_cast<int8_t*>(decoded_data.data());
+    return appendData(decoded_ptr, num_elements, SQLTypeInfo{});
+  }
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= num_elems_) {
+      // we're rewriting entire buffer so fully recompute metadata
+      resetChunkStats();
+      num_elems_ = 0;
+      buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Differential encoded chunks can only be appended to or rewritten entirely.");
+    }
+
+    const auto unencoded_data = reinterpret_cast<const int64_t*>(src_data);
+    std::vector<int64_t> values(num_elems_to_append);
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      values[i] = unencoded_data[replicating ? 0 : i];
+      updateStatsWithValue(values[i]);
+    }
+
+    alignas(int64_t) int8_t header[diff_encoding::kHeaderBytes];
+    if (num_elems_) {
+      buffer_->read(header, diff_encoding::kHeaderBytes);
+    }
+    if (num_elems_ && diff_encoding::fits(header, dataMin, dataMax)) {
+      appendToFrame(header, values);
+    } else {
+      reencode(values);
+    }
+    num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(int64_t);
+    }
+
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      dataMin = std::min(dataMin, val);
+      dataMax = std::max(dataMax, val);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<int64_t>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const auto unencoded_data = reinterpret_cast<const int64_t*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsWithValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsWithValue(
+          diff_encoding::decode(dst_data, i, inline_int_null_value<int64_t>()));
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto that_typed = static_cast<const DiffEncoder&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const DiffEncoder*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(int64_t), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(int64_t), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(int64_t), f);
+    fread((int8_t*)&dataMax, 1, sizeof(int64_t), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<int64_t>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<int64_t>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  void resetChunkStats() override {
+    dataMin = std::numeric_limits<int64_t>::max();
+    dataMax = std::numeric_limits<int64_t>::lowest();
+    has_nulls = false;
+  }
+
+  int64_t dataMin;
+  int64_t dataMax;
+  bool has_nulls;
+
+ private:
+  // Packs the new deltas after the existing ones. Only the word holding the end of the
+  // chunk and the padding word are rewritten.
+  void appendToFrame(const int8_t* header, const std::vector<int64_t>& values) {
+    const auto frame_base = diff_encoding::base(header);
+    const auto frame_bit_width = diff_encoding::bit_width(header);
+    const uint64_t end_bit = num_elems_ * frame_bit_width;
+    const auto first_word = end_bit / diff_encoding::kWordBits;
+    const auto num_words =
+        diff_encoding::num_words(num_elems_ + values.size(), frame_bit_width);
+    std::vector<uint64_t> words(num_words - first_word);
+    const auto first_word_offset =
+        diff_encoding::kHeaderBytes + first_word * sizeof(uint64_t);
+    buffer_->read(
+        reinterpret_cast<int8_t*>(words.data()), sizeof(uint64_t), first_word_offset);
+    diff_encoding::pack(values.data(),
+                        values.size(),
+                        frame_base,
+                        frame_bit_width,
+                        words.data(),
+                        end_bit % diff_encoding::kWordBits);
+    buffer_->write(reinterpret_cast<int8_t*>(words.data()),
+                   words.size() * sizeof(uint64_t),
+                   first_word_offset);
+  }
+
+  // Encodes the existing rows followed by the new ones in the frame of the chunk stats.
+  void reencode(const std::vector<int64_t>& values) {
+    std::vector<int64_t> all_values(num_elems_);
+    if (num_elems_) {
+      std::vector<int8_t> encoded(buffer_->size());
+      buffer_->read(encoded.data(), encoded.size());
+      diff_encoding::decode_rows(encoded.data(), 0, num_elems_, all_values.data());
+    }
+    all_values.insert(all_values.end(), values.begin(), values.end());
+    const auto frame_base = dataMax < dataMin ? 0 : dataMin;
+    const auto frame_bit_width = diff_encoding::bit_width_for(dataMin, dataMax);
+    std::vector<int8_t> encoded(
+        diff_encoding::byte_size(all_values.size(), frame_bit_width));
+    diff_encoding::encode(all_values.data(),
+                          all_values.size(),
+                          frame_base,
+                          frame_bit_width,
+                          encoded.data());
+    buffer_->write(encoded.data(), encoded.size(), 0);
+    if (buffer_->size() > encoded.size()) {
+      buffer_->setSize(encoded.size());
+    }
+  }
+
+  void updateStatsWithValue(const int64_t value) {
+    if (value == inline_int_null_value<int64_t>()) {
+      has_nulls = true;
+    } else {
+      decimal_overflow_validator_.validate(value);
+      dataMin = std::min(dataMin, value);
+      dataMax = std::max(dataMax, value);
+    }
+  }
+};  // DiffEncoder
+
+#endif  // DIFF_ENCODER_H
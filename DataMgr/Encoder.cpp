@@ -16,13 +16,47 @@
 
 #include "Encoder.h"
 #include "ArrayNoneEncoder.h"
+#include "BitPackedEncoder.h"
 #include "DateDaysEncoder.h"
+#include "DiffEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
 #include "Logger/Logger.h"
 #include "NoneEncoder.h"
+#include "RunLengthEncoder.h"
+#include "SparseEncoder.h"
 #include "StringNoneEncoder.h"
 
+bool g_enable_chunk_bloom_filters{true};
+bool g_enable_chunk_zone_maps{true};
+
+namespace {
+
+// Marks the bloom filter section, absent from metadata written by older versions.
+constexpr int32_t kBloomFilterMagic{0x424c4f4f};
+
+bool keeps_bloom_filter(const Data_Namespace::AbstractBuffer* buffer) {
+  if (!g_enable_chunk_bloom_filters || !buffer) {
+    return false;
+  }
+  const auto& ti = buffer->getSqlType();
+  return ti.is_integer() || ti.is_time() || ti.is_dict_encoded_string();
+}
+
+// Marks the zone map section.
+constexpr int32_t kZoneMapMagic{0x5a4f4e45};
+
+bool keeps_zone_map(const Data_Namespace::AbstractBuffer* buffer) {
+  if (!g_enable_chunk_zone_maps || !buffer) {
+    return false;
+  }
+  // String ids aren't ordered like the strings, so ranges of them don't help.
+  const auto& ti = buffer->getSqlType();
+  return ti.is_integer() || ti.is_decimal() || ti.is_time();
+}
+
+}  // namespace
+
 Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
                          const SQLTypeInfo sqlType) {
   switch (sqlType.get_compression()) {
@@ -61,7 +95,7 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
         case kTEXT:
         case kVARCHAR:
         case kCHAR:
-          return new StringNoneEncoder(buffer);
+          return new StringNoneEncoder(buffer, sqlType.is_fsst_string());
         case kARRAY: {
           if (sqlType.get_size() > 0) {
             return new FixedLengthArrayNoneEncoder(buffer, sqlType.get_size());
@@ -107,6 +141,18 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }
     }
     case kENCODING_FIXED: {
+      if (sqlType.is_bit_packed()) {
+        switch (sqlType.get_type()) {
+          case kSMALLINT:
+            return new BitPackedEncoder<int16_t>(buffer, sqlType.get_comp_param());
+          case kINT:
+            return new BitPackedEncoder<int32_t>(buffer, sqlType.get_comp_param());
+          case kBIGINT:
+            return new BitPackedEncoder<int64_t>(buffer, sqlType.get_comp_param());
+          default:
+            return 0;
+        }
+      }
       switch (sqlType.get_type()) {
         case kSMALLINT: {
           switch (sqlType.get_comp_param()) {
@@ -173,6 +219,65 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }  // switch (sqlType)
       break;
     }  // Case: kENCODING_FIXED
+    case kENCODING_RL: {
+      switch (sqlType.get_type()) {
+        case kBOOLEAN:
+        case kTINYINT:
+          return new RunLengthEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new RunLengthEncoder<int16_t>(buffer);
+        case kINT:
+          return new RunLengthEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new RunLengthEncoder<int64_t>(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }
+    case kENCODING_DIFF: {
+      switch (sqlType.get_type()) {
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+          return new DiffEncoder(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }
+    case kENCODING_SPARSE: {
+      switch (sqlType.get_type()) {
+        case kBOOLEAN:
+        case kTINYINT:
+          return new SparseEncoder<int8_t>(buffer);
+        case kSMALLINT:
+          return new SparseEncoder<int16_t>(buffer);
+        case kINT:
+          return new SparseEncoder<int32_t>(buffer);
+        case kBIGINT:
+        case kNUMERIC:
+        case kDECIMAL:
+        case kTIME:
+        case kTIMESTAMP:
+        case kDATE:
+          return new SparseEncoder<int64_t>(buffer);
+        case kFLOAT:
+          return new SparseEncoder<float>(buffer);
+        case kDOUBLE:
+          return new SparseEncoder<double>(buffer);
+        default:
+          return 0;
+      }
+      break;
+    }
     case kENCODING_DICT: {
       if (sqlType.get_type() == kARRAY) {
         CHECK(IS_STRING(sqlType.get_subtype()));
@@ -182,6 +287,10 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
         return new ArrayNoneEncoder(buffer);
       } else {
         CHECK(sqlType.is_string());
+        if (sqlType.is_run_length_dict_string()) {
+          CHECK_EQ(sqlType.get_size(), 4);
+          return new RunLengthEncoder<int32_t>(buffer);
+        }
         switch (sqlType.get_size()) {
           case 1:
             return new NoneEncoder<uint8_t>(buffer);
@@ -226,10 +335,108 @@ Encoder::Encoder(Data_Namespace::AbstractBuffer* buffer)
     : num_elems_(0)
     , buffer_(buffer)
     , decimal_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo())
-    , date_days_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo()){};
+    , date_days_overflow_validator_(buffer ? buffer->getSqlType() : SQLTypeInfo())
+    , keeps_bloom_filter_(keeps_bloom_filter(buffer))
+    , bloom_filter_num_elems_(0)
+    , keeps_zone_map_(keeps_zone_map(buffer))
+    , zone_map_num_elems_(0){};
 
 void Encoder::getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) {
   chunkMetadata->sqlType = buffer_->getSqlType();
   chunkMetadata->numBytes = buffer_->size();
   chunkMetadata->numElements = num_elems_;
+  // Shared rather than copied, the encoder copies them before changing them again.
+  chunkMetadata->bloomFilter = hasUsableBloomFilter() ? bloom_filter_ : nullptr;
+  chunkMetadata->zoneMap = hasUsableZoneMap() ? zone_map_ : nullptr;
+}
+
+bool Encoder::hasUsableBloomFilter() const {
+  return bloom_filter_ && bloom_filter_num_elems_ == num_elems_ &&
+         !bloom_filter_->isSaturated();
+}
+
+// A single zone holds no more than the chunk stats.
+bool Encoder::hasUsableZoneMap() const {
+  return zone_map_ && zone_map_num_elems_ == num_elems_ &&
+         num_elems_ > ChunkZoneMap::kMinBlockRows;
+}
+
+void Encoder::reduceSkippingIndexes(const Encoder& that) {
+  bloom_filter_num_elems_ += that.bloom_filter_num_elems_;
+  if (that.bloom_filter_) {
+    mutableIndex(bloom_filter_).merge(*that.bloom_filter_);
+  }
+  // The rows of both chunks don't line up.
+  zone_map_.reset();
+  zone_map_num_elems_ = 0;
+}
+
+void Encoder::copySkippingIndexes(const Encoder& that) {
+  bloom_filter_num_elems_ = that.bloom_filter_num_elems_;
+  bloom_filter_ = that.bloom_filter_;
+  zone_map_num_elems_ = that.zone_map_num_elems_;
+  zone_map_ = that.zone_map_;
+}
+
+void Encoder::writeBloomFilter(FILE* f, const bool with_filter) const {
+  const int8_t has_filter = with_filter && hasUsableBloomFilter();
+  fwrite((int8_t*)&kBloomFilterMagic, sizeof(int32_t), 1, f);
+  fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+  fwrite((int8_t*)&has_filter, sizeof(int8_t), 1, f);
+  if (has_filter) {
+    bloom_filter_->write(f);
+  }
+}
+
+void Encoder::readBloomFilter(FILE* f) {
+  int32_t magic{0};
+  size_t num_elems{0};
+  int8_t has_filter{0};
+  fread((int8_t*)&magic, sizeof(int32_t), 1, f);
+  if (magic == kBloomFilterMagic) {
+    fread((int8_t*)&num_elems, sizeof(size_t), 1, f);
+    fread((int8_t*)&has_filter, sizeof(int8_t), 1, f);
+  }
+  bloom_filter_.reset();
+  bloom_filter_num_elems_ = 0;
+  if (has_filter) {
+    auto bloom_filter = std::make_shared<ChunkBloomFilter>();
+    bloom_filter->read(f);
+    // Guards against a section left in a reused page by an older version.
+    if (keeps_bloom_filter_ && num_elems == num_elems_) {
+      bloom_filter_ = bloom_filter;
+      bloom_filter_num_elems_ = num_elems;
+    }
+  }
+}
+
+void Encoder::writeZoneMap(FILE* f, const bool with_zone_map) const {
+  const int8_t has_zone_map = with_zone_map && hasUsableZoneMap();
+  fwrite((int8_t*)&kZoneMapMagic, sizeof(int32_t), 1, f);
+  fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+  fwrite((int8_t*)&has_zone_map, sizeof(int8_t), 1, f);
+  if (has_zone_map) {
+    zone_map_->write(f);
+  }
+}
+
+void Encoder::readZoneMap(FILE* f) {
+  int32_t magic{0};
+  size_t num_elems{0};
+  int8_t has_zone_map{0};
+  fread((int8_t*)&magic, sizeof(int32_t), 1, f);
+  if (magic == kZoneMapMagic) {
+    fread((int8_t*)&num_elems, sizeof(size_t), 1, f);
+    fread((int8_t*)&has_zone_map, sizeof(int8_t), 1, f);
+  }
+  zone_map_.reset();
+  zone_map_num_elems_ = 0;
+  if (has_zone_map) {
+    auto zone_map = std::make_shared<ChunkZoneMap>();
+    // Guards against a section left in a reused page by an older version.
+    if (zone_map->read(f) && keeps_zone_map_ && num_elems == num_elems_) {
+      zone_map_ = zone_map;
+      zone_map_num_elems_ = num_elems;
+    }
+  }
 }
@@ -20,10 +20,13 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
+#include "ChunkBloomFilter.h"
 #include "ChunkMetadata.h"
+#include "ChunkZoneMap.h"
 #include "Shared/DateConverters.h"
 #include "Shared/sqltypes.h"
 #include "Shared/types.h"
@@ -35,6 +38,9 @@ class AbstractBuffer;
 // default max input buffer size to 1MB
 #define MAX_INPUT_BUF_SIZE 1048576
 
+extern bool g_enable_chunk_bloom_filters;
+extern bool g_enable_chunk_zone_maps;
+
 class DecimalOverflowValidator {
  public:
   DecimalOverflowValidator(SQLTypeInfo type) {
@@ -284,13 +290,93 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  // Bytes taken by the bloom filter section of the metadata, see writeBloomFilter.
+  static constexpr size_t kBloomFilterMetadataBytes{sizeof(int32_t) + sizeof(size_t) +
+                                                    sizeof(int8_t) +
+                                                    ChunkBloomFilter::kSerializedBytes};
+
+  /**
+   * Write the bloom filter of the chunk after the encoder metadata. The filter itself is
+   * only written when `with_filter` is set and it holds every row of the chunk.
+   */
+  void writeBloomFilter(FILE* f, const bool with_filter) const;
+  void readBloomFilter(FILE* f);
+
+  // Bytes taken by the zone map section of the metadata, at most. See writeZoneMap.
+  static constexpr size_t kZoneMapMetadataBytes{sizeof(int32_t) + sizeof(size_t) +
+                                                sizeof(int8_t) +
+                                                ChunkZoneMap::kSerializedBytes};
+
+  /**
+   * Write the zone map of the chunk after the bloom filter, with the same rules.
+   */
+  void writeZoneMap(FILE* f, const bool with_zone_map) const;
+  void readZoneMap(FILE* f);
+
  protected:
+  // Records the values of rows appended to the chunk, or already in it when recomputing
+  // the stats, in the bloom filter and the zone map. The rows must be recorded in order.
+  void updateSkippingIndexes(const int64_t val,
+                             const bool is_null,
+                             const size_t num_rows = 1) {
+    if (keeps_bloom_filter_) {
+      bloom_filter_num_elems_ += num_rows;
+      if (!is_null) {
+        mutableIndex(bloom_filter_).add(val);
+      }
+    }
+    if (keeps_zone_map_) {
+      if (!is_null) {
+        mutableIndex(zone_map_).add(zone_map_num_elems_, num_rows, val);
+      }
+      zone_map_num_elems_ += num_rows;
+    }
+  }
+
+  // Also drops the indexes when values are written to the chunk behind the encoder's
+  // back, since they then no longer cover all the rows until the stats are recomputed.
+  void resetSkippingIndexes() {
+    bloom_filter_.reset();
+    bloom_filter_num_elems_ = 0;
+    zone_map_.reset();
+    zone_map_num_elems_ = 0;
+  }
+
+  // The indexes are shared with the chunk metadata getMetadata hands out, and with the
+  // encoders they were copied to. They are copied before being changed while shared, and
+  // created when missing.
+  template <typename INDEX>
+  static INDEX& mutableIndex(std::shared_ptr<const INDEX>& index) {
+    if (!index || index.use_count() > 1) {
+      auto copy = index ? std::make_shared<INDEX>(*index) : std::make_shared<INDEX>();
+      index = copy;
+      return *copy;
+    }
+    // Indexes are always created non const, see above and the read functions.
+    return const_cast<INDEX&>(*index);
+  }
+
+  void reduceSkippingIndexes(const Encoder& that);
+  void copySkippingIndexes(const Encoder& that);
+  bool hasUsableBloomFilter() const;
+  bool hasUsableZoneMap() const;
+
   size_t num_elems_;
 
   Data_Namespace::AbstractBuffer* buffer_;
 
   DecimalOverflowValidator decimal_overflow_validator_;
   DateDaysOverflowValidator date_days_overflow_validator_;
+
+  bool keeps_bloom_filter_;
+  // Rows added to the filter since it was last reset, nulls included.
+  size_t bloom_filter_num_elems_;
+  std::shared_ptr<const ChunkBloomFilter> bloom_filter_;
+
+  bool keeps_zone_map_;
+  // Rows added to the zone map since it was last reset, nulls included.
+  size_t zone_map_num_elems_;
+  std::shared_ptr<const ChunkZoneMap> zone_map_;
 };
 
 #endif  // Encoder_h
@@ -116,6 +116,27 @@ void CachingGlobalFileMgr::fetchBuffer(const ChunkKey& chunk_key,
   }
 }
 
+void CachingGlobalFileMgr::fetchBuffers(
+    const std::vector<ChunkKey>& chunk_keys,
+    const std::vector<AbstractBuffer*>& destination_buffers,
+    const std::vector<size_t>& num_bytes) {
+  // Cacheable chunks go through the disk cache one by one, the others are batched.
+  std::vector<ChunkKey> storage_keys;
+  std::vector<AbstractBuffer*> storage_destination_buffers;
+  std::vector<size_t> storage_num_bytes;
+  for (size_t i = 0; i < chunk_keys.size(); ++i) {
+    if (isChunkPrefixCacheable(chunk_keys[i])) {
+      fetchBuffer(chunk_keys[i], destination_buffers[i], num_bytes[i]);
+    } else {
+      storage_keys.emplace_back(chunk_keys[i]);
+      storage_destination_buffers.emplace_back(destination_buffers[i]);
+      storage_num_bytes.emplace_back(num_bytes[i]);
+    }
+  }
+  GlobalFileMgr::fetchBuffers(
+      storage_keys, storage_destination_buffers, storage_num_bytes);
+}
+
 AbstractBuffer* CachingGlobalFileMgr::putBuffer(const ChunkKey& chunk_key,
                                                 AbstractBuffer* source_buffer,
                                                 const size_t num_bytes) {
@@ -48,6 +48,10 @@ class CachingGlobalFileMgr : public GlobalFileMgr {
                    AbstractBuffer* destination_buffer,
                    const size_t num_bytes) override;
 
+  void fetchBuffers(const std::vector<ChunkKey>& chunk_keys,
+                    const std::vector<AbstractBuffer*>& destination_buffers,
+                    const std::vector<size_t>& num_bytes) override;
+
   AbstractBuffer* putBuffer(const ChunkKey& chunk_key,
                             AbstractBuffer* source_buffer,
                             const size_t num_bytes) override;
@@ -60,7 +60,7 @@ struct Epoch {
 
   inline int8_t* storage_ptr() { return reinterpret_cast<int8_t*>(&epoch_storage[0]); }
 
-  static inline size_t byte_size() { return 2 * sizeof(int64_t); }
+  static constexpr size_t byte_size() { return 2 * sizeof(int64_t); }
 
   static inline int64_t min_allowable_epoch() {
     return std::numeric_limits<int32_t>::min();
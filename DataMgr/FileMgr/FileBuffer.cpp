@@ -22,12 +22,13 @@
 
 #include "DataMgr/FileMgr/FileBuffer.h"
 
-#include <future>
+#include <algorithm>
 #include <map>
 #include <thread>
 #include <utility>  // std::pair
 
 #include "DataMgr/FileMgr/FileMgr.h"
+#include "Shared/Compressor.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 
@@ -128,6 +129,21 @@ FileBuffer::FileBuffer(FileMgr* fm,
   }
 }
 
+FileBuffer::FileBuffer(FileMgr* fm, const ChunkKey& chunkKey, FILE* metadataFile)
+    : AbstractBuffer(fm->getDeviceId())
+    , fm_(fm)
+    , metadataPageSize_(fm->getMetadataPageSize())
+    , metadataPages_(metadataPageSize_)
+    , pageSize_(0)
+    , chunkKey_(chunkKey) {
+  // Metadata is restored from a page map snapshot; the FileMgr fills in the pages.
+  CHECK(fm_);
+  calcHeaderBuffer();
+  readMetadata(metadataFile);
+  CHECK_GT(pageSize_, reservedHeaderSize_);
+  pageDataSize_ = pageSize_ - reservedHeaderSize_;
+}
+
 FileBuffer::~FileBuffer() {
   // need to free pages
   // NOP
@@ -231,56 +247,81 @@ void FileBuffer::freePagesBeforeEpoch(const int32_t targetEpoch) {
   }
 }
 
-struct readThreadDS {
-  FileMgr* t_fm;       // ptr to FileMgr
-  size_t t_startPage;  // start page for the thread
-  size_t t_endPage;    // last page for the thread
-  int8_t* t_curPtr;    // pointer to the current location of the target for the thread
-  size_t t_bytesLeft;  // number of bytes to be read in the thread
-  size_t t_startPageOffset;  // offset - used for the first page of the buffer
-  bool t_isFirstPage;        // true - for first page of the buffer, false - otherwise
-  std::vector<MultiPage> multiPages;  // MultiPages of the FileBuffer passed to the thread
-};
-
-static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS) {
-  size_t startPage = threadDS.t_startPage;  // start reading at startPage, including it
-  size_t endPage = threadDS.t_endPage;      // stop reading at endPage, not including it
-  int8_t* curPtr = threadDS.t_curPtr;
-  size_t bytesLeft = threadDS.t_bytesLeft;
-  size_t totalBytesRead = 0;
-  bool isFirstPage = threadDS.t_isFirstPage;
-
-  // Traverse the logical pages
-  for (size_t pageNum = startPage; pageNum < endPage; ++pageNum) {
-    CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
-    Page page = threadDS.multiPages[pageNum].current().page;
-
-    FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
-    CHECK(fileInfo);
-
-    // Read the page into the destination (dst) buffer at its
-    // current (cur) location
-    size_t bytesRead = 0;
-    if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
-              fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
-      isFirstPage = false;
+void FileBuffer::appendPageRunReads(std::vector<PageRunRead>& reads,
+                                    int8_t* const dst,
+                                    const size_t numBytes,
+                                    const size_t offset) const {
+  if (numBytes == 0) {
+    return;
+  }
+  const size_t startPage = offset / pageDataSize_;
+  const size_t startPageOffset = offset % pageDataSize_;
+  const size_t numPagesToRead =
+      (numBytes + startPageOffset + pageDataSize_ - 1) / pageDataSize_;
+  CHECK(startPage + numPagesToRead <= multiPages_.size());
+
+  // Cap run length so that the pages of a single buffer are still spread over the
+  // configured number of reader threads.
+  const size_t numThreads = std::max(fm_->getNumReaderThreads(), size_t(1));
+  const size_t maxPagesPerRun = (numPagesToRead + numThreads - 1) / numThreads;
+
+  int8_t* curPtr = dst;
+  size_t bytesLeft = numBytes;
+  Page lastPage;
+  FileInfo* fileInfo{nullptr};
+  for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+    CHECK(multiPages_[pageNum].pageSize == pageSize_);
+    const Page page = multiPages_[pageNum].current().page;
+    const size_t pageOffset = (pageNum == startPage) ? startPageOffset : 0;
+    const size_t pageBytes = min(pageDataSize_ - pageOffset, bytesLeft);
+    if (!fileInfo || page.fileId != lastPage.fileId) {
+      fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      CHECK(fileInfo);
+    }
+    if (fileInfo->pageSize != pageSize_) {
+      reads.emplace_back(compressedPageRead(page, curPtr, pageBytes, pageOffset));
     } else {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize(), bytesLeft),
-          curPtr);
+      const bool extendsRun = !reads.empty() && pageNum != startPage &&
+                              !reads.back().isCompressed() &&
+                              page.fileId == lastPage.fileId &&
+                              page.pageNum == lastPage.pageNum + 1 &&
+                              reads.back().segments.size() < maxPagesPerRun;
+      if (!extendsRun) {
+        reads.push_back({fileInfo,
+                         page.pageNum * pageSize_ + reservedHeaderSize_ + pageOffset,
+                         pageSize_,
+                         reservedHeaderSize_,
+                         {}});
+      }
+      reads.back().segments.emplace_back(curPtr, pageBytes);
     }
-    curPtr += bytesRead;
-    bytesLeft -= bytesRead;
-    totalBytesRead += bytesRead;
+    curPtr += pageBytes;
+    bytesLeft -= pageBytes;
+    lastPage = page;
   }
-  CHECK(bytesLeft == 0);
+  CHECK_EQ(bytesLeft, size_t(0));
+}
+
+size_t FileBuffer::physicalPageSize(const Page& page) const {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  CHECK(fileInfo);
+  return fileInfo->pageSize;
+}
 
-  return (totalBytesRead);
+PageRunRead FileBuffer::compressedPageRead(const Page& page,
+                                           int8_t* const dst,
+                                           const size_t numBytes,
+                                           const size_t pageOffset) const {
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  CHECK(fileInfo);
+  PageRunRead read{fileInfo,
+                   page.pageNum * fileInfo->pageSize + reservedHeaderSize_,
+                   fileInfo->pageSize,
+                   reservedHeaderSize_,
+                   {{dst, numBytes}}};
+  read.uncompressed_size = pageDataSize_;
+  read.data_offset = pageOffset;
+  return read;
 }
 
 void FileBuffer::read(int8_t* const dst,
@@ -292,96 +333,17 @@ void FileBuffer::read(int8_t* const dst,
     LOG(FATAL) << "Unsupported Buffer type";
   }
 
-  // variable declarations
-  size_t startPage = offset / pageDataSize_;
-  size_t startPageOffset = offset % pageDataSize_;
-  size_t numPagesToRead =
-      (numBytes + startPageOffset + pageDataSize_ - 1) / pageDataSize_;
-  /*
-  if (startPage + numPagesToRead > multiPages_.size()) {
-      cout << "Start page: " << startPage << endl;
-      cout << "Num pages to read: " << numPagesToRead << endl;
-      cout << "Num multipages: " << multiPages_.size() << endl;
-      cout << "Offset: " << offset << endl;
-      cout << "Num bytes: " << numBytes << endl;
-  }
-  */
-
-  CHECK(startPage + numPagesToRead <= multiPages_.size());
-
-  size_t numPagesPerThread = 0;
-  size_t numBytesCurrent = numBytes;  // total number of bytes still to be read
-  size_t bytesRead = 0;               // total number of bytes already being read
-  size_t bytesLeftForThread = 0;      // number of bytes to be read in the thread
-  size_t numExtraPages = 0;  // extra pages to be assigned one per thread as needed
-  size_t numThreads = fm_->getNumReaderThreads();
-  std::vector<readThreadDS>
-      threadDSArr;  // array of threadDS, needed to avoid racing conditions
-
-  if (numPagesToRead > numThreads) {
-    numPagesPerThread = numPagesToRead / numThreads;
-    numExtraPages = numPagesToRead - (numThreads * numPagesPerThread);
-  } else {
-    numThreads = numPagesToRead;
-    numPagesPerThread = 1;
-  }
-
-  /* set threadDS for the first thread */
-  readThreadDS threadDS;
-  threadDS.t_fm = fm_;
-  threadDS.t_startPage = offset / pageDataSize_;
-  if (numExtraPages > 0) {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-    numExtraPages--;
+  auto page_move_lock = fm_->getPageMoveReadLock();
+  std::vector<PageRunRead> reads;
+  appendPageRunReads(reads, dst, numBytes, offset);
+  size_t bytesRead = 0;
+  if (reads.size() == 1) {
+    // Not worth a round trip through the read queue.
+    bytesRead = FileReadQueue::readPageRun(reads.front());
   } else {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
-  }
-  threadDS.t_curPtr = dst;
-  threadDS.t_startPageOffset = offset % pageDataSize_;
-  threadDS.t_isFirstPage = true;
-
-  bytesLeftForThread = min(((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_ -
-                            threadDS.t_startPageOffset),
-                           numBytesCurrent);
-  threadDS.t_bytesLeft = bytesLeftForThread;
-  threadDS.multiPages = getMultiPage();
-
-  if (numThreads == 1) {
-    bytesRead += readForThread(this, threadDS);
-  } else {
-    std::vector<std::future<size_t>> threads;
-
-    for (size_t i = 0; i < numThreads; i++) {
-      threadDSArr.push_back(threadDS);
-      threads.push_back(
-          std::async(std::launch::async, readForThread, this, threadDSArr[i]));
-
-      // calculate elements of threadDS
-      threadDS.t_fm = fm_;
-      threadDS.t_isFirstPage = false;
-      threadDS.t_curPtr += bytesLeftForThread;
-      threadDS.t_startPage +=
-          threadDS.t_endPage -
-          threadDS.t_startPage;  // based on # of pages read on previous iteration
-      if (numExtraPages > 0) {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-        numExtraPages--;
-      } else {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
-      }
-      numBytesCurrent -= bytesLeftForThread;
-      bytesLeftForThread = min(
-          ((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_), numBytesCurrent);
-      threadDS.t_bytesLeft = bytesLeftForThread;
-      threadDS.multiPages = getMultiPage();
-    }
-
-    for (auto& p : threads) {
-      p.wait();
-    }
-    for (auto& p : threads) {
-      bytesRead += p.get();
-    }
+    auto batch = FileReadQueue::instance().submit(std::move(reads));
+    batch->wait();
+    bytesRead = batch->bytesRead();
   }
   CHECK(bytesRead == numBytes);
 }
@@ -397,8 +359,14 @@ void FileBuffer::copyPage(Page& srcPage,
   FileInfo* destFileInfo = fm_->getFileInfoForFileId(destPage.fileId);
 
   int8_t* buffer = reinterpret_cast<int8_t*>(checked_malloc(numBytes));
-  size_t bytesRead = srcFileInfo->read(
-      srcPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
+  size_t bytesRead;
+  if (srcFileInfo->pageSize != pageSize_) {
+    bytesRead = FileReadQueue::readPageRun(
+        compressedPageRead(srcPage, buffer, numBytes, offset));
+  } else {
+    bytesRead = srcFileInfo->read(
+        srcPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
+  }
   CHECK(bytesRead == numBytes);
   size_t bytesWritten = destFileInfo->write(
       destPage.pageNum * pageSize_ + offset + reservedHeaderSize_, numBytes, buffer);
@@ -428,7 +396,8 @@ void FileBuffer::writeHeader(Page& page,
   header[intHeaderSize - 2] = pageId;
   header[intHeaderSize - 1] = epoch;
   FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
-  size_t pageSize = writeMetadata ? metadataPageSize_ : pageSize_;
+  // Compressed data pages live in files with a smaller page size.
+  size_t pageSize = writeMetadata ? metadataPageSize_ : fileInfo->pageSize;
   fileInfo->write(
       page.pageNum * pageSize, (intHeaderSize) * sizeof(int32_t), (int8_t*)&header[0]);
 }
@@ -436,6 +405,10 @@ void FileBuffer::writeHeader(Page& page,
 void FileBuffer::readMetadata(const Page& page) {
   FILE* f = fm_->getFileForFileId(page.fileId);
   fseek(f, page.pageNum * metadataPageSize_ + reservedHeaderSize_, SEEK_SET);
+  readMetadata(f);
+}
+
+void FileBuffer::readMetadata(FILE* f) {
   fread((int8_t*)&pageSize_, sizeof(size_t), 1, f);
   fread((int8_t*)&size_, sizeof(size_t), 1, f);
   vector<int32_t> typeData(
@@ -456,6 +429,8 @@ void FileBuffer::readMetadata(const Page& page) {
     sql_type_.set_size(typeData[9]);
     initEncoder(sql_type_);
     encoder_->readMetadata(f);
+    encoder_->readBloomFilter(f);
+    encoder_->readZoneMap(f);
   }
 }
 
@@ -465,7 +440,16 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   Page page = fm_->requestFreePage(metadataPageSize_, true);
   writeHeader(page, -1, epoch, true);
   FILE* f = fm_->getFileForFileId(page.fileId);
-  fseek(f, page.pageNum * metadataPageSize_ + reservedHeaderSize_, SEEK_SET);
+  const size_t metadata_offset = page.pageNum * metadataPageSize_ + reservedHeaderSize_;
+  fseek(f, metadata_offset, SEEK_SET);
+  writeMetadata(f);
+  fm_->getFileInfoForFileId(page.fileId)
+      ->recordWrite(metadata_offset, ftell(f) - metadata_offset);
+  metadataPages_.push(page, epoch);
+}
+
+void FileBuffer::writeMetadata(FILE* f) {
+  const auto metadata_start = ftell(f);
   fwrite((int8_t*)&pageSize_, sizeof(size_t), 1, f);
   fwrite((int8_t*)&size_, sizeof(size_t), 1, f);
   vector<int32_t> typeData(
@@ -486,14 +470,26 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   fwrite((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
+    // The bloom filter and zone map are left out when they don't fit in smaller
+    // metadata pages.
+    auto metadata_size = ftell(f) - metadata_start;
+    encoder_->writeBloomFilter(f,
+                               reservedHeaderSize_ + metadata_size +
+                                       Encoder::kBloomFilterMetadataBytes <=
+                                   metadataPageSize_);
+    metadata_size = ftell(f) - metadata_start;
+    encoder_->writeZoneMap(f,
+                           reservedHeaderSize_ + metadata_size +
+                                   Encoder::kZoneMapMetadataBytes <=
+                               metadataPageSize_);
   }
-  metadataPages_.push(page, epoch);
 }
 
 void FileBuffer::append(int8_t* src,
                         const size_t numBytes,
                         const MemoryLevel srcBufferType,
                         const int32_t deviceId) {
+  auto page_move_lock = fm_->getPageMoveReadLock();
   setAppended();
 
   size_t startPage = size_ / pageDataSize_;
@@ -514,6 +510,10 @@ void FileBuffer::append(int8_t* src,
       // we already have a new page at current
       // epoch for this page - just grab this page
       page = multiPages_[pageNum].current().page;
+      if (isCompressedPage(page)) {
+        // only happens if the buffer shrank below a compressed page
+        page = materializeCompressedPage(pageNum, epoch);
+      }
     }
     CHECK(page.fileId >= 0);  // make sure page was initialized
     FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
@@ -541,6 +541,7 @@ void FileBuffer::write(int8_t* src,
                        const int32_t deviceId) {
   CHECK(srcBufferType == CPU_LEVEL) << "Unsupported Buffer type";
 
+  auto page_move_lock = fm_->getPageMoveReadLock();
   bool tempIsAppended = false;
   setDirty();
   if (offset < size_) {
@@ -595,6 +596,8 @@ void FileBuffer::write(int8_t* src,
                               // worry about it right now
       }
       writeHeader(page, pageNum, epoch);
+    } else if (isCompressedPage(multiPages_[pageNum].current().page)) {
+      page = materializeCompressedPage(pageNum, epoch);
     } else {
       // we already have a new page at current
       // epoch for this page - just grab this page
@@ -624,6 +627,87 @@ void FileBuffer::write(int8_t* src,
   CHECK(bytesLeft == 0);
 }
 
+Page FileBuffer::materializeCompressedPage(const size_t pageNum, const int32_t epoch) {
+  CHECK_LT(pageNum, multiPages_.size());
+  auto& multiPage = multiPages_[pageNum];
+  Page compressedPage = multiPage.current().page;
+  CHECK(isCompressedPage(compressedPage));
+  Page page = fm_->requestFreePage(pageSize_, false);
+  copyPage(compressedPage, page, pageDataSize_, 0);
+  if (multiPage.current().epoch < epoch) {
+    multiPage.push(page, epoch);
+  } else {
+    // The compressed version was never checkpointed, replace it.
+    multiPage.pageVersions.back().page = page;
+    freePage(compressedPage, false /* isRolloff */);
+  }
+  writeHeader(page, pageNum, epoch);
+  return page;
+}
+
+void FileBuffer::compressPages(const int32_t epoch) {
+  const auto& compressor_name = fm_->getStorageCompression();
+  CHECK(!compressor_name.empty());
+  // Candidate page sizes, smallest first. Sizes that could be confused with metadata
+  // pages or cannot hold a header are skipped.
+  std::vector<size_t> compressedPageSizes;
+  for (size_t divisor = 16; divisor > 1; divisor /= 2) {
+    const size_t compressedPageSize = pageSize_ / divisor;
+    if (compressedPageSize > 2 * reservedHeaderSize_ &&
+        compressedPageSize != metadataPageSize_ && pageSize_ % divisor == 0) {
+      compressedPageSizes.emplace_back(compressedPageSize);
+    }
+  }
+  if (compressedPageSizes.empty()) {
+    return;
+  }
+  const size_t typeSize =
+      (hasEncoder() && sql_type_.get_size() > 0) ? sql_type_.get_size() : 1;
+  auto compressor = BloscCompressor::getCompressor();
+  std::vector<int8_t> pageData(pageDataSize_);
+  std::vector<int8_t> compressed(compressedPageSizes.back() - reservedHeaderSize_);
+  // Only full pages are compressed; the tail page keeps taking appends in place.
+  const size_t numFullPages = std::min(size_ / pageDataSize_, multiPages_.size());
+  for (size_t pageNum = 0; pageNum < numFullPages; ++pageNum) {
+    auto& multiPage = multiPages_[pageNum];
+    const auto currentPage = multiPage.current();
+    if (currentPage.epoch != epoch || isCompressedPage(currentPage.page)) {
+      continue;
+    }
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(currentPage.page.fileId);
+    CHECK_EQ(fileInfo->read(currentPage.page.pageNum * pageSize_ + reservedHeaderSize_,
+                            pageDataSize_,
+                            pageData.data()),
+             pageDataSize_);
+    const size_t compressedSize = compressor->compressWithContext(
+        reinterpret_cast<const uint8_t*>(pageData.data()),
+        pageDataSize_,
+        reinterpret_cast<uint8_t*>(compressed.data()),
+        compressed.size(),
+        compressor_name,
+        typeSize);
+    if (compressedSize == 0) {
+      continue;  // does not fit in half a page
+    }
+    const auto compressedPageSize =
+        *std::find_if(compressedPageSizes.begin(),
+                      compressedPageSizes.end(),
+                      [this, compressedSize](const size_t compressedPageSize) {
+                        return compressedPageSize - reservedHeaderSize_ >= compressedSize;
+                      });
+    Page page = fm_->requestFreePage(compressedPageSize, false);
+    writeHeader(page, pageNum, epoch);
+    FileInfo* compressedFileInfo = fm_->getFileInfoForFileId(page.fileId);
+    CHECK_EQ(compressedFileInfo->write(page.pageNum * compressedPageSize +
+                                           reservedHeaderSize_,
+                                       compressedSize,
+                                       compressed.data()),
+             compressedSize);
+    multiPage.pageVersions.back().page = page;
+    freePage(currentPage.page, false /* isRolloff */);
+  }
+}
+
 int32_t FileBuffer::getFileMgrEpoch() {
   auto [db_id, tb_id] = get_table_prefix(chunkKey_);
   return fm_->epoch(db_id, tb_id);
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/FileMgr/FileReadQueue.h"
 #include "DataMgr/FileMgr/Page.h"
 
 #include <iostream>
@@ -78,6 +79,10 @@ class FileBuffer : public AbstractBuffer {
              const std::vector<HeaderInfo>::const_iterator& headerStartIt,
              const std::vector<HeaderInfo>::const_iterator& headerEndIt);
 
+  /// Reads the chunk metadata from the current position of metadataFile, which holds
+  /// the same fields as a metadata page. Used when loading a page map snapshot.
+  FileBuffer(FileMgr* fm, const ChunkKey& chunkKey, FILE* metadataFile);
+
   /// Destructor
   ~FileBuffer() override;
 
@@ -96,6 +101,15 @@ class FileBuffer : public AbstractBuffer {
             const MemoryLevel dstMemoryLevel = CPU_LEVEL,
             const int32_t deviceId = -1) override;
 
+  /**
+   * @brief Appends to reads the page run reads covering numBytes at offset, so that
+   * several buffers can be read with a single submission.
+   */
+  void appendPageRunReads(std::vector<PageRunRead>& reads,
+                          int8_t* const dst,
+                          const size_t numBytes,
+                          const size_t offset) const;
+
   /**
    * @brief Writes the contents of source (src) into new versions of the affected logical
    * pages.
@@ -177,9 +191,35 @@ class FileBuffer : public AbstractBuffer {
                    const int32_t epoch,
                    const bool writeMetadata = false);
   void writeMetadata(const int32_t epoch);
+  void writeMetadata(FILE* f);
   void readMetadata(const Page& page);
+  void readMetadata(FILE* f);
   void calcHeaderBuffer();
 
+  /**
+   * @brief Moves the full data pages written in the given (not yet checkpointed) epoch
+   * into smaller pages holding their compressed payload, using the FileMgr's storage
+   * compression. Pages that do not compress below half a page stay as they are.
+   *
+   * Compressed pages are identified by living in a file whose page size differs from
+   * the buffer's page size; the payload is a blosc frame, whose header records the
+   * compressed length.
+   */
+  void compressPages(const int32_t epoch);
+
+  /// Replaces the current version of a compressed page with an uncompressed copy, so
+  /// that it can be partially overwritten.
+  Page materializeCompressedPage(const size_t pageNum, const int32_t epoch);
+
+  size_t physicalPageSize(const Page& page) const;
+  inline bool isCompressedPage(const Page& page) const {
+    return physicalPageSize(page) != pageSize_;
+  }
+  PageRunRead compressedPageRead(const Page& page,
+                                 int8_t* const dst,
+                                 const size_t numBytes,
+                                 const size_t pageOffset) const;
+
   void freePage(const Page& page, const bool isRolloff);
   void freePagesBeforeEpochForMultiPage(MultiPage& multiPage,
                                         const int32_t targetEpoch,
@@ -34,7 +34,22 @@ FileInfo::FileInfo(FileMgr* fileMgr,
                    const size_t pageSize,
                    size_t numPages,
                    bool init)
-    : fileMgr(fileMgr), fileId(fileId), f(f), pageSize(pageSize), numPages(numPages) {
+    : fileMgr(fileMgr)
+    , fileId(fileId)
+    , f(f)
+    , pageSize(pageSize)
+    , numPages(numPages)
+#ifdef _WIN32
+    , positionalIo(false) {
+#else
+    , positionalIo(g_enable_positional_file_io) {
+  if (positionalIo && f) {
+    // Any stdio buffering would hide bytes from (or serve stale bytes over) the
+    // pread/pwrite path, so flush what is pending and stop buffering.
+    CHECK_EQ(fflush(f), 0);
+    CHECK_EQ(setvbuf(f, nullptr, _IONBF, 0), 0);
+  }
+#endif
   if (init) {
     initNewFile();
   }
@@ -54,23 +69,92 @@ void FileInfo::initNewFile() {
   int32_t headerSize = 0;
   int8_t* headerSizePtr = (int8_t*)(&headerSize);
   for (size_t pageId = 0; pageId < numPages; ++pageId) {
-    File_Namespace::write(f, pageId * pageSize, sizeof(int32_t), headerSizePtr);
+    writeUnlocked(pageId * pageSize, sizeof(int32_t), headerSizePtr);
     freePages.insert(pageId);
   }
   isDirty = true;
 }
 
+size_t FileInfo::writeUnlocked(const size_t offset,
+                               const size_t size,
+                               const int8_t* buf) {
+#ifndef _WIN32
+  if (positionalIo) {
+    return File_Namespace::pwrite(fileno(f), offset, size, buf);
+  }
+#endif
+  return File_Namespace::write(f, offset, size, buf);
+}
+
 size_t FileInfo::write(const size_t offset, const size_t size, const int8_t* buf) {
+  recordWrite(offset, size);
+  if (positionalIo) {
+    isDirty = true;
+    return writeUnlocked(offset, size, buf);
+  }
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   isDirty = true;
   return File_Namespace::write(f, offset, size, buf);
 }
 
+void FileInfo::recordWrite(const size_t offset, const size_t size) {
+  if (!fileMgr || !fileMgr->hasWriteAheadLog()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(unloggedWritesMutex_);
+  // Merge with overlapping or adjacent ranges, so that appends to a page are logged as a
+  // single range.
+  size_t start = offset;
+  size_t end = offset + size;
+  auto it = unloggedWrites.upper_bound(start);
+  if (it != unloggedWrites.begin()) {
+    auto prev_it = std::prev(it);
+    if (prev_it->second >= start) {
+      start = prev_it->first;
+      end = std::max(end, prev_it->second);
+      unloggedWrites.erase(prev_it);
+    }
+  }
+  while (it != unloggedWrites.end() && it->first <= end) {
+    end = std::max(end, it->second);
+    it = unloggedWrites.erase(it);
+  }
+  unloggedWrites.emplace(start, end);
+}
+
+std::map<size_t, size_t> FileInfo::takeUnloggedWrites() {
+  std::lock_guard<std::mutex> lock(unloggedWritesMutex_);
+  std::map<size_t, size_t> writes;
+  writes.swap(unloggedWrites);
+  return writes;
+}
+
+size_t FileInfo::numUnloggedBytes() const {
+  std::lock_guard<std::mutex> lock(unloggedWritesMutex_);
+  size_t num_bytes{0};
+  for (const auto& [start, end] : unloggedWrites) {
+    num_bytes += end - start;
+  }
+  return num_bytes;
+}
+
 size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
+#ifndef _WIN32
+  if (positionalIo) {
+    return File_Namespace::pread(fileno(f), offset, size, buf);
+  }
+#endif
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   return File_Namespace::read(f, offset, size, buf);
 }
 
+#ifndef _WIN32
+size_t FileInfo::readv(const size_t offset, struct iovec* iov, const int iovcnt) {
+  CHECK(positionalIo);
+  return File_Namespace::preadv(fileno(f), offset, iov, iovcnt);
+}
+#endif
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec) {
   // HeaderInfo is defined in Page.h
 
@@ -183,15 +267,16 @@ static void sighandler(int sig) {
 #endif
 
 void FileInfo::freePage(int pageId, const bool isRolloff, int32_t epoch) {
+  fileMgr->invalidatePageMapSnapshot();
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   int32_t epoch_freed_page[2] = {DELETE_CONTINGENT, epoch};
   if (isRolloff) {
     epoch_freed_page[0] = ROLLOFF_CONTINGENT;
   }
-  File_Namespace::write(f,
-                        pageId * pageSize + sizeof(int32_t),
-                        sizeof(epoch_freed_page),
-                        reinterpret_cast<const int8_t*>(epoch_freed_page));
+  recordWrite(pageId * pageSize + sizeof(int32_t), sizeof(epoch_freed_page));
+  writeUnlocked(pageId * pageSize + sizeof(int32_t),
+                sizeof(epoch_freed_page),
+                reinterpret_cast<const int8_t*>(epoch_freed_page));
   fileMgr->free_page(std::make_pair(this, pageId));
   isDirty = true;
 
@@ -225,7 +310,14 @@ std::string FileInfo::print() const {
 
 int32_t FileInfo::syncToDisk() {
   std::lock_guard<std::mutex> lock(readWriteMutex_);
-  if (isDirty) {
+  // Clear the flag before syncing, since positional writes can land concurrently and
+  // must leave the file marked dirty for the next sync.
+  if (isDirty.exchange(false)) {
+    {
+      // Everything written so far becomes durable below and no longer needs logging.
+      std::lock_guard<std::mutex> unlogged_writes_lock(unloggedWritesMutex_);
+      unloggedWrites.clear();
+    }
     if (fflush(f) != 0) {
       LOG(FATAL) << "Error trying to flush changes to disk, the error was: "
                  << std::strerror(errno);
@@ -235,8 +327,8 @@ int32_t FileInfo::syncToDisk() {
 #else
     const int32_t sync_result = heavyai::fsync(fileno(f));
 #endif
-    if (sync_result == 0) {
-      isDirty = false;
+    if (sync_result != 0) {
+      isDirty = true;
     }
     return sync_result;
   }
@@ -249,8 +341,9 @@ void FileInfo::freePageImmediate(int32_t page_num) {
   // protecting from RO trying to write
   if (!g_read_only && !g_multi_instance) {
     int32_t zero{0};
-    File_Namespace::write(
-        f, page_num * pageSize, sizeof(int32_t), reinterpret_cast<const int8_t*>(&zero));
+    recordWrite(page_num * pageSize, sizeof(int32_t));
+    writeUnlocked(
+        page_num * pageSize, sizeof(int32_t), reinterpret_cast<const int8_t*>(&zero));
     freePageDeferred(page_num);
   }
 }
@@ -261,10 +354,10 @@ void FileInfo::recoverPage(const ChunkKey& chunk_key, int32_t page_num) {
   // as it seems we are no guaranteed to have f/synced so
   // protecting from RO trying to write
   if (!g_read_only && !g_multi_instance) {
-    File_Namespace::write(f,
-                          page_num * pageSize + sizeof(int32_t),
-                          2 * sizeof(int32_t),
-                          reinterpret_cast<const int8_t*>(chunk_key.data()));
+    recordWrite(page_num * pageSize + sizeof(int32_t), 2 * sizeof(int32_t));
+    writeUnlocked(page_num * pageSize + sizeof(int32_t),
+                  2 * sizeof(int32_t),
+                  reinterpret_cast<const int8_t*>(chunk_key.data()));
   }
 }
 
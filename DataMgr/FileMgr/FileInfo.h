@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdio>
 #include <cstring>
+#include <map>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -26,10 +28,17 @@
 #include <fcntl.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #include "../../Shared/types.h"
 #include "Logger/Logger.h"
 #include "OSDependent/heavyai_fs.h"
 #include "Page.h"
+
+extern bool g_enable_positional_file_io;
+
 namespace File_Namespace {
 
 struct Page;
@@ -47,6 +56,12 @@ struct Page;
  * time pop operation, which may reduce the cost of DBMS disk accesses.
  *
  * Helper functions are provided: size(), available(), and used().
+ *
+ * When positional I/O is enabled (g_enable_positional_file_io), page reads and writes
+ * go through pread/pwrite on the underlying file descriptor and do not take
+ * readWriteMutex_, so multiple reader threads can have reads in flight against the same
+ * file. The stream is made unbuffered in that mode so that the remaining FILE* based
+ * accesses (chunk metadata pages) always observe the same bytes as the descriptor.
  */
 constexpr int32_t DELETE_CONTINGENT = -1;
 constexpr int32_t ROLLOFF_CONTINGENT = -2;
@@ -58,10 +73,15 @@ struct FileInfo {
   FILE* f;                     /// file stream object for the represented file
   size_t pageSize;             /// the fixed size of each page in the file
   size_t numPages;             /// the number of pages in the file
-  bool isDirty{false};         // True if writes have occured since last sync
+  std::atomic<bool> isDirty{false};  // True if writes have occured since last sync
+  const bool positionalIo;           /// true if pread/pwrite is used for page I/O
   std::set<size_t> freePages;  /// set of page numbers of free pages
   mutable std::mutex freePagesMutex_;
   mutable std::mutex readWriteMutex_;
+  /// Byte ranges (offset to end) written since the last sync and not yet copied to the
+  /// write ahead log; only tracked when the FileMgr has a write ahead log
+  std::map<size_t, size_t> unloggedWrites;
+  mutable std::mutex unloggedWritesMutex_;
 
   /// Constructor
   FileInfo(FileMgr* fileMgr,
@@ -83,6 +103,10 @@ struct FileInfo {
   int32_t getFreePage();
   size_t write(const size_t offset, const size_t size, const int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
+#ifndef _WIN32
+  /// Scatter reads a contiguous byte range of the file into iov; requires positionalIo
+  size_t readv(const size_t offset, struct iovec* iov, const int iovcnt);
+#endif
 
   void openExistingFile(std::vector<HeaderInfo>& headerVec);
 
@@ -115,6 +139,17 @@ struct FileInfo {
 
   void freePageImmediate(int32_t page_num);
   void recoverPage(const ChunkKey& chunk_key, int32_t page_num);
+
+  /// Records a write that bypassed write(), if the FileMgr has a write ahead log
+  void recordWrite(const size_t offset, const size_t size);
+
+  /// Returns and forgets the byte ranges written since the last sync or call
+  std::map<size_t, size_t> takeUnloggedWrites();
+  size_t numUnloggedBytes() const;
+
+ private:
+  /// Writes through pwrite or the stream depending on positionalIo; takes no lock
+  size_t writeUnlocked(const size_t offset, const size_t size, const int8_t* buf);
 };
 
 bool is_page_deleted_with_checkpoint(int32_t table_epoch,
@@ -24,6 +24,7 @@
 
 #include <fcntl.h>
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <future>
 #include <string>
@@ -31,6 +32,7 @@
 #include <utility>
 #include <vector>
 
+#include <boost/crc.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/system/error_code.hpp>
@@ -42,6 +44,14 @@
 
 using namespace std;
 
+extern bool g_read_only;
+extern bool g_multi_instance;
+
+bool g_enable_page_map_snapshot{false};
+size_t g_page_map_snapshot_checkpoint_interval{0};
+bool g_enable_write_ahead_log{false};
+size_t g_write_ahead_log_max_bytes{256UL << 20};
+
 namespace File_Namespace {
 
 FileMgr::FileMgr(const int32_t device_id,
@@ -111,6 +121,11 @@ FileMgr::FileMgr(const size_t page_size, const size_t metadata_page_size)
     , metadata_page_size_(metadata_page_size) {}
 
 FileMgr::~FileMgr() {
+  if (hasWriteAheadLog_) {
+    // Checkpoints of a FileMgr that is reopened in this process are not replayed.
+    gfm_->unregisterFromWriteAheadLog(this);
+    flushLoggedCheckpoints();
+  }
   // free memory used by FileInfo objects
   for (auto chunkIt = chunkIndex_.begin(); chunkIt != chunkIndex_.end(); ++chunkIt) {
     delete chunkIt->second;
@@ -253,51 +268,368 @@ void FileMgr::clearFileInfos() {
   fileIndex_.clear();
 }
 
+namespace {
+constexpr uint64_t PAGE_MAP_SNAPSHOT_MAGIC{0x50414745'4d415031};  // "PAGEMAP1"
+constexpr int32_t PAGE_MAP_SNAPSHOT_VERSION{3};
+
+template <typename T>
+void write_snapshot_value(FILE* f, const T& value) {
+  CHECK_EQ(fwrite(&value, sizeof(T), 1, f), size_t(1))
+      << "Could not write page map snapshot";
+}
+
+template <typename T>
+T read_snapshot_value(FILE* f) {
+  T value;
+  if (fread(&value, sizeof(T), 1, f) != 1) {
+    throw std::runtime_error("Unexpected end of page map snapshot");
+  }
+  return value;
+}
+
+void write_snapshot_pages(FILE* f, const MultiPage& multi_page) {
+  write_snapshot_value<uint64_t>(f, multi_page.pageVersions.size());
+  for (const auto& epoched_page : multi_page.pageVersions) {
+    write_snapshot_value<int32_t>(f, epoched_page.page.fileId);
+    write_snapshot_value<uint64_t>(f, epoched_page.page.pageNum);
+    write_snapshot_value<int32_t>(f, epoched_page.epoch);
+  }
+}
+
+void read_snapshot_pages(FILE* f, MultiPage& multi_page) {
+  const auto num_versions = read_snapshot_value<uint64_t>(f);
+  for (uint64_t i = 0; i < num_versions; ++i) {
+    const auto file_id = read_snapshot_value<int32_t>(f);
+    const auto page_num = read_snapshot_value<uint64_t>(f);
+    multi_page.push(Page(file_id, page_num), read_snapshot_value<int32_t>(f));
+  }
+}
+
+// CRC-32 of the first num_bytes bytes of the file, read sequentially from the start.
+uint32_t snapshot_checksum(FILE* f, size_t num_bytes) {
+  boost::crc_32_type crc;
+  std::vector<char> buffer(std::min(num_bytes, size_t(1) << 20));
+  fseek(f, 0, SEEK_SET);
+  while (num_bytes > 0) {
+    const auto read_size = std::min(num_bytes, buffer.size());
+    if (fread(buffer.data(), 1, read_size, f) != read_size) {
+      throw std::runtime_error("Unexpected end of page map snapshot");
+    }
+    crc.process_bytes(buffer.data(), read_size);
+    num_bytes -= read_size;
+  }
+  return crc.checksum();
+}
+
+void sync_directory(const std::string& path) {
+#ifndef _WIN32
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  CHECK_GE(fd, 0) << "Could not open directory " << path;
+  const int status = heavyai::fsync(fd);
+  ::close(fd);
+  CHECK_EQ(status, 0) << "Could not sync directory " << path;
+#endif
+}
+}  // namespace
+
+/**
+ * Writes the page map of the table as of the last checkpoint: the free pages of every
+ * file and, for every chunk, the contents of its current metadata page and its page
+ * versions. The snapshot is written to a temporary file that is renamed into place, and
+ * ends with a CRC-32 of everything before it.
+ *
+ * Snapshots are written when the table is closed and, optionally, every
+ * g_page_map_snapshot_checkpoint_interval checkpoints, rather than on every checkpoint:
+ * the snapshot is only valid as long as no page header changes, so it is removed by
+ * invalidatePageMapSnapshot() before the first page is allocated or freed afterwards.
+ */
+void FileMgr::writePageMapSnapshot() {
+  auto clock_begin = timer_start();
+  const auto snapshot_path = getFilePath(PAGE_MAP_SNAPSHOT_FILENAME);
+  const auto temp_path = getFilePath(std::string(PAGE_MAP_SNAPSHOT_FILENAME) + ".tmp");
+  FILE* f = fopen(temp_path.string().c_str(), "w+b");
+  CHECK(f) << "Could not create page map snapshot file " << temp_path;
+
+  write_snapshot_value<uint64_t>(f, PAGE_MAP_SNAPSHOT_MAGIC);
+  write_snapshot_value<int32_t>(f, PAGE_MAP_SNAPSHOT_VERSION);
+  write_snapshot_value<int32_t>(f, fileMgrVersion_);
+  write_snapshot_value<int32_t>(f, lastCheckpointedEpoch());
+  write_snapshot_value<int32_t>(f, epochFloor());
+  {
+    heavyai::shared_lock<heavyai::shared_mutex> files_read_lock(files_rw_mutex_);
+    write_snapshot_value<uint64_t>(f, files_.size());
+    for (const auto& [file_id, file_info] : files_) {
+      write_snapshot_value<int32_t>(f, file_id);
+      write_snapshot_value<uint64_t>(f, file_info->pageSize);
+      write_snapshot_value<uint64_t>(f, file_info->numPages);
+      const auto free_pages = file_info->getFreePages();
+      write_snapshot_value<uint64_t>(f, free_pages.size());
+      for (const auto page_num : free_pages) {
+        write_snapshot_value<uint64_t>(f, page_num);
+      }
+    }
+  }
+  {
+    heavyai::shared_lock<heavyai::shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+    // Buffers that were never written have no pages on disk and are not restored by a
+    // header scan either.
+    uint64_t num_chunks{0};
+    for (const auto& [key, buffer] : chunkIndex_) {
+      if (!buffer->metadataPages_.pageVersions.empty()) {
+        num_chunks++;
+      }
+    }
+    write_snapshot_value<uint64_t>(f, num_chunks);
+    for (const auto& [key, buffer] : chunkIndex_) {
+      if (buffer->metadataPages_.pageVersions.empty()) {
+        continue;
+      }
+      write_snapshot_value<uint64_t>(f, key.size());
+      for (const auto key_part : key) {
+        write_snapshot_value<int32_t>(f, key_part);
+      }
+      buffer->writeMetadata(f);
+      write_snapshot_pages(f, buffer->metadataPages_);
+      write_snapshot_value<uint64_t>(f, buffer->multiPages_.size());
+      for (const auto& multi_page : buffer->multiPages_) {
+        write_snapshot_pages(f, multi_page);
+      }
+    }
+  }
+
+  CHECK_EQ(fflush(f), 0) << "Could not flush page map snapshot file " << temp_path;
+  const auto snapshot_size = static_cast<size_t>(ftell(f));
+  const uint32_t checksum = snapshot_checksum(f, snapshot_size);
+  fseek(f, 0, SEEK_END);
+  write_snapshot_value<uint32_t>(f, checksum);
+  CHECK_EQ(fflush(f), 0) << "Could not flush page map snapshot file " << temp_path;
+  CHECK_EQ(heavyai::fsync(fileno(f)), 0)
+      << "Could not sync page map snapshot file " << temp_path;
+  fclose(f);
+
+  std::lock_guard<std::mutex> lock(pageMapSnapshotMutex_);
+  boost::filesystem::rename(temp_path, snapshot_path);
+  sync_directory(fileMgrBasePath_);
+  pageMapSnapshotExists_ = true;
+  numCheckpointsSincePageMapSnapshot_ = 0;
+  VLOG(1) << "Wrote page map snapshot for " << describeSelf() << " ("
+          << snapshot_size + sizeof(uint32_t) << " bytes) in " << timer_stop(clock_begin)
+          << "ms";
+}
+
+/**
+ * Restores files_, fileIndex_ and chunkIndex_ from the page map snapshot instead of
+ * reading every page header. Returns false, leaving no files open, if the snapshot is
+ * missing, corrupt, or does not describe the current epoch and data files.
+ */
+bool FileMgr::openFilesFromPageMapSnapshot(int32_t& max_file_id) {
+  const auto snapshot_path = getFilePath(PAGE_MAP_SNAPSHOT_FILENAME);
+  if (!pageMapSnapshotExists_) {
+    return false;
+  }
+  auto clock_begin = timer_start();
+  const auto snapshot_size = boost::filesystem::file_size(snapshot_path);
+  if (snapshot_size < sizeof(uint32_t)) {
+    LOG(WARNING) << "Ignoring truncated page map snapshot " << snapshot_path;
+    return false;
+  }
+  FILE* f = fopen(snapshot_path.string().c_str(), "rb");
+  CHECK(f) << "Could not open page map snapshot file " << snapshot_path;
+  bool is_valid{false};
+  try {
+    const auto checksum = snapshot_checksum(f, snapshot_size - sizeof(uint32_t));
+    if (read_snapshot_value<uint32_t>(f) != checksum) {
+      throw std::runtime_error("checksum mismatch");
+    }
+    fseek(f, 0, SEEK_SET);
+    if (read_snapshot_value<uint64_t>(f) != PAGE_MAP_SNAPSHOT_MAGIC ||
+        read_snapshot_value<int32_t>(f) != PAGE_MAP_SNAPSHOT_VERSION ||
+        read_snapshot_value<int32_t>(f) != fileMgrVersion_) {
+      throw std::runtime_error("unsupported version");
+    }
+    const auto snapshot_epoch = read_snapshot_value<int32_t>(f);
+    const auto snapshot_epoch_floor = read_snapshot_value<int32_t>(f);
+    if (snapshot_epoch != epoch() || snapshot_epoch_floor != epochFloor()) {
+      throw std::runtime_error("snapshot epoch " + std::to_string(snapshot_epoch) +
+                               " does not match table epoch " +
+                               std::to_string(epoch()));
+    }
+
+    std::map<int32_t, FileMetadata> data_files;
+    boost::filesystem::directory_iterator end_itr;
+    for (boost::filesystem::directory_iterator file_it(fileMgrBasePath_);
+         file_it != end_itr;
+         ++file_it) {
+      if (is_compaction_status_file(file_it->path().filename().string())) {
+        throw std::runtime_error("interrupted data compaction");
+      }
+      auto file_metadata = getMetadataForFile(file_it);
+      if (file_metadata.is_data_file) {
+        data_files.emplace(file_metadata.file_id, file_metadata);
+      }
+    }
+
+    const auto num_files = read_snapshot_value<uint64_t>(f);
+    if (num_files != data_files.size()) {
+      throw std::runtime_error("data files changed");
+    }
+    {
+      heavyai::unique_lock<heavyai::shared_mutex> write_lock(files_rw_mutex_);
+      for (uint64_t i = 0; i < num_files; ++i) {
+        const auto file_id = read_snapshot_value<int32_t>(f);
+        const auto page_size = read_snapshot_value<uint64_t>(f);
+        const auto num_pages = read_snapshot_value<uint64_t>(f);
+        auto file_it = data_files.find(file_id);
+        if (file_it == data_files.end() || file_it->second.page_size != page_size ||
+            file_it->second.num_pages != num_pages) {
+          throw std::runtime_error("data files changed");
+        }
+        auto file_info = new FileInfo(
+            this, file_id, open(file_it->second.file_path), page_size, num_pages, false);
+        files_[file_id] = file_info;
+        fileIndex_.insert(std::pair<size_t, int32_t>(page_size, file_id));
+        const auto num_free_pages = read_snapshot_value<uint64_t>(f);
+        for (uint64_t j = 0; j < num_free_pages; ++j) {
+          file_info->freePages.insert(read_snapshot_value<uint64_t>(f));
+        }
+        max_file_id = std::max(max_file_id, file_id);
+      }
+    }
+
+    heavyai::unique_lock<heavyai::shared_mutex> chunk_index_write_lock(chunkIndexMutex_);
+    const auto num_chunks = read_snapshot_value<uint64_t>(f);
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+      ChunkKey key(read_snapshot_value<uint64_t>(f));
+      for (auto& key_part : key) {
+        key_part = read_snapshot_value<int32_t>(f);
+      }
+      auto buffer = new FileBuffer(this, key, f);
+      CHECK(chunkIndex_.emplace(key, buffer).second)
+          << "Chunk already exists for key: " << show_chunk(key);
+      read_snapshot_pages(f, buffer->metadataPages_);
+      const auto num_multi_pages = read_snapshot_value<uint64_t>(f);
+      for (uint64_t j = 0; j < num_multi_pages; ++j) {
+        buffer->multiPages_.emplace_back(buffer->pageSize_);
+        read_snapshot_pages(f, buffer->multiPages_.back());
+      }
+    }
+    if (static_cast<size_t>(ftell(f)) != snapshot_size - sizeof(uint32_t)) {
+      throw std::runtime_error("unexpected trailing data");
+    }
+    is_valid = true;
+  } catch (const std::exception& e) {
+    LOG(INFO) << "Not using page map snapshot for " << describeSelf() << ": "
+              << e.what();
+  }
+  fclose(f);
+
+  if (!is_valid) {
+    {
+      heavyai::unique_lock<heavyai::shared_mutex> chunk_index_write_lock(
+          chunkIndexMutex_);
+      for (auto [key, buffer] : chunkIndex_) {
+        delete buffer;
+      }
+      chunkIndex_.clear();
+    }
+    clearFileInfos();
+    max_file_id = -1;
+    return false;
+  }
+  LOG(INFO) << "Completed loading table's page map snapshot, Elapsed time : "
+            << timer_stop(clock_begin) << "ms Epoch: " << epoch_.ceiling()
+            << " files: " << files_.size() << " chunks: " << chunkIndex_.size()
+            << " table location: '" << fileMgrBasePath_ << "'";
+  return true;
+}
+
+void FileMgr::invalidatePageMapSnapshot() {
+  pagesChangedSinceCheckpoint_ = true;
+  if (!pageMapSnapshotExists_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pageMapSnapshotMutex_);
+  if (!pageMapSnapshotExists_) {
+    return;
+  }
+  if (!g_read_only) {
+    // Make the removal durable before any page header it describes is overwritten.
+    boost::filesystem::remove(getFilePath(PAGE_MAP_SNAPSHOT_FILENAME));
+    sync_directory(fileMgrBasePath_);
+  }
+  pageMapSnapshotExists_ = false;
+}
+
+heavyai::shared_lock<heavyai::shared_mutex> FileMgr::getPageMoveReadLock() const {
+  return heavyai::shared_lock<heavyai::shared_mutex>(page_move_mutex_);
+}
+
+void FileMgr::writePageMapSnapshotOnClose() {
+  if (!g_enable_page_map_snapshot || g_read_only || g_multi_instance ||
+      pagesChangedSinceCheckpoint_ || pageMapSnapshotExists_) {
+    return;
+  }
+  heavyai::shared_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
+  flushLoggedCheckpoints();
+  writePageMapSnapshot();
+}
+
 void FileMgr::init(const size_t num_reader_threads, const int32_t epochOverride) {
   // if epochCeiling = -1 this means open from epoch file
 
+  hasWriteAheadLog_ = gfm_->hasWriteAheadLog();
   const bool dataExists = coreInit();
   if (dataExists) {
     if (epochOverride != -1) {  // if opening at specified epoch
       setEpoch(epochOverride);
     }
 
-    auto open_files_result = openFiles();
-    if (!open_files_result.compaction_status_file_name.empty()) {
-      resumeFileCompaction(open_files_result.compaction_status_file_name);
-      clearFileInfos();
-      open_files_result = openFiles();
-      CHECK(open_files_result.compaction_status_file_name.empty());
-    }
-
-    /* Sort headerVec so that all HeaderInfos
-     * from a chunk will be grouped together
-     * and in order of increasing PageId
-     * - Version Epoch */
-    auto& header_vec = open_files_result.header_infos;
-    std::sort(header_vec.begin(), header_vec.end());
-
-    /* Goal of next section is to find sequences in the
-     * sorted headerVec of the same ChunkId, which we
-     * can then initiate a FileBuffer with */
-
-    VLOG(3) << "Number of Headers in Vector: " << header_vec.size();
-    if (header_vec.size() > 0) {
-      ChunkKey lastChunkKey = header_vec.begin()->chunkKey;
-      auto startIt = header_vec.begin();
+    pageMapSnapshotExists_ = boost::filesystem::exists(
+        getFilePath(PAGE_MAP_SNAPSHOT_FILENAME));
+    int32_t max_file_id{-1};
+    if (!g_enable_page_map_snapshot || g_multi_instance ||
+        !openFilesFromPageMapSnapshot(max_file_id)) {
+      // The header scan below may free or recover pages, after which the snapshot no
+      // longer describes the files.
+      invalidatePageMapSnapshot();
+      auto open_files_result = openFiles();
+      if (!open_files_result.compaction_status_file_name.empty()) {
+        resumeFileCompaction(open_files_result.compaction_status_file_name);
+        clearFileInfos();
+        open_files_result = openFiles();
+        CHECK(open_files_result.compaction_status_file_name.empty());
+      }
 
-      for (auto headerIt = header_vec.begin() + 1; headerIt != header_vec.end();
-           ++headerIt) {
-        if (headerIt->chunkKey != lastChunkKey) {
-          createBufferFromHeaders(lastChunkKey, startIt, headerIt);
-          lastChunkKey = headerIt->chunkKey;
-          startIt = headerIt;
+      /* Sort headerVec so that all HeaderInfos
+       * from a chunk will be grouped together
+       * and in order of increasing PageId
+       * - Version Epoch */
+      auto& header_vec = open_files_result.header_infos;
+      std::sort(header_vec.begin(), header_vec.end());
+
+      /* Goal of next section is to find sequences in the
+       * sorted headerVec of the same ChunkId, which we
+       * can then initiate a FileBuffer with */
+
+      VLOG(3) << "Number of Headers in Vector: " << header_vec.size();
+      if (header_vec.size() > 0) {
+        ChunkKey lastChunkKey = header_vec.begin()->chunkKey;
+        auto startIt = header_vec.begin();
+
+        for (auto headerIt = header_vec.begin() + 1; headerIt != header_vec.end();
+             ++headerIt) {
+          if (headerIt->chunkKey != lastChunkKey) {
+            createBufferFromHeaders(lastChunkKey, startIt, headerIt);
+            lastChunkKey = headerIt->chunkKey;
+            startIt = headerIt;
+          }
         }
+        // now need to insert last Chunk
+        createBufferFromHeaders(lastChunkKey, startIt, header_vec.end());
       }
-      // now need to insert last Chunk
-      createBufferFromHeaders(lastChunkKey, startIt, header_vec.end());
+      max_file_id = open_files_result.max_file_id;
     }
-    nextFileId_ = open_files_result.max_file_id + 1;
+    nextFileId_ = max_file_id + 1;
     rollOffOldData(epoch(), true /* only checkpoint if data is rolled off */);
     incrementEpoch();
     freePages();
@@ -575,6 +907,15 @@ void FileMgr::closePhysicalUnlocked() {
 }
 
 void FileMgr::closeRemovePhysical() {
+  if (gfm_ && gfm_->hasWriteAheadLog()) {
+    // A table created later with the same id must not pick up this table's records.
+    gfm_->unregisterFromWriteAheadLog(this);
+    {
+      std::lock_guard<std::mutex> epoch_file_lock(epochFileMutex_);
+      hasLoggedCheckpoints_ = false;
+    }
+    gfm_->flushWriteAheadLog();
+  }
   heavyai::unique_lock<heavyai::shared_mutex> write_lock(files_rw_mutex_);
   closePhysicalUnlocked();
   /* rename for later deletion the directory containing table related data */
@@ -651,11 +992,22 @@ void FileMgr::openAndReadEpochFile(const std::string& epochFileName) {
     epochFile_ = open(epochFilePath);
   }
   read(epochFile_, 0, Epoch::byte_size(), epoch_.storage_ptr());
+  lastDurableEpoch_ = epoch_;
 }
 
 void FileMgr::writeAndSyncEpochToDisk() {
+  std::lock_guard<std::mutex> epoch_file_lock(epochFileMutex_);
+  // Callers flush the write ahead log first, so that the writes only durable in the log
+  // are durable in the data files before the epoch file covers them.
+  CHECK(!hasLoggedCheckpoints_);
+  writeAndSyncEpochToDisk(epoch_);
+  epochIsCheckpointed_ = true;
+}
+
+// Assumes epochFileMutex_ is held.
+void FileMgr::writeAndSyncEpochToDisk(Epoch epoch) {
   CHECK(epochFile_);
-  write(epochFile_, 0, Epoch::byte_size(), epoch_.storage_ptr());
+  write(epochFile_, 0, Epoch::byte_size(), epoch.storage_ptr());
   int32_t status = fflush(epochFile_);
   CHECK(status == 0) << "Could not flush epoch file to disk";
 #ifdef __APPLE__
@@ -664,7 +1016,8 @@ void FileMgr::writeAndSyncEpochToDisk() {
   status = heavyai::fsync(fileno(epochFile_));
 #endif
   CHECK(status == 0) << "Could not sync epoch file to disk";
-  epochIsCheckpointed_ = true;
+  lastDurableEpoch_ = epoch;
+  hasLoggedCheckpoints_ = false;
 }
 
 void FileMgr::freePagesBeforeEpoch(const int32_t min_epoch) {
@@ -702,12 +1055,22 @@ std::string FileMgr::describeSelf() const {
 
 void FileMgr::checkpoint() {
   VLOG(2) << "Checkpointing " << describeSelf() << " epoch: " << epoch();
+  heavyai::shared_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
   writeDirtyBuffers();
   rollOffOldData(epoch(), false /* shouldCheckpoint */);
-  syncFilesToDisk();
-  writeAndSyncEpochToDisk();
+  if (!hasWriteAheadLog_ || !writeCheckpointToLog()) {
+    syncFilesToDisk();
+    writeAndSyncEpochToDisk();
+  }
   incrementEpoch();
   freePages();
+  pagesChangedSinceCheckpoint_ = false;
+  // A snapshot is only useful for checkpoints that do not need a log replay on startup.
+  if (g_enable_page_map_snapshot && g_page_map_snapshot_checkpoint_interval > 0 &&
+      ++numCheckpointsSincePageMapSnapshot_ >= g_page_map_snapshot_checkpoint_interval &&
+      !g_read_only && !g_multi_instance && !hasWriteAheadLog_) {
+    writePageMapSnapshot();
+  }
 }
 
 FileBuffer* FileMgr::createBuffer(const ChunkKey& key,
@@ -748,6 +1111,7 @@ bool FileMgr::isBufferOnDevice(const ChunkKey& key) {
 }
 
 void FileMgr::deleteBuffer(const ChunkKey& key, const bool purge) {
+  heavyai::shared_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
   heavyai::unique_lock<heavyai::shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
   auto chunk_it = chunkIndex_.find(key);
   CHECK(chunk_it != chunkIndex_.end())
@@ -766,6 +1130,7 @@ ChunkKeyToChunkMap::iterator FileMgr::deleteBufferUnlocked(
 }
 
 void FileMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const bool purge) {
+  heavyai::shared_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
   heavyai::unique_lock<heavyai::shared_mutex> chunkIndexWriteLock(chunkIndexMutex_);
   auto chunkIt = chunkIndex_.lower_bound(keyPrefix);
   if (chunkIt == chunkIndex_.end()) {
@@ -800,6 +1165,7 @@ void FileMgr::fetchBuffer(const ChunkKey& key,
   CHECK(!destBuffer->isDirty())
       << "Aborting attempt to fetch a chunk marked dirty. Chunk inconsistency for key: "
       << show_chunk(key);
+  // FileBuffer::read holds the page move lock.
   AbstractBuffer* chunk = getBuffer(key);
   // chunk's size is either specified in function call with numBytes or we
   // just look at pageSize * numPages in FileBuffer
@@ -811,9 +1177,61 @@ void FileMgr::fetchBuffer(const ChunkKey& key,
   chunk->copyTo(destBuffer, numBytes);
 }
 
+void FileMgr::fetchBuffers(const std::vector<ChunkKey>& keys,
+                           const std::vector<AbstractBuffer*>& destBuffers,
+                           const std::vector<size_t>& numBytes) {
+  CHECK_EQ(keys.size(), destBuffers.size());
+  CHECK_EQ(keys.size(), numBytes.size());
+  std::vector<FileBuffer*> chunks;
+  std::vector<size_t> chunkSizes;
+  chunks.reserve(keys.size());
+  chunkSizes.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    CHECK_EQ(destBuffers[i]->getType(), CPU_LEVEL);
+    CHECK(!destBuffers[i]->isDirty())
+        << "Aborting attempt to fetch a chunk marked dirty. Chunk inconsistency for key: "
+        << show_chunk(keys[i]);
+    auto chunk = getBuffer(keys[i]);
+    if (numBytes[i] > chunk->size()) {
+      LOG(FATAL) << "Chunk retrieved for key `" << show_chunk(keys[i])
+                 << "` is smaller (" << chunk->size()
+                 << ") than number of bytes requested (" << numBytes[i] << ")";
+    }
+    chunks.emplace_back(chunk);
+    chunkSizes.emplace_back(numBytes[i] == 0 ? chunk->size() : numBytes[i]);
+  }
+
+  heavyai::shared_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
+  std::vector<PageRunRead> reads;
+  size_t bytesToRead = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto destBuffer = destBuffers[i];
+    destBuffer->reserve(chunkSizes[i]);
+    // Mirrors AbstractBuffer::copyTo: updated chunks are re-read in full, otherwise only
+    // the bytes appended since the last fetch are read.
+    const size_t destOffset = chunks[i]->isUpdated() ? 0 : destBuffer->size();
+    CHECK_GE(chunkSizes[i], destOffset);
+    chunks[i]->appendPageRunReads(reads,
+                                  destBuffer->getMemoryPtr() + destOffset,
+                                  chunkSizes[i] - destOffset,
+                                  destOffset);
+    bytesToRead += chunkSizes[i] - destOffset;
+  }
+  if (!reads.empty()) {
+    auto batch = FileReadQueue::instance().submit(std::move(reads));
+    batch->wait();
+    CHECK_EQ(batch->bytesRead(), bytesToRead);
+  }
+  for (size_t i = 0; i < keys.size(); ++i) {
+    destBuffers[i]->setSize(chunkSizes[i]);
+    destBuffers[i]->syncEncoder(chunks[i]);
+  }
+}
+
 FileBuffer* FileMgr::putBuffer(const ChunkKey& key,
                                AbstractBuffer* srcBuffer,
                                const size_t numBytes) {
+  // FileBuffer::write and FileBuffer::append hold the page move lock.
   auto chunk = getOrCreateBuffer(key);
   size_t oldChunkSize = chunk->size();
   // write the buffer's data to the Chunk
@@ -873,6 +1291,7 @@ void FileMgr::free(AbstractBuffer* buffer) {
 }
 
 Page FileMgr::requestFreePage(size_t pageSize, const bool isMetadata) {
+  invalidatePageMapSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
 
   auto candidateFiles = fileIndex_.equal_range(pageSize);
@@ -902,6 +1321,7 @@ void FileMgr::requestFreePages(size_t numPagesRequested,
                                const bool isMetadata) {
   // not used currently
   // @todo add method to FileInfo to get more than one page
+  invalidatePageMapSnapshot();
   std::lock_guard<std::mutex> lock(getPageMutex_);
   auto candidateFiles = fileIndex_.equal_range(pageSize);
   size_t numPagesNeeded = numPagesRequested;
@@ -976,6 +1396,11 @@ FileInfo* FileMgr::createFile(const size_t pageSize, const size_t numPages) {
   FileInfo* fInfo =
       new FileInfo(this, fileId, f, pageSize, numPages, true);  // true means init file
   CHECK(fInfo);
+  if (hasWriteAheadLog_) {
+    // Only writes to existing pages are logged, so the initialized file has to be
+    // durable before pages in it can be.
+    CHECK_EQ(fInfo->syncToDisk(), 0) << "Could not sync file to disk";
+  }
 
   heavyai::unique_lock<heavyai::shared_mutex> write_lock(files_rw_mutex_);
   // update file manager data structures
@@ -1195,6 +1620,11 @@ void FileMgr::setEpoch(const int32_t newEpoch) {
     throw std::runtime_error(error_message.str());
   }
   epoch_.ceiling(newEpoch);
+  if (hasWriteAheadLog_) {
+    // Logged checkpoints that start from the new epoch would redo the rolled back data
+    // on the next startup.
+    gfm_->flushWriteAheadLog();
+  }
   writeAndSyncEpochToDisk();
 }
 
@@ -1263,10 +1693,13 @@ void FileMgr::resumeFileCompaction(const std::string& status_file_name) {
  * Delete status file.
  */
 void FileMgr::compactFiles() {
+  heavyai::unique_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_);
   heavyai::unique_lock<heavyai::shared_mutex> write_lock(files_rw_mutex_);
   if (files_.empty()) {
     return;
   }
+  invalidatePageMapSnapshot();
+  flushLoggedCheckpointsUnlocked();
 
   auto copy_pages_status_file_path = getFilePath(COPY_PAGES_STATUS);
   CHECK(!boost::filesystem::exists(copy_pages_status_file_path));
@@ -1293,6 +1726,174 @@ void FileMgr::compactFiles() {
   deleteEmptyFiles();
 }
 
+/**
+ * Runs one bounded pass of online data compaction: moves at most max_pages used pages
+ * out of the file that is cheapest to empty into free pages of the densest files of the
+ * same page size, and deletes files that end up empty. Each pass goes through the same
+ * status file phases as compactFiles(), so a crash in the middle of a pass is recovered
+ * by resumeFileCompaction(). The FileBuffer page versions that referenced the moved
+ * pages are updated in place.
+ *
+ * A pass is skipped (and 0 returned) when foreground reads or writes are in progress,
+ * when the table has unflushed buffers, or when no file can be emptied with the free
+ * pages that are available. Returns the number of bytes read and written.
+ */
+size_t FileMgr::compactFilesIncrementally(const size_t max_pages) {
+  heavyai::unique_lock<heavyai::shared_mutex> page_move_lock(page_move_mutex_,
+                                                              std::try_to_lock);
+  if (!page_move_lock.owns_lock() || max_pages == 0) {
+    return 0;
+  }
+  std::lock_guard<std::mutex> get_page_lock(getPageMutex_);
+  heavyai::unique_lock<heavyai::shared_mutex> write_lock(files_rw_mutex_);
+  heavyai::shared_lock<heavyai::shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+  for (const auto& [key, buffer] : chunkIndex_) {
+    if (buffer->isDirty()) {
+      return 0;
+    }
+  }
+
+  std::multimap<size_t, FileInfo*> files_by_free_pages;
+  FileInfo* source_file_info{nullptr};
+  for (auto page_size_it = fileIndex_.begin(); page_size_it != fileIndex_.end();
+       page_size_it = fileIndex_.upper_bound(page_size_it->first)) {
+    files_by_free_pages.clear();
+    auto range = fileIndex_.equal_range(page_size_it->first);
+    for (auto it = range.first; it != range.second; it++) {
+      auto file_info = files_.at(it->second);
+      files_by_free_pages.emplace(file_info->freePages.size(), file_info);
+    }
+    // The source is the file with the most free pages that still has used pages. It
+    // is only worth moving pages out of it if all of them fit into the other files.
+    size_t total_free_pages{0};
+    for (auto it = files_by_free_pages.rbegin(); it != files_by_free_pages.rend(); it++) {
+      if (it->second->freePages.size() < it->second->numPages) {
+        source_file_info = it->second;
+        for (auto dest_it = std::next(it); dest_it != files_by_free_pages.rend();
+             dest_it++) {
+          total_free_pages += dest_it->first;
+        }
+        break;
+      }
+    }
+    if (source_file_info && source_file_info->used() / source_file_info->pageSize <=
+                                total_free_pages) {
+      break;
+    }
+    source_file_info = nullptr;
+  }
+  if (!source_file_info) {
+    return 0;
+  }
+
+  // Only move checkpointed pages that are referenced by a chunk, leaving e.g. pages
+  // waiting for a deferred free in place.
+  std::vector<std::pair<Page, EpochedPage*>> pages_to_move;
+  for (size_t page_num = 0;
+       page_num < source_file_info->numPages && pages_to_move.size() < max_pages;
+       page_num++) {
+    if (source_file_info->freePages.find(page_num) != source_file_info->freePages.end()) {
+      continue;
+    }
+    Page page{source_file_info->fileId, page_num};
+    auto page_version = getPageVersionForCompaction(page);
+    if (page_version) {
+      pages_to_move.emplace_back(page, page_version);
+    }
+  }
+  if (pages_to_move.empty()) {
+    return 0;
+  }
+
+  invalidatePageMapSnapshot();
+  flushLoggedCheckpointsUnlocked();
+  auto copy_pages_status_file_path = getFilePath(COPY_PAGES_STATUS);
+  CHECK(!boost::filesystem::exists(copy_pages_status_file_path));
+  std::ofstream status_file(copy_pages_status_file_path.string(),
+                            std::ios::out | std::ios::binary);
+  status_file.close();
+
+  // Fill the densest files first.
+  std::vector<PageMapping> page_mappings;
+  std::set<Page> touched_pages;
+  auto dest_it = files_by_free_pages.begin();
+  for (const auto& [source_page, page_version] : pages_to_move) {
+    while (dest_it->second == source_file_info || dest_it->second->freePages.empty()) {
+      dest_it++;
+      CHECK(dest_it != files_by_free_pages.end());
+    }
+    copySourcePageForCompaction(
+        source_page, dest_it->second, page_mappings, touched_pages);
+  }
+  // Copied pages must be durable before the status file makes them visible.
+  for (const auto& [free_pages, file_info] : files_by_free_pages) {
+    CHECK_EQ(file_info->syncToDisk(), 0) << "Could not sync file to disk";
+  }
+
+  writePageMappingsToStatusFile(page_mappings);
+  renameCompactionStatusFile(COPY_PAGES_STATUS, UPDATE_PAGE_VISIBILITY_STATUS);
+  updateMappedPagesVisibility(page_mappings);
+  for (size_t i = 0; i < page_mappings.size(); i++) {
+    pages_to_move[i].second->page = Page(page_mappings[i].destination_file_id,
+                                         page_mappings[i].destination_page_num);
+  }
+  renameCompactionStatusFile(UPDATE_PAGE_VISIBILITY_STATUS, DELETE_EMPTY_FILES_STATUS);
+  deleteEmptyFiles();
+
+  VLOG(1) << "Moved " << page_mappings.size() << " pages of file "
+          << source_file_info->fileId << " while compacting " << describeSelf();
+  return 2 * page_mappings.size() * source_file_info->pageSize;
+}
+
+/**
+ * Returns the FileBuffer page version stored at the given used page, found through the
+ * chunk key and page id in the page header, or nullptr if no chunk references the page
+ * or the page was written in the current, not yet checkpointed, epoch.
+ */
+EpochedPage* FileMgr::getPageVersionForCompaction(const Page& page) {
+  auto file_info = files_.at(page.fileId);
+  PageHeaderSizeType header_size{0};
+  file_info->read(page.pageNum * file_info->pageSize,
+                  sizeof(PageHeaderSizeType),
+                  reinterpret_cast<int8_t*>(&header_size));
+  // The header holds the chunk key, page id and epoch after the header size.
+  if (header_size <= 0 || header_size % sizeof(int32_t) != 0 ||
+      header_size < static_cast<PageHeaderSizeType>(3 * sizeof(int32_t)) ||
+      static_cast<size_t>(header_size) >= file_info->pageSize) {
+    return nullptr;
+  }
+  std::vector<int32_t> header(header_size / sizeof(int32_t));
+  file_info->read(page.pageNum * file_info->pageSize + sizeof(PageHeaderSizeType),
+                  header_size,
+                  reinterpret_cast<int8_t*>(header.data()));
+  const int32_t page_epoch = header.back();
+  const int32_t page_id = header[header.size() - 2];
+  if (page_epoch >= epoch()) {
+    return nullptr;
+  }
+  const ChunkKey chunk_key(header.begin(), header.end() - 2);
+  auto chunk_it = chunkIndex_.find(chunk_key);
+  if (chunk_it == chunkIndex_.end()) {
+    return nullptr;
+  }
+  auto buffer = chunk_it->second;
+  MultiPage* multi_page{nullptr};
+  if (page_id == -1) {
+    multi_page = &buffer->metadataPages_;
+  } else if (page_id >= 0 && static_cast<size_t>(page_id) < buffer->multiPages_.size()) {
+    multi_page = &buffer->multiPages_[page_id];
+  } else {
+    return nullptr;
+  }
+  for (auto& page_version : multi_page->pageVersions) {
+    if (page_version.page.fileId == page.fileId &&
+        page_version.page.pageNum == page.pageNum && page_version.epoch == page_epoch) {
+      return &page_version;
+    }
+  }
+  return nullptr;
+}
+
 /**
  * Sorts all files with the given page size in ascending order of number of
  * free pages. Then copy over pages from files with more free pages to those
@@ -1488,7 +2089,8 @@ void FileMgr::updateMappedPagesVisibility(const std::vector<PageMapping>& page_m
  * status file.
  */
 void FileMgr::deleteEmptyFiles() {
-  for (auto [file_id, file_info] : files_) {
+  for (auto it = files_.begin(); it != files_.end();) {
+    auto [file_id, file_info] = *it;
     CHECK_EQ(file_id, file_info->fileId);
     if (file_info->freePages.size() == file_info->numPages) {
       fclose(file_info->f);
@@ -1496,6 +2098,19 @@ void FileMgr::deleteEmptyFiles() {
       auto file_path = get_data_file_path(fileMgrBasePath_, file_id, file_info->pageSize);
       boost::filesystem::remove(get_legacy_data_file_path(file_path));
       boost::filesystem::remove(file_path);
+
+      // Forget the file, so that the FileMgr remains usable after online compaction.
+      auto range = fileIndex_.equal_range(file_info->pageSize);
+      for (auto index_it = range.first; index_it != range.second; index_it++) {
+        if (index_it->second == file_id) {
+          fileIndex_.erase(index_it);
+          break;
+        }
+      }
+      delete file_info;
+      it = files_.erase(it);
+    } else {
+      it++;
     }
   }
 
@@ -1571,6 +2186,173 @@ void FileMgr::setNumPagesPerMetadataFile(size_t num_pages) {
   num_pages_per_metadata_file_ = num_pages;
 }
 
+namespace {
+// Header of a byte range in a write ahead log record, followed by the bytes.
+struct LoggedWrite {
+  int64_t file_id;
+  uint64_t page_size;
+  uint64_t offset;
+  uint64_t size;
+};
+
+// A record starts with the table key, the epoch it was logged on top of and the epoch
+// it makes durable, followed by the logged writes.
+constexpr size_t kRecordTableKeySize = 2 * sizeof(int32_t);
+constexpr size_t kRecordHeaderSize = kRecordTableKeySize + 2 * Epoch::byte_size();
+}  // namespace
+
+TablePair FileMgr::getWriteAheadLogRecordTable(const std::vector<int8_t>& record) {
+  CHECK_GE(record.size(), kRecordHeaderSize);
+  int32_t db_id, tb_id;
+  std::memcpy(&db_id, record.data(), sizeof(int32_t));
+  std::memcpy(&tb_id, record.data() + sizeof(int32_t), sizeof(int32_t));
+  return {db_id, tb_id};
+}
+
+/**
+ * Applies the checkpoints recorded in the write ahead log to the data files and advances
+ * the epoch file to the last of them. Runs before the table is opened.
+ *
+ * Records are chained by the epoch they were logged on top of. Records older than the
+ * epoch file, which remain in the log when a single table is flushed, start from an
+ * earlier epoch and are skipped.
+ */
+void FileMgr::replayWriteAheadLog(
+    const std::string& base_path,
+    const std::vector<const std::vector<int8_t>*>& records) {
+  const auto epoch_file_path = base_path + "/" + EPOCH_FILENAME;
+  if (!boost::filesystem::exists(epoch_file_path)) {
+    return;
+  }
+  FILE* epoch_file = open(epoch_file_path);
+  Epoch epoch;
+  read(epoch_file, 0, Epoch::byte_size(), epoch.storage_ptr());
+  std::map<std::pair<int64_t, uint64_t>, FILE*> data_files;
+  size_t num_records{0}, num_bytes{0};
+  for (const auto record : records) {
+    CHECK_GE(record->size(), kRecordHeaderSize);
+    if (std::memcmp(record->data() + kRecordTableKeySize,
+                    epoch.storage_ptr(),
+                    Epoch::byte_size()) != 0) {
+      continue;
+    }
+    std::memcpy(epoch.storage_ptr(),
+                record->data() + kRecordTableKeySize + Epoch::byte_size(),
+                Epoch::byte_size());
+    size_t offset = kRecordHeaderSize;
+    while (offset < record->size()) {
+      LoggedWrite logged_write;
+      CHECK_LE(offset + sizeof(LoggedWrite), record->size());
+      std::memcpy(&logged_write, record->data() + offset, sizeof(LoggedWrite));
+      offset += sizeof(LoggedWrite);
+      CHECK_LE(offset + logged_write.size, record->size());
+      auto& f = data_files[{logged_write.file_id, logged_write.page_size}];
+      if (!f) {
+        f = open(
+            get_data_file_path(base_path, logged_write.file_id, logged_write.page_size));
+      }
+      write(f, logged_write.offset, logged_write.size, record->data() + offset);
+      offset += logged_write.size;
+      num_bytes += logged_write.size;
+    }
+    num_records++;
+  }
+  if (num_records > 0) {
+    // The page map snapshot does not know about the replayed writes.
+    boost::filesystem::remove(base_path + "/" + PAGE_MAP_SNAPSHOT_FILENAME);
+    for (const auto& [file_key, f] : data_files) {
+      CHECK_EQ(fflush(f), 0) << "Could not flush file to disk";
+      CHECK_EQ(heavyai::fsync(fileno(f)), 0) << "Could not sync file to disk";
+      close(f);
+    }
+    write(epoch_file, 0, Epoch::byte_size(), epoch.storage_ptr());
+    CHECK_EQ(fflush(epoch_file), 0) << "Could not flush epoch file to disk";
+    CHECK_EQ(heavyai::fsync(fileno(epoch_file)), 0)
+        << "Could not sync epoch file to disk";
+    LOG(INFO) << "Replayed " << num_records << " checkpoints (" << num_bytes
+              << " bytes) from the write ahead log into " << base_path
+              << ", epoch: " << epoch.ceiling();
+  }
+  close(epoch_file);
+}
+
+size_t FileMgr::getNumUnloggedBytes() const {
+  heavyai::shared_lock<heavyai::shared_mutex> files_read_lock(files_rw_mutex_);
+  size_t num_bytes{0};
+  for (const auto& [file_id, file_info] : files_) {
+    num_bytes += file_info->numUnloggedBytes();
+  }
+  return num_bytes;
+}
+
+/**
+ * Makes the current epoch durable by appending everything written to the data files
+ * since the last checkpoint to the write ahead log, instead of syncing the data files
+ * and the epoch file. Returns false, after flushing the log, if the checkpoint does not
+ * fit in the log.
+ */
+bool FileMgr::writeCheckpointToLog() {
+  {
+    auto commit_lock = gfm_->getWriteAheadLogCommitLock();
+    if (gfm_->getWriteAheadLogSize() + getNumUnloggedBytes() <=
+        g_write_ahead_log_max_bytes) {
+      std::vector<int8_t> record(kRecordHeaderSize);
+      std::memcpy(record.data(), &fileMgrKey_.first, sizeof(int32_t));
+      std::memcpy(record.data() + sizeof(int32_t), &fileMgrKey_.second, sizeof(int32_t));
+      {
+        std::lock_guard<std::mutex> epoch_file_lock(epochFileMutex_);
+        std::memcpy(record.data() + kRecordTableKeySize,
+                    lastDurableEpoch_.storage_ptr(),
+                    Epoch::byte_size());
+      }
+      std::memcpy(record.data() + kRecordTableKeySize + Epoch::byte_size(),
+                  epoch_.storage_ptr(),
+                  Epoch::byte_size());
+      {
+        heavyai::shared_lock<heavyai::shared_mutex> files_read_lock(files_rw_mutex_);
+        for (const auto& [file_id, file_info] : files_) {
+          for (const auto& [start, end] : file_info->takeUnloggedWrites()) {
+            LoggedWrite logged_write{file_id, file_info->pageSize, start, end - start};
+            const auto offset = record.size();
+            record.resize(offset + sizeof(LoggedWrite) + logged_write.size);
+            std::memcpy(record.data() + offset, &logged_write, sizeof(LoggedWrite));
+            CHECK_EQ(file_info->read(start,
+                                     logged_write.size,
+                                     record.data() + offset + sizeof(LoggedWrite)),
+                     logged_write.size);
+          }
+        }
+      }
+      gfm_->commitToWriteAheadLog(this, record);
+      std::lock_guard<std::mutex> epoch_file_lock(epochFileMutex_);
+      lastDurableEpoch_ = epoch_;
+      hasLoggedCheckpoints_ = true;
+      epochIsCheckpointed_ = true;
+      return true;
+    }
+  }
+  // Make room for the checkpoints of other tables, this one is written in full.
+  gfm_->flushWriteAheadLog();
+  return false;
+}
+
+void FileMgr::flushLoggedCheckpoints() {
+  heavyai::shared_lock<heavyai::shared_mutex> files_read_lock(files_rw_mutex_);
+  flushLoggedCheckpointsUnlocked();
+}
+
+// Assumes files_rw_mutex_ is held.
+void FileMgr::flushLoggedCheckpointsUnlocked() {
+  std::lock_guard<std::mutex> epoch_file_lock(epochFileMutex_);
+  if (!hasLoggedCheckpoints_) {
+    return;
+  }
+  for (const auto& [file_id, file_info] : files_) {
+    CHECK_EQ(file_info->syncToDisk(), 0) << "Could not sync file to disk";
+  }
+  writeAndSyncEpochToDisk(lastDurableEpoch_);
+}
+
 void FileMgr::syncFilesToDisk() {
   heavyai::shared_lock<heavyai::shared_mutex> files_read_lock(files_rw_mutex_);
   for (auto file_info_entry : files_) {
@@ -1653,6 +2435,11 @@ void FileMgr::writeDirtyBuffers() {
   heavyai::unique_lock<heavyai::shared_mutex> chunk_index_write_lock(chunkIndexMutex_);
   for (auto [key, buf] : chunkIndex_) {
     if (buf->isDirty()) {
+      if (!storageCompression_.empty()) {
+        // Compression reads and replaces pages which writes, appends and deletes may
+        // change, so it runs under the chunk index write lock like the rest.
+        buf->compressPages(epoch());
+      }
       buf->writeMetadata(epoch());
       buf->clearDirtyBits();
     }
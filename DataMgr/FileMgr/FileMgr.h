@@ -24,9 +24,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -42,6 +44,11 @@
 
 using namespace Data_Namespace;
 
+extern bool g_enable_page_map_snapshot;
+extern size_t g_page_map_snapshot_checkpoint_interval;
+extern bool g_enable_write_ahead_log;
+extern size_t g_write_ahead_log_max_bytes;
+
 namespace boost {
 namespace filesystem {
 class directory_iterator;
@@ -196,6 +203,15 @@ class FileMgr : public AbstractBufferMgr {  // implements
                    AbstractBuffer* destBuffer,
                    const size_t numBytes) override;
 
+  /**
+   * @brief Reads the chunks for keys into the corresponding CPU destination buffers,
+   * submitting the page reads of all chunks to the FileReadQueue as a single batch and
+   * waiting once for all of them to complete.
+   */
+  void fetchBuffers(const std::vector<ChunkKey>& keys,
+                    const std::vector<AbstractBuffer*>& destBuffers,
+                    const std::vector<size_t>& numBytes) override;
+
   /**
    * @brief Puts the contents of d into the Chunk with the given key.
    * @param key - Unique identifier for a Chunk.
@@ -311,6 +327,16 @@ class FileMgr : public AbstractBufferMgr {  // implements
    */
   inline size_t getNumReaderThreads() { return num_reader_threads_; }
 
+  /**
+   * @brief Returns the blosc compressor used for full data pages written by this
+   * FileMgr, or an empty string if data pages are stored uncompressed.
+   */
+  inline const std::string& getStorageCompression() const { return storageCompression_; }
+
+  inline void setStorageCompression(const std::string& compression) {
+    storageCompression_ = compression;
+  }
+
   /**
    * @brief Returns FILE pointer associated with
    * requested fileId
@@ -348,6 +374,54 @@ class FileMgr : public AbstractBufferMgr {  // implements
 
   void compactFiles();
 
+  /**
+   * @brief Moves at most max_pages pages towards emptying one data or metadata file,
+   * without blocking foreground reads and writes. Returns the number of bytes copied,
+   * or 0 if there was nothing to do or the FileMgr was busy.
+   */
+  size_t compactFilesIncrementally(const size_t max_pages);
+
+  /**
+   * @brief Returns a shared lock that keeps data compaction from moving pages or
+   * deleting files. FileBuffer holds it while reading or writing pages.
+   */
+  heavyai::shared_lock<heavyai::shared_mutex> getPageMoveReadLock() const;
+
+  /**
+   * @brief Removes the page map snapshot, if any. Must be called before page headers
+   * are changed, i.e. before pages are allocated or freed.
+   */
+  void invalidatePageMapSnapshot();
+
+  /**
+   * @brief Writes the page map snapshot when the FileMgr is closed cleanly, provided no
+   * page changed since the last checkpoint.
+   */
+  void writePageMapSnapshotOnClose();
+
+  /**
+   * @brief True if checkpoints are made durable through the write ahead log of the
+   * GlobalFileMgr, in which case FileInfos record the byte ranges written since the last
+   * checkpoint.
+   */
+  inline bool hasWriteAheadLog() const { return hasWriteAheadLog_; }
+
+  /**
+   * @brief Makes the checkpoints that are only durable in the write ahead log durable in
+   * the data files and the epoch file.
+   */
+  void flushLoggedCheckpoints();
+
+  /**
+   * @brief Applies the logged checkpoints of the table at base_path on top of its epoch
+   * file. Records that do not continue from the epoch file are ignored.
+   */
+  static void replayWriteAheadLog(const std::string& base_path,
+                                  const std::vector<const std::vector<int8_t>*>& records);
+
+  /// Returns the table that a write ahead log record belongs to.
+  static TablePair getWriteAheadLogRecordTable(const std::vector<int8_t>& record);
+
   /**
    * @brief deletes or recovers a page based on last checkpointed epoch.
    **/
@@ -387,6 +461,8 @@ class FileMgr : public AbstractBufferMgr {  // implements
   static constexpr char EPOCH_FILENAME[] = "epoch_metadata";
   static constexpr char DB_META_FILENAME[] = "dbmeta";
   static constexpr char FILE_MGR_VERSION_FILENAME[] = "filemgr_version";
+  static constexpr char PAGE_MAP_SNAPSHOT_FILENAME[] = "page_map_snapshot";
+  static constexpr char WRITE_AHEAD_LOG_FILENAME[] = "write_ahead_log";
   static constexpr int32_t INVALID_VERSION = -1;
 
  protected:
@@ -394,6 +470,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   FileMgr(const size_t defaultPageSize, const size_t defaultMetadataPageSize);
 
   int32_t maxRollbackEpochs_;
+  std::string storageCompression_;
   std::string fileMgrBasePath_;  /// The OS file system path containing files related to
                                  /// this FileMgr
   std::map<int32_t, FileInfo*>
@@ -409,11 +486,29 @@ class FileMgr : public AbstractBufferMgr {  // implements
   std::mutex getPageMutex_;
   mutable heavyai::shared_mutex chunkIndexMutex_;
   mutable heavyai::shared_mutex files_rw_mutex_;
+  // Held in shared mode while FileBuffers read or write pages and while the FileMgr
+  // frees pages, and in exclusive mode while data compaction moves pages.
+  mutable heavyai::shared_mutex page_move_mutex_;
 
   mutable heavyai::shared_mutex mutex_free_page_;
   std::vector<std::pair<FileInfo*, int32_t>> free_pages_;
   bool isFullyInitted_{false};
 
+  std::atomic<bool> pageMapSnapshotExists_{false};
+  // Set when a page is allocated or freed, cleared by checkpoints.
+  std::atomic<bool> pagesChangedSinceCheckpoint_{false};
+  size_t numCheckpointsSincePageMapSnapshot_{0};
+  std::mutex pageMapSnapshotMutex_;
+
+  bool hasWriteAheadLog_{false};
+  // Protects the epoch file and the two members below, which may be flushed by a
+  // checkpoint of another table when the write ahead log is full.
+  std::mutex epochFileMutex_;
+  // Epoch of the last checkpoint made durable, by the epoch file or the log.
+  Epoch lastDurableEpoch_;
+  // Set while the epoch file is behind the log.
+  bool hasLoggedCheckpoints_{false};
+
   static size_t num_pages_per_data_file_;
   static size_t num_pages_per_metadata_file_;
 
@@ -443,6 +538,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   int32_t openAndReadLegacyEpochFile(const std::string& epochFileName);
   void openAndReadEpochFile(const std::string& epochFileName);
   void writeAndSyncEpochToDisk();
+  void writeAndSyncEpochToDisk(Epoch epoch);
   void setEpoch(const int32_t newEpoch);  // resets current value of epoch at startup
   int32_t readVersionFromDisk(const std::string& versionFileName) const;
   void writeAndSyncVersionToDisk(const std::string& versionFileName,
@@ -463,6 +559,13 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void migrateLegacyFilesV1();
 
   OpenFilesResult openFiles();
+  bool openFilesFromPageMapSnapshot(int32_t& max_file_id);
+  void writePageMapSnapshot();
+
+  // Write ahead log methods
+  size_t getNumUnloggedBytes() const;
+  bool writeCheckpointToLog();
+  void flushLoggedCheckpointsUnlocked();
 
   void clearFileInfos();
 
@@ -479,6 +582,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void updateMappedPagesVisibility(const std::vector<PageMapping>& page_mappings);
   void deleteEmptyFiles();
   void resumeFileCompaction(const std::string& status_file_name);
+  EpochedPage* getPageVersionForCompaction(const Page& page);
   std::vector<PageMapping> readPageMappingsFromStatusFile();
 
   // For testing purposes only
@@ -520,7 +624,7 @@ class FileMgr : public AbstractBufferMgr {  // implements
   void setDataAndMetadataFileStats(StorageStats& storage_stats) const;
   uint32_t getFragmentCount() const;
 
-  GlobalFileMgr* gfm_;  /// Global FileMgr
+  GlobalFileMgr* gfm_{nullptr};  /// Global FileMgr
   TablePair fileMgrKey_;
 
   Epoch epoch_;
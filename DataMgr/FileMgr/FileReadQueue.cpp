@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/FileMgr/FileReadQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DataMgr/FileMgr/FileInfo.h"
+#include "Logger/Logger.h"
+#include "Shared/Compressor.h"
+
+size_t g_file_io_queue_depth{0};
+
+namespace File_Namespace {
+
+size_t PageRunRead::numBytes() const {
+  size_t num_bytes{0};
+  for (const auto& segment : segments) {
+    num_bytes += segment.second;
+  }
+  return num_bytes;
+}
+
+void FileReadBatch::wait() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return pending_.load() == 0; });
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void FileReadBatch::complete(const size_t bytes_read, std::exception_ptr error) {
+  bytes_read_ += bytes_read;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (error && !error_) {
+    error_ = error;
+  }
+  if (--pending_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+FileReadQueue& FileReadQueue::instance() {
+  static FileReadQueue queue(g_file_io_queue_depth);
+  return queue;
+}
+
+FileReadQueue::FileReadQueue(const size_t queue_depth) {
+  const size_t num_workers =
+      queue_depth > 0 ? queue_depth
+                      : std::max(std::thread::hardware_concurrency(), unsigned(1));
+  VLOG(1) << "Starting file read queue with depth " << num_workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back([this] { workerLoop(); });
+  }
+}
+
+FileReadQueue::~FileReadQueue() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::shared_ptr<FileReadBatch> FileReadQueue::submit(std::vector<PageRunRead>&& reads) {
+  auto batch = std::make_shared<FileReadBatch>(reads.size());
+  if (reads.empty()) {
+    return batch;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    for (auto& read : reads) {
+      queue_.push_back({std::move(read), batch});
+    }
+  }
+  queue_cv_.notify_all();
+  return batch;
+}
+
+void FileReadQueue::workerLoop() {
+  while (true) {
+    QueuedRead queued_read;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      queued_read = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    size_t bytes_read{0};
+    std::exception_ptr error;
+    try {
+      bytes_read = readPageRun(queued_read.read);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    queued_read.batch->complete(bytes_read, error);
+  }
+}
+
+size_t FileReadQueue::readPageRun(const PageRunRead& read) {
+  CHECK(read.file_info);
+  CHECK(!read.segments.empty());
+  if (read.isCompressed()) {
+    return readCompressedPage(read);
+  }
+#ifndef _WIN32
+  if (read.file_info->positionalIo) {
+    // Scatter the whole run with one preadv, dropping page headers into a scratch
+    // buffer.
+    std::vector<int8_t> header_scratch(read.header_size);
+    std::vector<iovec> iov;
+    iov.reserve(2 * read.segments.size());
+    for (const auto& [dst, num_bytes] : read.segments) {
+      if (!iov.empty()) {
+        iov.push_back({header_scratch.data(), read.header_size});
+      }
+      iov.push_back({dst, num_bytes});
+    }
+    read.file_info->readv(read.file_offset, iov.data(), static_cast<int>(iov.size()));
+    return read.numBytes();
+  }
+#endif
+  size_t bytes_read{0};
+  size_t offset = read.file_offset;
+  for (const auto& [dst, num_bytes] : read.segments) {
+    bytes_read += read.file_info->read(offset, num_bytes, dst);
+    // Advance to the start of the data portion of the next page.
+    offset = (offset / read.page_size + 1) * read.page_size + read.header_size;
+  }
+  return bytes_read;
+}
+
+size_t FileReadQueue::readCompressedPage(const PageRunRead& read) {
+  CHECK_EQ(read.segments.size(), size_t(1));
+  const auto [dst, num_bytes] = read.segments.front();
+  CHECK_LE(read.data_offset + num_bytes, read.uncompressed_size);
+  const size_t compressed_size = read.page_size - read.header_size;
+  std::vector<int8_t> compressed(compressed_size);
+  CHECK_EQ(read.file_info->read(read.file_offset, compressed_size, compressed.data()),
+           compressed_size);
+  auto compressor = BloscCompressor::getCompressor();
+  if (read.data_offset == 0 && num_bytes == read.uncompressed_size) {
+    compressor->decompressWithContext(reinterpret_cast<const uint8_t*>(compressed.data()),
+                                      compressed_size,
+                                      reinterpret_cast<uint8_t*>(dst),
+                                      read.uncompressed_size);
+  } else {
+    std::vector<int8_t> page_data(read.uncompressed_size);
+    compressor->decompressWithContext(reinterpret_cast<const uint8_t*>(compressed.data()),
+                                      compressed_size,
+                                      reinterpret_cast<uint8_t*>(page_data.data()),
+                                      read.uncompressed_size);
+    std::memcpy(dst, page_data.data() + read.data_offset, num_bytes);
+  }
+  return num_bytes;
+}
+
+}  // namespace File_Namespace
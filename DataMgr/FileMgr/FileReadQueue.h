@@ -0,0 +1,135 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    FileReadQueue.h
+ * @brief   Asynchronous submission/completion queue for FileMgr page reads.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+extern size_t g_file_io_queue_depth;
+
+namespace File_Namespace {
+
+struct FileInfo;
+
+/**
+ * @struct PageRunRead
+ * @brief Read of the data portions of a run of physically consecutive pages in a file.
+ *
+ * Each segment receives the data portion of one page. The first segment starts at
+ * file_offset; every following segment starts header_size bytes after the end of the
+ * previous page, which is where the next page's data begins.
+ *
+ * A read with a non-zero uncompressed_size covers a single compressed page instead:
+ * file_offset points at the compressed payload, which is decompressed into
+ * uncompressed_size bytes and the only segment is filled from data_offset onwards.
+ */
+struct PageRunRead {
+  FileInfo* file_info;
+  size_t file_offset;
+  size_t page_size;
+  size_t header_size;
+  std::vector<std::pair<int8_t*, size_t>> segments;
+  size_t uncompressed_size{0};
+  size_t data_offset{0};
+
+  size_t numBytes() const;
+
+  bool isCompressed() const { return uncompressed_size > 0; }
+};
+
+/**
+ * @class FileReadBatch
+ * @brief Completion handle for a group of page run reads submitted together.
+ */
+class FileReadBatch {
+ public:
+  explicit FileReadBatch(const size_t num_reads) : pending_(num_reads) {}
+
+  /// Blocks until every read in the batch completed, rethrowing the first failure.
+  void wait();
+
+  bool isComplete() const { return pending_.load() == 0; }
+
+  size_t bytesRead() const { return bytes_read_.load(); }
+
+ private:
+  void complete(const size_t bytes_read, std::exception_ptr error);
+
+  std::atomic<size_t> pending_;
+  std::atomic<size_t> bytes_read_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::exception_ptr error_;
+
+  friend class FileReadQueue;
+};
+
+/**
+ * @class FileReadQueue
+ * @brief Process wide queue that executes submitted page reads asynchronously.
+ *
+ * Callers describe all the page reads they need (possibly for several chunks) and
+ * submit them at once; the queue keeps up to queue depth reads in flight and the caller
+ * only waits on the returned batch. Reads against files using positional I/O are issued
+ * as a single preadv per page run.
+ */
+class FileReadQueue {
+ public:
+  static FileReadQueue& instance();
+
+  ~FileReadQueue();
+
+  std::shared_ptr<FileReadBatch> submit(std::vector<PageRunRead>&& reads);
+
+  size_t getQueueDepth() const { return workers_.size(); }
+
+  /// Executes a single page run read on the calling thread.
+  static size_t readPageRun(const PageRunRead& read);
+
+ private:
+  explicit FileReadQueue(const size_t queue_depth);
+
+  void workerLoop();
+
+  static size_t readCompressedPage(const PageRunRead& read);
+
+  struct QueuedRead {
+    PageRunRead read;
+    std::shared_ptr<FileReadBatch> batch;
+  };
+
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<QueuedRead> queue_;
+  bool shutdown_{false};
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace File_Namespace
@@ -24,6 +24,7 @@
 
 #include <fcntl.h>
 #include <algorithm>
+#include <chrono>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <string>
@@ -37,6 +38,13 @@
 
 using namespace std;
 
+extern bool g_read_only;
+extern bool g_multi_instance;
+
+bool g_enable_background_compaction{false};
+size_t g_background_compaction_pages_per_pass{64};
+size_t g_background_compaction_max_bytes_per_sec{64UL << 20};
+
 namespace File_Namespace {
 
 GlobalFileMgr::GlobalFileMgr(const int32_t device_id,
@@ -57,6 +65,71 @@ GlobalFileMgr::GlobalFileMgr(const int32_t device_id,
   // DS changes also triggered by individual FileMgr per table project (release 2.1.0)
   dbConvert_ = false;
   init();
+  if (g_enable_background_compaction && !g_read_only && !g_multi_instance) {
+    compaction_thread_ = std::thread([this] { backgroundCompactionLoop(); });
+  }
+}
+
+GlobalFileMgr::~GlobalFileMgr() {
+  {
+    std::lock_guard<std::mutex> lock(compaction_mutex_);
+    stop_compaction_ = true;
+  }
+  compaction_cv_.notify_all();
+  if (compaction_thread_.joinable()) {
+    compaction_thread_.join();
+  }
+  for (const auto& [file_mgr_key, file_mgr] : ownedFileMgrs_) {
+    file_mgr->writePageMapSnapshotOnClose();
+  }
+}
+
+void GlobalFileMgr::backgroundCompactionLoop() {
+  // Time to wait before looking for more work after a pass that moved nothing.
+  constexpr std::chrono::milliseconds idle_interval{1000};
+  while (true) {
+    size_t bytes_copied{0};
+    try {
+      bytes_copied = compactNextFileMgr();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Background data file compaction pass failed: " << e.what();
+    }
+    auto wait_time = idle_interval;
+    if (bytes_copied > 0) {
+      // Throttle so that compaction I/O stays within the configured bandwidth.
+      const size_t max_bytes_per_sec =
+          std::max(g_background_compaction_max_bytes_per_sec, size_t(1));
+      wait_time = std::chrono::milliseconds(bytes_copied * 1000 / max_bytes_per_sec);
+    }
+    std::unique_lock<std::mutex> lock(compaction_mutex_);
+    if (compaction_cv_.wait_for(lock, wait_time, [this] { return stop_compaction_; })) {
+      return;
+    }
+  }
+}
+
+size_t GlobalFileMgr::compactNextFileMgr() {
+  // Never hold up table creation, deletion or checkpoints; try again on the next pass.
+  heavyai::shared_lock<heavyai::shared_mutex> read_lock(fileMgrs_mutex_,
+                                                        std::try_to_lock);
+  if (!read_lock.owns_lock() || ownedFileMgrs_.empty()) {
+    return 0;
+  }
+  // Keep compacting the table of the previous pass until it is done, then move on to
+  // the next table with work to do.
+  auto it = ownedFileMgrs_.lower_bound(next_compaction_table_);
+  for (size_t i = 0; i < ownedFileMgrs_.size(); ++i, ++it) {
+    if (it == ownedFileMgrs_.end()) {
+      it = ownedFileMgrs_.begin();
+    }
+    const auto bytes_copied =
+        it->second->compactFilesIncrementally(g_background_compaction_pages_per_pass);
+    if (bytes_copied > 0) {
+      next_compaction_table_ = it->first;
+      return bytes_copied;
+    }
+  }
+  return 0;
 }
 
 void GlobalFileMgr::init() {
@@ -74,6 +147,80 @@ void GlobalFileMgr::init() {
       LOG(FATAL) << "Could not create data directory";
     }
   }
+  openWriteAheadLog();
+}
+
+/**
+ * Replays the checkpoints that were only durable in the write ahead log before any
+ * table is opened, then starts the log empty.
+ */
+void GlobalFileMgr::openWriteAheadLog() {
+  const auto log_path = basePath_ + FileMgr::WRITE_AHEAD_LOG_FILENAME;
+  const bool use_log = g_enable_write_ahead_log && !g_read_only && !g_multi_instance;
+  if (!use_log && !boost::filesystem::exists(log_path)) {
+    return;
+  }
+  if (g_read_only || g_multi_instance) {
+    LOG(WARNING) << "Not replaying write ahead log " << log_path
+                 << " in read-only mode, checkpoints only recorded in the log are lost.";
+    return;
+  }
+  writeAheadLog_ = std::make_unique<WriteAheadLog>(log_path);
+  const auto records = writeAheadLog_->readCommittedRecords();
+  std::map<TablePair, std::vector<const std::vector<int8_t>*>> records_per_table;
+  for (const auto& record : records) {
+    records_per_table[FileMgr::getWriteAheadLogRecordTable(record)].emplace_back(&record);
+  }
+  for (const auto& [table_key, table_records] : records_per_table) {
+    const auto table_path = basePath_ + "table_" + std::to_string(table_key.first) +
+                            "_" + std::to_string(table_key.second);
+    FileMgr::replayWriteAheadLog(table_path, table_records);
+  }
+  writeAheadLog_->reset();
+  if (!use_log) {
+    // The log was left behind by a server that had it enabled.
+    writeAheadLog_.reset();
+    boost::filesystem::remove(log_path);
+  }
+}
+
+heavyai::shared_lock<heavyai::shared_mutex> GlobalFileMgr::getWriteAheadLogCommitLock() {
+  return heavyai::shared_lock<heavyai::shared_mutex>(writeAheadLogMutex_);
+}
+
+size_t GlobalFileMgr::getWriteAheadLogSize() const {
+  CHECK(writeAheadLog_);
+  return writeAheadLog_->size();
+}
+
+void GlobalFileMgr::commitToWriteAheadLog(FileMgr* file_mgr,
+                                          const std::vector<int8_t>& record) {
+  CHECK(writeAheadLog_);
+  {
+    std::lock_guard<std::mutex> lock(loggedFileMgrsMutex_);
+    loggedFileMgrs_.emplace(file_mgr);
+  }
+  // Committers of all tables that arrive during a sync share the next one.
+  writeAheadLog_->commit(record);
+}
+
+void GlobalFileMgr::flushWriteAheadLog() {
+  CHECK(writeAheadLog_);
+  heavyai::unique_lock<heavyai::shared_mutex> write_lock(writeAheadLogMutex_);
+  if (writeAheadLog_->empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(loggedFileMgrsMutex_);
+  for (auto file_mgr : loggedFileMgrs_) {
+    file_mgr->flushLoggedCheckpoints();
+  }
+  loggedFileMgrs_.clear();
+  writeAheadLog_->reset();
+}
+
+void GlobalFileMgr::unregisterFromWriteAheadLog(FileMgr* file_mgr) {
+  std::lock_guard<std::mutex> lock(loggedFileMgrsMutex_);
+  loggedFileMgrs_.erase(file_mgr);
 }
 
 void GlobalFileMgr::checkpoint() {
@@ -110,6 +257,26 @@ void GlobalFileMgr::deleteBuffersWithPrefix(const ChunkKey& keyPrefix, const boo
   }
 }
 
+void GlobalFileMgr::fetchBuffers(const std::vector<ChunkKey>& keys,
+                                 const std::vector<AbstractBuffer*>& destBuffers,
+                                 const std::vector<size_t>& numBytes) {
+  std::map<AbstractBufferMgr*, std::vector<size_t>> key_indices_by_file_mgr;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    key_indices_by_file_mgr[getFileMgr(keys[i])].emplace_back(i);
+  }
+  for (const auto& [file_mgr, key_indices] : key_indices_by_file_mgr) {
+    std::vector<ChunkKey> file_mgr_keys;
+    std::vector<AbstractBuffer*> file_mgr_dest_buffers;
+    std::vector<size_t> file_mgr_num_bytes;
+    for (const auto i : key_indices) {
+      file_mgr_keys.emplace_back(keys[i]);
+      file_mgr_dest_buffers.emplace_back(destBuffers[i]);
+      file_mgr_num_bytes.emplace_back(numBytes[i]);
+    }
+    file_mgr->fetchBuffers(file_mgr_keys, file_mgr_dest_buffers, file_mgr_num_bytes);
+  }
+}
+
 AbstractBufferMgr* GlobalFileMgr::findFileMgrUnlocked(const int32_t db_id,
                                                       const int32_t tb_id) {
   // NOTE: only call this private function after locking is already in place
@@ -134,6 +301,9 @@ void GlobalFileMgr::deleteFileMgr(const int32_t db_id, const int32_t tb_id) {
 
 void GlobalFileMgr::closeFileMgr(const int32_t db_id, const int32_t tb_id) {
   heavyai::unique_lock<heavyai::shared_mutex> write_lock(fileMgrs_mutex_);
+  if (auto it = ownedFileMgrs_.find({db_id, tb_id}); it != ownedFileMgrs_.end()) {
+    it->second->writePageMapSnapshotOnClose();
+  }
   deleteFileMgr(db_id, tb_id);
 }
 
@@ -170,6 +340,7 @@ void GlobalFileMgr::setFileMgrParams(const int32_t db_id,
       max_rollback_epochs,
       num_reader_threads_,
       file_mgr_params.epoch != -1 ? file_mgr_params.epoch : epoch_);
+  s->setStorageCompression(file_mgr_params.storage_compression);
   CHECK(ownedFileMgrs_.insert(std::make_pair(file_mgr_key, s)).second);
   CHECK(allFileMgrs_.insert(std::make_pair(file_mgr_key, s.get())).second);
   max_rollback_epochs_per_table_[file_mgr_key] = max_rollback_epochs;
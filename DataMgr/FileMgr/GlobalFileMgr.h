@@ -25,15 +25,22 @@
 #ifndef DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 #define DATAMGR_MEMORY_FILE_GLOBAL_FILEMGR_H
 
+#include <condition_variable>
 #include <iostream>
 #include <map>
 #include <mutex>
 #include <set>
+#include <thread>
 #include "../Shared/heavyai_shared_mutex.h"
 
 #include "../AbstractBuffer.h"
 #include "../AbstractBufferMgr.h"
 #include "FileMgr.h"
+#include "WriteAheadLog.h"
+
+extern bool g_enable_background_compaction;
+extern size_t g_background_compaction_pages_per_pass;
+extern size_t g_background_compaction_max_bytes_per_sec;
 
 class ForeignStorageInterface;
 
@@ -45,6 +52,7 @@ struct FileMgrParams {
   FileMgrParams() : epoch(-1), max_rollback_epochs(-1) {}
   int32_t epoch;
   int32_t max_rollback_epochs;
+  std::string storage_compression;  // blosc compressor for data pages, empty if none
 };
 
 /**
@@ -62,7 +70,7 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
                 const size_t page_size = DEFAULT_PAGE_SIZE,
                 const size_t metadata_page_size = DEFAULT_METADATA_PAGE_SIZE);
 
-  ~GlobalFileMgr() override {}
+  ~GlobalFileMgr() override;
 
   /// Creates a chunk with the specified key and page size.
   AbstractBuffer* createBuffer(const ChunkKey& key,
@@ -97,6 +105,11 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
     return getFileMgr(key)->fetchBuffer(key, destBuffer, numBytes);
   }
 
+  /// Fetches the chunks of each table with a single batch from the table's FileMgr.
+  void fetchBuffers(const std::vector<ChunkKey>& keys,
+                    const std::vector<AbstractBuffer*>& destBuffers,
+                    const std::vector<size_t>& numBytes) override;
+
   /**
    * @brief Puts the contents of d into the Chunk with the given key.
    * @param key - Unique identifier for a Chunk.
@@ -150,9 +163,45 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
 
   void compactDataFiles(const int32_t db_id, const int32_t tb_id);
 
+  /**
+   * @brief True if table checkpoints are made durable through the write ahead log shared
+   * by all tables, see g_enable_write_ahead_log.
+   */
+  bool hasWriteAheadLog() const { return writeAheadLog_ != nullptr; }
+
+  /**
+   * @brief Returns a lock that keeps the write ahead log from being flushed. Held while
+   * a checkpoint record is built and committed.
+   */
+  heavyai::shared_lock<heavyai::shared_mutex> getWriteAheadLogCommitLock();
+
+  /// Returns the number of record bytes in the write ahead log.
+  size_t getWriteAheadLogSize() const;
+
+  /**
+   * @brief Appends a checkpoint record of the given FileMgr to the write ahead log and
+   * returns once it is durable. Assumes the commit lock is held.
+   */
+  void commitToWriteAheadLog(FileMgr* file_mgr, const std::vector<int8_t>& record);
+
+  /**
+   * @brief Flushes the logged checkpoints of all tables to their data files and epoch
+   * files, and empties the write ahead log.
+   */
+  void flushWriteAheadLog();
+
+  /// Called when a FileMgr is closed, after which it is no longer flushed by the log.
+  void unregisterFromWriteAheadLog(FileMgr* file_mgr);
+
+  // For testing purposes only
+  WriteAheadLog* getWriteAheadLog() { return writeAheadLog_.get(); }
+
  private:
   AbstractBufferMgr* findFileMgrUnlocked(const int32_t db_id, const int32_t tb_id);
   void deleteFileMgr(const int32_t db_id, const int32_t tb_id);
+  void backgroundCompactionLoop();
+  size_t compactNextFileMgr();
+  void openWriteAheadLog();
 
  public:
   AbstractBufferMgr* findFileMgr(const int32_t db_id, const int32_t tb_id) {
@@ -218,12 +267,27 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
   bool dbConvert_;  /// true if conversion should be done between different
                     /// "omnisci_db_version_"
 
+  // Declared before the FileMgrs, which unregister from the log when destroyed.
+  std::unique_ptr<WriteAheadLog> writeAheadLog_;
+  // Held shared by committers and exclusively while the log is flushed.
+  heavyai::shared_mutex writeAheadLogMutex_;
+  // FileMgrs with records in the log since it was last emptied.
+  std::set<FileMgr*> loggedFileMgrs_;
+  std::mutex loggedFileMgrsMutex_;
+
   std::map<TablePair, std::shared_ptr<FileMgr>> ownedFileMgrs_;
   std::map<TablePair, AbstractBufferMgr*> allFileMgrs_;
   std::map<TablePair, int32_t> max_rollback_epochs_per_table_;
   std::map<TablePair, StorageStats> lazy_initialized_stats_;
 
   heavyai::shared_mutex fileMgrs_mutex_;
+
+  // Background data file compaction, see g_enable_background_compaction.
+  std::thread compaction_thread_;
+  std::mutex compaction_mutex_;
+  std::condition_variable compaction_cv_;
+  bool stop_compaction_{false};
+  std::pair<int32_t, int32_t> next_compaction_table_{0, 0};
 };
 
 }  // namespace File_Namespace
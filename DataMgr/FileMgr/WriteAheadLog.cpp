@@ -0,0 +1,180 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/FileMgr/WriteAheadLog.h"
+
+#include <cstring>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Logger/Logger.h"
+#include "OSDependent/heavyai_fs.h"
+#include "Shared/File.h"
+
+namespace File_Namespace {
+
+namespace {
+uint32_t record_checksum(const int8_t* data, const size_t size) {
+  boost::crc_32_type crc;
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+}  // namespace
+
+/*
+ * Log layout: magic and version, followed by records. Each record is the
+ * payload size, the payload and a CRC-32 of the payload, so a record torn by a crash is
+ * detected and ends the log.
+ */
+size_t WriteAheadLog::headerSize() {
+  return 2 * sizeof(uint32_t);
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& path) : path_(path) {
+  if (boost::filesystem::exists(path_)) {
+    file_ = open(path_);
+  } else {
+    file_ = create(path_, headerSize());
+  }
+  end_offset_ = fileSize(file_);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+  close(file_);
+}
+
+std::vector<std::vector<int8_t>> WriteAheadLog::readCommittedRecords() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::vector<int8_t>> records;
+  const size_t file_size = fileSize(file_);
+  if (file_size < headerSize()) {
+    return records;
+  }
+  std::vector<int8_t> header(headerSize());
+  read(file_, 0, header.size(), header.data());
+  uint32_t magic, version;
+  std::memcpy(&magic, header.data(), sizeof(uint32_t));
+  std::memcpy(&version, header.data() + sizeof(uint32_t), sizeof(uint32_t));
+  if (magic != kMagic || version != kVersion) {
+    // A log that was just created has no header yet.
+    LOG_IF(WARNING, magic == kMagic)
+        << "Ignoring write ahead log " << path_ << " of unknown version " << version;
+    return records;
+  }
+  size_t offset = headerSize();
+  while (offset + sizeof(uint64_t) + sizeof(uint32_t) <= file_size) {
+    uint64_t record_size;
+    read(file_, offset, sizeof(uint64_t), reinterpret_cast<int8_t*>(&record_size));
+    if (record_size > file_size - offset - sizeof(uint64_t) - sizeof(uint32_t)) {
+      break;
+    }
+    std::vector<int8_t> record(record_size);
+    read(file_, offset + sizeof(uint64_t), record_size, record.data());
+    uint32_t checksum;
+    read(file_,
+         offset + sizeof(uint64_t) + record_size,
+         sizeof(uint32_t),
+         reinterpret_cast<int8_t*>(&checksum));
+    if (checksum != record_checksum(record.data(), record.size())) {
+      break;
+    }
+    records.emplace_back(std::move(record));
+    offset += sizeof(uint64_t) + record_size + sizeof(uint32_t);
+  }
+  if (offset < file_size) {
+    LOG(WARNING) << "Ignoring " << file_size - offset
+                 << " bytes of incomplete records at the end of " << path_;
+  }
+  return records;
+}
+
+void WriteAheadLog::commit(const std::vector<int8_t>& record) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const uint64_t record_size = record.size();
+  const uint32_t checksum = record_checksum(record.data(), record.size());
+  size_t offset = end_offset_;
+  offset += write(
+      file_, offset, sizeof(uint64_t), reinterpret_cast<const int8_t*>(&record_size));
+  offset += write(file_, offset, record.size(), record.data());
+  offset += write(
+      file_, offset, sizeof(uint32_t), reinterpret_cast<const int8_t*>(&checksum));
+  appended_bytes_ += offset - end_offset_;
+  end_offset_ = offset;
+  num_records_++;
+
+  // The first committer to find no sync in progress syncs everything appended so far,
+  // including the records of committers that arrive while it waits on the disk.
+  const size_t record_end = appended_bytes_;
+  while (synced_bytes_ < record_end) {
+    if (sync_in_progress_) {
+      sync_cv_.wait(lock);
+      continue;
+    }
+    sync_in_progress_ = true;
+    const size_t sync_end = appended_bytes_;
+    CHECK_EQ(fflush(file_), 0) << "Could not flush write ahead log " << path_;
+    lock.unlock();
+    if (before_sync_hook_) {
+      before_sync_hook_();
+    }
+    const auto status = heavyai::fsync(fileno(file_));
+    lock.lock();
+    sync_in_progress_ = false;
+    CHECK_EQ(status, 0) << "Could not sync write ahead log " << path_;
+    synced_bytes_ = sync_end;
+    num_syncs_++;
+    sync_cv_.notify_all();
+  }
+}
+
+void WriteAheadLog::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(!sync_in_progress_);
+  CHECK_EQ(fflush(file_), 0);
+  boost::filesystem::resize_file(path_, headerSize());
+  std::vector<int8_t> header(headerSize());
+  std::memcpy(header.data(), &kMagic, sizeof(uint32_t));
+  std::memcpy(header.data() + sizeof(uint32_t), &kVersion, sizeof(uint32_t));
+  write(file_, 0, header.size(), header.data());
+  syncToDisk();
+  end_offset_ = headerSize();
+  synced_bytes_ = appended_bytes_;
+  num_records_ = 0;
+}
+
+size_t WriteAheadLog::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return end_offset_ - headerSize();
+}
+
+size_t WriteAheadLog::getNumRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_records_;
+}
+
+size_t WriteAheadLog::getNumSyncs() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_syncs_;
+}
+
+void WriteAheadLog::syncToDisk() {
+  CHECK_EQ(fflush(file_), 0) << "Could not flush write ahead log " << path_;
+  CHECK_EQ(heavyai::fsync(fileno(file_)), 0)
+      << "Could not sync write ahead log " << path_;
+}
+
+}  // namespace File_Namespace
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    WriteAheadLog.h
+ * @brief   Append-only, group committed redo log shared by the FileMgr checkpoints of all
+ *          tables.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace File_Namespace {
+
+/**
+ * @class   WriteAheadLog
+ * @brief   Sequential log of checkpoint records.
+ *
+ * A record is durable once commit() returns. Commits that arrive while another commit
+ * is syncing the log are made durable together by the next sync, so concurrent
+ * committers share a single fsync (group commit).
+ *
+ * The log does not interpret records; GlobalFileMgr tags them with the table they
+ * belong to.
+ */
+class WriteAheadLog {
+ public:
+  /// Opens the log at the given path, creating an empty log if there is none.
+  WriteAheadLog(const std::string& path);
+
+  ~WriteAheadLog();
+
+  /// Returns the records committed since the last reset, up to the first incomplete or
+  /// corrupt record.
+  std::vector<std::vector<int8_t>> readCommittedRecords();
+
+  /// Appends the record to the log and returns once it is durable.
+  void commit(const std::vector<int8_t>& record);
+
+  /// Discards all records.
+  void reset();
+
+  /// Returns the number of record bytes committed since the last reset.
+  size_t size() const;
+
+  bool empty() const { return size() == 0; }
+
+  /// Returns the number of records appended since the last reset.
+  size_t getNumRecords() const;
+
+  /// Returns the number of times records were synced to disk.
+  size_t getNumSyncs() const;
+
+  // For testing purposes only: called by the committer that syncs the log, right
+  // before the sync and without holding the log's lock.
+  void setBeforeSyncHook(std::function<void()> hook) { before_sync_hook_ = hook; }
+
+  static constexpr uint32_t kMagic{0x4C415748};  // "HWAL"
+  static constexpr uint32_t kVersion{2};
+
+ private:
+  static size_t headerSize();
+
+  void syncToDisk();
+
+  std::string path_;
+  FILE* file_;
+  size_t end_offset_;
+  std::function<void()> before_sync_hook_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable sync_cv_;
+  // Total bytes ever appended and synced; a record is durable once synced_bytes_ has
+  // reached the value of appended_bytes_ right after it was appended.
+  size_t appended_bytes_{0};
+  size_t synced_bytes_{0};
+  size_t num_records_{0};
+  size_t num_syncs_{0};
+  bool sync_in_progress_{false};
+};
+
+}  // namespace File_Namespace
@@ -95,6 +95,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -106,6 +107,7 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -149,6 +151,11 @@ class FixedLengthEncoder : public Encoder {
                             std::max(lhs_max, rhs_max),
                             lhs_nulls || rhs_nulls);
         });
+    if (keeps_bloom_filter_ || keeps_zone_map_) {
+      for (size_t i = 0; i < num_elements; ++i) {
+        updateSkippingIndexes(data[i], data[i] == std::numeric_limits<V>::min());
+      }
+    }
   }
 
   void updateStats(const std::vector<std::string>* const src_data,
@@ -171,6 +178,7 @@ class FixedLengthEncoder : public Encoder {
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceSkippingIndexes(that);
   }
 
   void copyMetadata(const Encoder* copyFromEncoder) override {
@@ -180,6 +188,7 @@ class FixedLengthEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copySkippingIndexes(*copyFromEncoder);
   }
 
   void writeMetadata(FILE* f) override {
@@ -216,6 +225,7 @@ class FixedLengthEncoder : public Encoder {
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
+    resetSkippingIndexes();
   }
 
   T dataMin;
@@ -271,6 +281,10 @@ class FixedLengthEncoder : public Encoder {
       buffer_->write(reinterpret_cast<int8_t*>(data_to_write),
                      num_elems_to_append * sizeof(V),
                      static_cast<size_t>(offset));
+      if (offset > 0) {
+        // The rows before the offset may not have been added to the skipping indexes.
+        resetSkippingIndexes();
+      }
     }
     auto chunk_metadata = std::make_shared<ChunkMetadata>();
     getMetadata(chunk_metadata);
@@ -278,12 +292,14 @@ class FixedLengthEncoder : public Encoder {
   }
 
   void updateStatsWithAlreadyEncoded(const V& encoded_data) {
-    if (encoded_data == std::numeric_limits<V>::min()) {
+    const bool is_null = encoded_data == std::numeric_limits<V>::min();
+    if (is_null) {
       has_nulls = true;
     } else {
       dataMin = std::min<T>(dataMin, encoded_data);
       dataMax = std::max<T>(dataMax, encoded_data);
     }
+    updateSkippingIndexes(encoded_data, is_null);
   }
 
   V encodeDataAndUpdateStats(const T& unencoded_data) {
@@ -303,6 +319,8 @@ class FixedLengthEncoder : public Encoder {
         dataMax = std::max(dataMax, data);
       }
     }
+    // The stored value, even when it overflowed.
+    updateSkippingIndexes(encoded_data, encoded_data == std::numeric_limits<V>::min());
     return encoded_data;
   }
 };  // FixedLengthEncoder
@@ -1216,7 +1216,10 @@ SQLTypeInfo suggest_floating_point_mapping(
 
 bool validate_integral_mapping(const ColumnDescriptor* omnisci_column,
                                const parquet::ColumnDescriptor* parquet_column) {
-  if (!omnisci_column->columnType.is_integer()) {
+  // Block encoded chunks, bit packed FIXED(n) included, are only written by their
+  // encoders.
+  if (!omnisci_column->columnType.is_integer() ||
+      omnisci_column->columnType.is_block_encoded()) {
     return false;
   }
   if (auto int_logical_column = dynamic_cast<const parquet::IntLogicalType*>(
@@ -1439,6 +1442,7 @@ bool validate_string_mapping(const ColumnDescriptor* omnisci_column,
                              const parquet::ColumnDescriptor* parquet_column) {
   return is_valid_parquet_string(parquet_column) &&
          omnisci_column->columnType.is_string() &&
+         !omnisci_column->columnType.is_fsst_string() &&
          (omnisci_column->columnType.get_compression() == kENCODING_NONE ||
           omnisci_column->columnType.get_compression() == kENCODING_DICT);
 }
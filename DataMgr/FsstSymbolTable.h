@@ -0,0 +1,195 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FSST_SYMBOL_TABLE_H
+#define FSST_SYMBOL_TABLE_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Shared/FsstEncoding.h"
+
+namespace fsst_encoding {
+
+// Bytes of the strings a symbol table is built from.
+constexpr size_t kSampleBytes{16384};
+constexpr int32_t kTrainingRounds{5};
+
+/**
+ * @class SymbolTable
+ * @brief Builds the symbol table of a chunk and compresses strings with it.
+ *
+ * The symbols are chosen over a few rounds: the sample is compressed with the symbols
+ * of the previous round, and the symbols and pairs of consecutive symbols saving the
+ * most bytes become the symbols of the next one. See Shared/FsstEncoding.h for the
+ * layout of the table in the chunk.
+ */
+class SymbolTable {
+ public:
+  // Loads the table at the start of a chunk data buffer.
+  explicit SymbolTable(const int8_t* table) {
+    const auto count = num_symbols(table);
+    CHECK_LE(count, kMaxSymbols);
+    for (int64_t code = 0; code < count; ++code) {
+      symbols_.emplace_back(symbol(table, code), symbol_length(table, code));
+    }
+    index();
+  }
+
+  // Builds the table from the first kSampleBytes bytes of the strings.
+  template <typename Iterator>
+  static SymbolTable build(Iterator first, const Iterator last) {
+    std::vector<std::string_view> sample;
+    size_t sample_bytes = 0;
+    for (; first != last && sample_bytes < kSampleBytes; ++first) {
+      sample.emplace_back(first->data(), first->size());
+      sample_bytes += first->size();
+    }
+    SymbolTable table;
+    for (int32_t round = 0; round < kTrainingRounds; ++round) {
+      table = table.nextRound(sample);
+    }
+    return table;
+  }
+
+  void serialize(int8_t* table) const {
+    std::memset(table, 0, kTableBytes);
+    reinterpret_cast<int64_t*>(table)[0] = symbols_.size();
+    for (size_t code = 0; code < symbols_.size(); ++code) {
+      reinterpret_cast<uint64_t*>(table + kSymbolsOffset)[code] = symbols_[code].first;
+      reinterpret_cast<uint8_t*>(table + kLengthsOffset)[code] = symbols_[code].second;
+    }
+  }
+
+  // Appends the codes of str to out, using the longest symbol matching at each position
+  // and escaping the bytes no symbol starts with.
+  void compress(const std::string_view str, std::string& out) const {
+    size_t pos = 0;
+    while (pos < str.size()) {
+      const auto code = longestMatch(str, pos);
+      if (code < 0) {
+        out.push_back(static_cast<char>(kEscapeCode));
+        out.push_back(str[pos++]);
+      } else {
+        out.push_back(static_cast<char>(code));
+        pos += symbols_[code].second;
+      }
+    }
+  }
+
+  std::string compress(const std::string_view str) const {
+    std::string out;
+    out.reserve(str.size());
+    compress(str, out);
+    return out;
+  }
+
+  size_t size() const { return symbols_.size(); }
+
+ private:
+  // Symbol bytes from the low end and length.
+  using Symbol = std::pair<uint64_t, int32_t>;
+
+  SymbolTable() = default;
+
+  // Codes of the symbols starting with each byte, longest first.
+  void index() {
+    for (auto& codes : codes_by_first_byte_) {
+      codes.clear();
+    }
+    for (size_t code = 0; code < symbols_.size(); ++code) {
+      codes_by_first_byte_[symbols_[code].first & 0xff].push_back(code);
+    }
+    for (auto& codes : codes_by_first_byte_) {
+      std::stable_sort(
+          codes.begin(), codes.end(), [this](const auto lhs, const auto rhs) {
+            return symbols_[lhs].second > symbols_[rhs].second;
+          });
+    }
+  }
+
+  int32_t longestMatch(const std::string_view str, const size_t pos) const {
+    uint64_t bytes = 0;
+    const auto available =
+        std::min(str.size() - pos, static_cast<size_t>(kMaxSymbolLength));
+    std::memcpy(&bytes, str.data() + pos, available);
+    for (const auto code : codes_by_first_byte_[static_cast<uint8_t>(str[pos])]) {
+      const auto& [symbol_bytes, length] = symbols_[code];
+      if (static_cast<size_t>(length) > available) {
+        continue;
+      }
+      const auto mask = length == kMaxSymbolLength ? ~uint64_t(0)
+                                                   : (uint64_t(1) << (8 * length)) - 1;
+      if ((bytes & mask) == symbol_bytes) {
+        return code;
+      }
+    }
+    return -1;
+  }
+
+  // Compresses the sample with this table and keeps the symbols, single bytes and pairs
+  // of consecutive ones saving the most bytes.
+  SymbolTable nextRound(const std::vector<std::string_view>& sample) const {
+    std::map<Symbol, int64_t> gains;
+    for (const auto str : sample) {
+      Symbol previous{0, 0};
+      size_t pos = 0;
+      while (pos < str.size()) {
+        const auto code = longestMatch(str, pos);
+        const auto current = code < 0 ? Symbol{static_cast<uint8_t>(str[pos]), 1}
+                                      : symbols_[code];
+        gains[current] += current.second;
+        if (previous.second && previous.second + current.second <= kMaxSymbolLength) {
+          const Symbol pair{previous.first | (current.first << (8 * previous.second)),
+                            previous.second + current.second};
+          gains[pair] += pair.second;
+        }
+        previous = current;
+        pos += current.second;
+      }
+    }
+    std::vector<std::pair<int64_t, Symbol>> candidates;
+    for (const auto& [candidate, gain] : gains) {
+      candidates.emplace_back(gain, candidate);
+    }
+    const auto num_kept = std::min(candidates.size(), static_cast<size_t>(kMaxSymbols));
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + num_kept,
+                      candidates.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs > rhs; });
+    SymbolTable table;
+    for (size_t i = 0; i < num_kept; ++i) {
+      table.symbols_.push_back(candidates[i].second);
+    }
+    table.index();
+    return table;
+  }
+
+  std::vector<Symbol> symbols_;
+  std::array<std::vector<int32_t>, 256> codes_by_first_byte_;
+};
+
+}  // namespace fsst_encoding
+
+#endif  // FSST_SYMBOL_TABLE_H
@@ -98,6 +98,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -109,6 +110,7 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    resetSkippingIndexes();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -149,6 +151,13 @@ class NoneEncoder : public Encoder {
                             std::max(lhs_max, rhs_max),
                             lhs_nulls || rhs_nulls);
         });
+    if constexpr (std::is_integral<T>::value) {
+      if (keeps_bloom_filter_ || keeps_zone_map_) {
+        for (size_t i = 0; i < num_elements; ++i) {
+          updateSkippingIndexes(data[i], data[i] == none_encoded_null_value<T>());
+        }
+      }
+    }
   }
 
   void updateStats(const std::vector<std::string>* const src_data,
@@ -171,6 +180,7 @@ class NoneEncoder : public Encoder {
     }
     dataMin = std::min(dataMin, that_typed.dataMin);
     dataMax = std::max(dataMax, that_typed.dataMax);
+    reduceSkippingIndexes(that);
   }
 
   void writeMetadata(FILE* f) override {
@@ -209,12 +219,14 @@ class NoneEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    copySkippingIndexes(*copyFromEncoder);
   }
 
   void resetChunkStats() override {
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
+    resetSkippingIndexes();
   }
 
   T dataMin;
@@ -238,6 +250,11 @@ class NoneEncoder : public Encoder {
         encoded_data.resize(num_elems_to_append);
         T data = validateDataAndUpdateStats(unencodedData[0]);
         std::fill(encoded_data.begin(), encoded_data.end(), data);
+        if constexpr (std::is_integral<T>::value) {
+          // The first row was recorded with the stats.
+          updateSkippingIndexes(
+              data, data == none_encoded_null_value<T>(), num_elems_to_append - 1);
+        }
       }
     } else {
       updateStats(src_data, num_elems_to_append, is_validated_data);
@@ -258,6 +275,10 @@ class NoneEncoder : public Encoder {
       CHECK_GE(offset, 0);
       buffer_->write(
           src_data, num_elems_to_append * sizeof(T), static_cast<size_t>(offset));
+      if (offset > 0) {
+        // The rows before the offset may not have been added to the skipping indexes.
+        resetSkippingIndexes();
+      }
     }
     auto chunk_metadata = std::make_shared<ChunkMetadata>();
     getMetadata(chunk_metadata);
@@ -268,12 +289,18 @@ class NoneEncoder : public Encoder {
                                const bool is_validated_data = false) {
     if (unencoded_data == none_encoded_null_value<T>()) {
       has_nulls = true;
+      if constexpr (std::is_integral<T>::value) {
+        updateSkippingIndexes(0, true);
+      }
     } else {
       if (!is_validated_data) {  // does not need validation
         decimal_overflow_validator_.validate(unencoded_data);
       }
       dataMin = std::min(dataMin, unencoded_data);
       dataMax = std::max(dataMax, unencoded_data);
+      if constexpr (std::is_integral<T>::value) {
+        updateSkippingIndexes(unencoded_data, false);
+      }
     }
     return unencoded_data;
   }
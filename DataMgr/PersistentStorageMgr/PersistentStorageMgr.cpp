@@ -81,6 +81,28 @@ void PersistentStorageMgr::fetchBuffer(const ChunkKey& chunk_key,
       chunk_key, destination_buffer, num_bytes);
 }
 
+void PersistentStorageMgr::fetchBuffers(
+    const std::vector<ChunkKey>& chunk_keys,
+    const std::vector<AbstractBuffer*>& destination_buffers,
+    const std::vector<size_t>& num_bytes) {
+  std::map<AbstractBufferMgr*, std::vector<size_t>> key_indices_by_storage_mgr;
+  for (size_t i = 0; i < chunk_keys.size(); ++i) {
+    key_indices_by_storage_mgr[getStorageMgrForTableKey(chunk_keys[i])].emplace_back(i);
+  }
+  for (const auto& [storage_mgr, key_indices] : key_indices_by_storage_mgr) {
+    std::vector<ChunkKey> storage_mgr_keys;
+    std::vector<AbstractBuffer*> storage_mgr_destination_buffers;
+    std::vector<size_t> storage_mgr_num_bytes;
+    for (const auto i : key_indices) {
+      storage_mgr_keys.emplace_back(chunk_keys[i]);
+      storage_mgr_destination_buffers.emplace_back(destination_buffers[i]);
+      storage_mgr_num_bytes.emplace_back(num_bytes[i]);
+    }
+    storage_mgr->fetchBuffers(
+        storage_mgr_keys, storage_mgr_destination_buffers, storage_mgr_num_bytes);
+  }
+}
+
 AbstractBuffer* PersistentStorageMgr::putBuffer(const ChunkKey& chunk_key,
                                                 AbstractBuffer* source_buffer,
                                                 const size_t num_bytes) {
@@ -39,6 +39,9 @@ class PersistentStorageMgr : public AbstractBufferMgr {
   void fetchBuffer(const ChunkKey& chunk_key,
                    AbstractBuffer* destination_buffer,
                    const size_t num_bytes) override;
+  void fetchBuffers(const std::vector<ChunkKey>& chunk_keys,
+                    const std::vector<AbstractBuffer*>& destination_buffers,
+                    const std::vector<size_t>& num_bytes) override;
   AbstractBuffer* putBuffer(const ChunkKey& chunk_key,
                             AbstractBuffer* source_buffer,
                             const size_t num_bytes) override;
@@ -0,0 +1,427 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUN_LENGTH_ENCODER_H
+#define RUN_LENGTH_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+
+#include <Shared/DatumFetchers.h>
+#include "Shared/Iteration.h"
+#include "Shared/RunLengthEncoding.h"
+
+namespace run_length_encoding {
+
+template <typename E>
+struct Run {
+  E end;
+  E value;
+};
+
+inline size_t byte_size(const int8_t* byte_stream, const int32_t value_width) {
+  return kHeaderBytes + num_runs(byte_stream) * entry_bytes(value_width);
+}
+
+// Writes the values of rows [start_row, start_row + num_rows) to dst.
+template <typename T>
+void decode_rows(const int8_t* byte_stream,
+                 const size_t start_row,
+                 const size_t num_rows,
+                 T* dst) {
+  if (!num_rows) {
+    return;
+  }
+  constexpr int32_t value_width = sizeof(T);
+  auto run = find_run(byte_stream, value_width, start_row);
+  auto row = start_row;
+  const auto end_row = start_row + num_rows;
+  while (row < end_row) {
+    const auto run_end_row =
+        std::min<size_t>(run_end(byte_stream, value_width, run), end_row);
+    const auto value = static_cast<T>(run_value(byte_stream, value_width, run));
+    std::fill(dst + (row - start_row), dst + (run_end_row - start_row), value);
+    row = run_end_row;
+    ++run;
+  }
+}
+
+// Writes the values of the first num_rows rows to dst, value_width bytes each.
+inline void expand(const int8_t* byte_stream,
+                   const int32_t value_width,
+                   const size_t num_rows,
+                   int8_t* dst) {
+  switch (value_width) {
+    case 1:
+      decode_rows(byte_stream, 0, num_rows, dst);
+      break;
+    case 2:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int16_t*>(dst));
+      break;
+    case 4:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int32_t*>(dst));
+      break;
+    case 8:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int64_t*>(dst));
+      break;
+    default:
+      UNREACHABLE() << "Unexpected run length encoded value width " << value_width;
+  }
+}
+
+template <typename E>
+size_t remove_rows_impl(int8_t* byte_stream, const std::vector<uint64_t>& rows) {
+  auto runs = reinterpret_cast<Run<E>*>(byte_stream + kHeaderBytes);
+  const auto runs_in = num_runs(byte_stream);
+  int64_t runs_out = 0;
+  size_t removed = 0;
+  auto row_it = rows.begin();
+  for (int64_t i = 0; i < runs_in; ++i) {
+    while (row_it != rows.end() && *row_it < static_cast<uint64_t>(runs[i].end)) {
+      ++removed;
+      ++row_it;
+    }
+    const auto end = static_cast<E>(runs[i].end - removed);
+    if (end == (runs_out ? runs[runs_out - 1].end : 0)) {
+      continue;  // all the rows of the run are gone
+    }
+    if (runs_out && runs[i].value == runs[runs_out - 1].value) {
+      runs[runs_out - 1].end = end;
+      continue;
+    }
+    runs[runs_out] = {end, runs[i].value};
+    ++runs_out;
+  }
+  *reinterpret_cast<int64_t*>(byte_stream) = runs_out;
+  return kHeaderBytes + runs_out * sizeof(Run<E>);
+}
+
+// Removes the given rows, sorted in ascending order, from the buffer in place and returns
+// its new size in bytes.
+inline size_t remove_rows(int8_t* byte_stream,
+                          const int32_t value_width,
+                          const std::vector<uint64_t>& rows) {
+  return value_width > 4 ? remove_rows_impl<int64_t>(byte_stream, rows)
+                         : remove_rows_impl<int32_t>(byte_stream, rows);
+}
+
+// Concatenates buffers holding consecutive row ranges into dst, which must have room for
+// the runs of all of them. Returns the number of bytes written.
+inline size_t concatenate(const std::vector<const int8_t*>& byte_streams,
+                          const int32_t value_width,
+                          int8_t* dst) {
+  const auto entry_size = entry_bytes(value_width);
+  int64_t total_runs = 0;
+  int64_t row_offset = 0;
+  auto dst_entry = dst + kHeaderBytes;
+  for (const auto byte_stream : byte_streams) {
+    const auto runs = num_runs(byte_stream);
+    for (int64_t i = 0; i < runs; ++i, dst_entry += entry_size) {
+      const auto end = row_offset + run_end(byte_stream, value_width, i);
+      const auto value = run_value(byte_stream, value_width, i);
+      if (value_width > 4) {
+        *reinterpret_cast<Run<int64_t>*>(dst_entry) = {end, value};
+      } else {
+        *reinterpret_cast<Run<int32_t>*>(dst_entry) = {static_cast<int32_t>(end),
+                                                       static_cast<int32_t>(value)};
+      }
+    }
+    if (runs) {
+      row_offset += run_end(byte_stream, value_width, runs - 1);
+    }
+    total_runs += runs;
+  }
+  *reinterpret_cast<int64_t*>(dst) = total_runs;
+  return kHeaderBytes + total_runs * entry_size;
+}
+
+}  // namespace run_length_encoding
+
+/**
+ * @class RunLengthEncoder
+ * @brief Stores a fixed width column as runs of repeated values.
+ *
+ * T is the logical storage type of the column. Appends extend the last run of the chunk
+ * when they start with its value, so the chunk stays as compact as if it had been
+ * encoded in one go. See Shared/RunLengthEncoding.h for the buffer layout.
+ */
+template <typename T>
+class RunLengthEncoder : public Encoder {
+  using RunType =
+      run_length_encoding::Run<std::conditional_t<(sizeof(T) > 4), int64_t, int32_t>>;
+
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
+    resetChunkStats();
+  }
+
+  size_t getNumElemsForBytesEncodedDataAtIndices(const int8_t* index_data,
+                                                 const std::vector<size_t>& selected_idx,
+                                                 const size_t byte_limit) override {
+    UNREACHABLE()
+        << "getNumElemsForBytesEncodedDataAtIndices unexpectedly called for non varlen"
+           " encoder";
+    return {};
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedDataAtIndices(
+      const int8_t*,
+      int8_t* data,
+      const std::vector<size_t>& selected_idx) override {
+    std::shared_ptr<ChunkMetadata> chunk_metadata;
+    shared::execute_over_contiguous_indices(
+        selected_idx, [&](const size_t start_pos, const size_t end_pos) {
+          chunk_metadata = appendEncodedData(
+              nullptr, data, selected_idx[start_pos], end_pos - start_pos);
+        });
+    return chunk_metadata;
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedData(const int8_t*,
+                                                   int8_t* data,
+                                                   const size_t start_idx,
+                                                   const size_t num_elements) override {
+    std::vector<T> decoded_data(num_elements);
+    run_length_encoding::decode_rows(data, start_idx, num_elements, decoded_data.data());
+    auto decoded_ptr = reinterpret_cast<int8_t*>(decoded_data.data());
+    return appendData(decoded_ptr, num_elements, SQLTypeInfo{});
+  }
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= num_elems_) {
+      // we're rewriting entire buffer so fully recompute metadata
+      resetChunkStats();
+      num_elems_ = 0;
+      buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Run length encoded chunks can only be appended to or rewritten entirely.");
+    }
+
+    const auto unencoded_data = reinterpret_cast<const T*>(src_data);
+    int64_t num_runs{0};
+    std::vector<RunType> runs;
+    if (num_elems_) {
+      CHECK_GE(buffer_->size(), run_length_encoding::kHeaderBytes + sizeof(RunType));
+      buffer_->read(reinterpret_cast<int8_t*>(&num_runs),
+                    run_length_encoding::kHeaderBytes);
+      CHECK_GT(num_runs, 0);
+      runs.emplace_back();
+      buffer_->read(reinterpret_cast<int8_t*>(&runs.back()),
+                    sizeof(RunType),
+                    lastRunOffset(num_runs));
+    }
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      const auto value = unencoded_data[replicating ? 0 : i];
+      updateStatsWithValue(value);
+      const auto end = num_elems_ + i + 1;
+      if (!runs.empty() && runs.back().value == value) {
+        runs.back().end = end;
+      } else {
+        runs.push_back({static_cast<decltype(RunType::end)>(end),
+                        static_cast<decltype(RunType::value)>(value)});
+      }
+    }
+
+    if (!num_elems_) {
+      buffer_->reserve(run_length_encoding::kHeaderBytes + runs.size() * sizeof(RunType));
+      buffer_->append(reinterpret_cast<int8_t*>(&num_runs),
+                      run_length_encoding::kHeaderBytes);
+    }
+    if (!runs.empty()) {
+      size_t first_new_run = 0;
+      if (num_elems_) {
+        // the last run of the chunk may have been extended
+        buffer_->write(reinterpret_cast<int8_t*>(&runs.front()),
+                       sizeof(RunType),
+                       lastRunOffset(num_runs));
+        first_new_run = 1;
+      }
+      const auto append_size = (runs.size() - first_new_run) * sizeof(RunType);
+      if (append_size) {
+        buffer_->reserve(buffer_->size() + append_size);
+        buffer_->append(reinterpret_cast<int8_t*>(runs.data() + first_new_run),
+                        append_size);
+      }
+      num_runs += runs.size() - first_new_run;
+      buffer_->write(reinterpret_cast<int8_t*>(&num_runs),
+                     run_length_encoding::kHeaderBytes);
+    }
+    num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsWithValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    constexpr int32_t value_width = sizeof(T);
+    const auto num_runs = run_length_encoding::num_runs(dst_data);
+    for (int64_t run = 0; run < num_runs; ++run) {
+      updateStatsWithValue(
+          static_cast<T>(run_length_encoding::run_value(dst_data, value_width, run)));
+      if (static_cast<size_t>(
+              run_length_encoding::run_end(dst_data, value_width, run)) >=
+          num_elements) {
+        break;
+      }
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto that_typed = static_cast<const RunLengthEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const RunLengthEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  void resetChunkStats() override {
+    dataMin = std::numeric_limits<T>::max();
+    dataMax = std::numeric_limits<T>::lowest();
+    has_nulls = false;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  static size_t lastRunOffset(const int64_t num_runs) {
+    return run_length_encoding::kHeaderBytes + (num_runs - 1) * sizeof(RunType);
+  }
+
+  void updateStatsWithValue(const T value) {
+    if (value == inline_int_null_value<T>()) {
+      has_nulls = true;
+    } else {
+      decimal_overflow_validator_.validate(value);
+      dataMin = std::min(dataMin, value);
+      dataMax = std::max(dataMax, value);
+    }
+  }
+};  // RunLengthEncoder
+
+#endif  // RUN_LENGTH_ENCODER_H
@@ -0,0 +1,442 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPARSE_ENCODER_H
+#define SPARSE_ENCODER_H
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "AbstractBuffer.h"
+#include "Encoder.h"
+#include "NoneEncoder.h"
+
+#include <Shared/DatumFetchers.h>
+#include "Shared/Iteration.h"
+#include "Shared/SparseEncoding.h"
+
+namespace sparse_encoding {
+
+template <typename E>
+struct Entry {
+  E position;
+  E value;
+};
+
+// Entries of a column whose logical storage type is T.
+template <typename T>
+using EntryType = Entry<std::conditional_t<(sizeof(T) > 4), int64_t, int32_t>>;
+
+template <typename T>
+EntryType<T> make_entry(const int64_t pos, const T value) {
+  EntryType<T> entry{static_cast<decltype(EntryType<T>::position)>(pos), 0};
+  std::memcpy(&entry.value, &value, sizeof(T));
+  return entry;
+}
+
+template <typename T>
+T entry_value(const int8_t* byte_stream, const int64_t idx) {
+  T value;
+  std::memcpy(&value, value_ptr(byte_stream, sizeof(T), idx), sizeof(T));
+  return value;
+}
+
+// Encodes num_rows rows into dst, which must have room for
+// byte_size(<number of non null rows>, sizeof(T)) bytes. Returns that size.
+template <typename T>
+size_t encode(const T* rows, const size_t num_rows, int8_t* dst) {
+  auto entries = reinterpret_cast<EntryType<T>*>(dst + kHeaderBytes);
+  int64_t values_count = 0;
+  for (size_t row = 0; row < num_rows; ++row) {
+    if (rows[row] != none_encoded_null_value<T>()) {
+      entries[values_count++] = make_entry(row, rows[row]);
+    }
+  }
+  auto header = reinterpret_cast<int64_t*>(dst);
+  header[0] = num_rows;
+  header[1] = values_count;
+  return byte_size(values_count, sizeof(T));
+}
+
+// Writes the values of rows [start_row, start_row + num_rows) to dst, nulls included.
+// Null ranges are filled in one go, only the entries of the rows are visited.
+template <typename T>
+void decode_rows(const int8_t* byte_stream,
+                 const size_t start_row,
+                 const size_t num_rows,
+                 T* dst) {
+  std::fill(dst, dst + num_rows, none_encoded_null_value<T>());
+  const auto end_row = static_cast<int64_t>(start_row + num_rows);
+  const auto values = num_values(byte_stream);
+  for (auto idx = find_entry(byte_stream, sizeof(T), start_row); idx < values; ++idx) {
+    const auto pos = position(byte_stream, sizeof(T), idx);
+    if (pos >= end_row) {
+      break;
+    }
+    dst[pos - start_row] = entry_value<T>(byte_stream, idx);
+  }
+}
+
+// Writes the values of the first num_rows rows to dst at the logical width of the type.
+inline void expand(const int8_t* byte_stream,
+                   const SQLTypeInfo& ti,
+                   const size_t num_rows,
+                   int8_t* dst) {
+  if (ti.get_type() == kFLOAT) {
+    decode_rows(byte_stream, 0, num_rows, reinterpret_cast<float*>(dst));
+    return;
+  }
+  if (ti.get_type() == kDOUBLE) {
+    decode_rows(byte_stream, 0, num_rows, reinterpret_cast<double*>(dst));
+    return;
+  }
+  switch (ti.get_size()) {
+    case 1:
+      decode_rows(byte_stream, 0, num_rows, dst);
+      break;
+    case 2:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int16_t*>(dst));
+      break;
+    case 4:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int32_t*>(dst));
+      break;
+    case 8:
+      decode_rows(byte_stream, 0, num_rows, reinterpret_cast<int64_t*>(dst));
+      break;
+    default:
+      UNREACHABLE() << "Unexpected sparse encoded value width " << ti.get_size();
+  }
+}
+
+inline size_t concatenated_byte_size(const std::vector<const int8_t*>& byte_streams,
+                                     const int32_t value_width) {
+  int64_t total_values = 0;
+  for (const auto byte_stream : byte_streams) {
+    total_values += num_values(byte_stream);
+  }
+  return byte_size(total_values, value_width);
+}
+
+template <typename E>
+size_t concatenate_impl(const std::vector<const int8_t*>& byte_streams, int8_t* dst) {
+  auto dst_entries = reinterpret_cast<Entry<E>*>(dst + kHeaderBytes);
+  int64_t total_rows = 0;
+  int64_t total_values = 0;
+  for (const auto byte_stream : byte_streams) {
+    const auto entries = reinterpret_cast<const Entry<E>*>(byte_stream + kHeaderBytes);
+    const auto values = num_values(byte_stream);
+    for (int64_t idx = 0; idx < values; ++idx) {
+      dst_entries[total_values + idx] = {
+          static_cast<E>(total_rows + entries[idx].position), entries[idx].value};
+    }
+    total_rows += num_rows(byte_stream);
+    total_values += values;
+  }
+  auto header = reinterpret_cast<int64_t*>(dst);
+  header[0] = total_rows;
+  header[1] = total_values;
+  return kHeaderBytes + total_values * sizeof(Entry<E>);
+}
+
+// Concatenates buffers holding consecutive row ranges into dst, which must have room for
+// concatenated_byte_size() bytes. Returns the number of bytes written.
+inline size_t concatenate(const std::vector<const int8_t*>& byte_streams,
+                          const int32_t value_width,
+                          int8_t* dst) {
+  return value_width > 4 ? concatenate_impl<int64_t>(byte_streams, dst)
+                         : concatenate_impl<int32_t>(byte_streams, dst);
+}
+
+template <typename E>
+size_t remove_rows_impl(int8_t* byte_stream, const std::vector<uint64_t>& rows) {
+  auto entries = reinterpret_cast<Entry<E>*>(byte_stream + kHeaderBytes);
+  const auto values_in = num_values(byte_stream);
+  int64_t values_out = 0;
+  E removed = 0;
+  auto row_it = rows.begin();
+  for (int64_t idx = 0; idx < values_in; ++idx) {
+    const auto pos = static_cast<uint64_t>(entries[idx].position);
+    while (row_it != rows.end() && *row_it < pos) {
+      ++removed;
+      ++row_it;
+    }
+    if (row_it != rows.end() && *row_it == pos) {
+      continue;  // the row and its value are gone
+    }
+    entries[values_out++] = {static_cast<E>(pos - removed), entries[idx].value};
+  }
+  auto header = reinterpret_cast<int64_t*>(byte_stream);
+  header[0] -= rows.size();
+  header[1] = values_out;
+  return kHeaderBytes + values_out * sizeof(Entry<E>);
+}
+
+// Removes the given rows, sorted in ascending order, from the buffer in place and returns
+// its new size in bytes.
+inline size_t remove_rows(int8_t* byte_stream,
+                          const int32_t value_width,
+                          const std::vector<uint64_t>& rows) {
+  return value_width > 4 ? remove_rows_impl<int64_t>(byte_stream, rows)
+                         : remove_rows_impl<int32_t>(byte_stream, rows);
+}
+
+}  // namespace sparse_encoding
+
+/**
+ * @class SparseEncoder
+ * @brief Stores a mostly null fixed width column as the positions and values of its non
+ * null rows.
+ *
+ * T is the logical storage type of the column. Null rows take no space, appends add the
+ * entries of their non null rows after those of the chunk and rewrite its header. See
+ * Shared/SparseEncoding.h for the buffer layout.
+ */
+template <typename T>
+class SparseEncoder : public Encoder {
+ public:
+  SparseEncoder(Data_Namespace::AbstractBuffer* buffer) : Encoder(buffer) {
+    resetChunkStats();
+  }
+
+  size_t getNumElemsForBytesEncodedDataAtIndices(const int8_t* index_data,
+                                                 const std::vector<size_t>& selected_idx,
+                                                 const size_t byte_limit) override {
+    UNREACHABLE()
+        << "getNumElemsForBytesEncodedDataAtIndices unexpectedly called for non varlen"
+           " encoder";
+    return {};
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedDataAtIndices(
+      const int8_t*,
+      int8_t* data,
+      const std::vector<size_t>& selected_idx) override {
+    std::shared_ptr<ChunkMetadata> chunk_metadata;
+    shared::execute_over_contiguous_indices(
+        selected_idx, [&](const size_t start_pos, const size_t end_pos) {
+          chunk_metadata = appendEncodedData(
+              nullptr, data, selected_idx[start_pos], end_pos - start_pos);
+        });
+    return chunk_metadata;
+  }
+
+  std::shared_ptr<ChunkMetadata> appendEncodedData(const int8_t*,
+                                                   int8_t* data,
+                                                   const size_t start_idx,
+                                                   const size_t num_elements) override {
+    std::vector<T> decoded_data(num_elements);
+    sparse_encoding::decode_rows(data, start_idx, num_elements, decoded_data.data());
+    auto decoded_ptr = reinterpret_cast<int8_t*>(decoded_data.data());
+    return appendData(decoded_ptr, num_elements, SQLTypeInfo{});
+  }
+
+  std::shared_ptr<ChunkMetadata> appendData(int8_t*& src_data,
+                                            const size_t num_elems_to_append,
+                                            const SQLTypeInfo&,
+                                            const bool replicating = false,
+                                            const int64_t offset = -1) override {
+    if (offset == 0 && num_elems_to_append >= num_elems_) {
+      // we're rewriting entire buffer so fully recompute metadata
+      resetChunkStats();
+      num_elems_ = 0;
+      buffer_->setSize(0);
+    } else if (offset != -1) {
+      throw std::runtime_error(
+          "Sparse encoded chunks can only be appended to or rewritten entirely.");
+    }
+
+    const auto unencoded_data = reinterpret_cast<const T*>(src_data);
+    std::vector<sparse_encoding::EntryType<T>> entries;
+    for (size_t i = 0; i < num_elems_to_append; ++i) {
+      const auto value = unencoded_data[replicating ? 0 : i];
+      updateStatsWithValue(value);
+      if (value != none_encoded_null_value<T>()) {
+        entries.push_back(sparse_encoding::make_entry(num_elems_ + i, value));
+      }
+    }
+
+    int64_t header[2]{0, 0};
+    const auto entries_size = entries.size() * sizeof(entries[0]);
+    if (num_elems_) {
+      CHECK_GE(buffer_->size(), size_t(sparse_encoding::kHeaderBytes));
+      buffer_->read(reinterpret_cast<int8_t*>(header), sparse_encoding::kHeaderBytes);
+    } else {
+      buffer_->reserve(sparse_encoding::kHeaderBytes + entries_size);
+      buffer_->append(reinterpret_cast<int8_t*>(header), sparse_encoding::kHeaderBytes);
+    }
+    if (entries_size) {
+      buffer_->reserve(buffer_->size() + entries_size);
+      buffer_->append(reinterpret_cast<int8_t*>(entries.data()), entries_size);
+    }
+    header[0] = num_elems_ + num_elems_to_append;
+    header[1] += entries.size();
+    buffer_->write(reinterpret_cast<int8_t*>(header), sparse_encoding::kHeaderBytes);
+    num_elems_ += num_elems_to_append;
+    if (!replicating) {
+      src_data += num_elems_to_append * sizeof(T);
+    }
+
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
+    Encoder::getMetadata(chunkMetadata);  // call on parent class
+    chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  std::shared_ptr<ChunkMetadata> getMetadata(const SQLTypeInfo& ti) override {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>(ti, 0, 0, ChunkStats{});
+    chunk_metadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    return chunk_metadata;
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const int64_t val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void updateStats(const double val, const bool is_null) override {
+    if (is_null) {
+      has_nulls = true;
+    } else {
+      const auto data = static_cast<T>(val);
+      dataMin = std::min(dataMin, data);
+      dataMax = std::max(dataMax, data);
+    }
+  }
+
+  void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    const T* unencoded_data = reinterpret_cast<const T*>(src_data);
+    for (size_t i = 0; i < num_elements; ++i) {
+      updateStatsWithValue(unencoded_data[i]);
+    }
+  }
+
+  void updateStatsEncoded(const int8_t* const dst_data,
+                          const size_t num_elements) override {
+    // Null rows are only counted, their ranges are never visited.
+    const auto values = sparse_encoding::num_values(dst_data);
+    int64_t idx = 0;
+    for (; idx < values && sparse_encoding::position(dst_data, sizeof(T), idx) <
+                               static_cast<int64_t>(num_elements);
+         ++idx) {
+      updateStatsWithValue(sparse_encoding::entry_value<T>(dst_data, idx));
+    }
+    if (idx < static_cast<int64_t>(num_elements)) {
+      has_nulls = true;
+    }
+  }
+
+  void updateStats(const std::vector<std::string>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  void updateStats(const std::vector<ArrayDatum>* const src_data,
+                   const size_t start_idx,
+                   const size_t num_elements) override {
+    UNREACHABLE();
+  }
+
+  // Only called from the executor for synthesized meta-information.
+  void reduceStats(const Encoder& that) override {
+    const auto that_typed = static_cast<const SparseEncoder<T>&>(that);
+    if (that_typed.has_nulls) {
+      has_nulls = true;
+    }
+    dataMin = std::min(dataMin, that_typed.dataMin);
+    dataMax = std::max(dataMax, that_typed.dataMax);
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    num_elems_ = copyFromEncoder->getNumElems();
+    auto castedEncoder = reinterpret_cast<const SparseEncoder<T>*>(copyFromEncoder);
+    dataMin = castedEncoder->dataMin;
+    dataMax = castedEncoder->dataMax;
+    has_nulls = castedEncoder->has_nulls;
+  }
+
+  void writeMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fwrite((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&dataMin, sizeof(T), 1, f);
+    fwrite((int8_t*)&dataMax, sizeof(T), 1, f);
+    fwrite((int8_t*)&has_nulls, sizeof(bool), 1, f);
+  }
+
+  void readMetadata(FILE* f) override {
+    // assumes pointer is already in right place
+    fread((int8_t*)&num_elems_, sizeof(size_t), 1, f);
+    fread((int8_t*)&dataMin, 1, sizeof(T), f);
+    fread((int8_t*)&dataMax, 1, sizeof(T), f);
+    fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
+  }
+
+  bool resetChunkStats(const ChunkStats& stats) override {
+    const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
+    const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
+
+    if (dataMin == new_min && dataMax == new_max && has_nulls == stats.has_nulls) {
+      return false;
+    }
+
+    dataMin = new_min;
+    dataMax = new_max;
+    has_nulls = stats.has_nulls;
+    return true;
+  }
+
+  void resetChunkStats() override {
+    dataMin = std::numeric_limits<T>::max();
+    dataMax = std::numeric_limits<T>::lowest();
+    has_nulls = false;
+  }
+
+  T dataMin;
+  T dataMax;
+  bool has_nulls;
+
+ private:
+  void updateStatsWithValue(const T value) {
+    if (value == none_encoded_null_value<T>()) {
+      has_nulls = true;
+    } else {
+      decimal_overflow_validator_.validate(value);
+      dataMin = std::min(dataMin, value);
+      dataMax = std::max(dataMax, value);
+    }
+  }
+};  // SparseEncoder
+
+#endif  // SPARSE_ENCODER_H
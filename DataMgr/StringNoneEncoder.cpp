@@ -24,6 +24,8 @@
 #include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
+#include "FsstSymbolTable.h"
 #include "MemoryLevel.h"
 
 using Data_Namespace::AbstractBuffer;
@@ -67,11 +69,8 @@ std::shared_ptr<ChunkMetadata> StringNoneEncoder::appendEncodedDataAtIndices(
     const int8_t* index_data,
     int8_t* data,
     const std::vector<size_t>& selected_idx) {
-  std::vector<std::string_view> data_subset;
-  data_subset.reserve(selected_idx.size());
-  for (const auto& offset_index : selected_idx) {
-    data_subset.emplace_back(getStringAtIndex(index_data, data, offset_index));
-  }
+  std::vector<std::string> decompressed;
+  auto data_subset = getStrings(index_data, data, selected_idx, decompressed);
   return appendData(&data_subset, 0, selected_idx.size(), false);
 }
 
@@ -80,32 +79,99 @@ std::shared_ptr<ChunkMetadata> StringNoneEncoder::appendEncodedData(
     int8_t* data,
     const size_t start_idx,
     const size_t num_elements) {
-  std::vector<std::string_view> data_subset;
-  data_subset.reserve(num_elements);
-  for (size_t count = 0; count < num_elements; ++count) {
-    auto current_index = start_idx + count;
-    data_subset.emplace_back(getStringAtIndex(index_data, data, current_index));
-  }
+  std::vector<size_t> indices(num_elements);
+  std::iota(indices.begin(), indices.end(), start_idx);
+  std::vector<std::string> decompressed;
+  auto data_subset = getStrings(index_data, data, indices, decompressed);
   return appendData(&data_subset, 0, num_elements, false);
 }
 
+std::vector<std::string_view> StringNoneEncoder::getStrings(
+    const int8_t* index_data,
+    const int8_t* data,
+    const std::vector<size_t>& indices,
+    std::vector<std::string>& decompressed) {
+  std::vector<std::string_view> strings;
+  strings.reserve(indices.size());
+  if (fsst_) {
+    // The views must stay valid, no reallocation.
+    decompressed.reserve(indices.size());
+  }
+  for (const auto index : indices) {
+    auto str = getStringAtIndex(index_data, data, index);
+    if (fsst_) {
+      decompressed.emplace_back(fsst_encoding::decompress(
+          data, reinterpret_cast<const int8_t*>(str.data()), str.size()));
+      str = decompressed.back();
+    }
+    strings.emplace_back(str);
+  }
+  return strings;
+}
+
 template <typename StringType>
 std::shared_ptr<ChunkMetadata> StringNoneEncoder::appendData(
     const std::vector<StringType>* srcData,
     const int start_idx,
     const size_t numAppendElems,
     const bool replicating) {
+  if (!fsst_) {
+    return appendStrings(srcData, start_idx, numAppendElems, replicating);
+  }
+  const auto compressed =
+      compressStrings(srcData, start_idx, numAppendElems, replicating);
+  return appendStrings(&compressed, 0, numAppendElems, replicating);
+}
+
+template <typename StringType>
+std::vector<std::string> StringNoneEncoder::compressStrings(
+    const std::vector<StringType>* srcData,
+    const int start_idx,
+    const size_t numAppendElems,
+    const bool replicating) {
+  const auto first = srcData->begin() + start_idx;
+  const auto last = replicating ? first + 1 : first + numAppendElems;
+  std::vector<int8_t> serialized_table(fsst_encoding::kTableBytes);
+  if (buffer_->size() == 0) {
+    CHECK_EQ(num_elems_, size_t(0));
+    const auto symbol_table = fsst_encoding::SymbolTable::build(first, last);
+    symbol_table.serialize(serialized_table.data());
+    buffer_->append(serialized_table.data(), serialized_table.size());
+  } else {
+    CHECK_GE(buffer_->size(), serialized_table.size());
+    buffer_->read(serialized_table.data(),
+                  serialized_table.size(),
+                  0,
+                  Data_Namespace::CPU_LEVEL);
+  }
+  const fsst_encoding::SymbolTable symbol_table(serialized_table.data());
+  std::vector<std::string> compressed;
+  compressed.reserve(last - first);
+  for (auto it = first; it != last; ++it) {
+    compressed.emplace_back(
+        symbol_table.compress(std::string_view(it->data(), it->size())));
+  }
+  return compressed;
+}
+
+template <typename StringType>
+std::shared_ptr<ChunkMetadata> StringNoneEncoder::appendStrings(
+    const std::vector<StringType>* srcData,
+    const int start_idx,
+    const size_t numAppendElems,
+    const bool replicating) {
   CHECK(index_buf);  // index_buf must be set before this.
   size_t append_index_size = numAppendElems * sizeof(StringOffsetT);
   if (num_elems_ == 0) {
     append_index_size += sizeof(StringOffsetT);  // plus one for the initial offset of 0.
   }
   index_buf->reserve(index_buf->size() + append_index_size);
-  StringOffsetT offset = 0;
+  // the strings of fsst encoded chunks follow the symbol table.
+  StringOffsetT offset = fsst_ ? fsst_encoding::kTableBytes : 0;
   if (num_elems_ == 0) {
     index_buf->append((int8_t*)&offset,
                       sizeof(StringOffsetT));  // write the inital 0 offset
-    last_offset = 0;
+    last_offset = offset;
   } else {
     // always need to read a valid last offset from buffer/disk
     // b/c now due to vacuum "last offset" may go backward and if
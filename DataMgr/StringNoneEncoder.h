@@ -35,8 +35,13 @@ using Data_Namespace::AbstractBuffer;
 
 class StringNoneEncoder : public Encoder {
  public:
-  StringNoneEncoder(AbstractBuffer* buffer)
-      : Encoder(buffer), index_buf(nullptr), last_offset(-1), has_nulls(false) {}
+  // Strings of fsst encoders are stored compressed, see Shared/FsstEncoding.h.
+  StringNoneEncoder(AbstractBuffer* buffer, const bool fsst = false)
+      : Encoder(buffer)
+      , index_buf(nullptr)
+      , last_offset(-1)
+      , has_nulls(false)
+      , fsst_(fsst) {}
 
   size_t getNumElemsForBytesInsertData(const std::vector<std::string>* srcData,
                                        const int start_idx,
@@ -137,9 +142,32 @@ class StringNoneEncoder : public Encoder {
                                     const int8_t* data,
                                     size_t index);
 
+  // Appends the strings as they are to the buffers.
+  template <typename StringType>
+  std::shared_ptr<ChunkMetadata> appendStrings(const std::vector<StringType>* srcData,
+                                               const int start_idx,
+                                               const size_t numAppendElems,
+                                               const bool replicating);
+
+  // Compresses the strings with the symbol table of the chunk, writing it first if the
+  // chunk is empty.
+  template <typename StringType>
+  std::vector<std::string> compressStrings(const std::vector<StringType>* srcData,
+                                           const int start_idx,
+                                           const size_t numAppendElems,
+                                           const bool replicating);
+
+  // The strings of encoded data, decompressed with the symbol table of the data when it
+  // is fsst encoded.
+  std::vector<std::string_view> getStrings(const int8_t* index_data,
+                                           const int8_t* data,
+                                           const std::vector<size_t>& indices,
+                                           std::vector<std::string>& decompressed);
+
   AbstractBuffer* index_buf;
   StringOffsetT last_offset;
   bool has_nulls;
+  const bool fsst_;
 
   template <typename StringType>
   void update_elem_stats(const StringType& elem);
@@ -155,6 +155,7 @@ void InsertOrderFragmenter::conditionallyInstantiateFileMgrWithParams() {
         catalog_->getMetadataForTable(physicalTableId_, false /*populateFragmenter*/);
     File_Namespace::FileMgrParams fileMgrParams;
     fileMgrParams.max_rollback_epochs = td->maxRollbackEpochs;
+    fileMgrParams.storage_compression = td->storageCompression;
     dataMgr_->getGlobalFileMgr()->setFileMgrParams(
         chunkKeyPrefix_[0], chunkKeyPrefix_[1], fileMgrParams);
   }
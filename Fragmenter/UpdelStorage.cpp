@@ -24,11 +24,16 @@
 
 #include "Catalog/Catalog.h"
 #include "DataMgr/ArrayNoneEncoder.h"
+#include "DataMgr/BitPackedEncoder.h"
+#include "DataMgr/DiffEncoder.h"
 #include "DataMgr/FixedLengthArrayNoneEncoder.h"
+#include "DataMgr/RunLengthEncoder.h"
+#include "DataMgr/SparseEncoder.h"
 #include "Fragmenter/InsertOrderFragmenter.h"
 #include "LockMgr/LockMgr.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/DateConverters.h"
+#include "Shared/FsstEncoding.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/thread_count.h"
 #include "TargetValueConvertersFactories.h"
@@ -222,6 +227,11 @@ struct StringChunkConverter : public ChunkToInsertDataConverter {
     size_t src_value_size =
         index_buffer_addr_[indexInFragment + 1] - index_buffer_addr_[indexInFragment];
     auto src_value_ptr = data_buffer_addr_ + index_buffer_addr_[indexInFragment];
+    if (column_descriptor_->columnType.is_fsst_string()) {
+      (*column_data_)[row] =
+          fsst_encoding::decompress(data_buffer_addr_, src_value_ptr, src_value_size);
+      return;
+    }
     (*column_data_)[row] = std::string((const char*)src_value_ptr, src_value_size);
   }
 
@@ -657,6 +667,11 @@ std::optional<ChunkUpdateStats> InsertOrderFragmenter::updateColumn(
   if (0 == nrow) {
     return {};
   }
+  if (cd->columnType.is_block_encoded()) {
+    throw std::runtime_error("In-place update of " +
+                             cd->columnType.get_compression_name() + " encoded column '" +
+                             cd->columnName + "' is not supported.");
+  }
   CHECK(nrow == n_rhs_values || 1 == n_rhs_values);
 
   auto fragment_ptr = getFragmentInfo(fragment_id);
@@ -1209,8 +1224,12 @@ auto InsertOrderFragmenter::vacuum_varlen_rows(
   int64_t irow_of_blk_to_fill = 0;  // row offset to fit the kept block
   size_t nbytes_fix_data_to_keep = 0;
   auto nrows_in_fragment = fragment.getPhysicalNumTuples();
+  // The symbol table at the start of FSST encoded chunks is kept like a padding.
   size_t null_padding =
-      get_null_padding(is_varlen_array, frag_offsets, index_array, nrows_in_fragment);
+      chunk->getColumnDesc()->columnType.is_fsst_string()
+          ? fsst_encoding::kTableBytes
+          : get_null_padding(
+                is_varlen_array, frag_offsets, index_array, nrows_in_fragment);
   size_t nbytes_var_data_to_keep = null_padding;
   auto null_array_indexes = get_var_len_null_array_indexes(
       chunk->getColumnDesc()->columnType, frag_offsets, index_array, nrows_in_fragment);
@@ -1365,8 +1384,131 @@ void InsertOrderFragmenter::compactRows(const Catalog_Namespace::Catalog* catalo
       set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
     };
 
+    auto run_length_vacuum =
+        [=, &update_stats_per_thread, &updel_roll, &frag_offsets, &fragment] {
+          const auto value_width = col_type.get_size();
+          size_t nbytes_to_keep;
+          if (nrows_to_keep == 0) {
+            *reinterpret_cast<int64_t*>(data_addr) = 0;
+            nbytes_to_keep = run_length_encoding::kHeaderBytes;
+          } else {
+            nbytes_to_keep =
+                run_length_encoding::remove_rows(data_addr, value_width, frag_offsets);
+          }
+
+          data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+          data_buffer->setSize(nbytes_to_keep);
+          data_buffer->setUpdated();
+
+          set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+
+          // Runs hold logical values, stats only need one look at each of them.
+          const auto null_val = inline_int_null_val(get_logical_type_info(col_type));
+          auto& stats = update_stats_per_thread[ci].new_values_stats;
+          data_buffer->getEncoder()->resetChunkStats();
+          const auto nruns = run_length_encoding::num_runs(data_addr);
+          for (int64_t run = 0; run < nruns; ++run) {
+            const auto v = run_length_encoding::run_value(data_addr, value_width, run);
+            if (v == null_val) {
+              stats.has_null = true;
+            } else {
+              set_minmax(stats.min_int64t, stats.max_int64t, v);
+            }
+          }
+        };
+
+    auto diff_vacuum =
+        [=, &update_stats_per_thread, &updel_roll, &frag_offsets, &fragment] {
+          const auto nbytes_to_keep =
+              diff_encoding::remove_rows(data_addr, nrows_in_fragment, frag_offsets);
+
+          data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+          data_buffer->setSize(nbytes_to_keep);
+          data_buffer->setUpdated();
+
+          set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+
+          auto& stats = update_stats_per_thread[ci].new_values_stats;
+          data_buffer->getEncoder()->resetChunkStats();
+          for (size_t irow = 0; irow < nrows_to_keep; ++irow) {
+            const auto v =
+                diff_encoding::decode(data_addr, irow, inline_int_null_value<int64_t>());
+            if (v == inline_int_null_value<int64_t>()) {
+              stats.has_null = true;
+            } else {
+              set_minmax(stats.min_int64t, stats.max_int64t, v);
+            }
+          }
+        };
+
+    auto bit_packed_vacuum =
+        [=, &update_stats_per_thread, &updel_roll, &frag_offsets, &fragment] {
+          const auto bit_width = col_type.get_comp_param();
+          const auto nbytes_to_keep = bit_packing::remove_rows(
+              data_addr, bit_width, nrows_in_fragment, frag_offsets);
+
+          data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+          data_buffer->setSize(nbytes_to_keep);
+          data_buffer->setUpdated();
+
+          set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+
+          auto& stats = update_stats_per_thread[ci].new_values_stats;
+          data_buffer->getEncoder()->resetChunkStats();
+          std::vector<int64_t> values(nrows_to_keep);
+          bit_packing::decode_rows(data_addr, bit_width, 0, nrows_to_keep, values.data());
+          for (const auto v : values) {
+            if (v == inline_int_null_value<int64_t>()) {
+              stats.has_null = true;
+            } else {
+              set_minmax(stats.min_int64t, stats.max_int64t, v);
+            }
+          }
+        };
+
+    auto sparse_vacuum =
+        [=, &update_stats_per_thread, &updel_roll, &frag_offsets, &fragment] {
+          const auto value_width = col_type.get_size();
+          const auto nbytes_to_keep =
+              sparse_encoding::remove_rows(data_addr, value_width, frag_offsets);
+
+          data_buffer->getEncoder()->setNumElems(nrows_to_keep);
+          data_buffer->setSize(nbytes_to_keep);
+          data_buffer->setUpdated();
+
+          set_chunk_metadata(catalog, fragment, chunk, nrows_to_keep, updel_roll);
+
+          // Only the non null values are stored, they are all the stats need.
+          auto& stats = update_stats_per_thread[ci].new_values_stats;
+          data_buffer->getEncoder()->resetChunkStats();
+          const auto nvalues = sparse_encoding::num_values(data_addr);
+          if (nvalues < static_cast<int64_t>(nrows_to_keep)) {
+            stats.has_null = true;
+          }
+          for (int64_t ivalue = 0; ivalue < nvalues; ++ivalue) {
+            auto vaddr = const_cast<int8_t*>(
+                sparse_encoding::value_ptr(data_addr, value_width, ivalue));
+            bool is_null{false};
+            if (col_type.is_fp()) {
+              set_chunk_stats(
+                  col_type, vaddr, is_null, stats.min_double, stats.max_double);
+            } else {
+              set_chunk_stats(
+                  col_type, vaddr, is_null, stats.min_int64t, stats.max_int64t);
+            }
+          }
+        };
+
     if (is_varlen) {
       threads.emplace_back(std::async(std::launch::async, varlen_vacuum));
+    } else if (col_type.is_run_length_encoded()) {
+      threads.emplace_back(std::async(std::launch::async, run_length_vacuum));
+    } else if (col_type.get_compression() == kENCODING_DIFF) {
+      threads.emplace_back(std::async(std::launch::async, diff_vacuum));
+    } else if (col_type.get_compression() == kENCODING_SPARSE) {
+      threads.emplace_back(std::async(std::launch::async, sparse_vacuum));
+    } else if (col_type.is_bit_packed()) {
+      threads.emplace_back(std::async(std::launch::async, bit_packed_vacuum));
     } else {
       threads.emplace_back(std::async(std::launch::async, fixlen_vacuum));
     }
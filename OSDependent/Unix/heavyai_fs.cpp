@@ -54,6 +54,18 @@ void checked_munmap(void* addr, size_t length) {
   CHECK_EQ(0, munmap(addr, length));
 }
 
+void release_pages(void* addr, size_t length) {
+  const uintptr_t page_size = get_page_size();
+  const auto begin = reinterpret_cast<uintptr_t>(addr);
+  const auto aligned_begin = (begin + page_size - 1) / page_size * page_size;
+  const auto aligned_end = (begin + length) / page_size * page_size;
+  if (aligned_begin < aligned_end) {
+    madvise(reinterpret_cast<void*>(aligned_begin),
+            aligned_end - aligned_begin,
+            MADV_DONTNEED);
+  }
+}
+
 int msync(void* addr, size_t length, bool async) {
   // TODO: support MS_INVALIDATE?
   return ::msync(addr, length, async ? MS_ASYNC : MS_SYNC);
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/heavyai_huge_pages.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Logger/Logger.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace heavyai {
+void* mmap_huge_pages(const size_t num_bytes, const size_t huge_page_size) {
+#ifdef MAP_HUGETLB
+  CHECK_EQ(num_bytes % huge_page_size, size_t(0));
+  int huge_page_shift = 0;
+  while ((size_t(1) << huge_page_shift) < huge_page_size) {
+    ++huge_page_shift;
+  }
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                    (huge_page_shift << MAP_HUGE_SHIFT);
+  auto ptr = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+#else
+  return nullptr;
+#endif
+}
+
+void* mmap_transparent_huge_pages(const size_t num_bytes) {
+  auto ptr = mmap(nullptr,
+                  num_bytes,
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS,
+                  -1,
+                  0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(ptr, num_bytes, MADV_HUGEPAGE);
+#endif
+  return ptr;
+}
+
+void munmap_pages(void* addr, const size_t num_bytes) {
+  CHECK_EQ(0, munmap(addr, num_bytes));
+}
+
+size_t get_transparent_huge_page_bytes(
+    const std::vector<std::pair<void*, size_t>>& ranges) {
+  std::ifstream smaps("/proc/self/smaps");
+  size_t huge_page_bytes = 0;
+  // Bytes of the current mapping that overlap the given ranges.
+  size_t overlap_bytes = 0;
+  std::string line;
+  while (std::getline(smaps, line)) {
+    uintptr_t start, end;
+    char dash;
+    std::istringstream header(line);
+    if (header >> std::hex >> start >> dash >> end && dash == '-') {
+      overlap_bytes = 0;
+      for (const auto& [addr, num_bytes] : ranges) {
+        const auto range_start = reinterpret_cast<uintptr_t>(addr);
+        const auto range_end = range_start + num_bytes;
+        if (range_start < end && start < range_end) {
+          overlap_bytes += std::min(end, range_end) - std::max(start, range_start);
+        }
+      }
+      continue;
+    }
+    const std::string anon_huge_pages_prefix{"AnonHugePages:"};
+    if (overlap_bytes > 0 && line.compare(0,
+                                          anon_huge_pages_prefix.size(),
+                                          anon_huge_pages_prefix) == 0) {
+      const size_t kb = std::stoull(line.substr(anon_huge_pages_prefix.size()));
+      // A mapping can span memory outside of the ranges, which is not counted.
+      huge_page_bytes += std::min(kb * 1024, overlap_bytes);
+    }
+  }
+  return huge_page_bytes;
+}
+}  // namespace heavyai
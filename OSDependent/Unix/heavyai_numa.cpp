@@ -0,0 +1,130 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/heavyai_numa.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Logger/Logger.h"
+
+namespace heavyai {
+namespace {
+// Parses a sysfs CPU list, e.g. "0-15,32-47".
+std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+  std::vector<int> cpus;
+  std::vector<std::string> ranges;
+  boost::split(ranges, boost::trim_copy(cpu_list), boost::is_any_of(","));
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash_pos = range.find('-');
+    const int first = std::stoi(range.substr(0, dash_pos));
+    const int last =
+        dash_pos == std::string::npos ? first : std::stoi(range.substr(dash_pos + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.emplace_back(cpu);
+    }
+  }
+  return cpus;
+}
+}  // namespace
+
+std::vector<std::vector<int>> read_numa_node_cpus(const std::string& node_dir,
+                                                  const size_t num_online_cpus) {
+  std::vector<std::vector<int>> node_cpus;
+  for (size_t node = 0;; ++node) {
+    std::ifstream cpu_list_file((boost::filesystem::path(node_dir) /
+                                 ("node" + std::to_string(node)) / "cpulist")
+                                    .string());
+    if (!cpu_list_file) {
+      break;
+    }
+    std::string cpu_list;
+    std::getline(cpu_list_file, cpu_list);
+    try {
+      node_cpus.emplace_back(parse_cpu_list(cpu_list));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Could not parse the CPUs of NUMA node " << node << ": "
+                   << e.what();
+      node_cpus.clear();
+      break;
+    }
+  }
+  // Nodes without CPUs (e.g. memory only nodes) cannot run threads, so report the host
+  // as a single node rather than handle them.
+  if (node_cpus.empty() || std::any_of(node_cpus.begin(),
+                                       node_cpus.end(),
+                                       [](const auto& cpus) { return cpus.empty(); })) {
+    std::vector<int> cpus;
+    for (size_t cpu = 0; cpu < std::max(num_online_cpus, size_t(1)); ++cpu) {
+      cpus.emplace_back(cpu);
+    }
+    node_cpus = {cpus};
+  }
+  return node_cpus;
+}
+
+const std::vector<std::vector<int>>& get_numa_node_cpus() {
+  static const auto node_cpus =
+      read_numa_node_cpus("/sys/devices/system/node", sysconf(_SC_NPROCESSORS_ONLN));
+  return node_cpus;
+}
+
+size_t get_num_numa_nodes() {
+  return get_numa_node_cpus().size();
+}
+
+namespace {
+bool set_thread_cpus(const std::vector<const std::vector<int>*>& cpu_lists) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpus : cpu_lists) {
+    for (const auto cpu : *cpus) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpu_set);
+      }
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+}
+}  // namespace
+
+bool bind_thread_to_numa_node(const size_t numa_node) {
+  const auto& node_cpus = get_numa_node_cpus();
+  if (numa_node >= node_cpus.size()) {
+    return false;
+  }
+  return set_thread_cpus({&node_cpus[numa_node]});
+}
+
+bool unbind_thread_from_numa_node() {
+  std::vector<const std::vector<int>*> cpu_lists;
+  for (const auto& cpus : get_numa_node_cpus()) {
+    cpu_lists.emplace_back(&cpus);
+  }
+  return set_thread_cpus(cpu_lists);
+}
+}  // namespace heavyai
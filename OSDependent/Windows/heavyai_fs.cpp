@@ -52,6 +52,19 @@ void checked_munmap(void* addr, size_t length) {
   CHECK(UnmapViewOfFile(addr) != 0);
 }
 
+void release_pages(void* addr, size_t length) {
+  const uintptr_t page_size = get_page_size();
+  const auto begin = reinterpret_cast<uintptr_t>(addr);
+  const auto aligned_begin = (begin + page_size - 1) / page_size * page_size;
+  const auto aligned_end = (begin + length) / page_size * page_size;
+  if (aligned_begin < aligned_end) {
+    VirtualAlloc(reinterpret_cast<void*>(aligned_begin),
+                 aligned_end - aligned_begin,
+                 MEM_RESET,
+                 PAGE_READWRITE);
+  }
+}
+
 int msync(void* addr, size_t length, bool async) {
   auto err = FlushViewOfFile(addr, length);
   return err != 0 ? 0 : -1;
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/heavyai_huge_pages.h"
+
+namespace heavyai {
+void* mmap_huge_pages(const size_t num_bytes, const size_t huge_page_size) {
+  return nullptr;
+}
+
+void* mmap_transparent_huge_pages(const size_t num_bytes) {
+  return nullptr;
+}
+
+void munmap_pages(void* addr, const size_t num_bytes) {}
+
+size_t get_transparent_huge_page_bytes(
+    const std::vector<std::pair<void*, size_t>>& ranges) {
+  return 0;
+}
+}  // namespace heavyai
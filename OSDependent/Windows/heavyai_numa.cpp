@@ -0,0 +1,44 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/heavyai_numa.h"
+
+#include <thread>
+
+namespace heavyai {
+const std::vector<std::vector<int>>& get_numa_node_cpus() {
+  static const auto node_cpus = [] {
+    std::vector<int> cpus;
+    for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+      cpus.emplace_back(cpu);
+    }
+    return std::vector<std::vector<int>>{cpus};
+  }();
+  return node_cpus;
+}
+
+size_t get_num_numa_nodes() {
+  return get_numa_node_cpus().size();
+}
+
+bool bind_thread_to_numa_node(const size_t numa_node) {
+  return false;
+}
+
+bool unbind_thread_from_numa_node() {
+  return false;
+}
+}  // namespace heavyai
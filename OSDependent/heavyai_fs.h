@@ -34,6 +34,10 @@ void* checked_mmap(const int fd, const size_t sz);
 
 void checked_munmap(void* addr, size_t length);
 
+// Returns the physical pages of the page aligned part of a range of anonymous memory to
+// the OS. The range stays mapped, but its contents are lost.
+void release_pages(void* addr, size_t length);
+
 int msync(void* addr, size_t length, bool async);
 
 int fsync(int fd);
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace heavyai {
+constexpr size_t kHugePageSize2MB{size_t(1) << 21};
+constexpr size_t kHugePageSize1GB{size_t(1) << 30};
+
+// Maps anonymous memory backed by explicit huge pages of huge_page_size bytes, which must
+// be reserved beforehand, e.g. through /sys/kernel/mm/hugepages. num_bytes must be a
+// multiple of huge_page_size. Returns nullptr if not enough huge pages are available.
+void* mmap_huge_pages(const size_t num_bytes, const size_t huge_page_size);
+
+// Maps anonymous memory that the kernel is asked to back with transparent huge pages.
+// Returns nullptr if the memory could not be mapped.
+void* mmap_transparent_huge_pages(const size_t num_bytes);
+
+void munmap_pages(void* addr, const size_t num_bytes);
+
+// Returns the number of bytes of the given address ranges that are currently backed by
+// transparent huge pages.
+size_t get_transparent_huge_page_bytes(
+    const std::vector<std::pair<void*, size_t>>& ranges);
+}  // namespace heavyai
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace heavyai {
+// Returns the CPUs of each NUMA node of the host, indexed by node. A host without NUMA
+// information is reported as a single node holding every CPU.
+const std::vector<std::vector<int>>& get_numa_node_cpus();
+
+size_t get_num_numa_nodes();
+
+#ifndef _WIN32
+// Reads the CPUs of each NUMA node from a sysfs node directory, falling back to a single
+// node holding CPUs 0 to num_online_cpus - 1. Exposed for testing.
+std::vector<std::vector<int>> read_numa_node_cpus(const std::string& node_dir,
+                                                  const size_t num_online_cpus);
+#endif
+
+// Restricts the calling thread to the CPUs of the given NUMA node. Returns false if the
+// thread could not be restricted.
+bool bind_thread_to_numa_node(const size_t numa_node);
+
+// Lets the calling thread run on the CPUs of every NUMA node again.
+bool unbind_thread_from_numa_node();
+}  // namespace heavyai
@@ -36,6 +36,7 @@
 #include <limits>
 #include <random>
 #include <regex>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -2985,6 +2986,25 @@ decltype(auto) get_max_rollback_epochs_def(TableDescriptor& td,
       p, assignment);
 }
 
+decltype(auto) get_storage_compression_def(TableDescriptor& td,
+                                           const NameValueAssign* p,
+                                           const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td](const auto compression_uc) {
+    const auto compression = boost::to_lower_copy<std::string>(compression_uc);
+    if (compression == "none") {
+      td.storageCompression.clear();
+      return;
+    }
+    static const std::set<std::string> supported_compressors{
+        "blosclz", "lz4", "lz4hc", "zlib", "zstd"};
+    if (!supported_compressors.count(compression)) {
+      throw std::runtime_error(
+          "STORAGE_COMPRESSION must be NONE, BLOSCLZ, LZ4, LZ4HC, ZLIB or ZSTD");
+    }
+    td.storageCompression = compression;
+  });
+}
+
 static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap = {
     {"fragment_size"s, get_frag_size_def},
     {"max_chunk_size"s, get_max_chunk_size_def},
@@ -2995,7 +3015,8 @@ static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap
     {"vacuum"s, get_vacuum_def},
     {"sort_column"s, get_sort_column_def},
     {"storage_type"s, get_storage_type},
-    {"max_rollback_epochs", get_max_rollback_epochs_def}};
+    {"max_rollback_epochs", get_max_rollback_epochs_def},
+    {"storage_compression"s, get_storage_compression_def}};
 
 void get_table_definitions(TableDescriptor& td,
                            const std::unique_ptr<NameValueAssign>& p,
@@ -3006,7 +3027,8 @@ void get_table_definitions(TableDescriptor& td,
         "Invalid CREATE TABLE option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE, "
+        "STORAGE_COMPRESSION.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -3020,8 +3042,8 @@ void get_table_definitions_for_ctas(TableDescriptor& td,
         "Invalid CREATE TABLE AS option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE,  "
-        "USE_SHARED_DICTIONARIES or FORCE_GEO_COMPRESSION.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE, "
+        "STORAGE_COMPRESSION, USE_SHARED_DICTIONARIES or FORCE_GEO_COMPRESSION.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -397,6 +397,8 @@ struct CgenState {
 
   llvm::Function* query_func_;
   llvm::IRBuilder<> query_func_entry_ir_builder_;
+  // Values of the query function passed to the row function, keyed by literal buffer
+  // offset, or by -1 - local column id for decode cursors.
   std::unordered_map<int, std::vector<llvm::Value*>> query_func_literal_loads_;
 
   struct HoistedLiteralLoadLocator {
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/ChunkPrefetcher.h"
+
+#include "Catalog/Catalog.h"
+#include "Logger/Logger.h"
+
+bool g_enable_chunk_prefetch{false};
+size_t g_chunk_prefetch_max_bytes{1UL << 30};
+size_t g_chunk_prefetch_num_kernels{8};
+
+std::atomic<size_t> ChunkPrefetcher::total_num_prefetched_{0};
+
+ChunkPrefetcher::ChunkPrefetcher(
+    const Catalog_Namespace::Catalog& cat,
+    const std::vector<InputTableInfo>& query_infos,
+    const ColumnIds& columns_to_fetch,
+    const std::vector<const FragmentsList*>& kernel_fragments,
+    const size_t max_bytes,
+    const size_t max_kernels_ahead)
+    : data_mgr_(&cat.getDataMgr())
+    , max_bytes_(max_bytes)
+    , max_kernels_ahead_(max_kernels_ahead)
+    , prefetched_chunks_(kernel_fragments.size())
+    , kernel_states_(kernel_fragments.size(), KernelState::kPending) {
+  size_t total_bytes{0};
+  for (const auto frag_list : kernel_fragments) {
+    CHECK(frag_list);
+    requests_.emplace_back(
+        prefetchRequests(cat, query_infos, columns_to_fetch, *frag_list));
+    size_t kernel_bytes{0};
+    for (const auto& request : requests_.back()) {
+      kernel_bytes += request.num_bytes;
+    }
+    request_bytes_.emplace_back(kernel_bytes);
+    total_bytes += kernel_bytes;
+  }
+  if (total_bytes == 0) {
+    return;
+  }
+  VLOG(1) << "Prefetching up to " << total_bytes << " bytes of chunks for "
+          << requests_.size() << " kernels";
+  prefetch_thread_ = std::thread([this] { prefetchLoop(); });
+}
+
+ChunkPrefetcher::~ChunkPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  VLOG(1) << "Prefetched chunks for " << num_prefetched_ << " of " << requests_.size()
+          << " kernels";
+}
+
+void ChunkPrefetcher::kernelStarted(const size_t kernel_idx) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_LT(kernel_idx, kernel_states_.size());
+    if (kernel_states_[kernel_idx] == KernelState::kPending) {
+      // Too late to help this kernel; it will fetch its own chunks.
+      kernel_states_[kernel_idx] = KernelState::kStarted;
+    }
+    ++num_started_;
+  }
+  cv_.notify_all();
+}
+
+void ChunkPrefetcher::kernelFinished(const size_t kernel_idx) {
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_release;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CHECK_LT(kernel_idx, kernel_states_.size());
+    if (kernel_states_[kernel_idx] == KernelState::kPrefetched) {
+      chunks_to_release = std::move(prefetched_chunks_[kernel_idx]);
+      pinned_bytes_ -= request_bytes_[kernel_idx];
+    }
+    // Chunks of a kernel still being prefetched are released by the prefetch thread.
+    kernel_states_[kernel_idx] = KernelState::kFinished;
+  }
+  chunks_to_release.clear();  // unpins outside of the lock
+  cv_.notify_all();
+}
+
+size_t ChunkPrefetcher::getNumPrefetchedKernels() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_prefetched_;
+}
+
+size_t ChunkPrefetcher::getTotalNumPrefetchedKernels() {
+  return total_num_prefetched_.load();
+}
+
+void ChunkPrefetcher::prefetchLoop() {
+  for (size_t kernel_idx = 0; kernel_idx < requests_.size(); ++kernel_idx) {
+    if (requests_[kernel_idx].empty() || request_bytes_[kernel_idx] > max_bytes_) {
+      continue;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this, kernel_idx] {
+        return shutdown_ || kernel_states_[kernel_idx] != KernelState::kPending ||
+               (kernel_idx < num_started_ + max_kernels_ahead_ &&
+                pinned_bytes_ + request_bytes_[kernel_idx] <= max_bytes_);
+      });
+      if (shutdown_) {
+        return;
+      }
+      if (kernel_states_[kernel_idx] != KernelState::kPending) {
+        continue;
+      }
+      kernel_states_[kernel_idx] = KernelState::kPrefetching;
+      pinned_bytes_ += request_bytes_[kernel_idx];
+    }
+
+    std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks;
+    bool failed{false};
+    try {
+      chunks = Chunk_NS::Chunk::getChunks(
+          requests_[kernel_idx], data_mgr_, Data_Namespace::CPU_LEVEL, 0);
+    } catch (const std::exception& e) {
+      // Prefetching is best effort, e.g. the CPU buffer pool may be full. Kernels fetch
+      // whatever is missing themselves.
+      LOG(INFO) << "Stopping chunk prefetch: " << e.what();
+      failed = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (failed || kernel_states_[kernel_idx] != KernelState::kPrefetching) {
+        pinned_bytes_ -= request_bytes_[kernel_idx];
+        kernel_states_[kernel_idx] = KernelState::kFinished;
+      } else {
+        prefetched_chunks_[kernel_idx] = std::move(chunks);
+        kernel_states_[kernel_idx] = KernelState::kPrefetched;
+        ++num_prefetched_;
+        ++total_num_prefetched_;
+      }
+    }
+    chunks.clear();
+    cv_.notify_all();
+    if (failed) {
+      return;
+    }
+  }
+}
+
+std::vector<ChunkPrefetcher::ChunkRequest> ChunkPrefetcher::prefetchRequests(
+    const Catalog_Namespace::Catalog& cat,
+    const std::vector<InputTableInfo>& query_infos,
+    const ColumnIds& columns_to_fetch,
+    const FragmentsList& frag_list) const {
+  std::vector<ChunkRequest> requests;
+  if (frag_list.empty()) {
+    return requests;
+  }
+  // Only the outer table is streamed fragment by fragment; inner tables are read by
+  // every kernel and stay resident anyway.
+  const auto& outer_frags = frag_list.front();
+  if (outer_frags.table_id <= 0) {
+    return requests;
+  }
+  const auto td = cat.getMetadataForTable(outer_frags.table_id, false);
+  if (!td || td->isForeignTable() || td->isView) {
+    return requests;
+  }
+  const Fragmenter_Namespace::TableInfo* table_info{nullptr};
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id == outer_frags.table_id) {
+      table_info = &query_info.info;
+      break;
+    }
+  }
+  if (!table_info) {
+    return requests;
+  }
+  for (const auto& [table_id, column_id] : columns_to_fetch) {
+    if (table_id != outer_frags.table_id) {
+      continue;
+    }
+    const auto cd = cat.getMetadataForColumn(table_id, column_id);
+    // Varlen chunks carry an index buffer and are fetched under a dedicated lock by
+    // the ColumnFetcher, so leave them to the kernels.
+    if (!cd || cd->isVirtualCol || cd->columnType.is_varlen()) {
+      continue;
+    }
+    for (const auto frag_id : outer_frags.fragment_ids) {
+      CHECK_LT(frag_id, table_info->fragments.size());
+      const auto& fragment = table_info->fragments[frag_id];
+      if (fragment.isEmptyPhysicalFragment() || fragment.resultSet) {
+        continue;
+      }
+      const auto& chunk_metadata_map = fragment.getChunkMetadataMapPhysical();
+      const auto chunk_metadata_it = chunk_metadata_map.find(column_id);
+      if (chunk_metadata_it == chunk_metadata_map.end()) {
+        continue;
+      }
+      requests.push_back({cd,
+                          {cat.getCurrentDB().dbId,
+                           fragment.physicalTableId,
+                           column_id,
+                           fragment.fragmentId},
+                          chunk_metadata_it->second->numBytes,
+                          chunk_metadata_it->second->numElements});
+    }
+  }
+  return requests;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ChunkPrefetcher.h
+ * @brief   Background loading of the outer table chunks of upcoming execution kernels
+ *          into the CPU buffer pool.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "DataMgr/Chunk/Chunk.h"
+#include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
+#include "QueryEngine/InputMetadata.h"
+
+extern bool g_enable_chunk_prefetch;
+extern size_t g_chunk_prefetch_max_bytes;
+extern size_t g_chunk_prefetch_num_kernels;
+
+namespace Catalog_Namespace {
+class Catalog;
+}  // namespace Catalog_Namespace
+
+/**
+ * Loads the chunks that the kernels of a query step will read for their outer table
+ * fragments into the CPU buffer pool ahead of time, while earlier kernels execute.
+ *
+ * Kernels are prefetched in launch order, at most g_chunk_prefetch_num_kernels ahead of
+ * the kernels that have already started, and only while the pinned prefetched bytes
+ * stay within g_chunk_prefetch_max_bytes. A kernel that starts before its chunks were
+ * prefetched simply fetches them itself. Prefetched chunks stay pinned until the
+ * consuming kernel finishes, at which point the kernel holds its own references.
+ */
+class ChunkPrefetcher {
+ public:
+  using ColumnIds = std::set<std::pair<int, int>>;
+
+  ChunkPrefetcher(const Catalog_Namespace::Catalog& cat,
+                  const std::vector<InputTableInfo>& query_infos,
+                  const ColumnIds& columns_to_fetch,
+                  const std::vector<const FragmentsList*>& kernel_fragments,
+                  const size_t max_bytes,
+                  const size_t max_kernels_ahead);
+
+  ~ChunkPrefetcher();
+
+  void kernelStarted(const size_t kernel_idx);
+
+  void kernelFinished(const size_t kernel_idx);
+
+  size_t getNumPrefetchedKernels() const;
+
+  // Number of kernels prefetched by all ChunkPrefetchers of the process so far.
+  static size_t getTotalNumPrefetchedKernels();
+
+ private:
+  using ChunkRequest = Chunk_NS::ChunkRequest;
+
+  enum class KernelState { kPending, kPrefetching, kPrefetched, kStarted, kFinished };
+
+  void prefetchLoop();
+
+  std::vector<ChunkRequest> prefetchRequests(const Catalog_Namespace::Catalog& cat,
+                                             const std::vector<InputTableInfo>& infos,
+                                             const ColumnIds& columns_to_fetch,
+                                             const FragmentsList& frag_list) const;
+
+  Data_Namespace::DataMgr* data_mgr_;
+  const size_t max_bytes_;
+  const size_t max_kernels_ahead_;
+
+  std::vector<std::vector<ChunkRequest>> requests_;
+  std::vector<size_t> request_bytes_;
+  std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> prefetched_chunks_;
+  std::vector<KernelState> kernel_states_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t num_started_{0};
+  size_t pinned_bytes_{0};
+  size_t num_prefetched_{0};
+  bool shutdown_{false};
+  std::thread prefetch_thread_;
+
+  static std::atomic<size_t> total_num_prefetched_;
+};
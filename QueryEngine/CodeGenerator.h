@@ -304,7 +304,14 @@ class CodeGenerator {
       const Analyzer::ColumnVar* col_var,
       llvm::Value* col_byte_stream,
       llvm::Value* pos_arg,
-      const WindowFunctionContext* window_function_context = nullptr);
+      const WindowFunctionContext* window_function_context = nullptr,
+      llvm::Value* decode_cursor = nullptr);
+
+  // Pointer to the run or entry of the last row of a run length or sparse encoded column
+  // the row function decoded. It lives in the query function, whose scan loop calls the
+  // row function, and is passed to it like a hoisted literal.
+  llvm::Value* codegenDecodeCursor(const Analyzer::ColumnVar* col_var,
+                                   const bool fetch_column);
 
   // Generates code for a fixed length column when a window function is active.
   llvm::Value* codegenFixedLengthColVarInWindow(
@@ -455,6 +462,22 @@ class CodeGenerator {
                                const char escape_char,
                                const CompilationOptions&);
 
+  llvm::Value* codegenFsstLike(const Analyzer::LikeExpr*,
+                               const char escape_char,
+                               const CompilationOptions&);
+
+  llvm::Value* codegenFsstStrCmp(const SQLOps,
+                                 const Analyzer::Expr*,
+                                 const Analyzer::Expr*,
+                                 const SQLTypeInfo& result_ti,
+                                 const CompilationOptions&);
+
+  llvm::Value* codegenFsstStrCmp(const std::string& fn_base,
+                                 const Analyzer::ColumnVar*,
+                                 const std::string& str,
+                                 const SQLTypeInfo& result_ti,
+                                 const CompilationOptions&);
+
   llvm::Value* codegenDictStrCmp(const std::shared_ptr<Analyzer::Expr>,
                                  const std::shared_ptr<Analyzer::Expr>,
                                  const SQLOps,
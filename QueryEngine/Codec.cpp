@@ -54,23 +54,107 @@ llvm::Instruction* FixedWidthUnsigned::codegenDecode(llvm::Value* byte_stream,
   return llvm::CallInst::Create(f, args);
 }
 
-DiffFixedWidthInt::DiffFixedWidthInt(const size_t byte_width, const int64_t baseline)
-    : byte_width_{byte_width}, baseline_{baseline} {}
+DiffBitPackedInt::DiffBitPackedInt(const int64_t null_val) : null_val_{null_val} {}
 
-llvm::Instruction* DiffFixedWidthInt::codegenDecode(llvm::Value* byte_stream,
-                                                    llvm::Value* pos,
-                                                    llvm::Module* llvm_module) const {
+llvm::Instruction* DiffBitPackedInt::codegenDecode(llvm::Value* byte_stream,
+                                                   llvm::Value* pos,
+                                                   llvm::Module* llvm_module) const {
   auto& context = llvm_module->getContext();
-  auto f = llvm_module->getFunction("diff_fixed_width_int_decode");
+  auto f = llvm_module->getFunction("diff_bit_packed_int_decode");
   CHECK(f);
   llvm::Value* args[] = {
       byte_stream,
-      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
-      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), baseline_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+BitPackedInt::BitPackedInt(const int32_t bit_width, const int64_t null_val)
+    : bit_width_{bit_width}, null_val_{null_val} {}
+
+llvm::Instruction* BitPackedInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  auto f = llvm_module->getFunction("bit_packed_int_decode");
+  CHECK(f);
+  // A constant bit width lets the shifts and masks fold once the decoder is inlined.
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), bit_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
       pos};
   return llvm::CallInst::Create(f, args);
 }
 
+RunLengthInt::RunLengthInt(const size_t byte_width, llvm::Value* run_cursor)
+    : byte_width_{byte_width}, run_cursor_{run_cursor} {}
+
+llvm::Instruction* RunLengthInt::codegenDecode(llvm::Value* byte_stream,
+                                               llvm::Value* pos,
+                                               llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  const auto width_lv =
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_);
+  if (run_cursor_) {
+    auto f = llvm_module->getFunction("run_length_int_decode_cursor");
+    CHECK(f);
+    llvm::Value* args[] = {byte_stream, width_lv, pos, run_cursor_};
+    return llvm::CallInst::Create(f, args);
+  }
+  auto f = llvm_module->getFunction("run_length_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {byte_stream, width_lv, pos};
+  return llvm::CallInst::Create(f, args);
+}
+
+namespace {
+
+llvm::Value* sparse_cursor_or_null(llvm::Value* cursor, llvm::LLVMContext& context) {
+  return cursor ? cursor
+                : llvm::ConstantPointerNull::get(llvm::Type::getInt64PtrTy(context));
+}
+
+}  // namespace
+
+SparseInt::SparseInt(const size_t byte_width,
+                     const int64_t null_val,
+                     llvm::Value* cursor)
+    : byte_width_{byte_width}, null_val_{null_val}, cursor_{cursor} {}
+
+llvm::Instruction* SparseInt::codegenDecode(llvm::Value* byte_stream,
+                                            llvm::Value* pos,
+                                            llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  auto f = llvm_module->getFunction("sparse_int_decode");
+  CHECK(f);
+  llvm::Value* args[] = {
+      byte_stream,
+      llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), byte_width_),
+      llvm::ConstantInt::get(llvm::Type::getInt64Ty(context), null_val_),
+      pos,
+      sparse_cursor_or_null(cursor_, context)};
+  return llvm::CallInst::Create(f, args);
+}
+
+SparseReal::SparseReal(const bool is_double, llvm::Value* cursor)
+    : is_double_(is_double), cursor_(cursor) {}
+
+llvm::Instruction* SparseReal::codegenDecode(llvm::Value* byte_stream,
+                                             llvm::Value* pos,
+                                             llvm::Module* llvm_module) const {
+  auto& context = llvm_module->getContext();
+  auto f = llvm_module->getFunction(is_double_ ? "sparse_double_decode"
+                                               : "sparse_float_decode");
+  CHECK(f);
+  auto null_val =
+      is_double_ ? llvm::ConstantFP::get(llvm::Type::getDoubleTy(context), NULL_DOUBLE)
+                 : llvm::ConstantFP::get(llvm::Type::getFloatTy(context), NULL_FLOAT);
+  llvm::Value* args[] = {
+      byte_stream, null_val, pos, sparse_cursor_or_null(cursor_, context)};
+  return llvm::CallInst::Create(f, args);
+}
+
 FixedWidthReal::FixedWidthReal(const bool is_double) : is_double_(is_double) {}
 
 llvm::Instruction* FixedWidthReal::codegenDecode(llvm::Value* byte_stream,
@@ -53,16 +53,70 @@ class FixedWidthUnsigned : public Decoder {
   const size_t byte_width_;
 };
 
-class DiffFixedWidthInt : public Decoder {
+class DiffBitPackedInt : public Decoder {
  public:
-  DiffFixedWidthInt(const size_t byte_width, const int64_t baseline);
+  DiffBitPackedInt(const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const int64_t null_val_;
+};
+
+class BitPackedInt : public Decoder {
+ public:
+  BitPackedInt(const int32_t bit_width, const int64_t null_val);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const int32_t bit_width_;
+  const int64_t null_val_;
+};
+
+class RunLengthInt : public Decoder {
+ public:
+  // The run lookup starts from *run_cursor when given, see
+  // run_length_encoding::find_run_from.
+  RunLengthInt(const size_t byte_width, llvm::Value* run_cursor = nullptr);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const size_t byte_width_;
+  llvm::Value* run_cursor_;
+};
+
+// The entry lookup of the sparse decoders starts from *cursor when given, see
+// sparse_encoding::find_entry_from.
+class SparseInt : public Decoder {
+ public:
+  SparseInt(const size_t byte_width,
+            const int64_t null_val,
+            llvm::Value* cursor = nullptr);
   llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
                                    llvm::Value* pos,
                                    llvm::Module* llvm_module) const override;
 
  private:
   const size_t byte_width_;
-  const int64_t baseline_;
+  const int64_t null_val_;
+  llvm::Value* cursor_;
+};
+
+class SparseReal : public Decoder {
+ public:
+  SparseReal(const bool is_double, llvm::Value* cursor = nullptr);
+  llvm::Instruction* codegenDecode(llvm::Value* byte_stream,
+                                   llvm::Value* pos,
+                                   llvm::Module* llvm_module) const override;
+
+ private:
+  const bool is_double_;
+  llvm::Value* cursor_;
 };
 
 class FixedWidthReal : public Decoder {
@@ -17,10 +17,16 @@
 #include "QueryEngine/ColumnFetcher.h"
 
 #include <memory>
+#include <numeric>
 
 #include "DataMgr/ArrayNoneEncoder.h"
+#include "DataMgr/BitPackedEncoder.h"
+#include "DataMgr/DiffEncoder.h"
+#include "DataMgr/RunLengthEncoder.h"
+#include "DataMgr/SparseEncoder.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
+#include "Shared/FsstEncoding.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
@@ -97,12 +103,16 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
                        fragment.physicalTableId,
                        hash_col.get_column_id(),
                        fragment.fragmentId};
+    // Block encoded chunks are expanded on the CPU, the callers index rows directly.
+    const bool is_block_encoded = cd->columnType.is_block_encoded();
+    const auto chunk_mem_lvl =
+        is_block_encoded ? Data_Namespace::CPU_LEVEL : effective_mem_lvl;
     const auto chunk = Chunk_NS::Chunk::getChunk(
         cd,
         &catalog.getDataMgr(),
         chunk_key,
-        effective_mem_lvl,
-        effective_mem_lvl == Data_Namespace::CPU_LEVEL ? 0 : device_id,
+        chunk_mem_lvl,
+        chunk_mem_lvl == Data_Namespace::CPU_LEVEL ? 0 : device_id,
         chunk_meta_it->second->numBytes,
         chunk_meta_it->second->numElements);
     chunks_owner.push_back(chunk);
@@ -110,6 +120,15 @@ std::pair<const int8_t*, size_t> ColumnFetcher::getOneColumnFragment(
     auto ab = chunk->getBuffer();
     CHECK(ab->getMemoryPtr());
     col_buff = reinterpret_cast<int8_t*>(ab->getMemoryPtr());
+    if (is_block_encoded) {
+      col_buff = expandBlockEncodedColumn(executor,
+                                          col_buff,
+                                          cd->columnType,
+                                          fragment.getNumTuples(),
+                                          effective_mem_lvl,
+                                          device_allocator,
+                                          thread_idx);
+    }
   } else {  // temporary table
     const ColumnarResults* col_frag{nullptr};
     {
@@ -238,6 +257,12 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
   const bool is_varlen =
       is_real_string ||
       col_type.is_array();  // TODO: should it be col_type.is_varlen_array() ?
+  // FSST encoded columns are only left compressed when the generated code just compares
+  // them with literals.
+  const bool decompress =
+      col_type.is_fsst_string() &&
+      (!executor_->plan_state_ ||
+       executor_->plan_state_->columns_to_decompress_.count({table_id, col_id}));
   {
     ChunkKey chunk_key{
         cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
@@ -245,17 +270,33 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
     if (is_varlen) {
       varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_fetch_mutex_));
     }
+    const auto chunk_memory_level = decompress ? Data_Namespace::CPU_LEVEL : memory_level;
     chunk = Chunk_NS::Chunk::getChunk(
         cd,
         &cat.getDataMgr(),
         chunk_key,
-        memory_level,
-        memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id,
+        chunk_memory_level,
+        chunk_memory_level == Data_Namespace::CPU_LEVEL ? 0 : device_id,
         chunk_meta_it->second->numBytes,
         chunk_meta_it->second->numElements);
     std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
     chunk_holder.push_back(chunk);
   }
+  if (decompress) {
+    auto chunk_iter = decompressFsstChunks(
+        {chunk->begin_iterator(chunk_meta_it->second)}, memory_level, allocator);
+    std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
+    chunk_iter_holder.push_back(chunk_iter);
+    if (memory_level == Data_Namespace::CPU_LEVEL) {
+      return reinterpret_cast<int8_t*>(&chunk_iter_holder.back());
+    }
+    CHECK(allocator);
+    auto chunk_iter_gpu = allocator->alloc(sizeof(ChunkIter));
+    allocator->copyToDevice(chunk_iter_gpu,
+                            reinterpret_cast<int8_t*>(&chunk_iter_holder.back()),
+                            sizeof(ChunkIter));
+    return chunk_iter_gpu;
+  }
   if (is_varlen) {
     CHECK_GT(table_id, 0);
     CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
@@ -282,6 +323,73 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
   }
 }
 
+void ColumnFetcher::prefetchTableColumnFragments(
+    const int table_id,
+    const std::vector<int>& col_ids,
+    const std::vector<size_t>& frag_ids,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunk_holder) const {
+  CHECK_GT(table_id, 0);
+  const auto& cat = *executor_->getCatalog();
+  const auto td = cat.getMetadataForTable(table_id, false);
+  // Foreign tables populate chunks through their data wrappers, chunk by chunk.
+  if (!td || td->isForeignTable() || td->isView) {
+    return;
+  }
+  const auto fragments_it = all_tables_fragments.find(table_id);
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto fragments = fragments_it->second;
+  if (fragments->empty()) {
+    return;
+  }
+  std::vector<Chunk_NS::ChunkRequest> requests;
+  bool has_varlen{false};
+  for (const auto col_id : col_ids) {
+    const auto cd = get_column_descriptor(col_id, table_id, cat);
+    CHECK(cd);
+    if (cd->isVirtualCol) {
+      continue;
+    }
+    for (const auto frag_id : frag_ids) {
+      CHECK_LT(frag_id, fragments->size());
+      const auto& fragment = (*fragments)[frag_id];
+      if (fragment.isEmptyPhysicalFragment()) {
+        continue;
+      }
+      auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+      CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+      requests.push_back({cd,
+                          {cat.getCurrentDB().dbId,
+                           fragment.physicalTableId,
+                           col_id,
+                           fragment.fragmentId},
+                          chunk_meta_it->second->numBytes,
+                          chunk_meta_it->second->numElements});
+      has_varlen = has_varlen || cd->columnType.is_varlen();
+    }
+  }
+  if (requests.empty()) {
+    return;
+  }
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks;
+  {
+    std::unique_ptr<std::lock_guard<std::mutex>> varlen_chunk_lock;
+    if (has_varlen) {
+      varlen_chunk_lock.reset(new std::lock_guard<std::mutex>(varlen_chunk_fetch_mutex_));
+    }
+    try {
+      chunks = Chunk_NS::Chunk::getChunks(
+          requests, &cat.getDataMgr(), Data_Namespace::CPU_LEVEL, 0);
+    } catch (const OutOfMemory& e) {
+      VLOG(1) << "Fetching " << requests.size()
+              << " chunks one at a time, the batch does not fit: " << e.what();
+      return;
+    }
+  }
+  std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
+  chunk_holder.insert(chunk_holder.end(), chunks.begin(), chunks.end());
+}
+
 const int8_t* ColumnFetcher::getAllTableColumnFragments(
     const int table_id,
     const int col_id,
@@ -290,6 +398,19 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
     const int device_id,
     DeviceAllocator* device_allocator,
     const size_t thread_idx) const {
+  {
+    const auto cd = get_column_descriptor(col_id, table_id, *executor_->getCatalog());
+    CHECK(cd);
+    if (cd->columnType.is_block_encoded()) {
+      return linearizeBlockEncodedColumnFragments(table_id,
+                                                  col_id,
+                                                  all_tables_fragments,
+                                                  memory_level,
+                                                  device_id,
+                                                  device_allocator,
+                                                  thread_idx);
+    }
+  }
   const auto fragments_it = all_tables_fragments.find(table_id);
   CHECK(fragments_it != all_tables_fragments.end());
   const auto fragments = fragments_it->second;
@@ -302,6 +423,11 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
     std::lock_guard<std::mutex> columnar_conversion_guard(columnar_fetch_mutex_);
     auto column_it = columnarized_scan_table_cache_.find(col_desc);
     if (column_it == columnarized_scan_table_cache_.end()) {
+      std::list<std::shared_ptr<Chunk_NS::Chunk>> prefetched_chunks;
+      std::vector<size_t> frag_ids(frag_count);
+      std::iota(frag_ids.begin(), frag_ids.end(), size_t(0));
+      prefetchTableColumnFragments(
+          table_id, {col_id}, frag_ids, all_tables_fragments, prefetched_chunks);
       for (size_t frag_id = 0; frag_id < frag_count; ++frag_id) {
         if (g_enable_non_kernel_time_query_interrupt &&
             executor_->checkNonKernelTimeInterrupted()) {
@@ -348,6 +474,225 @@ const int8_t* ColumnFetcher::getAllTableColumnFragments(
                                                device_allocator);
 }
 
+// The kernels decode block encoded columns themselves, so the fragments are merged into
+// a single buffer of the same encoding rather than expanded. Runs and sparse values are
+// concatenated as is, bit packed rows are packed again after each other and deltas are
+// encoded again in a frame covering all the fragments.
+const int8_t* ColumnFetcher::linearizeBlockEncodedColumnFragments(
+    const int table_id,
+    const int col_id,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    const Data_Namespace::MemoryLevel memory_level,
+    const int device_id,
+    DeviceAllocator* device_allocator,
+    const size_t thread_idx) const {
+  const auto fragments_it = all_tables_fragments.find(table_id);
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto fragments = fragments_it->second;
+  const InputColDescriptor col_desc(col_id, table_id, int(0));
+  const auto& cat = *executor_->getCatalog();
+  const auto cd = get_column_descriptor(col_id, table_id, cat);
+  CHECK(cd);
+  const auto value_width = cd->columnType.get_size();
+  std::pair<const int8_t*, size_t> linearized_col;
+  {
+    std::lock_guard<std::mutex> columnar_conversion_guard(columnar_fetch_mutex_);
+    auto column_it = linearized_block_encoded_col_cache_.find(col_desc);
+    if (column_it == linearized_block_encoded_col_cache_.end()) {
+      std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
+      std::vector<const int8_t*> frag_buffers;
+      std::vector<size_t> frag_num_rows;
+      for (const auto& fragment : *fragments) {
+        if (fragment.isEmptyPhysicalFragment()) {
+          continue;
+        }
+        if (g_enable_non_kernel_time_query_interrupt &&
+            executor_->checkNonKernelTimeInterrupted()) {
+          throw QueryExecutionError(Executor::ERR_INTERRUPTED);
+        }
+        auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+        CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+        ChunkKey chunk_key{cat.getCurrentDB().dbId,
+                           fragment.physicalTableId,
+                           col_id,
+                           fragment.fragmentId};
+        auto chunk = Chunk_NS::Chunk::getChunk(cd,
+                                               &cat.getDataMgr(),
+                                               chunk_key,
+                                               Data_Namespace::CPU_LEVEL,
+                                               0,
+                                               chunk_meta_it->second->numBytes,
+                                               chunk_meta_it->second->numElements);
+        CHECK(chunk);
+        chunk_holder.push_back(chunk);
+        const auto frag_buffer = chunk->getBuffer()->getMemoryPtr();
+        CHECK(frag_buffer);
+        frag_buffers.push_back(frag_buffer);
+        frag_num_rows.push_back(chunk_meta_it->second->numElements);
+      }
+      int8_t* buffer{nullptr};
+      size_t num_bytes{0};
+      if (cd->columnType.is_run_length_encoded()) {
+        num_bytes = run_length_encoding::kHeaderBytes;
+        for (const auto frag_buffer : frag_buffers) {
+          num_bytes += run_length_encoding::byte_size(frag_buffer, value_width) -
+                       run_length_encoding::kHeaderBytes;
+        }
+        buffer = executor_->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+        CHECK_EQ(num_bytes,
+                 run_length_encoding::concatenate(frag_buffers, value_width, buffer));
+      } else if (cd->columnType.get_compression() == kENCODING_SPARSE) {
+        num_bytes = sparse_encoding::concatenated_byte_size(frag_buffers, value_width);
+        buffer = executor_->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+        CHECK_EQ(num_bytes,
+                 sparse_encoding::concatenate(frag_buffers, value_width, buffer));
+      } else if (cd->columnType.is_bit_packed()) {
+        const auto bit_width = cd->columnType.get_comp_param();
+        size_t total_rows = 0;
+        for (const auto num_rows : frag_num_rows) {
+          total_rows += num_rows;
+        }
+        num_bytes = bit_packing::byte_size(total_rows, bit_width);
+        buffer = executor_->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+        CHECK_EQ(
+            num_bytes,
+            bit_packing::concatenate(frag_buffers, frag_num_rows, bit_width, buffer));
+      } else {
+        CHECK_EQ(cd->columnType.get_compression(), kENCODING_DIFF);
+        std::vector<int64_t> values;
+        for (size_t i = 0; i < frag_buffers.size(); ++i) {
+          const auto frag_start_row = values.size();
+          values.resize(frag_start_row + frag_num_rows[i]);
+          diff_encoding::decode_rows(
+              frag_buffers[i], 0, frag_num_rows[i], values.data() + frag_start_row);
+        }
+        const auto [frame_base, frame_bit_width] =
+            diff_encoding::frame_of(values.data(), values.size());
+        num_bytes = diff_encoding::byte_size(values.size(), frame_bit_width);
+        buffer = executor_->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+        diff_encoding::encode(
+            values.data(), values.size(), frame_base, frame_bit_width, buffer);
+      }
+      column_it = linearized_block_encoded_col_cache_
+                      .emplace(col_desc, std::make_pair(buffer, num_bytes))
+                      .first;
+    }
+    linearized_col = column_it->second;
+  }
+  if (memory_level == Data_Namespace::GPU_LEVEL) {
+    CHECK(device_allocator);
+    auto gpu_col_buffer = device_allocator->alloc(linearized_col.second);
+    device_allocator->copyToDevice(
+        gpu_col_buffer, linearized_col.first, linearized_col.second);
+    return gpu_col_buffer;
+  }
+  return linearized_col.first;
+}
+
+const int8_t* ColumnFetcher::expandBlockEncodedColumn(
+    Executor* executor,
+    const int8_t* col_buff,
+    const SQLTypeInfo& col_ti,
+    const size_t num_rows,
+    const Data_Namespace::MemoryLevel memory_level,
+    DeviceAllocator* device_allocator,
+    const size_t thread_idx) {
+  const auto value_width = col_ti.get_size();
+  const auto num_bytes = num_rows * value_width;
+  auto expanded_buff = executor->row_set_mem_owner_->allocate(num_bytes, thread_idx);
+  switch (col_ti.get_compression()) {
+    case kENCODING_DICT:
+      CHECK(col_ti.is_run_length_dict_string());
+      run_length_encoding::expand(col_buff, value_width, num_rows, expanded_buff);
+      break;
+    case kENCODING_RL:
+      run_length_encoding::expand(col_buff, value_width, num_rows, expanded_buff);
+      break;
+    case kENCODING_DIFF:
+      diff_encoding::expand(col_buff, num_rows, expanded_buff);
+      break;
+    case kENCODING_SPARSE:
+      sparse_encoding::expand(col_buff, col_ti, num_rows, expanded_buff);
+      break;
+    case kENCODING_FIXED:
+      CHECK(col_ti.is_bit_packed());
+      bit_packing::expand(
+          col_buff, col_ti.get_comp_param(), value_width, num_rows, expanded_buff);
+      break;
+    default:
+      UNREACHABLE() << col_ti.to_string();
+  }
+  if (memory_level == Data_Namespace::GPU_LEVEL) {
+    CHECK(device_allocator);
+    auto gpu_col_buff = device_allocator->alloc(num_bytes);
+    device_allocator->copyToDevice(gpu_col_buff, expanded_buff, num_bytes);
+    return gpu_col_buff;
+  }
+  return expanded_buff;
+}
+
+ChunkIter ColumnFetcher::decompressFsstChunks(
+    const std::vector<ChunkIter>& chunk_iters,
+    const Data_Namespace::MemoryLevel memory_level,
+    DeviceAllocator* device_allocator) const {
+  CHECK(!chunk_iters.empty());
+  size_t num_rows = 0;
+  size_t num_data_bytes = 0;
+  for (const auto& chunk_iter : chunk_iters) {
+    CHECK(chunk_iter.type_info.is_fsst_string());
+    const auto offsets = reinterpret_cast<const StringOffsetT*>(chunk_iter.start_pos);
+    for (size_t i = 0; i < chunk_iter.num_elems; ++i) {
+      const auto codes = chunk_iter.second_buf + offsets[i];
+      num_data_bytes += fsst_encoding::decompressed_length(
+          chunk_iter.second_buf, codes, offsets[i + 1] - offsets[i]);
+    }
+    num_rows += chunk_iter.num_elems;
+  }
+  if (num_data_bytes > static_cast<size_t>(std::numeric_limits<StringOffsetT>::max())) {
+    throw std::runtime_error("Decompressed FSST encoded column exceeds " +
+                             std::to_string(std::numeric_limits<StringOffsetT>::max()) +
+                             " bytes.");
+  }
+  const auto num_index_bytes = (num_rows + 1) * sizeof(StringOffsetT);
+  auto& row_set_mem_owner = executor_->getRowSetMemoryOwner();
+  auto index_buffer = row_set_mem_owner->allocate(num_index_bytes);
+  // at least one byte so that the data buffer of only null rows isn't null
+  auto data_buffer = row_set_mem_owner->allocate(std::max(num_data_bytes, size_t(1)));
+  auto decompressed_offsets = reinterpret_cast<StringOffsetT*>(index_buffer);
+  StringOffsetT data_offset = 0;
+  size_t row = 0;
+  decompressed_offsets[row] = data_offset;
+  for (const auto& chunk_iter : chunk_iters) {
+    const auto offsets = reinterpret_cast<const StringOffsetT*>(chunk_iter.start_pos);
+    for (size_t i = 0; i < chunk_iter.num_elems; ++i) {
+      data_offset += fsst_encoding::decompress(chunk_iter.second_buf,
+                                               chunk_iter.second_buf + offsets[i],
+                                               offsets[i + 1] - offsets[i],
+                                               data_buffer + data_offset);
+      decompressed_offsets[++row] = data_offset;
+    }
+  }
+  CHECK_EQ(static_cast<size_t>(data_offset), num_data_bytes);
+  if (memory_level == Data_Namespace::GPU_LEVEL) {
+    CHECK(device_allocator);
+    auto gpu_index_buffer = device_allocator->alloc(num_index_bytes);
+    device_allocator->copyToDevice(gpu_index_buffer, index_buffer, num_index_bytes);
+    index_buffer = gpu_index_buffer;
+    if (num_data_bytes) {
+      auto gpu_data_buffer = device_allocator->alloc(num_data_bytes);
+      device_allocator->copyToDevice(gpu_data_buffer, data_buffer, num_data_bytes);
+      data_buffer = gpu_data_buffer;
+    }
+  }
+  ChunkIter decompressed_iter = chunk_iters.front();
+  decompressed_iter.type_info.set_comp_param(0);
+  decompressed_iter.current_pos = decompressed_iter.start_pos = index_buffer;
+  decompressed_iter.end_pos = index_buffer + num_rows * sizeof(StringOffsetT);
+  decompressed_iter.second_buf = data_buffer;
+  decompressed_iter.num_elems = num_rows;
+  return decompressed_iter;
+}
+
 const int8_t* ColumnFetcher::getResultSetColumn(
     const InputColDescriptor* col_desc,
     const Data_Namespace::MemoryLevel memory_level,
@@ -462,6 +807,29 @@ const int8_t* ColumnFetcher::linearizeColumnFragments(
     }
   }
 
+  if (cd->columnType.is_fsst_string()) {
+    // The fragments have their own symbol tables, the merged chunk is decompressed.
+    auto merged_chunk_iter = decompressFsstChunks(
+        {local_chunk_iter_holder.begin(), local_chunk_iter_holder.end()},
+        memory_level,
+        device_allocator);
+    {
+      std::lock_guard<std::mutex> chunk_list_lock(chunk_list_mutex_);
+      chunk_holder.insert(
+          chunk_holder.end(), local_chunk_holder.begin(), local_chunk_holder.end());
+      chunk_iter_holder.push_back(merged_chunk_iter);
+    }
+    auto merged_chunk_iter_ptr = reinterpret_cast<int8_t*>(&(chunk_iter_holder.back()));
+    if (memory_level == MemoryLevel::CPU_LEVEL) {
+      return merged_chunk_iter_ptr;
+    }
+    CHECK(device_allocator);
+    auto chunk_iter_gpu = device_allocator->alloc(sizeof(ChunkIter));
+    device_allocator->copyToDevice(
+        chunk_iter_gpu, merged_chunk_iter_ptr, sizeof(ChunkIter));
+    return chunk_iter_gpu;
+  }
+
   auto& col_ti = cd->columnType;
   MergedChunk res{nullptr, nullptr};
   // Do linearize multi-fragmented column depending on column type
@@ -1062,6 +1430,7 @@ ChunkIter ColumnFetcher::prepareChunkIter(AbstractBuffer* merged_data_buf,
   merged_chunk_iter.skip = chunk_iter.skip;
   merged_chunk_iter.skip_size = chunk_iter.skip_size;
   merged_chunk_iter.type_info = chunk_iter.type_info;
+  merged_chunk_iter.decode_cursor = 0;
   return merged_chunk_iter;
 }
 
@@ -86,6 +86,16 @@ class ColumnFetcher {
       const int device_id,
       DeviceAllocator* device_allocator) const;
 
+  //! Loads the CPU chunks of the columns for the fragments of a physical table with a
+  //! single batch of reads and pins them in chunk_holder. Chunks that do not fit in the
+  //! CPU buffer pool together are left to be fetched one at a time.
+  void prefetchTableColumnFragments(
+      const int table_id,
+      const std::vector<int>& col_ids,
+      const std::vector<size_t>& frag_ids,
+      const std::map<int, const TableFragments*>& all_tables_fragments,
+      std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunk_holder) const;
+
   const int8_t* getAllTableColumnFragments(
       const int table_id,
       const int col_id,
@@ -116,6 +126,30 @@ class ColumnFetcher {
   void freeLinearizedBuf();
 
  private:
+  static const int8_t* expandBlockEncodedColumn(
+      Executor* executor,
+      const int8_t* col_buff,
+      const SQLTypeInfo& col_ti,
+      const size_t num_rows,
+      const Data_Namespace::MemoryLevel memory_level,
+      DeviceAllocator* device_allocator,
+      const size_t thread_idx);
+
+  const int8_t* linearizeBlockEncodedColumnFragments(
+      const int table_id,
+      const int col_id,
+      const std::map<int, const TableFragments*>& all_tables_fragments,
+      const Data_Namespace::MemoryLevel memory_level,
+      const int device_id,
+      DeviceAllocator* device_allocator,
+      const size_t thread_idx) const;
+
+  // Decompresses FSST encoded chunks into the buffers of a single none encoded chunk,
+  // owned by the row set memory owner.
+  ChunkIter decompressFsstChunks(const std::vector<ChunkIter>& chunk_iters,
+                                 const Data_Namespace::MemoryLevel memory_level,
+                                 DeviceAllocator* device_allocator) const;
+
   static const int8_t* transferColumnIfNeeded(
       const ColumnarResults* columnar_results,
       const int col_id,
@@ -186,6 +220,9 @@ class ColumnFetcher {
   mutable ColumnCacheMap columnarized_table_cache_;
   mutable std::unordered_map<InputColDescriptor, std::unique_ptr<const ColumnarResults>>
       columnarized_scan_table_cache_;
+  // Merged block encoded fragments and their size in bytes.
+  mutable std::unordered_map<InputColDescriptor, std::pair<const int8_t*, size_t>>
+      linearized_block_encoded_col_cache_;
   using DeviceMergedChunkIterMap = std::unordered_map<int, int8_t*>;
   using DeviceMergedChunkMap = std::unordered_map<int, AbstractBuffer*>;
   mutable std::unordered_map<InputColDescriptor, DeviceMergedChunkIterMap>
@@ -25,7 +25,8 @@ namespace {
 
 // Return the right decoder for a given column expression. Doesn't handle
 // variable length data. The decoder encapsulates the code generation logic.
-std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
+std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var,
+                                         llvm::Value* decode_cursor) {
   const auto enc_type = col_var->get_compression();
   const auto& ti = col_var->get_type_info();
   switch (enc_type) {
@@ -56,6 +57,9 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
     }
     case kENCODING_DICT:
       CHECK(ti.is_string());
+      if (ti.is_run_length_dict_string()) {
+        return std::make_shared<RunLengthInt>(ti.get_size(), decode_cursor);
+      }
       // For dictionary-encoded columns encoded on less than 4 bytes, we can use
       // unsigned representation for double the maximum cardinality. The inline
       // null value is going to be the maximum value of the underlying type.
@@ -65,9 +69,25 @@ std::shared_ptr<Decoder> get_col_decoder(const Analyzer::ColumnVar* col_var) {
       return std::make_shared<FixedWidthInt>(ti.get_size());
     case kENCODING_FIXED: {
       const auto bit_width = col_var->get_comp_param();
+      if (ti.is_bit_packed()) {
+        // Decodes to the logical null, no null adjustment needed.
+        return std::make_shared<BitPackedInt>(bit_width, inline_int_null_val(ti));
+      }
       CHECK_EQ(0, bit_width % 8);
       return std::make_shared<FixedWidthInt>(bit_width / 8);
     }
+    case kENCODING_RL:
+      // Runs hold logical values, nulls included.
+      return std::make_shared<RunLengthInt>(ti.get_logical_size(), decode_cursor);
+    case kENCODING_DIFF:
+      return std::make_shared<DiffBitPackedInt>(inline_int_null_val(ti));
+    case kENCODING_SPARSE:
+      // Null rows have no value stored, the decoders return the null sentinel for them.
+      if (ti.is_fp()) {
+        return std::make_shared<SparseReal>(ti.get_type() == kDOUBLE, decode_cursor);
+      }
+      return std::make_shared<SparseInt>(
+          ti.get_logical_size(), inline_int_null_val(ti), decode_cursor);
     case kENCODING_DATE_IN_DAYS: {
       CHECK(ti.is_date_in_days());
       return col_var->get_comp_param() == 16 ? std::make_shared<FixedWidthSmallDate>(2)
@@ -204,6 +224,12 @@ std::vector<llvm::Value*> CodeGenerator::codegenColVar(const Analyzer::ColumnVar
   }
   const auto& col_ti = col_var->get_type_info();
   if (col_ti.is_string() && col_ti.get_compression() == kENCODING_NONE) {
+    if (col_ti.is_fsst_string()) {
+      // The generated code reads the strings as they are, see
+      // ColumnFetcher::decompressFsstChunks.
+      plan_state_->columns_to_decompress_.insert(
+          std::make_pair(col_var->get_table_id(), col_var->get_column_id()));
+    }
     const auto varlen_str_column_lvs =
         codegenVariableLengthStringColVar(col_byte_stream, pos_arg);
     if (!window_func_context) {
@@ -220,8 +246,13 @@ std::vector<llvm::Value*> CodeGenerator::codegenColVar(const Analyzer::ColumnVar
     return {codegenFixedLengthColVarInWindow(
         col_var, col_byte_stream, pos_arg, window_func_context)};
   }
+  llvm::Value* decode_cursor{nullptr};
+  if (hoist_literals && cgen_state_->query_func_ &&
+      (col_ti.is_run_length_encoded() || col_ti.get_compression() == kENCODING_SPARSE)) {
+    decode_cursor = codegenDecodeCursor(col_var, fetch_column);
+  }
   const auto fixed_length_column_lv =
-      codegenFixedLengthColVar(col_var, col_byte_stream, pos_arg);
+      codegenFixedLengthColVar(col_var, col_byte_stream, pos_arg, nullptr, decode_cursor);
   auto it_ok = cgen_state_->fetch_cache_.insert(
       std::make_pair(col_var_hash, std::vector<llvm::Value*>{fixed_length_column_lv}));
   return {it_ok.first->second};
@@ -244,9 +275,10 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(
     const Analyzer::ColumnVar* col_var,
     llvm::Value* col_byte_stream,
     llvm::Value* pos_arg,
-    const WindowFunctionContext* window_function_context) {
+    const WindowFunctionContext* window_function_context,
+    llvm::Value* decode_cursor) {
   AUTOMATIC_IR_METADATA(cgen_state_);
-  const auto decoder = get_col_decoder(col_var);
+  const auto decoder = get_col_decoder(col_var, decode_cursor);
   auto dec_val = decoder->codegenDecode(col_byte_stream, pos_arg, cgen_state_->module_);
   cgen_state_->ir_builder_.Insert(dec_val);
   auto dec_type = dec_val->getType();
@@ -272,13 +304,14 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(
       }
     }
     if (adjust_fixed_enc_null &&
-        (col_ti.get_compression() == kENCODING_FIXED ||
+        ((col_ti.get_compression() == kENCODING_FIXED && !col_ti.is_bit_packed()) ||
          (col_ti.get_compression() == kENCODING_DICT && col_ti.get_size() < 4)) &&
         !col_ti.get_notnull()) {
       dec_val_cast = codgenAdjustFixedEncNull(dec_val_cast, col_ti);
     }
   } else {
-    CHECK_EQ(kENCODING_NONE, col_ti.get_compression());
+    CHECK(col_ti.get_compression() == kENCODING_NONE ||
+          col_ti.get_compression() == kENCODING_SPARSE);
     CHECK(dec_type->isFloatTy() || dec_type->isDoubleTy());
     if (dec_type->isDoubleTy()) {
       CHECK(col_ti.get_type() == kDOUBLE);
@@ -291,6 +324,36 @@ llvm::Value* CodeGenerator::codegenFixedLengthColVar(
   return dec_val_cast;
 }
 
+llvm::Value* CodeGenerator::codegenDecodeCursor(const Analyzer::ColumnVar* col_var,
+                                                const bool fetch_column) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  CHECK(cgen_state_->query_func_);
+  // Literal loads are keyed by their offset in the literal buffer, cursors by negative
+  // keys so that they can't collide.
+  const auto local_col_id = plan_state_->getLocalColumnId(col_var, fetch_column);
+  const int cursor_key = -1 - local_col_id;
+  const auto cursor_name = "decode_cursor_" + std::to_string(local_col_id);
+  auto entry = cgen_state_->query_func_literal_loads_.find(cursor_key);
+  if (entry == cgen_state_->query_func_literal_loads_.end()) {
+    auto& entry_ir_builder = cgen_state_->query_func_entry_ir_builder_;
+    auto cursor = entry_ir_builder.CreateAlloca(
+        get_int_type(64, cgen_state_->context_), nullptr, cursor_name);
+    entry_ir_builder.CreateStore(cgen_state_->llInt(int64_t(0)), cursor);
+    entry = cgen_state_->query_func_literal_loads_
+                .emplace(cursor_key, std::vector<llvm::Value*>{cursor})
+                .first;
+  }
+  const auto cursor = entry->second.front();
+  auto* int_to_ptr = cgen_state_->ir_builder_.CreateIntToPtr(
+      cgen_state_->llInt(0), llvm::PointerType::get(cursor->getType(), 0));
+  auto placeholder =
+      cgen_state_->ir_builder_.CreateLoad(int_to_ptr->getType()->getPointerElementType(),
+                                          int_to_ptr,
+                                          "__placeholder__literal_" + cursor_name);
+  cgen_state_->row_func_hoisted_literals_[placeholder] = {cursor_key, 0};
+  return placeholder;
+}
+
 llvm::Value* CodeGenerator::codegenFixedLengthColVarInWindow(
     const Analyzer::ColumnVar* col_var,
     llvm::Value* col_byte_stream,
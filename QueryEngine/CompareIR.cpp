@@ -259,6 +259,13 @@ llvm::Value* CodeGenerator::codegenCmp(const Analyzer::BinOper* bin_oper,
   const auto& lhs_ti = lhs->get_type_info();
   const auto& rhs_ti = rhs->get_type_info();
 
+  if (lhs_ti.is_string() && rhs_ti.is_string() && qualifier == kONE) {
+    auto fsst_cmp = codegenFsstStrCmp(optype, lhs, rhs, bin_oper->get_type_info(), co);
+    if (fsst_cmp) {
+      return fsst_cmp;
+    }
+  }
+
   if (lhs_ti.is_string() && rhs_ti.is_string() &&
       !(IS_EQUIVALENCE(optype) || optype == kNE)) {
     auto cmp_str = codegenStrCmp(optype,
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/CpuKernelService.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#ifdef HAVE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
+#include "Logger/Logger.h"
+#include "Shared/measure.h"
+#include "Shared/thread_count.h"
+
+namespace cpu_kernel_service {
+
+namespace {
+
+// The kernels of a run_kernels call, owned by the calling thread until all are finished.
+struct KernelBatch {
+  KernelBatch(const std::function<void(const size_t)>& run_kernel,
+              const size_t num_kernels)
+      : run_kernel(run_kernel), num_kernels(num_kernels), clock_begin(timer_start()) {}
+
+  const std::function<void(const size_t)>& run_kernel;
+  const size_t num_kernels;
+  const std::chrono::steady_clock::time_point clock_begin;
+  // The members below are guarded by the service mutex.
+  size_t next_kernel{0};
+  size_t num_finished{0};
+  int64_t queue_time_ms{-1};
+  std::exception_ptr first_exception;
+  std::condition_variable done_cv;
+};
+
+struct Session {
+  double virtual_time{0};
+  std::deque<KernelBatch*> batches;
+};
+
+std::mutex service_mutex;
+std::unordered_map<std::string, size_t> session_weights;
+// Sessions with queued kernels.
+std::unordered_map<std::string, Session> active_sessions;
+// Virtual time of the session of the last kernel started.
+double service_virtual_time{0};
+
+size_t get_session_weight(const std::string& session) {
+  const auto it = session_weights.find(session);
+  return it == session_weights.end() ? kDefaultSessionWeight : it->second;
+}
+
+// Takes the next kernel of the session with the lowest virtual time. Must be called with
+// the service mutex held.
+std::pair<KernelBatch*, size_t> take_next_kernel() {
+  auto next_session = active_sessions.end();
+  for (auto it = active_sessions.begin(); it != active_sessions.end(); ++it) {
+    if (next_session == active_sessions.end() ||
+        it->second.virtual_time < next_session->second.virtual_time) {
+      next_session = it;
+    }
+  }
+  CHECK(next_session != active_sessions.end());
+  auto& session = next_session->second;
+  CHECK(!session.batches.empty());
+  auto batch = session.batches.front();
+  const auto kernel_idx = batch->next_kernel++;
+  if (batch->next_kernel == batch->num_kernels) {
+    session.batches.pop_front();
+  }
+  service_virtual_time = session.virtual_time;
+  session.virtual_time += 1.0 / get_session_weight(next_session->first);
+  if (session.batches.empty()) {
+    active_sessions.erase(next_session);
+  }
+  return {batch, kernel_idx};
+}
+
+void run_next_kernel() {
+  KernelBatch* batch{nullptr};
+  size_t kernel_idx{0};
+  bool skip_kernel{false};
+  {
+    std::lock_guard<std::mutex> lock(service_mutex);
+    std::tie(batch, kernel_idx) = take_next_kernel();
+    if (batch->queue_time_ms < 0) {
+      batch->queue_time_ms = timer_stop(batch->clock_begin);
+    }
+    skip_kernel = static_cast<bool>(batch->first_exception);
+  }
+  std::exception_ptr exception;
+  if (!skip_kernel) {
+    try {
+#ifdef HAVE_TBB
+      // While the kernel waits for its nested parallel work, its thread must not start
+      // the kernels of other queries on top of it.
+      tbb::this_task_arena::isolate(
+          [batch, kernel_idx] { batch->run_kernel(kernel_idx); });
+#else
+      batch->run_kernel(kernel_idx);
+#endif  // HAVE_TBB
+    } catch (...) {
+      exception = std::current_exception();
+    }
+  }
+  std::lock_guard<std::mutex> lock(service_mutex);
+  if (exception && !batch->first_exception) {
+    batch->first_exception = exception;
+  }
+  if (++batch->num_finished == batch->num_kernels) {
+    batch->done_cv.notify_all();
+  }
+}
+
+#ifdef HAVE_TBB
+tbb::task_arena& get_kernel_arena() {
+  static auto arena = [] {
+    auto arena = std::make_unique<tbb::task_arena>();
+    // No slots are reserved for external threads, which only queue kernels and wait.
+    arena->initialize(cpu_threads(), 0);
+    return arena;
+  }();
+  return *arena;
+}
+#endif  // HAVE_TBB
+
+}  // namespace
+
+bool can_run_kernels() {
+#ifdef HAVE_TBB
+  return true;
+#else
+  return false;
+#endif  // HAVE_TBB
+}
+
+void set_session_weight(const std::string& session, const size_t weight) {
+  CHECK_GE(weight, size_t(1));
+  CHECK_LE(weight, kMaxSessionWeight);
+  std::lock_guard<std::mutex> lock(service_mutex);
+  session_weights[session] = weight;
+}
+
+void remove_session(const std::string& session) {
+  std::lock_guard<std::mutex> lock(service_mutex);
+  session_weights.erase(session);
+}
+
+int64_t run_kernels(const std::string& session,
+                    const size_t num_kernels,
+                    const std::function<void(const size_t)>& run_kernel) {
+#ifdef HAVE_TBB
+  if (num_kernels == 0) {
+    return 0;
+  }
+  KernelBatch batch(run_kernel, num_kernels);
+  {
+    std::lock_guard<std::mutex> lock(service_mutex);
+    auto [it, inserted] = active_sessions.try_emplace(session);
+    if (inserted) {
+      it->second.virtual_time = service_virtual_time;
+    }
+    it->second.batches.push_back(&batch);
+  }
+  // Every task starts the next kernel picked by the scheduler, not necessarily one of
+  // this batch, and there are as many tasks as queued kernels.
+  auto& arena = get_kernel_arena();
+  tbb::task_group tg;
+  arena.execute([&tg, num_kernels] {
+    for (size_t i = 0; i < num_kernels; ++i) {
+      tg.run(run_next_kernel);
+    }
+  });
+  // The tasks run in the arena, so they must be waited for in it as well.
+  arena.execute([&tg] { tg.wait(); });
+  // The tasks of this batch may have started the kernels of other batches, whose tasks
+  // may still be running some of this one.
+  std::unique_lock<std::mutex> lock(service_mutex);
+  batch.done_cv.wait(lock, [&batch] { return batch.num_finished == batch.num_kernels; });
+  if (batch.first_exception) {
+    std::rethrow_exception(batch.first_exception);
+  }
+  return batch.queue_time_ms;
+#else
+  UNREACHABLE();
+  return 0;
+#endif  // HAVE_TBB
+}
+
+}  // namespace cpu_kernel_service
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    CpuKernelService.h
+ * @brief   Runs the CPU execution kernels of concurrent queries on one shared TBB arena,
+ *          sharing it between sessions by weight.
+ *
+ * The kernels are queued under the session of their query. Every session has a virtual
+ * time which advances by 1 / weight for each kernel of the session started, and a free
+ * thread of the arena always starts a kernel of the session with the lowest virtual time.
+ * Sessions with queued kernels thus get arena threads in proportion to their weights, and
+ * a session that had nothing queued starts at the virtual time of the last kernel
+ * started, so a short query of a session is not queued behind all the kernels of a long
+ * query of another one.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace cpu_kernel_service {
+
+constexpr size_t kDefaultSessionWeight{1};
+constexpr size_t kMaxSessionWeight{1000};
+
+// Returns true if kernels can be run on the shared arena in this build.
+bool can_run_kernels();
+
+// Sets the weight of the kernels of the session, between 1 and kMaxSessionWeight.
+void set_session_weight(const std::string& session, const size_t weight);
+
+// Forgets the weight of the session, once it is disconnected.
+void remove_session(const std::string& session);
+
+/**
+ * Calls run_kernel(kernel_idx) for every kernel on the shared arena and waits for them.
+ * Once a kernel throws, the kernels not started yet are skipped and the first exception
+ * is rethrown. Returns the time in milliseconds the first kernel was queued for.
+ */
+int64_t run_kernels(const std::string& session,
+                    const size_t num_kernels,
+                    const std::function<void(const size_t)>& run_kernel);
+
+}  // namespace cpu_kernel_service
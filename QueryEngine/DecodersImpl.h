@@ -24,6 +24,10 @@
 #define QUERYENGINE_DECODERSIMPL_H
 
 #include <cstdint>
+#include "../Shared/BitPacking.h"
+#include "../Shared/DiffEncoding.h"
+#include "../Shared/RunLengthEncoding.h"
+#include "../Shared/SparseEncoding.h"
 #include "../Shared/funcannotations.h"
 #include "ExtractFromTime.h"
 
@@ -102,11 +106,135 @@ SUFFIX(fixed_width_unsigned_decode_noinline)(const int8_t* byte_stream,
 }
 
 extern "C" DEVICE ALWAYS_INLINE int64_t
-SUFFIX(diff_fixed_width_int_decode)(const int8_t* byte_stream,
-                                    const int32_t byte_width,
-                                    const int64_t baseline,
-                                    const int64_t pos) {
-  return SUFFIX(fixed_width_int_decode)(byte_stream, byte_width, pos) + baseline;
+SUFFIX(diff_bit_packed_int_decode)(const int8_t* byte_stream,
+                                   const int64_t null_val,
+                                   const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  return diff_encoding::decode(byte_stream, pos, null_val);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(diff_bit_packed_int_decode_noinline)(const int8_t* byte_stream,
+                                            const int64_t null_val,
+                                            const int64_t pos) {
+  return SUFFIX(diff_bit_packed_int_decode)(byte_stream, null_val, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(bit_packed_int_decode)(const int8_t* byte_stream,
+                              const int32_t bit_width,
+                              const int64_t null_val,
+                              const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  return bit_packing::decode(byte_stream, bit_width, pos, null_val);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(bit_packed_int_decode_noinline)(const int8_t* byte_stream,
+                                       const int32_t bit_width,
+                                       const int64_t null_val,
+                                       const int64_t pos) {
+  return SUFFIX(bit_packed_int_decode)(byte_stream, bit_width, null_val, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_int_decode)(const int8_t* byte_stream,
+                              const int32_t byte_width,
+                              const int64_t pos) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  return run_length_encoding::decode(byte_stream, byte_width, pos);
+}
+
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(run_length_int_decode_cursor)(const int8_t* byte_stream,
+                                     const int32_t byte_width,
+                                     const int64_t pos,
+                                     int64_t* run_cursor) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  return run_length_encoding::decode_from(byte_stream, byte_width, pos, run_cursor);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(run_length_int_decode_noinline)(const int8_t* byte_stream,
+                                       const int32_t byte_width,
+                                       const int64_t pos) {
+  return SUFFIX(run_length_int_decode)(byte_stream, byte_width, pos);
+}
+
+// The sparse decoders start the lookup from *cursor and move it, unless cursor is null.
+extern "C" DEVICE ALWAYS_INLINE int64_t
+SUFFIX(sparse_int_decode)(const int8_t* byte_stream,
+                          const int32_t byte_width,
+                          const int64_t null_val,
+                          const int64_t pos,
+                          int64_t* cursor) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto idx = sparse_encoding::value_index(byte_stream, byte_width, pos, cursor);
+  return idx < 0 ? null_val
+                 : SUFFIX(fixed_width_int_decode)(
+                       sparse_encoding::value_ptr(byte_stream, byte_width, idx),
+                       byte_width,
+                       0);
+}
+
+extern "C" DEVICE NEVER_INLINE int64_t
+SUFFIX(sparse_int_decode_noinline)(const int8_t* byte_stream,
+                                   const int32_t byte_width,
+                                   const int64_t null_val,
+                                   const int64_t pos) {
+  return SUFFIX(sparse_int_decode)(byte_stream, byte_width, null_val, pos, nullptr);
+}
+
+extern "C" DEVICE ALWAYS_INLINE float SUFFIX(sparse_float_decode)(
+    const int8_t* byte_stream,
+    const float null_val,
+    const int64_t pos,
+    int64_t* cursor) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto idx = sparse_encoding::value_index(byte_stream, sizeof(float), pos, cursor);
+  return idx < 0 ? null_val
+                 : *reinterpret_cast<const float*>(
+                       sparse_encoding::value_ptr(byte_stream, sizeof(float), idx));
+}
+
+extern "C" DEVICE NEVER_INLINE float SUFFIX(sparse_float_decode_noinline)(
+    const int8_t* byte_stream,
+    const float null_val,
+    const int64_t pos) {
+  return SUFFIX(sparse_float_decode)(byte_stream, null_val, pos, nullptr);
+}
+
+extern "C" DEVICE ALWAYS_INLINE double SUFFIX(sparse_double_decode)(
+    const int8_t* byte_stream,
+    const double null_val,
+    const int64_t pos,
+    int64_t* cursor) {
+#ifdef WITH_DECODERS_BOUNDS_CHECKING
+  assert(pos >= 0);
+#endif  // WITH_DECODERS_BOUNDS_CHECKING
+  const auto idx = sparse_encoding::value_index(byte_stream, sizeof(double), pos, cursor);
+  return idx < 0 ? null_val
+                 : *reinterpret_cast<const double*>(
+                       sparse_encoding::value_ptr(byte_stream, sizeof(double), idx));
+}
+
+extern "C" DEVICE NEVER_INLINE double SUFFIX(sparse_double_decode_noinline)(
+    const int8_t* byte_stream,
+    const double null_val,
+    const int64_t pos) {
+  return SUFFIX(sparse_double_decode)(byte_stream, null_val, pos, nullptr);
 }
 
 extern "C" DEVICE ALWAYS_INLINE float SUFFIX(
@@ -152,8 +152,12 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     }
 
     const auto& fragment = (*fragments)[i];
-    const auto skip_frag = executor->skipFragment(
-        table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
+    const auto skip_frag = executor->skipFragment(table_desc,
+                                                  fragment,
+                                                  ra_exe_unit.simple_quals,
+                                                  ra_exe_unit.quals,
+                                                  frag_offsets,
+                                                  i);
     if (skip_frag.first) {
       continue;
     }
@@ -380,6 +384,7 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
     auto skip_frag = executor->skipFragment(outer_table_desc,
                                             fragment,
                                             ra_exe_unit.simple_quals,
+                                            ra_exe_unit.quals,
                                             frag_offsets,
                                             outer_frag_id);
     if (enable_inner_join_fragment_skipping &&
@@ -29,12 +29,17 @@
 #include "DataMgr/DataMgr.h"
 #include "Logger/Logger.h"
 #include "QueryEngine/CountDistinct.h"
+#include "QueryEngine/GroupByBufferPool.h"
 #include "QueryEngine/StringDictionaryGenerations.h"
 #include "QueryEngine/TableFunctionMetadataType.h"
 #include "Shared/quantile.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 #include "StringOps/StringOps.h"
 
+#ifdef HAVE_TBB
+#include <tbb/task_arena.h>
+#endif
+
 namespace Catalog_Namespace {
 class Catalog;
 }
@@ -50,39 +55,49 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   RowSetMemoryOwner(const size_t arena_block_size, const size_t num_kernel_threads = 0)
       : arena_block_size_(arena_block_size) {
     for (size_t i = 0; i < num_kernel_threads + 1; i++) {
-      allocators_.emplace_back(std::make_unique<DramArena>(arena_block_size));
+      thread_states_.emplace_back(std::make_unique<ThreadState>());
+      thread_states_.back()->allocator = std::make_unique<DramArena>(arena_block_size);
     }
-    CHECK(!allocators_.empty());
+    CHECK(!thread_states_.empty());
   }
 
   enum class StringTranslationType { SOURCE_INTERSECTION, SOURCE_UNION };
 
   int8_t* allocate(const size_t num_bytes, const size_t thread_idx = 0) override {
-    CHECK_LT(thread_idx, allocators_.size());
-    auto allocator = allocators_[thread_idx].get();
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    return reinterpret_cast<int8_t*>(allocator->allocate(num_bytes));
+    auto& state = getThreadState(thread_idx);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return reinterpret_cast<int8_t*>(state.allocator->allocate(num_bytes));
   }
 
   int8_t* allocateCountDistinctBuffer(const size_t num_bytes,
                                       const size_t thread_idx = 0) {
-    int8_t* buffer = allocate(num_bytes, thread_idx);
+    auto& state = getThreadState(thread_idx);
+    int8_t* buffer;
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      buffer = reinterpret_cast<int8_t*>(state.allocator->allocate(num_bytes));
+      state.count_distinct_bitmaps.emplace_back(
+          CountDistinctBitmapBuffer{buffer, num_bytes, /*physical_buffer=*/true});
+    }
     std::memset(buffer, 0, num_bytes);
-    addCountDistinctBuffer(buffer, num_bytes, /*physical_buffer=*/true);
     return buffer;
   }
 
   void addCountDistinctBuffer(int8_t* count_distinct_buffer,
                               const size_t bytes,
-                              const bool physical_buffer) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_bitmaps_.emplace_back(
+                              const bool physical_buffer,
+                              const size_t thread_idx = 0) {
+    auto& state = getThreadState(thread_idx);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.count_distinct_bitmaps.emplace_back(
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(CountDistinctSet* count_distinct_set) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_sets_.push_back(count_distinct_set);
+  void addCountDistinctSet(CountDistinctSet* count_distinct_set,
+                           const size_t thread_idx = 0) {
+    auto& state = getThreadState(thread_idx);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.count_distinct_sets.push_back(count_distinct_set);
   }
 
   void addGroupByBuffer(int64_t* group_by_buffer) {
@@ -90,6 +105,12 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     group_by_buffers_.push_back(group_by_buffer);
   }
 
+  // The buffer is given back to the GroupByBufferPool on destruction.
+  void addPooledGroupByBuffer(int8_t* group_by_buffer) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    pooled_group_by_buffers_.push_back(group_by_buffer);
+  }
+
   void addVarlenBuffer(void* varlen_buffer) {
     std::lock_guard<std::mutex> lock(state_mutex_);
     if (std::find(varlen_buffers_.begin(), varlen_buffers_.end(), varlen_buffer) ==
@@ -109,16 +130,31 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     varlen_input_buffers_.push_back(buffer);
   }
 
-  std::string* addString(const std::string& str) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    strings_.emplace_back(str);
-    return &strings_.back();
+  // Returns the thread index for allocations made from the calling TBB worker, or 0
+  // when called from outside of a TBB arena.
+  size_t getCurrentThreadIdx() const {
+#ifdef HAVE_TBB
+    const auto arena_thread_idx = tbb::this_task_arena::current_thread_index();
+    if (arena_thread_idx >= 0) {
+      return static_cast<size_t>(arena_thread_idx) % thread_states_.size();
+    }
+#endif  // HAVE_TBB
+    return 0;
   }
 
-  std::vector<int64_t>* addArray(const std::vector<int64_t>& arr) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    arrays_.emplace_back(arr);
-    return &arrays_.back();
+  std::string* addString(const std::string& str, const size_t thread_idx = 0) {
+    auto& state = getThreadState(thread_idx);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.strings.emplace_back(str);
+    return &state.strings.back();
+  }
+
+  std::vector<int64_t>* addArray(const std::vector<int64_t>& arr,
+                                 const size_t thread_idx = 0) {
+    auto& state = getThreadState(thread_idx);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.arrays.emplace_back(arr);
+    return &state.arrays.back();
   }
 
   StringDictionaryProxy* addStringDict(std::shared_ptr<StringDictionary> str_dict,
@@ -269,12 +305,17 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   }
 
   ~RowSetMemoryOwner() {
-    for (auto count_distinct_set : count_distinct_sets_) {
-      delete count_distinct_set;
+    for (auto& state : thread_states_) {
+      for (auto count_distinct_set : state->count_distinct_sets) {
+        delete count_distinct_set;
+      }
     }
     for (auto group_by_buffer : group_by_buffers_) {
       free(group_by_buffer);
     }
+    for (auto group_by_buffer : pooled_group_by_buffers_) {
+      GroupByBufferPool::instance().release(group_by_buffer);
+    }
     for (auto varlen_buffer : varlen_buffers_) {
       free(varlen_buffer);
     }
@@ -340,12 +381,29 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     const bool physical_buffer;
   };
 
-  std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<CountDistinctSet*> count_distinct_sets_;
+  /**
+   * Allocations and outputs of a kernel thread. Kernels only use the state of their
+   * thread index, so they do not contend on state_mutex_. The mutex of the state is
+   * still taken, as callers that do not know their thread index share the state of
+   * index 0 and kernels beyond the number of threads reuse the indices.
+   */
+  struct alignas(64) ThreadState {
+    std::mutex mutex;
+    std::unique_ptr<Arena> allocator;
+    std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps;
+    std::vector<CountDistinctSet*> count_distinct_sets;
+    std::list<std::string> strings;
+    std::list<std::vector<int64_t>> arrays;
+  };
+
+  ThreadState& getThreadState(const size_t thread_idx) {
+    CHECK_LT(thread_idx, thread_states_.size());
+    return *thread_states_[thread_idx];
+  }
+
   std::vector<int64_t*> group_by_buffers_;
+  std::vector<int8_t*> pooled_group_by_buffers_;
   std::vector<void*> varlen_buffers_;
-  std::list<std::string> strings_;
-  std::list<std::vector<int64_t>> arrays_;
   std::unordered_map<int, std::shared_ptr<StringDictionaryProxy>> str_dict_proxy_owned_;
   std::map<std::string, StringDictionaryProxy::IdMap>
       str_proxy_intersection_translation_maps_owned_;
@@ -362,7 +420,7 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
       string_ops_owned_;
 
   size_t arena_block_size_;  // for cloning
-  std::vector<std::unique_ptr<Arena>> allocators_;
+  std::vector<std::unique_ptr<ThreadState>> thread_states_;
 
   mutable std::mutex state_mutex_;
 
@@ -36,13 +36,17 @@
 #include "Catalog/Catalog.h"
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "DataMgr/ForeignStorage/FsiChunkUtils.h"
 #include "OSDependent/heavyai_path.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/AggregateUtils.h"
 #include "QueryEngine/AggregatedColRange.h"
+#include "QueryEngine/ChunkPrefetcher.h"
 #include "QueryEngine/CodeGenerator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/CpuKernelService.h"
+#include "QueryEngine/DateTimeTranslator.h"
 #include "QueryEngine/Descriptors/QueryCompilationDescriptor.h"
 #include "QueryEngine/Descriptors/QueryFragmentDescriptor.h"
 #include "QueryEngine/DynamicWatchdog.h"
@@ -51,10 +55,13 @@
 #include "QueryEngine/ExpressionRewrite.h"
 #include "QueryEngine/ExternalCacheInvalidators.h"
 #include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/GroupByBufferPool.h"
 #include "QueryEngine/InPlaceSort.h"
 #include "QueryEngine/JoinHashTable/BaselineJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/RuntimeJoinFilter.h"
 #include "QueryEngine/JsonAccessors.h"
+#include "QueryEngine/NumaKernelScheduler.h"
 #include "QueryEngine/OutputBufferInitialization.h"
 #include "QueryEngine/QueryDispatchQueue.h"
 #include "QueryEngine/QueryEngine.h"
@@ -67,6 +74,7 @@
 #include "QueryEngine/TableFunctions/TableFunctionCompilationContext.h"
 #include "QueryEngine/TableFunctions/TableFunctionExecutionContext.h"
 #include "QueryEngine/Visitors/TransientStringLiteralsVisitor.h"
+#include "Shared/RunLengthEncoding.h"
 #include "Shared/SystemParameters.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/checked_alloc.h"
@@ -81,6 +89,7 @@ bool g_enable_dynamic_watchdog{false};
 size_t g_watchdog_none_encoded_string_translation_limit{1000000UL};
 bool g_enable_cpu_sub_tasks{false};
 size_t g_cpu_sub_task_size{500'000};
+bool g_enable_shared_cpu_kernel_pool{false};
 bool g_enable_filter_function{true};
 unsigned g_dynamic_watchdog_time_limit{10000};
 bool g_allow_cpu_retry{true};
@@ -89,6 +98,7 @@ bool g_null_div_by_zero{false};
 unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
+bool g_enable_runtime_join_filters{true};
 extern bool g_enable_smem_group_by;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
@@ -509,6 +519,7 @@ void Executor::clearMemory(const Data_Namespace::MemoryLevel memory_level) {
         // For now, assume the user wants to purge the hash table cache when they clear
         // CPU memory (currently used in ExecuteTest to lower memory pressure)
         JoinHashTableCacheInvalidator::invalidateCaches();
+        GroupByBufferPool::instance().clear();
       }
       ResultSetCacheInvalidator::invalidateCaches();
       Catalog_Namespace::SysCatalog::instance().getDataMgr().clearMemory(memory_level);
@@ -1306,13 +1317,14 @@ ResultSetPtr Executor::resultsUnion(SharedKernelContext& shared_context,
                                        gridSize());
   }
   using IndexedResultSet = std::pair<ResultSetPtr, std::vector<size_t>>;
-  std::sort(results_per_device.begin(),
-            results_per_device.end(),
-            [](const IndexedResultSet& lhs, const IndexedResultSet& rhs) {
-              CHECK_GE(lhs.second.size(), size_t(1));
-              CHECK_GE(rhs.second.size(), size_t(1));
-              return lhs.second.front() < rhs.second.front();
-            });
+  // The results of the sub-tasks of a fragment are added in the order of their rows.
+  std::stable_sort(results_per_device.begin(),
+                   results_per_device.end(),
+                   [](const IndexedResultSet& lhs, const IndexedResultSet& rhs) {
+                     CHECK_GE(lhs.second.size(), size_t(1));
+                     CHECK_GE(rhs.second.size(), size_t(1));
+                     return lhs.second.front() < rhs.second.front();
+                   });
 
   return get_merged_result(results_per_device, targets);
 }
@@ -2667,12 +2679,55 @@ std::vector<std::unique_ptr<ExecutionKernel>> Executor::createKernels(
   return execution_kernels;
 }
 
+namespace {
+// Returns the NUMA node that holds the outer table chunks of the kernel, if any.
+std::optional<size_t> get_kernel_numa_node(
+    const ExecutionKernel& kernel,
+    const std::vector<InputTableInfo>& query_infos) {
+  const auto& frag_list = kernel.getFragmentsList();
+  if (frag_list.empty() || frag_list[0].fragment_ids.empty()) {
+    return std::nullopt;
+  }
+  for (const auto& query_info : query_infos) {
+    if (query_info.table_id == frag_list[0].table_id) {
+      const auto& fragments = query_info.info.fragments;
+      const auto frag_idx = frag_list[0].fragment_ids[0];
+      if (frag_idx < fragments.size() && fragments[frag_idx].fragmentId >= 0) {
+        return Buffer_Namespace::get_numa_node_for_fragment(
+            fragments[frag_idx].fragmentId);
+      }
+      break;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the session the CPU kernel service schedules the kernels of the unit under.
+std::string get_kernel_session(const RelAlgExecutionUnit* ra_exe_unit) {
+  if (ra_exe_unit && ra_exe_unit->query_state) {
+    const auto& session_data = ra_exe_unit->query_state->getSessionData();
+    if (session_data) {
+      return session_data->public_session_id;
+    }
+  }
+  return "";
+}
+}  // namespace
+
 void Executor::launchKernels(SharedKernelContext& shared_context,
                              std::vector<std::unique_ptr<ExecutionKernel>>&& kernels,
                              const ExecutorDeviceType device_type) {
-  auto clock_begin = timer_start();
-  std::lock_guard<std::mutex> kernel_lock(kernel_mutex_);
-  kernel_queue_time_ms_ += timer_stop(clock_begin);
+  // The CPU kernels of concurrent queries are interleaved by the kernel service, only
+  // the other kernels are run one query at a time.
+  const bool use_cpu_kernel_service = g_enable_shared_cpu_kernel_pool &&
+                                      device_type == ExecutorDeviceType::CPU &&
+                                      cpu_kernel_service::can_run_kernels();
+  std::unique_lock<std::mutex> kernel_lock(kernel_mutex_, std::defer_lock);
+  if (!use_cpu_kernel_service) {
+    auto clock_begin = timer_start();
+    kernel_lock.lock();
+    kernel_queue_time_ms_ += timer_stop(clock_begin);
+  }
 
   threading::task_group tg;
   // A hack to have unused unit for results collection.
@@ -2686,22 +2741,72 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
   ScopeGuard pool_guard([&shared_context]() { shared_context.setThreadPool(nullptr); });
 #endif  // HAVE_TBB
 
+  std::unique_ptr<ChunkPrefetcher> chunk_prefetcher;
+  if (g_enable_chunk_prefetch && kernels.size() > 1) {
+    CHECK(catalog_);
+    CHECK(plan_state_);
+    std::vector<const FragmentsList*> kernel_fragments;
+    for (const auto& kernel : kernels) {
+      kernel_fragments.push_back(&kernel->getFragmentsList());
+    }
+    chunk_prefetcher = std::make_unique<ChunkPrefetcher>(*catalog_,
+                                                         shared_context.getQueryInfos(),
+                                                         plan_state_->columns_to_fetch_,
+                                                         kernel_fragments,
+                                                         g_chunk_prefetch_max_bytes,
+                                                         g_chunk_prefetch_num_kernels);
+  }
+
   VLOG(1) << "Launching " << kernels.size() << " kernels for query on "
           << (device_type == ExecutorDeviceType::CPU ? "CPU"s : "GPU"s) << ".";
-  size_t kernel_idx = 1;
-  for (auto& kernel : kernels) {
-    CHECK(kernel.get());
-    tg.run([this,
-            &kernel,
-            &shared_context,
-            parent_thread_id = logger::thread_id(),
-            crt_kernel_idx = kernel_idx++] {
-      DEBUG_TIMER_NEW_THREAD(parent_thread_id);
-      const size_t thread_i = crt_kernel_idx % cpu_threads();
-      kernel->run(this, thread_i, shared_context);
+  auto run_kernel = [this,
+                     &kernels,
+                     &shared_context,
+                     prefetcher = chunk_prefetcher.get(),
+                     parent_thread_id =
+                         logger::thread_id()](const size_t crt_kernel_idx) {
+    DEBUG_TIMER_NEW_THREAD(parent_thread_id);
+    const size_t thread_i = crt_kernel_idx % cpu_threads();
+    if (prefetcher) {
+      prefetcher->kernelStarted(crt_kernel_idx - 1);
+    }
+    ScopeGuard prefetch_guard = [prefetcher, crt_kernel_idx] {
+      if (prefetcher) {
+        prefetcher->kernelFinished(crt_kernel_idx - 1);
+      }
+    };
+    kernels[crt_kernel_idx - 1]->run(this, thread_i, shared_context);
+  };
+  if (use_cpu_kernel_service) {
+    for (const auto& kernel : kernels) {
+      CHECK(kernel.get());
+    }
+    kernel_queue_time_ms_ += cpu_kernel_service::run_kernels(
+        get_kernel_session(ra_exe_unit),
+        kernels.size(),
+        [&run_kernel](const size_t kernel_idx) { run_kernel(kernel_idx + 1); });
+  } else if (g_enable_numa_aware_placement && device_type == ExecutorDeviceType::CPU &&
+             kernels.size() > 1 && can_run_kernels_on_numa_nodes()) {
+    std::vector<std::optional<size_t>> kernel_numa_nodes;
+    for (const auto& kernel : kernels) {
+      CHECK(kernel.get());
+      kernel_numa_nodes.emplace_back(
+          get_kernel_numa_node(*kernel, shared_context.getQueryInfos()));
+    }
+    // The CPU buffer pool homes the chunks of a fragment on a NUMA node, so run the
+    // kernel of the fragment there.
+    run_kernels_on_numa_nodes(kernel_numa_nodes, [&run_kernel](const size_t kernel_idx) {
+      run_kernel(kernel_idx + 1);
     });
+  } else {
+    for (size_t kernel_idx = 1; kernel_idx <= kernels.size(); ++kernel_idx) {
+      CHECK(kernels[kernel_idx - 1].get());
+      tg.run([&run_kernel, kernel_idx] { run_kernel(kernel_idx); });
+    }
   }
+  // Also waits for the sub-tasks of the kernels
   tg.wait();
+  chunk_prefetcher.reset();
 
   for (auto& exec_ctx : shared_context.getTlsExecutionContext()) {
     // The first arg is used for GPU only, it's not our case.
@@ -2967,6 +3072,29 @@ FetchResult Executor::fetchChunks(
                             selected_fragments,
                             ra_exe_unit);
 
+  // Read the chunks of the kernel's table columns into the CPU buffer pool with one
+  // batch per table, so that the loop below finds them there.
+  std::map<int, std::vector<int>> table_col_ids_by_nest_level;
+  for (const auto& col_id : col_global_ids) {
+    CHECK(col_id);
+    const auto& scan_desc = col_id->getScanDesc();
+    if (scan_desc.getSourceType() == InputSourceType::TABLE &&
+        scan_desc.getTableId() > 0 &&
+        !needFetchAllFragments(*col_id, ra_exe_unit, selected_fragments)) {
+      table_col_ids_by_nest_level[scan_desc.getNestLevel()].push_back(col_id->getColId());
+    }
+  }
+  std::list<std::shared_ptr<Chunk_NS::Chunk>> prefetched_chunks;
+  for (const auto& [nest_level, col_ids] : table_col_ids_by_nest_level) {
+    CHECK_LT(static_cast<size_t>(nest_level), selected_fragments.size());
+    const auto& table_fragments = selected_fragments[nest_level];
+    column_fetcher.prefetchTableColumnFragments(table_fragments.table_id,
+                                                col_ids,
+                                                table_fragments.fragment_ids,
+                                                all_tables_fragments,
+                                                prefetched_chunks);
+  }
+
   CartesianProduct<std::vector<std::vector<size_t>>> frag_ids_crossjoin(
       selected_fragments_crossjoin);
   std::vector<std::vector<const int8_t*>> all_frag_col_buffers;
@@ -3324,6 +3452,122 @@ class OutVecOwner {
 };
 }  // namespace
 
+std::vector<int64_t*> Executor::aggregateRunLengthColumns(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<Analyzer::Expr*>& target_exprs,
+    const std::vector<std::vector<const int8_t*>>& col_buffers,
+    const std::vector<std::vector<int64_t>>& num_rows,
+    const QueryExecutionContext* query_exe_context) const {
+  if (ra_exe_unit.input_descs.size() != 1 || ra_exe_unit.estimator ||
+      !ra_exe_unit.join_quals.empty() || !ra_exe_unit.simple_quals.empty() ||
+      !ra_exe_unit.quals.empty()) {
+    return {};
+  }
+  const auto& input_desc = ra_exe_unit.input_descs.front();
+  if (input_desc.getSourceType() != InputSourceType::TABLE ||
+      input_desc.getTableId() <= 0 ||
+      plan_state_->getDeletedColForTable(input_desc.getTableId())) {
+    return {};
+  }
+  // Local id of the column of each target, -1 for COUNT(*).
+  std::vector<int> local_col_ids;
+  bool has_run_length_col{false};
+  for (size_t target_idx = 0; target_idx < target_exprs.size(); ++target_idx) {
+    const auto agg_expr =
+        dynamic_cast<const Analyzer::AggExpr*>(target_exprs[target_idx]);
+    if (!agg_expr || agg_expr->get_is_distinct() ||
+        query_exe_context->query_mem_desc_.getPaddedSlotWidthBytes(target_idx) != 8) {
+      return {};
+    }
+    const auto agg_kind = agg_expr->get_aggtype();
+    if (!agg_expr->get_arg()) {
+      if (agg_kind != kCOUNT) {
+        return {};
+      }
+      local_col_ids.push_back(-1);
+      continue;
+    }
+    const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(agg_expr->get_arg());
+    if (!col_var || col_var->get_rte_idx() != 0 ||
+        !col_var->get_type_info().is_run_length_encoded()) {
+      return {};
+    }
+    const auto& ti = col_var->get_type_info();
+    if (agg_kind != kCOUNT &&
+        (ti.is_string() || (agg_kind != kSUM && agg_kind != kMIN && agg_kind != kMAX))) {
+      return {};
+    }
+    local_col_ids.push_back(plan_state_->getLocalColumnId(col_var, false));
+    has_run_length_col = true;
+  }
+  if (!has_run_length_col) {
+    return {};
+  }
+
+  const auto num_frags = col_buffers.size();
+  std::vector<std::vector<int64_t>> outs;
+  for (size_t target_idx = 0; target_idx < target_exprs.size(); ++target_idx) {
+    const auto agg_expr = static_cast<const Analyzer::AggExpr*>(target_exprs[target_idx]);
+    const auto init_val = query_exe_context->getAggInitValForIndex(target_idx);
+    auto& out = outs.emplace_back(num_frags, init_val);
+    for (size_t frag_idx = 0; frag_idx < num_frags; ++frag_idx) {
+      const auto frag_num_rows = num_rows[frag_idx].front();
+      if (local_col_ids[target_idx] < 0) {
+        out[frag_idx] = frag_num_rows;
+        continue;
+      }
+      if (!frag_num_rows) {
+        continue;
+      }
+      const auto& ti = agg_expr->get_arg()->get_type_info();
+      const auto byte_stream = col_buffers[frag_idx][local_col_ids[target_idx]];
+      const int32_t value_width = ti.is_string() ? ti.get_size() : ti.get_logical_size();
+      const auto null_val = inline_fixed_encoding_null_val(ti);
+      const auto num_runs = run_length_encoding::num_runs(byte_stream);
+      int64_t run_start{0};
+      for (int64_t run = 0; run < num_runs && run_start < frag_num_rows; ++run) {
+        const auto run_end = std::min(
+            run_length_encoding::run_end(byte_stream, value_width, run), frag_num_rows);
+        const auto run_length = run_end - run_start;
+        run_start = run_end;
+        const auto value = run_length_encoding::run_value(byte_stream, value_width, run);
+        if (!ti.get_notnull() && value == null_val) {
+          continue;
+        }
+        switch (agg_expr->get_aggtype()) {
+          case kCOUNT:
+            out[frag_idx] += run_length;
+            break;
+          case kSUM: {
+            // Sums which overflow are left to the kernel, which reports the error.
+            const auto sum = out[frag_idx] == init_val ? 0 : out[frag_idx];
+            int64_t run_sum;
+            if (__builtin_mul_overflow(value, run_length, &run_sum) ||
+                __builtin_add_overflow(sum, run_sum, &out[frag_idx])) {
+              return {};
+            }
+            break;
+          }
+          case kMIN:
+            agg_min_skip_val(&out[frag_idx], value, init_val);
+            break;
+          case kMAX:
+            agg_max_skip_val(&out[frag_idx], value, init_val);
+            break;
+          default:
+            UNREACHABLE();
+        }
+      }
+    }
+  }
+  std::vector<int64_t*> out_vec;
+  for (const auto& out : outs) {
+    out_vec.push_back(new int64_t[num_frags]);
+    std::copy(out.begin(), out.end(), out_vec.back());
+  }
+  return out_vec;
+}
+
 int32_t Executor::executePlanWithoutGroupBy(
     const RelAlgExecutionUnit& ra_exe_unit,
     const CompilationResult& compilation_result,
@@ -3383,18 +3627,24 @@ int32_t Executor::executePlanWithoutGroupBy(
     CpuCompilationContext* cpu_generated_code =
         dynamic_cast<CpuCompilationContext*>(compilation_result.generated_code.get());
     CHECK(cpu_generated_code);
-    out_vec = query_exe_context->launchCpuCode(ra_exe_unit,
-                                               cpu_generated_code,
-                                               hoist_literals,
-                                               hoist_buf,
-                                               col_buffers,
-                                               num_rows,
-                                               frag_offsets,
-                                               0,
-                                               &error_code,
-                                               num_tables,
-                                               join_hash_table_ptrs,
-                                               rows_to_process);
+    if (!start_rowid && rows_to_process <= 0) {
+      out_vec = aggregateRunLengthColumns(
+          ra_exe_unit, target_exprs, col_buffers, num_rows, query_exe_context);
+    }
+    if (out_vec.empty()) {
+      out_vec = query_exe_context->launchCpuCode(ra_exe_unit,
+                                                 cpu_generated_code,
+                                                 hoist_literals,
+                                                 hoist_buf,
+                                                 col_buffers,
+                                                 num_rows,
+                                                 frag_offsets,
+                                                 0,
+                                                 &error_code,
+                                                 num_tables,
+                                                 join_hash_table_ptrs,
+                                                 rows_to_process);
+    }
     output_memory_scope.reset(new OutVecOwner(out_vec));
   } else {
     GpuCompilationContext* gpu_generated_code =
@@ -4125,10 +4375,313 @@ FragmentSkipStatus Executor::canSkipFragmentForFpQual(
   return FragmentSkipStatus::NOT_SKIPPABLE;
 }
 
+namespace {
+
+bool is_outer_table_column(const Analyzer::ColumnVar* col_var) {
+  return !dynamic_cast<const Analyzer::Var*>(col_var) && col_var->get_table_id() &&
+         !col_var->get_rte_idx();
+}
+
+// EXTRACT of the field is non decreasing over the periods of the returned truncation
+// field, or over all time for dtINVALID. Returns nullopt for the cyclic fields.
+std::optional<DatetruncField> get_extract_monotonic_period(const ExtractField field) {
+  switch (field) {
+    case kYEAR:
+    case kEPOCH:
+    case kDATEEPOCH:
+      return dtINVALID;
+    case kQUARTER:
+    case kMONTH:
+    case kDOY:
+      return dtYEAR;
+    case kDAY:
+      return dtMONTH;
+    case kHOUR:
+      return dtDAY;
+    case kMINUTE:
+      return dtHOUR;
+    case kSECOND:
+      return dtMINUTE;
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
+
+// Returns the value of the constant as stored in a column of type ti, the string id for
+// dictionary encoded strings, or nullopt when the constant can't be compared that way.
+std::optional<int64_t> Executor::getConstantIntValue(
+    const SQLTypeInfo& ti,
+    const Analyzer::Constant* constant) const {
+  if (constant->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& constant_ti = constant->get_type_info();
+  if (ti.is_dict_encoded_string()) {
+    if (!constant_ti.is_string() || !constant->get_constval().stringval) {
+      return std::nullopt;
+    }
+    CHECK(catalog_);
+    const auto dd = catalog_->getMetadataForDict(ti.get_comp_param(), true);
+    if (!dd || !dd->stringDict) {
+      return std::nullopt;
+    }
+    return dd->stringDict->getIdOfString(*constant->get_constval().stringval);
+  }
+  if (ti.is_integer() && constant_ti.is_integer()) {
+    return extract_int_type_from_datum(constant->get_constval(), constant_ti);
+  }
+  if ((ti.is_time() || ti.is_decimal()) && ti.get_type() == constant_ti.get_type() &&
+      ti.get_dimension() == constant_ti.get_dimension() &&
+      ti.get_scale() == constant_ti.get_scale()) {
+    return extract_int_type_from_datum(constant->get_constval(), constant_ti);
+  }
+  return std::nullopt;
+}
+
+// Returns the range of the values of an integer backed expression over the fragment, from
+// the chunk stats, or over some rows of it, from the zone maps. DATE_TRUNC and the
+// EXTRACT fields which don't wrap around within the range are computed from the range of
+// their argument.
+std::optional<std::pair<int64_t, int64_t>> Executor::getFragmentIntRange(
+    const Analyzer::Expr* expr,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::optional<FragmentRowRange>& row_range) const {
+  if (const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr)) {
+    const auto& ti = col_var->get_type_info();
+    if (!is_outer_table_column(col_var) ||
+        !(ti.is_integer() || ti.is_time() || ti.is_decimal() ||
+          ti.is_dict_encoded_string())) {
+      return std::nullopt;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(col_var->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end()) {
+      return std::nullopt;
+    }
+    if (row_range) {
+      const auto& zone_map = chunk_meta_it->second->zoneMap;
+      return zone_map ? zone_map->getRange(row_range->first, row_range->second)
+                      : std::nullopt;
+    }
+    const auto min = extract_min_stat_int_type(chunk_meta_it->second->chunkStats, ti);
+    const auto max = extract_max_stat_int_type(chunk_meta_it->second->chunkStats, ti);
+    if (min > max) {
+      // No non null value, or invalid metadata.
+      return std::nullopt;
+    }
+    return std::make_pair(min, max);
+  }
+  if (const auto datetrunc_expr = dynamic_cast<const Analyzer::DatetruncExpr*>(expr)) {
+    const auto from_range =
+        getFragmentIntRange(datetrunc_expr->get_from_expr(), fragment, row_range);
+    if (!from_range) {
+      return std::nullopt;
+    }
+    const auto& from_ti = datetrunc_expr->get_from_expr()->get_type_info();
+    return std::make_pair(DateTimeTranslator::getDateTruncConstantValue(
+                              from_range->first, datetrunc_expr->get_field(), from_ti),
+                          DateTimeTranslator::getDateTruncConstantValue(
+                              from_range->second, datetrunc_expr->get_field(), from_ti));
+  }
+  if (const auto extract_expr = dynamic_cast<const Analyzer::ExtractExpr*>(expr)) {
+    const auto period = get_extract_monotonic_period(extract_expr->get_field());
+    const auto from_range =
+        getFragmentIntRange(extract_expr->get_from_expr(), fragment, row_range);
+    if (!period || !from_range) {
+      return std::nullopt;
+    }
+    const auto& from_ti = extract_expr->get_from_expr()->get_type_info();
+    if (*period != dtINVALID &&
+        DateTimeTranslator::getDateTruncConstantValue(
+            from_range->first, *period, from_ti) !=
+            DateTimeTranslator::getDateTruncConstantValue(
+                from_range->second, *period, from_ti)) {
+      return std::nullopt;
+    }
+    return std::make_pair(DateTimeTranslator::getExtractFromTimeConstantValue(
+                              from_range->first, extract_expr->get_field(), from_ti),
+                          DateTimeTranslator::getExtractFromTimeConstantValue(
+                              from_range->second, extract_expr->get_field(), from_ti));
+  }
+  return std::nullopt;
+}
+
+// Uses the Bloom filter of the chunk to tell whether no row of the fragment can be equal
+// to the constant. Only integer, time and dictionary encoded string chunks have one.
+bool Executor::canSkipFragmentForEqualityQual(
+    const Analyzer::ColumnVar* lhs_col,
+    const Analyzer::Constant* rhs_const,
+    const Fragmenter_Namespace::FragmentInfo& fragment) const {
+  const auto chunk_meta_it =
+      fragment.getChunkMetadataMap().find(lhs_col->get_column_id());
+  if (chunk_meta_it == fragment.getChunkMetadataMap().end() ||
+      !chunk_meta_it->second->bloomFilter) {
+    return false;
+  }
+  if (rhs_const->get_is_null()) {
+    // Nothing is equal to null.
+    return true;
+  }
+  const auto rhs_val = getConstantIntValue(lhs_col->get_type_info(), rhs_const);
+  if (!rhs_val) {
+    return false;
+  }
+  if (lhs_col->get_type_info().is_dict_encoded_string() &&
+      *rhs_val == StringDictionary::INVALID_STR_ID) {
+    // Strings missing from the dictionary aren't in any chunk of the column.
+    return true;
+  }
+  return !chunk_meta_it->second->bloomFilter->mayContain(*rhs_val);
+}
+
+// Whether `lhs optype rhs_const` is false for every row of the fragment, or of the rows
+// in row_range. The Bloom filters are only checked for whole fragments.
+bool Executor::canSkipFragmentForComparison(
+    const Analyzer::Expr* lhs,
+    const SQLOps optype,
+    const Analyzer::Constant* rhs_const,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::optional<FragmentRowRange>& row_range) const {
+  const auto lhs_col = dynamic_cast<const Analyzer::ColumnVar*>(lhs);
+  if (!row_range && optype == kEQ && lhs_col && is_outer_table_column(lhs_col) &&
+      canSkipFragmentForEqualityQual(lhs_col, rhs_const, fragment)) {
+    return true;
+  }
+  const auto& lhs_ti = lhs->get_type_info();
+  if (lhs_ti.is_dict_encoded_string() && optype != kEQ && optype != kNE) {
+    // String ids don't follow the order of the strings.
+    return false;
+  }
+  const auto lhs_range = getFragmentIntRange(lhs, fragment, row_range);
+  if (!lhs_range) {
+    return false;
+  }
+  const auto rhs_val = getConstantIntValue(lhs_ti, rhs_const);
+  if (!rhs_val) {
+    return false;
+  }
+  if (lhs_ti.is_dict_encoded_string() && *rhs_val == StringDictionary::INVALID_STR_ID) {
+    return optype == kEQ;
+  }
+  const auto [min, max] = *lhs_range;
+  switch (optype) {
+    case kEQ:
+      return *rhs_val < min || *rhs_val > max;
+    case kNE:
+      return min == max && min == *rhs_val;
+    case kLT:
+      return min >= *rhs_val;
+    case kLE:
+      return min > *rhs_val;
+    case kGT:
+      return max <= *rhs_val;
+    case kGE:
+      return max < *rhs_val;
+    default:
+      return false;
+  }
+}
+
+bool Executor::canSkipFragmentForInValues(
+    const Analyzer::InValues* in_values,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::optional<FragmentRowRange>& row_range) const {
+  const auto& value_list = in_values->get_value_list();
+  if (value_list.empty()) {
+    return false;
+  }
+  for (const auto& in_val : value_list) {
+    const auto in_val_const =
+        dynamic_cast<const Analyzer::Constant*>(extract_cast_arg(in_val.get()));
+    if (!in_val_const ||
+        !canSkipFragmentForComparison(
+            in_values->get_arg(), kEQ, in_val_const, fragment, row_range)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the qual is false for every row of the fragment. Conjunctions are skipped when
+// any of their operands is, disjunctions when all of them are.
+bool Executor::canSkipFragmentForQual(
+    const Analyzer::Expr* qual,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::optional<FragmentRowRange>& row_range) const {
+  if (const auto in_values = dynamic_cast<const Analyzer::InValues*>(qual)) {
+    return canSkipFragmentForInValues(in_values, fragment, row_range);
+  }
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!bin_oper) {
+    return false;
+  }
+  const auto optype = bin_oper->get_optype();
+  if (optype == kAND) {
+    return canSkipFragmentForQual(bin_oper->get_left_operand(), fragment, row_range) ||
+           canSkipFragmentForQual(bin_oper->get_right_operand(), fragment, row_range);
+  }
+  if (optype == kOR) {
+    return canSkipFragmentForQual(bin_oper->get_left_operand(), fragment, row_range) &&
+           canSkipFragmentForQual(bin_oper->get_right_operand(), fragment, row_range);
+  }
+  if (!IS_COMPARISON(optype) || bin_oper->get_qualifier() != kONE) {
+    return false;
+  }
+  if (const auto rhs_const = dynamic_cast<const Analyzer::Constant*>(
+          extract_cast_arg(bin_oper->get_right_operand()))) {
+    return canSkipFragmentForComparison(
+        bin_oper->get_left_operand(), optype, rhs_const, fragment, row_range);
+  }
+  if (const auto lhs_const = dynamic_cast<const Analyzer::Constant*>(
+          extract_cast_arg(bin_oper->get_left_operand()))) {
+    return canSkipFragmentForComparison(bin_oper->get_right_operand(),
+                                        COMMUTE_COMPARISON(optype),
+                                        lhs_const,
+                                        fragment,
+                                        row_range);
+  }
+  return false;
+}
+
+// Whether no row of the fragment of the outer table can match the build side of one of
+// the inner hash joins of the query, from the keys of the hash tables.
+bool Executor::canSkipFragmentForRuntimeJoinFilters(
+    const InputDescriptor& table_desc,
+    const Fragmenter_Namespace::FragmentInfo& fragment) const {
+  if (!g_enable_runtime_join_filters || !plan_state_ || table_desc.getNestLevel()) {
+    return false;
+  }
+  for (const auto& hash_table : plan_state_->join_info_.join_hash_tables_) {
+    const auto filter = hash_table->getRuntimeJoinFilter();
+    if (!filter || filter->getOuterKey()->get_table_id() != table_desc.getTableId()) {
+      continue;
+    }
+    const auto outer_range = getFragmentIntRange(filter->getOuterKey(), fragment);
+    if (!outer_range) {
+      continue;
+    }
+    if (!filter->mayMatch(outer_range->first, outer_range->second)) {
+      return true;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(filter->getOuterKey()->get_column_id());
+    CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+    const auto& bloom_filter = chunk_meta_it->second->bloomFilter;
+    if (bloom_filter &&
+        !filter->mayMatch(outer_range->first, outer_range->second, *bloom_filter)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::pair<bool, int64_t> Executor::skipFragment(
     const InputDescriptor& table_desc,
     const Fragmenter_Namespace::FragmentInfo& fragment,
     const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
     const std::vector<uint64_t>& frag_offsets,
     const size_t frag_idx) {
   const int table_id = table_desc.getTableId();
@@ -4169,6 +4722,10 @@ std::pair<bool, int64_t> Executor::skipFragment(
       // is this possible?
       return {false, -1};
     }
+    if (comp_expr->get_optype() == kEQ && lhs == lhs_col &&
+        canSkipFragmentForEqualityQual(lhs_col, rhs_const, fragment)) {
+      return {true, -1};
+    }
     if (!lhs->get_type_info().is_integer() && !lhs->get_type_info().is_time() &&
         !lhs->get_type_info().is_fp()) {
       continue;
@@ -4302,6 +4859,16 @@ std::pair<bool, int64_t> Executor::skipFragment(
         break;
     }
   }
+  // The other quals are checked against the chunk stats and Bloom filters, through
+  // conjunctions, disjunctions, IN lists and date/time functions.
+  for (const auto& qual : quals) {
+    if (canSkipFragmentForQual(qual.get(), fragment)) {
+      return {true, -1};
+    }
+  }
+  if (canSkipFragmentForRuntimeJoinFilters(table_desc, fragment)) {
+    return {true, -1};
+  }
   return {false, -1};
 }
 
@@ -4344,14 +4911,21 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
     // extracting all the conjunctive simple_quals from the quals stored for the inner
     // join
     std::list<std::shared_ptr<Analyzer::Expr>> inner_join_simple_quals;
+    std::list<std::shared_ptr<Analyzer::Expr>> inner_join_quals;
     for (auto& qual : inner_join.quals) {
       auto temp_qual = qual_to_conjunctive_form(qual);
       inner_join_simple_quals.insert(inner_join_simple_quals.begin(),
                                      temp_qual.simple_quals.begin(),
                                      temp_qual.simple_quals.end());
+      inner_join_quals.insert(
+          inner_join_quals.begin(), temp_qual.quals.begin(), temp_qual.quals.end());
     }
-    auto temp_skip_frag = skipFragment(
-        table_desc, fragment, inner_join_simple_quals, frag_offsets, frag_idx);
+    auto temp_skip_frag = skipFragment(table_desc,
+                                       fragment,
+                                       inner_join_simple_quals,
+                                       inner_join_quals,
+                                       frag_offsets,
+                                       frag_idx);
     if (temp_skip_frag.second != -1) {
       skip_frag.second = temp_skip_frag.second;
       return skip_frag;
@@ -4362,6 +4936,43 @@ std::pair<bool, int64_t> Executor::skipFragmentInnerJoins(
   return skip_frag;
 }
 
+// Splits the first num_rows rows of the fragment in blocks of the size of the zone maps
+// of its chunks, and returns the ranges of consecutive blocks the quals may hold for.
+std::vector<FragmentRowRange> Executor::getFragmentScanRanges(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const size_t num_rows) const {
+  std::vector<FragmentRowRange> scan_ranges;
+  const auto& chunk_metadata_map = fragment.getChunkMetadataMap();
+  if ((ra_exe_unit.simple_quals.empty() && ra_exe_unit.quals.empty()) ||
+      std::none_of(chunk_metadata_map.begin(),
+                   chunk_metadata_map.end(),
+                   [](const auto& kv) { return kv.second->zoneMap != nullptr; })) {
+    scan_ranges.emplace_back(0, num_rows);
+    return scan_ranges;
+  }
+  const auto block_rows = ChunkZoneMap::blockRows(num_rows);
+  for (size_t block_start = 0; block_start < num_rows; block_start += block_rows) {
+    const FragmentRowRange block{block_start,
+                                 std::min(block_start + block_rows, num_rows)};
+    const auto can_skip_block = [this, &fragment, &block](const auto& qual) {
+      return canSkipFragmentForQual(qual.get(), fragment, block);
+    };
+    if (std::any_of(ra_exe_unit.simple_quals.begin(),
+                    ra_exe_unit.simple_quals.end(),
+                    can_skip_block) ||
+        std::any_of(ra_exe_unit.quals.begin(), ra_exe_unit.quals.end(), can_skip_block)) {
+      continue;
+    }
+    if (!scan_ranges.empty() && scan_ranges.back().second == block.first) {
+      scan_ranges.back().second = block.second;
+    } else {
+      scan_ranges.push_back(block);
+    }
+  }
+  return scan_ranges;
+}
+
 AggregatedColRange Executor::computeColRangesCache(
     const std::unordered_set<PhysicalInput>& phys_inputs) {
   AggregatedColRange agg_col_range_cache;
@@ -27,6 +27,7 @@
 #include <limits>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <stack>
 #include <unordered_map>
@@ -161,6 +162,9 @@ class WatchdogException : public std::runtime_error {
 
 enum FragmentSkipStatus { SKIPPABLE, NOT_SKIPPABLE, INVALID };
 
+// Rows [first, second) of a fragment.
+using FragmentRowRange = std::pair<size_t, size_t>;
+
 class Executor;
 
 inline llvm::Value* get_arg_by_name(llvm::Function* func, const std::string& name) {
@@ -956,6 +960,15 @@ class Executor {
       const bool allow_runtime_interrupt,
       RenderInfo* render_info,
       const int64_t rows_to_process = -1);
+  // Outputs of the kernel of an unfiltered COUNT, SUM, MIN or MAX over run length
+  // encoded columns of a single table, computed once per run instead of once per row.
+  // Empty if the query needs the kernel.
+  std::vector<int64_t*> aggregateRunLengthColumns(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<Analyzer::Expr*>& target_exprs,
+      const std::vector<std::vector<const int8_t*>>& col_buffers,
+      const std::vector<std::vector<int64_t>>& num_rows,
+      const QueryExecutionContext* query_exe_context) const;
 
  public:  // Temporary, ask saman about this
   static std::pair<int64_t, int32_t> reduceResults(const SQLAgg agg,
@@ -1152,10 +1165,45 @@ class Executor {
       const Fragmenter_Namespace::FragmentInfo& fragment,
       const Analyzer::Constant* rhs_const) const;
 
+  std::optional<int64_t> getConstantIntValue(const SQLTypeInfo& ti,
+                                             const Analyzer::Constant* constant) const;
+
+  std::optional<std::pair<int64_t, int64_t>> getFragmentIntRange(
+      const Analyzer::Expr* expr,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::optional<FragmentRowRange>& row_range = std::nullopt) const;
+
+  bool canSkipFragmentForEqualityQual(
+      const Analyzer::ColumnVar* lhs_col,
+      const Analyzer::Constant* rhs_const,
+      const Fragmenter_Namespace::FragmentInfo& fragment) const;
+
+  bool canSkipFragmentForComparison(
+      const Analyzer::Expr* lhs,
+      const SQLOps optype,
+      const Analyzer::Constant* rhs_const,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::optional<FragmentRowRange>& row_range = std::nullopt) const;
+
+  bool canSkipFragmentForInValues(
+      const Analyzer::InValues* in_values,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::optional<FragmentRowRange>& row_range = std::nullopt) const;
+
+  bool canSkipFragmentForQual(
+      const Analyzer::Expr* qual,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::optional<FragmentRowRange>& row_range = std::nullopt) const;
+
+  bool canSkipFragmentForRuntimeJoinFilters(
+      const InputDescriptor& table_desc,
+      const Fragmenter_Namespace::FragmentInfo& fragment) const;
+
   std::pair<bool, int64_t> skipFragment(
       const InputDescriptor& table_desc,
       const Fragmenter_Namespace::FragmentInfo& frag_info,
       const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& quals,
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
@@ -1166,6 +1214,15 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+ public:
+  // Public for the tests, kernels are the only other callers.
+  std::vector<FragmentRowRange> getFragmentScanRanges(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const size_t num_rows) const;
+
+ private:
+
   AggregatedColRange computeColRangesCache(
       const std::unordered_set<PhysicalInput>& phys_inputs);
   StringDictionaryGenerations computeStringDictionaryGenerations(
@@ -144,6 +144,7 @@ TableUpdateMetadata Executor::executeUpdate(
     auto skip_frag = skipFragment(ra_exe_unit.input_descs[0],
                                   outer_fragments[fragment_index],
                                   ra_exe_unit.simple_quals,
+                                  ra_exe_unit.quals,
                                   frag_offsets,
                                   fragment_index);
     if (skip_frag.first) {
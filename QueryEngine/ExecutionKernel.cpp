@@ -17,6 +17,7 @@
 #include "QueryEngine/ExecutionKernel.h"
 
 #include <mutex>
+#include <optional>
 #include <vector>
 
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
@@ -78,6 +79,54 @@ bool need_to_hold_chunk(const Chunk_NS::Chunk* chunk,
   return false;
 }
 
+// The kernel only scans the rows of its fragment from a start row id to an end one on
+// CPU, see launchCpuCode.
+bool can_skip_row_blocks(const RelAlgExecutionUnit& ra_exe_unit,
+                         const FragmentsList& frag_list,
+                         const ExecutorDeviceType device_type,
+                         const int64_t rowid_lookup_key,
+                         const bool do_render) {
+  return device_type == ExecutorDeviceType::CPU && !ra_exe_unit.union_all &&
+         ra_exe_unit.input_descs.size() == 1 && frag_list.size() == 1 &&
+         frag_list[0].fragment_ids.size() == 1 && rowid_lookup_key < 0 && !do_render;
+}
+
+#ifdef HAVE_TBB
+// Projections and aggregates without group by can be split in sub-tasks with their own
+// execution context, as long as the output of a sub-task can be sized from its number of
+// rows: the projected rows are written row-wise and at most one per input row.
+bool can_run_subtasks_with_own_context(const RelAlgExecutionUnit& ra_exe_unit,
+                                       const QueryMemoryDescriptor& query_mem_desc,
+                                       const Executor* executor,
+                                       const bool do_render) {
+  if (do_render || ra_exe_unit.union_all) {
+    return false;
+  }
+  switch (query_mem_desc.getQueryDescriptionType()) {
+    case QueryDescriptionType::NonGroupedAggregate:
+      return query_mem_desc.countDistinctDescriptorsLogicallyEmpty();
+    case QueryDescriptionType::Projection: {
+      if (ra_exe_unit.scan_limit || ra_exe_unit.use_bump_allocator ||
+          query_mem_desc.didOutputColumnar() || query_mem_desc.useStreamingTopN() ||
+          query_mem_desc.hasVarlenOutput()) {
+        return false;
+      }
+      // Every join level has to find at most one match per row.
+      const auto& join_hash_tables = executor->plan_state_->join_info_.join_hash_tables_;
+      return join_hash_tables.size() + 1 == ra_exe_unit.input_descs.size() &&
+             std::all_of(join_hash_tables.begin(),
+                         join_hash_tables.end(),
+                         [](const auto& hash_table) {
+                           return hash_table &&
+                                  hash_table->getHashType() == HashType::OneToOne;
+                         });
+    }
+    default:
+      return false;
+  }
+}
+#endif  // HAVE_TBB
+
 bool need_to_hold_chunk(const std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
                         const RelAlgExecutionUnit& ra_exe_unit,
                         const std::vector<ColumnLazyFetchInfo>& lazy_fetch_info,
@@ -120,6 +169,19 @@ SharedKernelContext::getFragmentResults() {
   return all_fragment_results_;
 }
 
+#ifdef HAVE_TBB
+void KernelSubtaskResults::setResults(const size_t subtask_idx, ResultSetPtr&& results) {
+  CHECK_LT(subtask_idx, results_.size());
+  results_[subtask_idx] = std::move(results);
+  if (num_pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    for (auto& subtask_results : results_) {
+      shared_context_.addDeviceResults(std::move(subtask_results),
+                                       outer_table_fragment_ids_);
+    }
+  }
+}
+#endif  // HAVE_TBB
+
 void ExecutionKernel::run(Executor* executor,
                           const size_t thread_idx,
                           SharedKernelContext& shared_context) {
@@ -302,44 +364,91 @@ void ExecutionKernel::runImpl(Executor* executor,
     }
   }
 
+  // Blocks of rows of the fragment which the zone maps of its chunks rule out for the
+  // quals are left out of the scan.
+  std::optional<std::vector<FragmentRowRange>> scan_ranges;
+  if (can_skip_row_blocks(
+          ra_exe_unit_, frag_list, chosen_device_type, rowid_lookup_key, do_render)) {
+    const auto& fragments = shared_context.getQueryInfos().front().info.fragments;
+    const auto frag_id = frag_list[0].fragment_ids.front();
+    CHECK_LT(frag_id, fragments.size());
+    scan_ranges = executor->getFragmentScanRanges(
+        ra_exe_unit_, fragments[frag_id], fetch_result->num_rows[0][0]);
+    if (scan_ranges->empty()) {
+      return;
+    }
+    start_rowid = scan_ranges->front().first;
+  }
+
 #ifdef HAVE_TBB
   bool can_run_subkernels = shared_context.getThreadPool() != nullptr;
 
-  // Sub-tasks are supported for groupby queries and estimators only for now.
+  // Group by queries and estimators accumulate the rows of all the sub-tasks run by a
+  // thread in its execution context. Projections and aggregates without group by get a
+  // context per sub-task instead.
   bool is_groupby =
       (ra_exe_unit_.groupby_exprs.size() > 1) ||
       (ra_exe_unit_.groupby_exprs.size() == 1 && ra_exe_unit_.groupby_exprs.front());
-  can_run_subkernels = can_run_subkernels && (is_groupby || ra_exe_unit_.estimator);
-
-  // In case some column is lazily fetched, we cannot mix different fragments in a single
-  // ResultSet.
-  can_run_subkernels =
-      can_run_subkernels && !executor->hasLazyFetchColumns(ra_exe_unit_.target_exprs);
-
-  // TODO: Use another structure to hold chunks. Currently, ResultSet holds them, but with
-  // sub-tasks chunk can be referenced by many ResultSets. So, some outer structure to
-  // hold all ResultSets and all chunks is required.
-  can_run_subkernels =
-      can_run_subkernels &&
-      !need_to_hold_chunk(
-          chunks, ra_exe_unit_, std::vector<ColumnLazyFetchInfo>(), chosen_device_type);
+  const bool uses_thread_context = is_groupby || ra_exe_unit_.estimator;
+  can_run_subkernels = can_run_subkernels &&
+                       (uses_thread_context ||
+                        can_run_subtasks_with_own_context(
+                            ra_exe_unit_, query_mem_desc, executor, do_render));
+
+  if (uses_thread_context) {
+    // In case some column is lazily fetched, we cannot mix different fragments in a
+    // single ResultSet.
+    can_run_subkernels =
+        can_run_subkernels && !executor->hasLazyFetchColumns(ra_exe_unit_.target_exprs);
+
+    // TODO: Use another structure to hold chunks. Currently, ResultSet holds them, but
+    // with sub-tasks chunk can be referenced by many ResultSets. So, some outer structure
+    // to hold all ResultSets and all chunks is required.
+    can_run_subkernels =
+        can_run_subkernels &&
+        !need_to_hold_chunk(
+            chunks, ra_exe_unit_, std::vector<ColumnLazyFetchInfo>(), chosen_device_type);
+  }
 
   // TODO: check for literals? We serialize literals before execution and hold them in
   // result sets. Can we simply do it once and holdin an outer structure?
   if (can_run_subkernels) {
-    size_t total_rows = fetch_result->num_rows[0][0];
-    size_t sub_size = g_cpu_sub_task_size;
-
-    for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
-      sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
+    const std::vector<FragmentRowRange> sub_ranges =
+        scan_ranges ? *scan_ranges
+                    : std::vector<FragmentRowRange>{
+                          {start_rowid,
+                           static_cast<size_t>(fetch_result->num_rows[0][0])}};
+
+    // The fragment is cut in sub-tasks of g_cpu_sub_task_size rows, which the threads of
+    // the pool steal from each other once they are done with their own.
+    std::vector<FragmentRowRange> subtask_ranges;
+    for (const auto& [range_start, range_end] : sub_ranges) {
+      for (size_t sub_start = range_start; sub_start < range_end;
+           sub_start += g_cpu_sub_task_size) {
+        subtask_ranges.emplace_back(sub_start,
+                                    std::min(sub_start + g_cpu_sub_task_size, range_end));
+      }
+    }
+    std::shared_ptr<KernelSubtaskResults> subtask_results;
+    if (!uses_thread_context) {
+      subtask_results = std::make_shared<KernelSubtaskResults>(shared_context,
+                                                               outer_tab_frag_ids,
+                                                               chunks,
+                                                               chunk_iterators_ptr,
+                                                               subtask_ranges.size());
+    }
+    for (size_t subtask_idx = 0; subtask_idx < subtask_ranges.size(); ++subtask_idx) {
+      const auto& [sub_start, sub_end] = subtask_ranges[subtask_idx];
       auto subtask = std::make_shared<KernelSubtask>(*this,
                                                      shared_context,
                                                      fetch_result,
                                                      chunk_iterators_ptr,
                                                      total_num_input_rows,
                                                      sub_start,
-                                                     sub_size,
-                                                     thread_idx);
+                                                     sub_end - sub_start,
+                                                     thread_idx,
+                                                     subtask_results,
+                                                     subtask_idx);
       shared_context.getThreadPool()->run(
           [subtask, executor] { subtask->run(executor); });
     }
@@ -377,6 +486,8 @@ void ExecutionKernel::runImpl(Executor* executor,
   QueryExecutionContext* query_exe_context{query_exe_context_owned.get()};
   CHECK(query_exe_context);
   int32_t err{0};
+  // Rows past the last range left by the zone maps aren't scanned either.
+  const int64_t scan_end_rowid = scan_ranges ? scan_ranges->back().second : -1;
 
   if (ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(ra_exe_unit_,
@@ -394,7 +505,8 @@ void ExecutionKernel::runImpl(Executor* executor,
                                               start_rowid,
                                               ra_exe_unit_.input_descs.size(),
                                               eo.allow_runtime_query_interrupt,
-                                              do_render ? render_info_ : nullptr);
+                                              do_render ? render_info_ : nullptr,
+                                              scan_end_rowid);
   } else {
     if (ra_exe_unit_.union_all) {
       VLOG(1) << "outer_table_id=" << outer_table_id
@@ -417,7 +529,8 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            start_rowid,
                                            ra_exe_unit_.input_descs.size(),
                                            eo.allow_runtime_query_interrupt,
-                                           do_render ? render_info_ : nullptr);
+                                           do_render ? render_info_ : nullptr,
+                                           scan_end_rowid);
   }
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
@@ -469,44 +582,84 @@ void KernelSubtask::run(Executor* executor) {
   }
 }
 
-void KernelSubtask::runImpl(Executor* executor) {
-  auto& query_exe_context_owned = shared_context_.getTlsExecutionContext().local();
+std::unique_ptr<QueryExecutionContext> KernelSubtask::createQueryExecutionContext(
+    Executor* executor) {
   const bool do_render = kernel_.render_info_ && kernel_.render_info_->isInSitu();
   const CompilationResult& compilation_result =
       kernel_.query_comp_desc.getCompilationResult();
   const int outer_table_id = kernel_.ra_exe_unit_.union_all
                                  ? kernel_.frag_list[0].table_id
                                  : kernel_.ra_exe_unit_.input_descs[0].getTableId();
-
-  if (!query_exe_context_owned) {
-    try {
-      // We pass fake col_buffers and frag_offsets. These are not actually used
-      // for subtasks but shouldn't pass empty structures to avoid empty results.
-      std::vector<std::vector<const int8_t*>> col_buffers(
-          fetch_result_->col_buffers.size(),
-          std::vector<const int8_t*>(fetch_result_->col_buffers[0].size()));
-      std::vector<std::vector<uint64_t>> frag_offsets(
-          fetch_result_->frag_offsets.size(),
-          std::vector<uint64_t>(fetch_result_->frag_offsets[0].size()));
-      query_exe_context_owned = kernel_.query_mem_desc.getQueryExecutionContext(
+  try {
+    if (subtask_results_) {
+      // The context only holds the rows of the sub-task, and keeps the buffers of the
+      // fragment for the lazily fetched columns of its result.
+      auto query_mem_desc = kernel_.query_mem_desc;
+      int64_t num_input_rows = total_num_input_rows_;
+      if (query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection) {
+        query_mem_desc.setEntryCount(
+            std::min(query_mem_desc.getEntryCount(), num_rows_to_process_));
+        num_input_rows = num_rows_to_process_;
+      }
+      return query_mem_desc.getQueryExecutionContext(
           kernel_.ra_exe_unit_,
           executor,
           kernel_.chosen_device_type,
           kernel_.kernel_dispatch_mode,
           kernel_.chosen_device_id,
           outer_table_id,
-          total_num_input_rows_,
-          col_buffers,
-          frag_offsets,
+          num_input_rows,
+          fetch_result_->col_buffers,
+          fetch_result_->frag_offsets,
           executor->getRowSetMemoryOwner(),
           compilation_result.output_columnar,
-          kernel_.query_mem_desc.sortOnGpu(),
-          // TODO: use TBB thread id to choose allocator
+          query_mem_desc.sortOnGpu(),
           thread_idx_,
           do_render ? kernel_.render_info_ : nullptr);
-    } catch (const OutOfHostMemory& e) {
-      throw QueryExecutionError(Executor::ERR_OUT_OF_CPU_MEM);
     }
+    // We pass fake col_buffers and frag_offsets. These are not actually used
+    // for subtasks but shouldn't pass empty structures to avoid empty results.
+    std::vector<std::vector<const int8_t*>> col_buffers(
+        fetch_result_->col_buffers.size(),
+        std::vector<const int8_t*>(fetch_result_->col_buffers[0].size()));
+    std::vector<std::vector<uint64_t>> frag_offsets(
+        fetch_result_->frag_offsets.size(),
+        std::vector<uint64_t>(fetch_result_->frag_offsets[0].size()));
+    return kernel_.query_mem_desc.getQueryExecutionContext(
+        kernel_.ra_exe_unit_,
+        executor,
+        kernel_.chosen_device_type,
+        kernel_.kernel_dispatch_mode,
+        kernel_.chosen_device_id,
+        outer_table_id,
+        total_num_input_rows_,
+        col_buffers,
+        frag_offsets,
+        executor->getRowSetMemoryOwner(),
+        compilation_result.output_columnar,
+        kernel_.query_mem_desc.sortOnGpu(),
+        // TODO: use TBB thread id to choose allocator
+        thread_idx_,
+        do_render ? kernel_.render_info_ : nullptr);
+  } catch (const OutOfHostMemory& e) {
+    throw QueryExecutionError(Executor::ERR_OUT_OF_CPU_MEM);
+  }
+}
+
+void KernelSubtask::runImpl(Executor* executor) {
+  std::unique_ptr<QueryExecutionContext> own_query_exe_context;
+  auto& query_exe_context_owned = subtask_results_
+                                      ? own_query_exe_context
+                                      : shared_context_.getTlsExecutionContext().local();
+  const bool do_render = kernel_.render_info_ && kernel_.render_info_->isInSitu();
+  const CompilationResult& compilation_result =
+      kernel_.query_comp_desc.getCompilationResult();
+  const int outer_table_id = kernel_.ra_exe_unit_.union_all
+                                 ? kernel_.frag_list[0].table_id
+                                 : kernel_.ra_exe_unit_.input_descs[0].getTableId();
+
+  if (!query_exe_context_owned) {
+    query_exe_context_owned = createQueryExecutionContext(executor);
   }
 
   const auto& outer_tab_frag_ids = kernel_.frag_list[0].fragment_ids;
@@ -515,12 +668,16 @@ void KernelSubtask::runImpl(Executor* executor) {
   QueryExecutionContext* query_exe_context{query_exe_context_owned.get()};
   CHECK(query_exe_context);
   int32_t err{0};
+  // Sub-tasks sharing the context of their thread collect their results at the end of
+  // launchKernels.
+  ResultSetPtr device_results;
+  ResultSetPtr* results = subtask_results_ ? &device_results : nullptr;
 
   if (kernel_.ra_exe_unit_.groupby_exprs.empty()) {
     err = executor->executePlanWithoutGroupBy(kernel_.ra_exe_unit_,
                                               compilation_result,
                                               kernel_.query_comp_desc.hoistLiterals(),
-                                              nullptr,
+                                              results,
                                               kernel_.ra_exe_unit_.target_exprs,
                                               kernel_.chosen_device_type,
                                               fetch_result_->col_buffers,
@@ -538,7 +695,7 @@ void KernelSubtask::runImpl(Executor* executor) {
     err = executor->executePlanWithGroupBy(kernel_.ra_exe_unit_,
                                            compilation_result,
                                            kernel_.query_comp_desc.hoistLiterals(),
-                                           nullptr,
+                                           results,
                                            kernel_.chosen_device_type,
                                            fetch_result_->col_buffers,
                                            outer_tab_frag_ids,
@@ -559,6 +716,22 @@ void KernelSubtask::runImpl(Executor* executor) {
   if (err) {
     throw QueryExecutionError(err);
   }
+  if (subtask_results_) {
+    if (device_results) {
+      std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
+      for (const auto& chunk : subtask_results_->getChunks()) {
+        if (need_to_hold_chunk(chunk.get(),
+                               kernel_.ra_exe_unit_,
+                               device_results->getLazyFetchInfo(),
+                               kernel_.chosen_device_type)) {
+          chunks_to_hold.push_back(chunk);
+        }
+      }
+      device_results->holdChunks(chunks_to_hold);
+      device_results->holdChunkIterators(subtask_results_->getChunkIterators());
+    }
+    subtask_results_->setResults(subtask_idx_, std::move(device_results));
+  }
 }
 
 #endif  // HAVE_TBB
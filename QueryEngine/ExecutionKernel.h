@@ -98,6 +98,8 @@ class ExecutionKernel {
            const size_t thread_idx,
            SharedKernelContext& shared_context);
 
+  const FragmentsList& getFragmentsList() const { return frag_list; }
+
   const RelAlgExecutionUnit& ra_exe_unit_;
 
  private:
@@ -122,6 +124,45 @@ class ExecutionKernel {
 };
 
 #ifdef HAVE_TBB
+/**
+ * Results of the sub-tasks of a kernel which run with an execution context of their own,
+ * i.e. projections and aggregates without group by. They are added to the shared context
+ * in the order of their rows once the last sub-task is done, along with the chunks they
+ * may read from.
+ */
+class KernelSubtaskResults {
+ public:
+  KernelSubtaskResults(SharedKernelContext& shared_context,
+                       const std::vector<size_t>& outer_table_fragment_ids,
+                       std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks,
+                       std::shared_ptr<std::list<ChunkIter>> chunk_iterators,
+                       const size_t num_subtasks)
+      : shared_context_(shared_context)
+      , outer_table_fragment_ids_(outer_table_fragment_ids)
+      , chunks_(std::move(chunks))
+      , chunk_iterators_(std::move(chunk_iterators))
+      , results_(num_subtasks)
+      , num_pending_(num_subtasks) {}
+
+  const std::list<std::shared_ptr<Chunk_NS::Chunk>>& getChunks() const {
+    return chunks_;
+  }
+
+  const std::shared_ptr<std::list<ChunkIter>>& getChunkIterators() const {
+    return chunk_iterators_;
+  }
+
+  void setResults(const size_t subtask_idx, ResultSetPtr&& results);
+
+ private:
+  SharedKernelContext& shared_context_;
+  const std::vector<size_t> outer_table_fragment_ids_;
+  const std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_;
+  const std::shared_ptr<std::list<ChunkIter>> chunk_iterators_;
+  std::vector<ResultSetPtr> results_;
+  std::atomic<size_t> num_pending_;
+};
+
 class KernelSubtask {
  public:
   KernelSubtask(ExecutionKernel& k,
@@ -131,7 +172,9 @@ class KernelSubtask {
                 int64_t total_num_input_rows,
                 size_t start_rowid,
                 size_t num_rows_to_process,
-                size_t thread_idx)
+                size_t thread_idx,
+                std::shared_ptr<KernelSubtaskResults> subtask_results = nullptr,
+                size_t subtask_idx = 0)
       : kernel_(k)
       , shared_context_(shared_context)
       , fetch_result_(fetch_result)
@@ -139,13 +182,18 @@ class KernelSubtask {
       , total_num_input_rows_(total_num_input_rows)
       , start_rowid_(start_rowid)
       , num_rows_to_process_(num_rows_to_process)
-      , thread_idx_(thread_idx) {}
+      , thread_idx_(thread_idx)
+      , subtask_results_(subtask_results)
+      , subtask_idx_(subtask_idx) {}
 
   void run(Executor* executor);
 
  private:
   void runImpl(Executor* executor);
 
+  std::unique_ptr<QueryExecutionContext> createQueryExecutionContext(
+      Executor* executor);
+
   ExecutionKernel& kernel_;
   SharedKernelContext& shared_context_;
   std::shared_ptr<FetchResult> fetch_result_;
@@ -154,5 +202,8 @@ class KernelSubtask {
   size_t start_rowid_;
   size_t num_rows_to_process_;
   size_t thread_idx_;
+  // Set when the sub-task doesn't share the execution context of its thread.
+  std::shared_ptr<KernelSubtaskResults> subtask_results_;
+  size_t subtask_idx_;
 };
 #endif  // HAVE_TBB
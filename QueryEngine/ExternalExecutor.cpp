@@ -19,6 +19,7 @@
 #include "Logger/Logger.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/OutputBufferInitialization.h"
+#include "Shared/FsstEncoding.h"
 #include "SqliteConnector/SqliteConnector.h"
 
 namespace {
@@ -275,6 +276,10 @@ int vt_column(sqlite3_vtab_cursor* cur, sqlite3_context* ctx, int col_idx) {
         ChunkIter_get_nth(chunk_iter, p_cur->count - 1, false, &vd, &is_end);
         if (vd.is_null) {
           sqlite3_result_null(ctx);
+        } else if (chunk_iter->type_info.is_fsst_string()) {
+          const auto str =
+              fsst_encoding::decompress(chunk_iter->second_buf, vd.pointer, vd.length);
+          sqlite3_result_text(ctx, str.data(), str.size(), SQLITE_TRANSIENT);
         } else {
           sqlite3_result_text(
               ctx, reinterpret_cast<const char*>(vd.pointer), vd.length, nullptr);
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/GroupByBufferPool.h"
+
+#include <cstring>
+
+#include "Logger/Logger.h"
+#include "Shared/checked_alloc.h"
+
+size_t g_group_by_buffer_pool_size{0};
+
+GroupByBufferPool& GroupByBufferPool::instance() {
+  static auto pool = new GroupByBufferPool();
+  return *pool;
+}
+
+GroupByBufferPool::GroupByBufferPool() {
+  init_thread_ = std::thread(&GroupByBufferPool::initLoop, this);
+}
+
+int8_t* GroupByBufferPool::acquire(const std::string& layout_key,
+                                   const size_t num_bytes,
+                                   const InitBufferFunc& init_buffer) {
+  std::shared_ptr<Layout> layout;
+  std::shared_ptr<int8_t> template_buffer;
+  size_t num_reserved_bytes{0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& layout_entry = layouts_[layout_key];
+    if (!layout_entry) {
+      layout_entry = std::make_shared<Layout>();
+      layout_entry->num_bytes = num_bytes;
+    }
+    layout = layout_entry;
+    CHECK_EQ(layout->num_bytes, num_bytes);
+    layout->last_used = ++clock_;
+    if (!layout->ready_buffers.empty()) {
+      auto buffer = layout->ready_buffers.back();
+      layout->ready_buffers.pop_back();
+      ++layout->num_used_buffers;
+      used_buffers_.emplace(buffer, layout);
+      return buffer;
+    }
+    template_buffer = layout->template_buffer;
+    num_reserved_bytes = template_buffer ? num_bytes : 2 * num_bytes;
+    if (!reserveBytes(num_reserved_bytes, layout.get())) {
+      if (!layout->template_buffer && !layout->num_used_buffers) {
+        layouts_.erase(layout_key);
+      }
+      return nullptr;
+    }
+    pool_bytes_ += num_reserved_bytes;
+    ++layout->num_used_buffers;
+  }
+
+  // Allocate and initialize outside of the lock, the template is kept alive by our
+  // reference even if the layout is evicted meanwhile.
+  int8_t* buffer{nullptr};
+  std::shared_ptr<int8_t> new_template_buffer;
+  try {
+    buffer = static_cast<int8_t*>(checked_malloc(num_bytes));
+    if (template_buffer) {
+      std::memcpy(buffer, template_buffer.get(), num_bytes);
+    } else {
+      init_buffer(buffer);
+      new_template_buffer.reset(static_cast<int8_t*>(checked_malloc(num_bytes)), free);
+      std::memcpy(new_template_buffer.get(), buffer, num_bytes);
+    }
+  } catch (...) {
+    free(buffer);
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_bytes_ -= num_reserved_bytes;
+    --layout->num_used_buffers;
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (new_template_buffer) {
+    if (!layout->evicted && !layout->template_buffer) {
+      layout->template_buffer = std::move(new_template_buffer);
+    } else {
+      // Another query initialized the template first.
+      pool_bytes_ -= num_bytes;
+    }
+  }
+  used_buffers_.emplace(buffer, layout);
+  return buffer;
+}
+
+void GroupByBufferPool::release(int8_t* buffer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = used_buffers_.find(buffer);
+  CHECK(it != used_buffers_.end());
+  auto layout = std::move(it->second);
+  used_buffers_.erase(it);
+  CHECK_GT(layout->num_used_buffers, size_t(0));
+  --layout->num_used_buffers;
+  if (layout->evicted || !layout->template_buffer ||
+      pool_bytes_ > g_group_by_buffer_pool_size) {
+    free(buffer);
+    pool_bytes_ -= layout->num_bytes;
+    return;
+  }
+  released_buffers_.emplace_back(std::move(layout), buffer);
+  cv_.notify_one();
+}
+
+void GroupByBufferPool::drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  drained_cv_.wait(
+      lock, [this] { return released_buffers_.empty() && !num_resetting_buffers_; });
+}
+
+void GroupByBufferPool::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [layout_key, layout] : layouts_) {
+    freeLayoutBuffers(*layout);
+  }
+  layouts_.clear();
+}
+
+size_t GroupByBufferPool::getPoolBytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pool_bytes_;
+}
+
+size_t GroupByBufferPool::getNumLayouts() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return layouts_.size();
+}
+
+// Assumes mutex_ is held. Evicts the idle buffers and templates of the least recently
+// used layouts until num_bytes more fit in the pool.
+bool GroupByBufferPool::reserveBytes(const size_t num_bytes,
+                                     const Layout* current_layout) {
+  const auto budget = g_group_by_buffer_pool_size;
+  if (num_bytes > budget) {
+    return false;
+  }
+  while (pool_bytes_ + num_bytes > budget) {
+    auto lru_it = layouts_.end();
+    for (auto it = layouts_.begin(); it != layouts_.end(); ++it) {
+      const auto& layout = it->second;
+      if (layout.get() == current_layout ||
+          (layout->ready_buffers.empty() && !layout->template_buffer)) {
+        continue;
+      }
+      if (lru_it == layouts_.end() || layout->last_used < lru_it->second->last_used) {
+        lru_it = it;
+      }
+    }
+    if (lru_it == layouts_.end()) {
+      return false;
+    }
+    freeLayoutBuffers(*lru_it->second);
+    layouts_.erase(lru_it);
+  }
+  return true;
+}
+
+// Assumes mutex_ is held.
+void GroupByBufferPool::freeLayoutBuffers(Layout& layout) {
+  for (auto buffer : layout.ready_buffers) {
+    free(buffer);
+    pool_bytes_ -= layout.num_bytes;
+  }
+  layout.ready_buffers.clear();
+  if (layout.template_buffer) {
+    layout.template_buffer.reset();
+    pool_bytes_ -= layout.num_bytes;
+  }
+  layout.evicted = true;
+}
+
+void GroupByBufferPool::initLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return !released_buffers_.empty(); });
+    auto [layout, buffer] = std::move(released_buffers_.front());
+    released_buffers_.pop_front();
+    ++num_resetting_buffers_;
+    auto template_buffer = layout->template_buffer;
+    if (!layout->evicted && template_buffer) {
+      lock.unlock();
+      std::memcpy(buffer, template_buffer.get(), layout->num_bytes);
+      lock.lock();
+    }
+    if (layout->evicted || !template_buffer) {
+      free(buffer);
+      pool_bytes_ -= layout->num_bytes;
+    } else {
+      layout->ready_buffers.push_back(buffer);
+    }
+    --num_resetting_buffers_;
+    if (released_buffers_.empty() && !num_resetting_buffers_) {
+      drained_cv_.notify_all();
+    }
+  }
+}
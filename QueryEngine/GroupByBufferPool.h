@@ -0,0 +1,110 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    GroupByBufferPool.h
+ * @brief   Process wide pool of initialized CPU group by output buffers.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+extern size_t g_group_by_buffer_pool_size;
+
+/**
+ * @class GroupByBufferPool
+ * @brief Hands out group by output buffers that are already initialized.
+ *
+ * Buffers are pooled per layout, a key describing everything the initial contents of a
+ * buffer depend on (query memory descriptor, initial aggregate values, size). The first
+ * buffer of a layout is initialized by the caller and a copy of it is kept as template.
+ * Buffers given back to the pool are reset from the template on a background thread, so
+ * that the next query with the same layout gets a ready buffer without initializing it.
+ *
+ * All the memory held by the pool, including the buffers in use, is bounded by
+ * g_group_by_buffer_pool_size. Idle buffers and templates of the least recently used
+ * layouts are freed to make room for new ones; when that is not enough, acquire()
+ * returns nullptr and the caller allocates the buffer itself.
+ */
+class GroupByBufferPool {
+ public:
+  using InitBufferFunc = std::function<void(int8_t*)>;
+
+  // The pool is never destroyed, result sets returning buffers to it can outlive the
+  // static objects.
+  static GroupByBufferPool& instance();
+
+  /// Returns an initialized buffer of num_bytes for the layout, or nullptr if the pool
+  /// has no room for it. The buffer must be given back with release().
+  int8_t* acquire(const std::string& layout_key,
+                  const size_t num_bytes,
+                  const InitBufferFunc& init_buffer);
+
+  void release(int8_t* buffer);
+
+  /// Waits until the buffers released so far are reset and back in the pool.
+  void drain();
+
+  /// Frees the idle buffers and the templates. Buffers in use are freed on release.
+  void clear();
+
+  /// Bytes held by the pool, including the buffers in use.
+  size_t getPoolBytes() const;
+
+  size_t getNumLayouts() const;
+
+  // Smaller buffers are cheaper to initialize than to look up.
+  static constexpr size_t kMinBufferBytes{1 << 16};
+
+ private:
+  GroupByBufferPool();
+
+  struct Layout {
+    size_t num_bytes;
+    std::shared_ptr<int8_t> template_buffer;
+    std::vector<int8_t*> ready_buffers;
+    size_t num_used_buffers{0};
+    uint64_t last_used{0};
+    bool evicted{false};
+  };
+
+  bool reserveBytes(const size_t num_bytes, const Layout* current_layout);
+  void freeLayoutBuffers(Layout& layout);
+  void initLoop();
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable drained_cv_;
+  std::unordered_map<std::string, std::shared_ptr<Layout>> layouts_;
+  std::unordered_map<int8_t*, std::shared_ptr<Layout>> used_buffers_;
+  std::deque<std::pair<std::shared_ptr<Layout>, int8_t*>> released_buffers_;
+  size_t num_resetting_buffers_{0};
+  size_t pool_bytes_{0};
+  uint64_t clock_{0};
+  std::thread init_thread_;
+};
@@ -33,6 +33,7 @@
 #include "StringOps/StringOpInfo.h"
 
 class CodeGenerator;
+class RuntimeJoinFilter;
 
 class TooManyHashEntries : public std::runtime_error {
  public:
@@ -181,6 +182,12 @@ class HashJoin {
 
   virtual bool isBitwiseEq() const = 0;
 
+  // Keys of the build side the outer table can be filtered on, when the hash table can
+  // tell them cheaply. See RuntimeJoinFilter.h.
+  virtual std::shared_ptr<const RuntimeJoinFilter> getRuntimeJoinFilter() const {
+    return nullptr;
+  }
+
   JoinColumn fetchJoinColumn(
       const Analyzer::ColumnVar* hash_col,
       const std::vector<Fragmenter_Namespace::FragmentInfo>& fragment_info,
@@ -30,6 +30,8 @@
 #include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
 #include "QueryEngine/RuntimeFunctions.h"
 
+extern bool g_enable_runtime_join_filters;
+
 // let's only consider CPU hahstable recycler at this moment
 std::unique_ptr<HashtableRecycler> PerfectJoinHashTable::hash_table_cache_ =
     std::make_unique<HashtableRecycler>(CacheItemType::PERFECT_HT,
@@ -254,6 +256,9 @@ std::shared_ptr<PerfectJoinHashTable> PerfectJoinHashTable::getInstance(
         std::string("Fatal error while attempting to build hash tables for join: ") +
         e.what());
   }
+  if (g_enable_runtime_join_filters) {
+    join_hash_table->buildRuntimeJoinFilter();
+  }
   if (VLOGGING(1)) {
     ts2 = std::chrono::steady_clock::now();
     VLOG(1) << "Built perfect hash table "
@@ -630,6 +635,68 @@ void PerfectJoinHashTable::reify() {
   }
 }
 
+// Collects the keys of the CPU hash table, to skip the fragments of the outer table which
+// can't have a match. Only inner joins on a column of the outer table comparing the keys
+// of both sides as stored in their chunks are filtered.
+void PerfectJoinHashTable::buildRuntimeJoinFilter() {
+  if (join_type_ != JoinType::INNER || isBitwiseEq() || needs_dict_translation_ ||
+      shardCount() || inner_outer_pairs_.empty() || hash_tables_for_device_.empty() ||
+      !inner_outer_string_op_infos_.first.empty() ||
+      !inner_outer_string_op_infos_.second.empty()) {
+    return;
+  }
+  const auto outer_col =
+      dynamic_cast<const Analyzer::ColumnVar*>(inner_outer_pairs_.front().second);
+  if (!outer_col || outer_col->get_rte_idx() != 0) {
+    return;
+  }
+  const auto& hash_table = hash_tables_for_device_.front();
+  if (!hash_table || !hash_table->getCpuBuffer() ||
+      (hash_table->getLayout() != HashType::OneToOne &&
+       hash_table->getLayout() != HashType::OneToMany)) {
+    return;
+  }
+  const auto buff = reinterpret_cast<const int32_t*>(hash_table->getCpuBuffer());
+  const auto entry_count = hash_table->getEntryCount();
+  // The counts follow the offsets in one-to-many layouts, and empty one-to-one slots hold
+  // the invalid slot value.
+  const auto count_buff =
+      hash_table->getLayout() == HashType::OneToMany ? buff + entry_count : nullptr;
+  const auto bucket_normalization =
+      get_bucketized_hash_entry_info(
+          inner_outer_pairs_.front().first->get_type_info(), col_range_, false)
+          .bucket_normalization;
+  int64_t min_key{std::numeric_limits<int64_t>::max()};
+  int64_t max_key{std::numeric_limits<int64_t>::min()};
+  std::vector<int64_t> keys;
+  bool has_all_keys{bucket_normalization == 1};
+  for (size_t slot = 0; slot < entry_count; ++slot) {
+    if (count_buff ? count_buff[slot] <= 0 : buff[slot] == -1) {
+      continue;
+    }
+    const int64_t first_key =
+        col_range_.getIntMin() + static_cast<int64_t>(slot) * bucket_normalization;
+    const int64_t last_key =
+        std::min(first_key + bucket_normalization - 1, col_range_.getIntMax());
+    min_key = std::min(min_key, first_key);
+    max_key = std::max(max_key, last_key);
+    if (has_all_keys && keys.size() < RuntimeJoinFilter::kMaxKeys) {
+      keys.push_back(first_key);
+    } else {
+      has_all_keys = false;
+    }
+  }
+  VLOG(1) << "Runtime join filter on " << outer_col->toString() << ": [" << min_key
+          << ", " << max_key << "]"
+          << (has_all_keys ? ", " + std::to_string(keys.size()) + " keys" : "");
+  runtime_join_filter_ = std::make_shared<RuntimeJoinFilter>(
+      std::dynamic_pointer_cast<Analyzer::ColumnVar>(outer_col->deep_copy()),
+      min_key,
+      max_key,
+      has_all_keys ? std::optional<std::vector<int64_t>>(std::move(keys))
+                   : std::nullopt);
+}
+
 Data_Namespace::MemoryLevel PerfectJoinHashTable::getEffectiveMemoryLevel(
     const std::vector<InnerOuter>& inner_outer_pairs) const {
   if (needs_dictionary_translation(
@@ -34,6 +34,7 @@
 #include "QueryEngine/InputMetadata.h"
 #include "QueryEngine/JoinHashTable/HashJoin.h"
 #include "QueryEngine/JoinHashTable/PerfectHashTable.h"
+#include "QueryEngine/JoinHashTable/RuntimeJoinFilter.h"
 
 #include <llvm/IR/Value.h>
 
@@ -98,6 +99,10 @@ class PerfectJoinHashTable : public HashJoin {
 
   std::string getHashJoinType() const final { return "Perfect"; }
 
+  std::shared_ptr<const RuntimeJoinFilter> getRuntimeJoinFilter() const override {
+    return runtime_join_filter_;
+  }
+
   static HashtableRecycler* getHashTableCache() {
     CHECK(hash_table_cache_);
     return hash_table_cache_.get();
@@ -203,6 +208,7 @@ class PerfectJoinHashTable : public HashJoin {
                        const Analyzer::ColumnVar* inner_col) const;
 
   void reify();
+  void buildRuntimeJoinFilter();
   std::shared_ptr<PerfectHashTable> initHashTableOnCpuFromCache(
       QueryPlanHash key,
       CacheItemType item_type,
@@ -283,6 +289,7 @@ class PerfectJoinHashTable : public HashJoin {
   std::unordered_set<size_t> table_keys_;
   const TableIdToNodeMap table_id_to_node_map_;
   const InnerOuterStringOpInfos inner_outer_string_op_infos_;
+  std::shared_ptr<const RuntimeJoinFilter> runtime_join_filter_;
 
   static std::unique_ptr<HashtableRecycler> hash_table_cache_;
   static std::unique_ptr<HashingSchemeRecycler> hash_table_layout_cache_;
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RuntimeJoinFilter.h
+ * @brief   Keys of the build side of an inner hash join, used to skip the fragments of
+ *          the outer table whose rows can't find a match.
+ *
+ * The filter holds the range of the keys inserted in the hash table and, when there are
+ * at most kMaxKeys of them, the keys themselves, which are also looked up in the Bloom
+ * filters of the chunks of the outer key column.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Analyzer/Analyzer.h"
+#include "DataMgr/ChunkBloomFilter.h"
+
+class RuntimeJoinFilter {
+ public:
+  static constexpr size_t kMaxKeys{1024};
+
+  // Keys in [min_key, max_key], all of them in keys if set. The keys must be sorted.
+  RuntimeJoinFilter(std::shared_ptr<Analyzer::ColumnVar> outer_key,
+                    const int64_t min_key,
+                    const int64_t max_key,
+                    std::optional<std::vector<int64_t>> keys)
+      : outer_key_(std::move(outer_key))
+      , min_key_(min_key)
+      , max_key_(max_key)
+      , keys_(std::move(keys)) {}
+
+  const Analyzer::ColumnVar* getOuterKey() const { return outer_key_.get(); }
+
+  // Whether a key may be in [min, max].
+  bool mayMatch(const int64_t min, const int64_t max) const {
+    if (max < min_key_ || min > max_key_) {
+      return false;
+    }
+    if (!keys_) {
+      return true;
+    }
+    const auto it = std::lower_bound(keys_->begin(), keys_->end(), min);
+    return it != keys_->end() && *it <= max;
+  }
+
+  // Whether a key in [min, max] may be in the chunk. Without the keys, only the range
+  // can be checked.
+  bool mayMatch(const int64_t min,
+                const int64_t max,
+                const ChunkBloomFilter& bloom_filter) const {
+    if (!keys_) {
+      return mayMatch(min, max);
+    }
+    for (auto it = std::lower_bound(keys_->begin(), keys_->end(), min);
+         it != keys_->end() && *it <= max;
+         ++it) {
+      if (bloom_filter.mayContain(*it)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::shared_ptr<Analyzer::ColumnVar> outer_key_;
+  int64_t min_key_;
+  int64_t max_key_;
+  std::optional<std::vector<int64_t>> keys_;
+};
@@ -762,6 +762,12 @@ declare i64 @DateAddNullable(i32, i64, i64, i64);
 declare i64 @DateAddHighPrecision(i32, i64, i64, i32);
 declare i64 @DateAddHighPrecisionNullable(i32, i64, i64, i32, i64);
 declare i64 @string_decode(i8*, i64);
+declare i1 @fsst_string_eq(i8*, i64, i8*, i32);
+declare i8 @fsst_string_eq_nullable(i8*, i64, i8*, i32, i8);
+declare i1 @fsst_string_ne(i8*, i64, i8*, i32);
+declare i8 @fsst_string_ne_nullable(i8*, i64, i8*, i32, i8);
+declare i1 @fsst_string_starts_with(i8*, i64, i8*, i32);
+declare i8 @fsst_string_starts_with_nullable(i8*, i64, i8*, i32, i8);
 declare i32 @array_size(i8*, i64, i32);
 declare i32 @array_size_nullable(i8*, i64, i32, i32);
 declare i32 @array_size_1_nullable(i8*, i64, i32);
@@ -1494,7 +1500,13 @@ bool CodeGenerator::alwaysCloneRuntimeFunction(const llvm::Function* func) {
          func->getName() == "query_stub" || func->getName() == "multifrag_query" ||
          func->getName() == "fixed_width_int_decode" ||
          func->getName() == "fixed_width_unsigned_decode" ||
-         func->getName() == "diff_fixed_width_int_decode" ||
+         func->getName() == "diff_bit_packed_int_decode" ||
+         func->getName() == "bit_packed_int_decode" ||
+         func->getName() == "run_length_int_decode" ||
+         func->getName() == "run_length_int_decode_cursor" ||
+         func->getName() == "sparse_int_decode" ||
+         func->getName() == "sparse_float_decode" ||
+         func->getName() == "sparse_double_decode" ||
          func->getName() == "fixed_width_double_decode" ||
          func->getName() == "fixed_width_float_decode" ||
          func->getName() == "fixed_width_small_date_decode" ||
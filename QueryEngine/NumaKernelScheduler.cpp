@@ -0,0 +1,185 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "QueryEngine/NumaKernelScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#ifdef HAVE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+#include "Logger/Logger.h"
+#include "OSDependent/heavyai_numa.h"
+#include "Shared/thread_count.h"
+
+size_t g_num_executors{2};
+
+#ifdef HAVE_TBB
+namespace {
+// Binds the threads of an arena to a NUMA node while they work in the arena.
+class NumaNodeObserver : public tbb::task_scheduler_observer {
+ public:
+  NumaNodeObserver(tbb::task_arena& arena, const size_t numa_node)
+      : tbb::task_scheduler_observer(arena), numa_node_(numa_node) {
+    observe(true);
+  }
+
+  ~NumaNodeObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool is_worker) override {
+    heavyai::bind_thread_to_numa_node(numa_node_);
+  }
+
+  void on_scheduler_exit(bool is_worker) override {
+    heavyai::unbind_thread_from_numa_node();
+  }
+
+ private:
+  const size_t numa_node_;
+};
+
+struct NumaNodeArena {
+  tbb::task_arena arena;
+  std::unique_ptr<NumaNodeObserver> observer;
+};
+
+std::vector<std::unique_ptr<NumaNodeArena>>& get_numa_node_arenas() {
+  static auto arenas = [] {
+    std::vector<std::unique_ptr<NumaNodeArena>> arenas;
+    const auto& node_cpus = heavyai::get_numa_node_cpus();
+    for (size_t numa_node = 0; numa_node < node_cpus.size(); ++numa_node) {
+      auto arena = std::make_unique<NumaNodeArena>();
+      // No slots are reserved for external threads, kernels are only enqueued.
+      arena->arena.initialize(
+          get_numa_node_max_concurrency(node_cpus[numa_node].size()), 0);
+      arena->observer = std::make_unique<NumaNodeObserver>(arena->arena, numa_node);
+      arenas.emplace_back(std::move(arena));
+    }
+    return arenas;
+  }();
+  return arenas;
+}
+}  // namespace
+#endif  // HAVE_TBB
+
+bool can_run_kernels_on_numa_nodes() {
+#ifdef HAVE_TBB
+  return heavyai::get_num_numa_nodes() > 1;
+#else
+  return false;
+#endif  // HAVE_TBB
+}
+
+std::vector<std::vector<size_t>> assign_kernels_to_numa_nodes(
+    const std::vector<std::optional<size_t>>& kernel_numa_nodes,
+    const size_t num_numa_nodes) {
+  CHECK_GT(num_numa_nodes, size_t(0));
+  std::vector<std::vector<size_t>> node_kernels(num_numa_nodes);
+  size_t next_numa_node = 0;
+  for (size_t kernel_idx = 0; kernel_idx < kernel_numa_nodes.size(); ++kernel_idx) {
+    const auto& numa_node = kernel_numa_nodes[kernel_idx];
+    const size_t kernel_node =
+        numa_node ? *numa_node % num_numa_nodes : next_numa_node++ % num_numa_nodes;
+    node_kernels[kernel_node].emplace_back(kernel_idx);
+  }
+  return node_kernels;
+}
+
+size_t get_numa_node_max_concurrency(const size_t num_node_cpus) {
+  const size_t executor_threads =
+      cpu_threads() / std::max(g_num_executors, static_cast<size_t>(1));
+  return std::max(std::min(num_node_cpus, executor_threads), static_cast<size_t>(1));
+}
+
+void run_kernels_on_numa_nodes(
+    const std::vector<std::optional<size_t>>& kernel_numa_nodes,
+    const std::function<void(const size_t)>& run_kernel) {
+#ifdef HAVE_TBB
+  auto& arenas = get_numa_node_arenas();
+  const size_t num_numa_nodes = arenas.size();
+  const auto node_kernels =
+      assign_kernels_to_numa_nodes(kernel_numa_nodes, num_numa_nodes);
+
+  std::vector<std::atomic<size_t>> next_node_kernel(num_numa_nodes);
+  for (auto& next_kernel : next_node_kernel) {
+    next_kernel.store(0);
+  }
+  // Takes the next kernel of the node, or steals one from the other nodes.
+  auto get_next_kernel = [&](const size_t numa_node) -> std::optional<size_t> {
+    for (size_t i = 0; i < num_numa_nodes; ++i) {
+      const size_t victim_node = (numa_node + i) % num_numa_nodes;
+      const size_t idx = next_node_kernel[victim_node]++;
+      if (idx < node_kernels[victim_node].size()) {
+        return node_kernels[victim_node][idx];
+      }
+    }
+    return std::nullopt;
+  };
+
+  std::mutex mutex;
+  std::condition_variable workers_done_cv;
+  std::exception_ptr first_exception;
+  std::atomic<bool> failed{false};
+  std::vector<size_t> num_node_workers(num_numa_nodes);
+  size_t num_running_workers = 0;
+  for (size_t numa_node = 0; numa_node < num_numa_nodes; ++numa_node) {
+    num_node_workers[numa_node] =
+        std::min(static_cast<size_t>(arenas[numa_node]->arena.max_concurrency()),
+                 kernel_numa_nodes.size());
+    num_running_workers += num_node_workers[numa_node];
+  }
+  for (size_t numa_node = 0; numa_node < num_numa_nodes; ++numa_node) {
+    for (size_t worker = 0; worker < num_node_workers[numa_node]; ++worker) {
+      arenas[numa_node]->arena.enqueue([&, numa_node] {
+        try {
+          while (!failed) {
+            const auto kernel_idx = get_next_kernel(numa_node);
+            if (!kernel_idx) {
+              break;
+            }
+            run_kernel(*kernel_idx);
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!first_exception) {
+            first_exception = std::current_exception();
+          }
+          failed = true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--num_running_workers == 0) {
+          workers_done_cv.notify_all();
+        }
+      });
+    }
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  workers_done_cv.wait(lock, [&] { return num_running_workers == 0; });
+  if (first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+#else
+  UNREACHABLE();
+#endif  // HAVE_TBB
+}
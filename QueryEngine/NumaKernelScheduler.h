@@ -0,0 +1,55 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file    NumaKernelScheduler.h
+ * @brief   Runs CPU execution kernels on the NUMA node that holds their chunks.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// Number of executors sharing the host CPUs (--num-executors), bounds the arena workers.
+extern size_t g_num_executors;
+
+// Returns true if kernels can be run on NUMA node bound threads on this host.
+bool can_run_kernels_on_numa_nodes();
+
+// Returns the kernels to run on each node. Kernels without a home node are spread
+// round-robin over the nodes.
+std::vector<std::vector<size_t>> assign_kernels_to_numa_nodes(
+    const std::vector<std::optional<size_t>>& kernel_numa_nodes,
+    const size_t num_numa_nodes);
+
+// Returns the number of workers to run on a node with num_node_cpus CPUs, so that the
+// arenas of all executors together do not exceed cpu_threads().
+size_t get_numa_node_max_concurrency(const size_t num_node_cpus);
+
+/**
+ * Calls run_kernel(kernel_idx) for every kernel. A kernel with a home node runs on a TBB
+ * arena whose threads are bound to that node; kernels without one are spread over the
+ * nodes. Every node runs up to get_numa_node_max_concurrency() workers and a worker
+ * whose node has no kernels left steals kernels from the other nodes instead of sitting
+ * idle. Once all workers are done, the first exception thrown by a kernel is rethrown.
+ */
+void run_kernels_on_numa_nodes(
+    const std::vector<std::optional<size_t>>& kernel_numa_nodes,
+    const std::function<void(const size_t)>& run_kernel);
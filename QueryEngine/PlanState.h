@@ -60,6 +60,8 @@ struct PlanState {
   std::unordered_map<InputColDescriptor, size_t> global_to_local_col_ids_;
   std::set<std::pair<TableId, ColumnId>> columns_to_fetch_;
   std::set<std::pair<TableId, ColumnId>> columns_to_not_fetch_;
+  // FSST encoded columns read by the generated code, fetched decompressed.
+  std::set<std::pair<TableId, ColumnId>> columns_to_decompress_;
   std::unordered_map<size_t, std::vector<std::shared_ptr<Analyzer::Expr>>>
       left_join_non_hashtable_quals_;
   bool allow_lazy_fetch_;
@@ -20,6 +20,7 @@
 #include "Execute.h"
 #include "GpuInitGroups.h"
 #include "GpuMemUtils.h"
+#include "GroupByBufferPool.h"
 #include "Logger/Logger.h"
 #include "OutputBufferInitialization.h"
 #include "QueryEngine/QueryEngine.h"
@@ -77,6 +78,44 @@ int64_t* alloc_group_by_buffer(const size_t numBytes,
   }
 }
 
+// Returns the key of the layout of the group by buffer in the GroupByBufferPool, or an
+// empty string if the buffer cannot be pooled. Count distinct and approximate quantile
+// targets initialize the buffer with pointers owned by the query, so it cannot be reused.
+std::string get_group_by_buffer_pool_key(const RelAlgExecutionUnit& ra_exe_unit,
+                                         const QueryMemoryDescriptor& query_mem_desc,
+                                         const ExecutorDeviceType device_type,
+                                         const bool output_columnar,
+                                         const bool render,
+                                         const size_t group_buffer_size,
+                                         const std::vector<int64_t>& init_agg_vals,
+                                         const Executor* executor) {
+  if (!g_group_by_buffer_pool_size || device_type != ExecutorDeviceType::CPU || render ||
+      ra_exe_unit.use_bump_allocator || query_mem_desc.lazyInitGroups(device_type) ||
+      group_buffer_size < GroupByBufferPool::kMinBufferBytes) {
+    return {};
+  }
+  for (const auto target_expr : executor->plan_state_->target_exprs_) {
+    const auto agg_info = get_target_info(target_expr, g_bigint_count);
+    if (is_distinct_target(agg_info) ||
+        (agg_info.is_agg && agg_info.agg_kind == kAPPROX_QUANTILE)) {
+      return {};
+    }
+  }
+  auto key = query_mem_desc.toString();
+  key += "\tOutput Columnar Buffer: " + std::to_string(output_columnar) + "\n";
+  if (query_mem_desc.useStreamingTopN()) {
+    key += "\tTop N: " +
+           std::to_string(ra_exe_unit.sort_info.offset + ra_exe_unit.sort_info.limit) +
+           "\n";
+  }
+  key += "\tInit Agg Vals:";
+  for (const auto init_agg_val : init_agg_vals) {
+    key += " " + std::to_string(init_agg_val);
+  }
+  key += "\n\tBuffer Size: " + std::to_string(group_buffer_size) + "\n";
+  return key;
+}
+
 inline int64_t get_consistent_frag_size(const std::vector<uint64_t>& frag_offsets) {
   if (frag_offsets.size() < 2) {
     return int64_t(-1);
@@ -241,8 +280,18 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   CHECK_GE(group_buffer_size, size_t(0));
 
   const auto group_buffers_count = !query_mem_desc.isGroupBy() ? 1 : num_buffers_;
+  const auto pool_layout_key =
+      get_group_by_buffer_pool_key(ra_exe_unit,
+                                   query_mem_desc,
+                                   device_type,
+                                   output_columnar,
+                                   render_allocator_map != nullptr,
+                                   group_buffer_size,
+                                   init_agg_vals_,
+                                   executor);
   int64_t* group_by_buffer_template{nullptr};
-  if (!query_mem_desc.lazyInitGroups(device_type) && group_buffers_count > 1) {
+  if (!query_mem_desc.lazyInitGroups(device_type) && group_buffers_count > 1 &&
+      pool_layout_key.empty()) {
     group_by_buffer_template = reinterpret_cast<int64_t*>(
         row_set_mem_owner_->allocate(group_buffer_size, thread_idx_));
     initGroupByBuffer(group_by_buffer_template,
@@ -280,11 +329,31 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   }
 
   for (size_t i = 0; i < group_buffers_count; i += step) {
-    auto group_by_buffer = alloc_group_by_buffer(actual_group_buffer_size,
-                                                 render_allocator_map,
-                                                 thread_idx_,
-                                                 row_set_mem_owner_.get());
-    if (!query_mem_desc.lazyInitGroups(device_type)) {
+    int64_t* group_by_buffer{nullptr};
+    if (!pool_layout_key.empty()) {
+      CHECK_EQ(index_buffer_qw, size_t(0));
+      auto pooled_buffer = GroupByBufferPool::instance().acquire(
+          pool_layout_key, group_buffer_size, [&](int8_t* buffer) {
+            initGroupByBuffer(reinterpret_cast<int64_t*>(buffer),
+                              ra_exe_unit,
+                              query_mem_desc,
+                              device_type,
+                              output_columnar,
+                              executor);
+          });
+      if (pooled_buffer) {
+        row_set_mem_owner_->addPooledGroupByBuffer(pooled_buffer);
+        group_by_buffer = reinterpret_cast<int64_t*>(pooled_buffer);
+      }
+    }
+    const bool is_pooled_buffer = group_by_buffer != nullptr;
+    if (!is_pooled_buffer) {
+      group_by_buffer = alloc_group_by_buffer(actual_group_buffer_size,
+                                              render_allocator_map,
+                                              thread_idx_,
+                                              row_set_mem_owner_.get());
+    }
+    if (!query_mem_desc.lazyInitGroups(device_type) && !is_pooled_buffer) {
       if (group_by_buffer_template) {
         memcpy(group_by_buffer + index_buffer_qw,
                group_by_buffer_template,
@@ -737,7 +806,7 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
     auto ptr = count_distinct_bitmap_crt_ptr_;
     count_distinct_bitmap_crt_ptr_ += bitmap_byte_sz;
     row_set_mem_owner_->addCountDistinctBuffer(
-        ptr, bitmap_byte_sz, /*physial_buffer=*/false);
+        ptr, bitmap_byte_sz, /*physial_buffer=*/false, thread_idx_);
     return reinterpret_cast<int64_t>(ptr);
   }
   return reinterpret_cast<int64_t>(
@@ -746,7 +815,7 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
 
 int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   auto count_distinct_set = new CountDistinctSet();
-  row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
+  row_set_mem_owner_->addCountDistinctSet(count_distinct_set, thread_idx_);
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
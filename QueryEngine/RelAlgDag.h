@@ -2190,7 +2190,10 @@ class RelModify : public RelAlgNode {
         }
 
         // Check for valid types
-        if (column_desc->columnType.is_varlen()) {
+        if (column_desc->columnType.is_varlen() ||
+            column_desc->columnType.is_block_encoded()) {
+          // run length, differential and sparse encoded rows cannot be overwritten in
+          // place either
           varlen_update_required = true;
         }
         if (column_desc->columnType.is_geometry()) {
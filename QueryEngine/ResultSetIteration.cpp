@@ -30,6 +30,7 @@
 #include "ResultSet.h"
 #include "ResultSetGeoSerialization.h"
 #include "RuntimeFunctions.h"
+#include "Shared/FsstEncoding.h"
 #include "Shared/SqlTypesLayout.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
@@ -107,6 +108,16 @@ const int8_t* advance_col_buff_to_slot(const int8_t* buff,
   CHECK(false);
   return nullptr;
 }
+
+// The string of a lazily fetched none encoded string column, decompressed if the chunk
+// is FSST encoded.
+std::string lazy_fetch_string(const ChunkIter* chunk_iter, const VarlenDatum& vd) {
+  if (chunk_iter->type_info.is_fsst_string()) {
+    return fsst_encoding::decompress(chunk_iter->second_buf, vd.pointer, vd.length);
+  }
+  return std::string(reinterpret_cast<char*>(vd.pointer), vd.length);
+}
+
 }  // namespace
 
 // Gets the byte offset, starting from the beginning of the row targets buffer, of
@@ -641,7 +652,8 @@ InternalTargetValue ResultSet::getVarlenOrderEntry(const int64_t str_ptr,
     host_str_ptr = reinterpret_cast<char*>(str_ptr);
   }
   std::string str(host_str_ptr, str_len);
-  return InternalTargetValue(row_set_mem_owner_->addString(str));
+  return InternalTargetValue(
+      row_set_mem_owner_->addString(str, row_set_mem_owner_->getCurrentThreadIdx()));
 }
 
 int64_t ResultSet::lazyReadInt(const int64_t ival,
@@ -666,18 +678,17 @@ int64_t ResultSet::lazyReadInt(const int64_t ival,
           target_info.sql_type.get_compression() == kENCODING_NONE) {
         VarlenDatum vd;
         bool is_end{false};
+        auto chunk_iter =
+            reinterpret_cast<ChunkIter*>(const_cast<int8_t*>(frag_col_buffer));
         ChunkIter_get_nth(
-            reinterpret_cast<ChunkIter*>(const_cast<int8_t*>(frag_col_buffer)),
-            storage_lookup_result.fixedup_entry_idx,
-            false,
-            &vd,
-            &is_end);
+            chunk_iter, storage_lookup_result.fixedup_entry_idx, false, &vd, &is_end);
         CHECK(!is_end);
         if (vd.is_null) {
           return 0;
         }
-        std::string fetched_str(reinterpret_cast<char*>(vd.pointer), vd.length);
-        return reinterpret_cast<int64_t>(row_set_mem_owner_->addString(fetched_str));
+        const auto fetched_str = lazy_fetch_string(chunk_iter, vd);
+        return reinterpret_cast<int64_t>(row_set_mem_owner_->addString(
+            fetched_str, row_set_mem_owner_->getCurrentThreadIdx()));
       }
       return result_set::lazy_decode(col_lazy_fetch, frag_col_buffer, ival_copy);
     }
@@ -1366,8 +1377,7 @@ TargetValue ResultSet::makeVarlenTargetValue(const int8_t* ptr1,
         }
         CHECK(vd.pointer);
         CHECK_GT(vd.length, 0u);
-        std::string fetched_str(reinterpret_cast<char*>(vd.pointer), vd.length);
-        return fetched_str;
+        return lazy_fetch_string(reinterpret_cast<ChunkIter*>(col_buf), vd);
       } else {
         CHECK(target_info.sql_type.is_array());
         ArrayDatum ad;
@@ -115,17 +115,38 @@ int64_t result_set::lazy_decode(const ColumnLazyFetchInfo& col_lazy_fetch,
   CHECK(col_lazy_fetch.is_lazily_fetched);
   const auto& type_info = col_lazy_fetch.type;
   if (type_info.is_fp()) {
+    const bool is_sparse = type_info.get_compression() == kENCODING_SPARSE;
     if (type_info.get_type() == kFLOAT) {
-      double fval = fixed_width_float_decode_noinline(byte_stream, pos);
+      double fval = is_sparse
+                        ? sparse_float_decode_noinline(byte_stream, NULL_FLOAT, pos)
+                        : fixed_width_float_decode_noinline(byte_stream, pos);
       return *reinterpret_cast<const int64_t*>(may_alias_ptr(&fval));
     } else {
-      double fval = fixed_width_double_decode_noinline(byte_stream, pos);
+      double fval = is_sparse
+                        ? sparse_double_decode_noinline(byte_stream, NULL_DOUBLE, pos)
+                        : fixed_width_double_decode_noinline(byte_stream, pos);
       return *reinterpret_cast<const int64_t*>(may_alias_ptr(&fval));
     }
   }
   CHECK(type_info.is_integer() || type_info.is_decimal() || type_info.is_time() ||
         type_info.is_timeinterval() || type_info.is_boolean() || type_info.is_string() ||
         type_info.is_array());
+  if (type_info.is_run_length_encoded()) {
+    // Runs hold logical values, nulls included.
+    return run_length_int_decode_noinline(byte_stream, type_info.get_size(), pos);
+  }
+  if (type_info.get_compression() == kENCODING_DIFF) {
+    return diff_bit_packed_int_decode_noinline(
+        byte_stream, inline_int_null_val(type_info), pos);
+  }
+  if (type_info.get_compression() == kENCODING_SPARSE) {
+    return sparse_int_decode_noinline(
+        byte_stream, type_info.get_size(), inline_int_null_val(type_info), pos);
+  }
+  if (type_info.is_bit_packed()) {
+    return bit_packed_int_decode_noinline(
+        byte_stream, type_info.get_comp_param(), inline_int_null_val(type_info), pos);
+  }
   size_t type_bitwidth = get_bit_width(type_info);
   if (type_info.get_compression() == kENCODING_FIXED) {
     type_bitwidth = type_info.get_comp_param();
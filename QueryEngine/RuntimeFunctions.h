@@ -264,6 +264,36 @@ fixed_width_unsigned_decode_noinline(const int8_t* byte_stream,
                                      const int32_t byte_width,
                                      const int64_t pos);
 
+extern "C" RUNTIME_EXPORT int64_t
+diff_bit_packed_int_decode_noinline(const int8_t* byte_stream,
+                                    const int64_t null_val,
+                                    const int64_t pos);
+
+extern "C" RUNTIME_EXPORT int64_t
+bit_packed_int_decode_noinline(const int8_t* byte_stream,
+                               const int32_t bit_width,
+                               const int64_t null_val,
+                               const int64_t pos);
+
+extern "C" RUNTIME_EXPORT int64_t
+run_length_int_decode_noinline(const int8_t* byte_stream,
+                               const int32_t byte_width,
+                               const int64_t pos);
+
+extern "C" RUNTIME_EXPORT int64_t sparse_int_decode_noinline(const int8_t* byte_stream,
+                                                             const int32_t byte_width,
+                                                             const int64_t null_val,
+                                                             const int64_t pos);
+
+extern "C" RUNTIME_EXPORT float sparse_float_decode_noinline(const int8_t* byte_stream,
+                                                             const float null_val,
+                                                             const int64_t pos);
+
+extern "C" RUNTIME_EXPORT double sparse_double_decode_noinline(
+    const int8_t* byte_stream,
+    const double null_val,
+    const int64_t pos);
+
 extern "C" RUNTIME_EXPORT float fixed_width_float_decode_noinline(
     const int8_t* byte_stream,
     const int64_t pos);
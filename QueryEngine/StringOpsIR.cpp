@@ -25,6 +25,8 @@
 
 #include <boost/locale/conversion.hpp>
 
+#include <optional>
+
 extern "C" RUNTIME_EXPORT uint64_t string_decode(int8_t* chunk_iter_, int64_t pos) {
   auto chunk_iter = reinterpret_cast<ChunkIter*>(chunk_iter_);
   VarlenDatum vd;
@@ -36,6 +38,40 @@ extern "C" RUNTIME_EXPORT uint64_t string_decode(int8_t* chunk_iter_, int64_t po
                           (static_cast<uint64_t>(vd.length) << 48);
 }
 
+// Compare FSST encoded strings with a literal without decompressing them.
+#define FSST_STRING_CMP(fn_name, prefix, negate)                                         \
+  extern "C" RUNTIME_EXPORT bool fn_name(                                              \
+      int8_t* chunk_iter_, int64_t pos, const char* str, const int32_t str_len) {      \
+    bool is_null;                                                                      \
+    return ChunkIter_string_matches(reinterpret_cast<ChunkIter*>(chunk_iter_),         \
+                                    pos,                                               \
+                                    str,                                               \
+                                    str_len,                                           \
+                                    prefix,                                            \
+                                    &is_null) != negate;                               \
+  }                                                                                    \
+  extern "C" RUNTIME_EXPORT int8_t fn_name##_nullable(int8_t* chunk_iter_,             \
+                                                      int64_t pos,                     \
+                                                      const char* str,                 \
+                                                      const int32_t str_len,           \
+                                                      const int8_t bool_null) {        \
+    bool is_null;                                                                      \
+    const auto matches =                                                               \
+        ChunkIter_string_matches(reinterpret_cast<ChunkIter*>(chunk_iter_),            \
+                                 pos,                                                  \
+                                 str,                                                  \
+                                 str_len,                                              \
+                                 prefix,                                               \
+                                 &is_null);                                            \
+    return is_null ? bool_null : (matches != negate) ? 1 : 0;                          \
+  }
+
+FSST_STRING_CMP(fsst_string_eq, false, false)
+FSST_STRING_CMP(fsst_string_ne, false, true)
+FSST_STRING_CMP(fsst_string_starts_with, true, false)
+
+#undef FSST_STRING_CMP
+
 extern "C" RUNTIME_EXPORT uint64_t string_decompress(const int32_t string_id,
                                                      const int64_t string_dict_handle) {
   if (string_id == NULL_INT) {
@@ -569,6 +605,10 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
   if (fast_dict_like_lv) {
     return fast_dict_like_lv;
   }
+  auto fsst_like_lv = codegenFsstLike(expr, escape_char, co);
+  if (fsst_like_lv) {
+    return fsst_like_lv;
+  }
   const auto& ti = expr->get_arg()->get_type_info();
   CHECK(ti.is_string());
   if (g_enable_watchdog && ti.get_compression() != kENCODING_NONE) {
@@ -603,6 +643,126 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
   return cgen_state_->emitCall(fn_name, str_like_args);
 }
 
+namespace {
+
+// The operand if it is an FSST encoded column which can be compared with a literal
+// without decompressing it, nullptr otherwise.
+const Analyzer::ColumnVar* get_fsst_column_var(const Analyzer::Expr* expr,
+                                               const Executor* executor) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(col_var) ||
+      col_var->get_table_id() <= 0 || col_var->get_rte_idx() > 0 ||
+      !col_var->get_type_info().is_fsst_string()) {
+    return nullptr;
+  }
+  if (WindowProjectNodeContext::getActiveWindowFunctionContext(executor)) {
+    return nullptr;
+  }
+  return col_var;
+}
+
+// The string matched by a LIKE pattern without wildcards or by the prefix of a pattern
+// ending with its only wildcard, a single %. Returns the unescaped string and whether
+// it is a prefix.
+std::optional<std::pair<std::string, bool>> get_fsst_like_string(
+    const std::string& pattern,
+    const char escape_char) {
+  std::string str;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    const auto c = pattern[i];
+    if (c == escape_char) {
+      if (++i == pattern.size()) {
+        return std::nullopt;
+      }
+      str.push_back(pattern[i]);
+    } else if (c == '%' && i + 1 == pattern.size()) {
+      return std::make_pair(str, true);
+    } else if (c == '%' || c == '_' || c == '[' || c == ']') {
+      return std::nullopt;
+    } else {
+      str.push_back(c);
+    }
+  }
+  return std::make_pair(str, false);
+}
+
+}  // namespace
+
+llvm::Value* CodeGenerator::codegenFsstLike(const Analyzer::LikeExpr* expr,
+                                            const char escape_char,
+                                            const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  const auto col_var = get_fsst_column_var(expr->get_arg(), executor());
+  if (!col_var || expr->get_is_ilike() || expr->get_is_simple()) {
+    return nullptr;
+  }
+  const auto pattern = dynamic_cast<const Analyzer::Constant*>(expr->get_like_expr());
+  CHECK(pattern);
+  if (pattern->get_is_null()) {
+    return nullptr;
+  }
+  const auto like_str =
+      get_fsst_like_string(*pattern->get_constval().stringval, escape_char);
+  if (!like_str) {
+    return nullptr;
+  }
+  const auto& [str, is_prefix] = *like_str;
+  return codegenFsstStrCmp(is_prefix ? "fsst_string_starts_with" : "fsst_string_eq",
+                           col_var,
+                           str,
+                           expr->get_type_info(),
+                           co);
+}
+
+llvm::Value* CodeGenerator::codegenFsstStrCmp(const SQLOps optype,
+                                              const Analyzer::Expr* lhs,
+                                              const Analyzer::Expr* rhs,
+                                              const SQLTypeInfo& result_ti,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  if (optype != kEQ && optype != kNE) {
+    return nullptr;
+  }
+  auto col_var = get_fsst_column_var(lhs, executor());
+  auto constant = dynamic_cast<const Analyzer::Constant*>(rhs);
+  if (!col_var) {
+    col_var = get_fsst_column_var(rhs, executor());
+    constant = dynamic_cast<const Analyzer::Constant*>(lhs);
+  }
+  if (!col_var || !constant || constant->get_is_null()) {
+    return nullptr;
+  }
+  return codegenFsstStrCmp(optype == kEQ ? "fsst_string_eq" : "fsst_string_ne",
+                           col_var,
+                           *constant->get_constval().stringval,
+                           result_ti,
+                           co);
+}
+
+llvm::Value* CodeGenerator::codegenFsstStrCmp(const std::string& fn_base,
+                                              const Analyzer::ColumnVar* col_var,
+                                              const std::string& str,
+                                              const SQLTypeInfo& result_ti,
+                                              const CompilationOptions& co) {
+  AUTOMATIC_IR_METADATA(cgen_state_);
+  Datum str_datum;
+  str_datum.stringval = new std::string(str);
+  const auto str_literal = makeExpr<Analyzer::Constant>(kTEXT, false, str_datum);
+  const auto str_lvs = codegen(str_literal.get(), true, co);
+  CHECK_EQ(size_t(3), str_lvs.size());
+  std::vector<llvm::Value*> args{colByteStream(col_var, true, co.hoist_literals),
+                                 posArg(col_var),
+                                 str_lvs[1],
+                                 str_lvs[2]};
+  if (col_var->get_type_info().get_notnull()) {
+    return cgen_state_->emitExternalCall(
+        fn_base, get_int_type(1, cgen_state_->context_), args);
+  }
+  args.push_back(cgen_state_->inlineIntNull(result_ti));
+  return cgen_state_->emitExternalCall(
+      fn_base + "_nullable", get_int_type(8, cgen_state_->context_), args);
+}
+
 void pre_translate_string_ops(const Analyzer::StringOper* string_oper,
                               Executor* executor) {
   // If here we are operating on top of one or more string functions, i.e. LOWER(str),
@@ -818,6 +978,10 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::RegexpExpr* expr,
   if (fast_dict_pattern_lv) {
     return fast_dict_pattern_lv;
   }
+  auto fsst_like_lv = codegenFsstLike(expr, escape_char, co);
+  if (fsst_like_lv) {
+    return fsst_like_lv;
+  }
   const auto& ti = expr->get_arg()->get_type_info();
   CHECK(ti.is_string());
   if (g_enable_watchdog && ti.get_compression() != kENCODING_NONE) {
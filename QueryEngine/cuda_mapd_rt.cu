@@ -1211,6 +1211,40 @@ extern "C" __device__ uint64_t string_decode(int8_t* chunk_iter_, int64_t pos) {
                           (static_cast<uint64_t>(vd.length) << 48);
 }
 
+// Compare FSST encoded strings with a literal without decompressing them.
+#define FSST_STRING_CMP(fn_name, prefix, negate)                                         \
+  extern "C" __device__ bool fn_name(                                                 \
+      int8_t* chunk_iter_, int64_t pos, const char* str, const int32_t str_len) {      \
+    bool is_null;                                                                      \
+    return ChunkIter_string_matches(reinterpret_cast<ChunkIter*>(chunk_iter_),         \
+                                    pos,                                               \
+                                    str,                                               \
+                                    str_len,                                           \
+                                    prefix,                                            \
+                                    &is_null) != negate;                               \
+  }                                                                                    \
+  extern "C" __device__ int8_t fn_name##_nullable(int8_t* chunk_iter_,                \
+                                                   int64_t pos,                        \
+                                                   const char* str,                    \
+                                                   const int32_t str_len,              \
+                                                   const int8_t bool_null) {           \
+    bool is_null;                                                                      \
+    const auto matches =                                                               \
+        ChunkIter_string_matches(reinterpret_cast<ChunkIter*>(chunk_iter_),            \
+                                 pos,                                                  \
+                                 str,                                                  \
+                                 str_len,                                              \
+                                 prefix,                                               \
+                                 &is_null);                                            \
+    return is_null ? bool_null : (matches != negate) ? 1 : 0;                          \
+  }
+
+FSST_STRING_CMP(fsst_string_eq, false, false)
+FSST_STRING_CMP(fsst_string_ne, false, true)
+FSST_STRING_CMP(fsst_string_starts_with, true, false)
+
+#undef FSST_STRING_CMP
+
 extern "C" __device__ void linear_probabilistic_count(uint8_t* bitmap,
                                                       const uint32_t bitmap_bytes,
                                                       const uint8_t* key_bytes,
@@ -787,6 +787,14 @@ void print_memory_info(ClientContext& context, std::string memory_level) {
           << " MB" << std::endl;
       tss << "Memory allocated: " << (nodeIt.num_pages_allocated * nodeIt.page_size) / MB
           << " MB" << std::endl;
+      if (nodeIt.huge_page_bytes_allocated) {
+        tss << "Memory backed by huge pages: " << nodeIt.huge_page_bytes_allocated / MB
+            << " MB" << std::endl;
+      }
+      if (nodeIt.group_by_buffer_pool_bytes) {
+        tss << "Group by buffer pool: " << nodeIt.group_by_buffer_pool_bytes / MB << " MB"
+            << std::endl;
+      }
     } else {
       ++mgr_num;
     }
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    BitPacking.h
+ * @brief   Layout of bit packed (ENCODING FIXED(n), n not a whole integer width) chunk
+ *          buffers.
+ *
+ * Every row is stored as an n-bit two's complement integer, packed into 64-bit words
+ * starting with the low bits of the first word. The smallest n-bit integer stands for
+ * null. Blocks of 64 rows take exactly n words, so they can be unpacked independently.
+ * One extra word is kept past the last row so that decoding always reads two whole
+ * words. The bit width isn't stored, it is the parameter of the column type.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "funcannotations.h"
+
+namespace bit_packing {
+
+constexpr int64_t kWordBits{64};
+constexpr int64_t kBlockRows{64};
+
+DEVICE inline uint64_t mask(const int32_t bit_width) {
+  return ~uint64_t(0) >> (kWordBits - bit_width);
+}
+
+// The stored null, the smallest signed bit_width bits integer.
+DEVICE inline int64_t null_bits(const int32_t bit_width) {
+  return -(int64_t(1) << (bit_width - 1));
+}
+
+DEVICE inline int64_t num_words(const int64_t num_rows, const int32_t bit_width) {
+  return (num_rows * bit_width + kWordBits - 1) / kWordBits + 1;
+}
+
+// Straight line code, no branch on the position of the row within the words, so that
+// decoding consecutive rows vectorizes.
+DEVICE inline int64_t unpack(const int8_t* byte_stream,
+                             const int32_t bit_width,
+                             const int64_t pos) {
+  const auto words = reinterpret_cast<const uint64_t*>(byte_stream);
+  const uint64_t bit_pos = static_cast<uint64_t>(pos) * bit_width;
+  const auto word = bit_pos / kWordBits;
+  const auto shift = bit_pos % kWordBits;
+  const auto low = words[word] >> shift;
+  // The high bits of a row spanning two words, zero when shift is 0.
+  const auto high = (words[word + 1] << 1) << (kWordBits - 1 - shift);
+  // Moves the sign bit of the row to the top to sign extend it.
+  return static_cast<int64_t>((low | high) << (kWordBits - bit_width)) >>
+         (kWordBits - bit_width);
+}
+
+DEVICE inline int64_t decode(const int8_t* byte_stream,
+                             const int32_t bit_width,
+                             const int64_t pos,
+                             const int64_t null_val) {
+  const auto val = unpack(byte_stream, bit_width, pos);
+  return val == null_bits(bit_width) ? null_val : val;
+}
+
+}  // namespace bit_packing
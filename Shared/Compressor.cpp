@@ -200,6 +200,61 @@ bool BloscCompressor::decompressOrMemcpy(const uint8_t* compressed_buffer,
   return false;
 }
 
+size_t BloscCompressor::compressWithContext(const uint8_t* buffer,
+                                            const size_t buffer_size,
+                                            uint8_t* compressed_buffer,
+                                            const size_t compressed_buffer_size,
+                                            const std::string& compressor_name,
+                                            const size_t type_size) {
+  if (compressed_buffer_size < BLOSC_MIN_HEADER_LENGTH) {
+    return 0;
+  }
+  const size_t shuffle_type_size =
+      (type_size > 0 && type_size <= BLOSC_MAX_TYPESIZE) ? type_size : 1;
+  const auto compressed_len = blosc_compress_ctx(5,
+                                                 BLOSC_SHUFFLE,
+                                                 shuffle_type_size,
+                                                 buffer_size,
+                                                 buffer,
+                                                 compressed_buffer,
+                                                 compressed_buffer_size,
+                                                 compressor_name.c_str(),
+                                                 0,
+                                                 1);
+  if (compressed_len < 0) {
+    throw CompressionFailedError("failed to compress buffer of length " +
+                                 std::to_string(buffer_size) + " with " +
+                                 compressor_name);
+  }
+  return static_cast<size_t>(compressed_len);
+}
+
+size_t BloscCompressor::decompressWithContext(const uint8_t* compressed_buffer,
+                                              const size_t compressed_buffer_size,
+                                              uint8_t* decompressed_buffer,
+                                              const size_t decompressed_size) {
+  size_t decompressed_buf_len{0}, compressed_buf_len{0}, block_size{0};
+  if (compressed_buffer_size >= BLOSC_MIN_HEADER_LENGTH) {
+    getBloscBufferSizes(
+        compressed_buffer, &compressed_buf_len, &decompressed_buf_len, &block_size);
+  }
+  if (compressed_buf_len == 0 || compressed_buf_len > compressed_buffer_size ||
+      decompressed_buf_len != decompressed_size) {
+    throw CompressionFailedError(
+        "invalid compressed buffer header, compressed size: " +
+        std::to_string(compressed_buf_len) +
+        ", decompressed size: " + std::to_string(decompressed_buf_len));
+  }
+  const auto decompressed_len =
+      blosc_decompress_ctx(compressed_buffer, decompressed_buffer, decompressed_size, 1);
+  if (decompressed_len < 0 ||
+      static_cast<size_t>(decompressed_len) != decompressed_size) {
+    throw CompressionFailedError("failed to decompress buffer for compressed size: " +
+                                 std::to_string(compressed_buf_len));
+  }
+  return static_cast<size_t>(decompressed_len);
+}
+
 void BloscCompressor::getBloscBufferSizes(const uint8_t* data_ptr,
                                           size_t* num_bytes_compressed,
                                           size_t* num_bytes_uncompressed,
@@ -71,6 +71,23 @@ class BloscCompressor {
                           uint8_t* decompressed_buffer,
                           const size_t decompressed_size);
 
+  // Compresses with the named blosc compressor using a private context, so it neither
+  // takes compressor_lock nor changes the global compressor. type_size is the element
+  // width used for byte shuffling. Returns 0 if the result does not fit in
+  // compressed_buffer_size bytes.
+  size_t compressWithContext(const uint8_t* buffer,
+                             const size_t buffer_size,
+                             uint8_t* compressed_buffer,
+                             const size_t compressed_buffer_size,
+                             const std::string& compressor_name,
+                             const size_t type_size);
+
+  // Decompresses a buffer produced by compressWithContext using a private context.
+  size_t decompressWithContext(const uint8_t* compressed_buffer,
+                               const size_t compressed_buffer_size,
+                               uint8_t* decompressed_buffer,
+                               const size_t decompressed_size);
+
   void getBloscBufferSizes(const uint8_t* data_ptr,
                            size_t* num_bytes_compressed,
                            size_t* num_bytes_uncompressed,
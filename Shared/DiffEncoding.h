@@ -0,0 +1,78 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DiffEncoding.h
+ * @brief   Layout of differential (ENCODING DIFF) chunk buffers.
+ *
+ * A buffer starts with the base of the chunk, a lower bound of its values, and the bit
+ * width of the deltas, both as int64_t. The delta of every row from the base follows,
+ * bit packed into 64-bit words starting with the low bits of the first word. The all
+ * ones delta stands for null. One extra word is kept past the last delta so that decoding
+ * always reads two whole words.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "funcannotations.h"
+
+namespace diff_encoding {
+
+constexpr int64_t kHeaderBytes{2 * sizeof(int64_t)};
+constexpr int64_t kWordBits{64};
+
+DEVICE inline int64_t base(const int8_t* byte_stream) {
+  return reinterpret_cast<const int64_t*>(byte_stream)[0];
+}
+
+DEVICE inline int32_t bit_width(const int8_t* byte_stream) {
+  return static_cast<int32_t>(reinterpret_cast<const int64_t*>(byte_stream)[1]);
+}
+
+DEVICE inline uint64_t null_delta(const int32_t bit_width) {
+  return ~uint64_t(0) >> (kWordBits - bit_width);
+}
+
+DEVICE inline int64_t num_words(const int64_t num_rows, const int32_t bit_width) {
+  return (num_rows * bit_width + kWordBits - 1) / kWordBits + 1;
+}
+
+// Straight line code, no branch on the position of the delta within the words, so that
+// decoding consecutive rows vectorizes.
+DEVICE inline uint64_t delta(const int8_t* byte_stream, const int64_t pos) {
+  const auto words = reinterpret_cast<const uint64_t*>(byte_stream + kHeaderBytes);
+  const auto bits = bit_width(byte_stream);
+  const uint64_t bit_pos = static_cast<uint64_t>(pos) * bits;
+  const auto word = bit_pos / kWordBits;
+  const auto shift = bit_pos % kWordBits;
+  const auto low = words[word] >> shift;
+  // The high bits of a delta spanning two words, zero when shift is 0.
+  const auto high = (words[word + 1] << 1) << (kWordBits - 1 - shift);
+  return (low | high) & null_delta(bits);
+}
+
+DEVICE inline int64_t decode(const int8_t* byte_stream,
+                             const int64_t pos,
+                             const int64_t null_val) {
+  const auto d = delta(byte_stream, pos);
+  return d == null_delta(bit_width(byte_stream))
+             ? null_val
+             : static_cast<int64_t>(static_cast<uint64_t>(base(byte_stream)) + d);
+}
+
+}  // namespace diff_encoding
@@ -37,7 +37,13 @@
 
 #include <boost/filesystem.hpp>
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <climits>
+#endif
+
 bool g_read_only{false};
+bool g_enable_positional_file_io{false};
 
 namespace File_Namespace {
 
@@ -165,6 +171,77 @@ size_t write(FILE* f, const size_t offset, const size_t size, const int8_t* buf)
   return bytesWritten;
 }
 
+#ifndef _WIN32
+size_t pread(const int fd, const size_t offset, const size_t size, int8_t* buf) {
+  size_t bytes_read{0};
+  while (bytes_read < size) {
+    const auto ret =
+        ::pread(fd, buf + bytes_read, size - bytes_read, offset + bytes_read);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG(FATAL) << "Error trying to read from file (during pread) the error was: "
+                 << std::strerror(errno);
+    }
+    CHECK_GT(ret, 0) << "Unexpected end of file during pread at offset "
+                     << offset + bytes_read;
+    bytes_read += ret;
+  }
+  return bytes_read;
+}
+
+size_t preadv(const int fd, const size_t offset, struct iovec* iov, int iovcnt) {
+  size_t bytes_read{0};
+  while (iovcnt > 0) {
+    const auto ret = ::preadv(fd, iov, std::min(iovcnt, IOV_MAX), offset + bytes_read);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG(FATAL) << "Error trying to read from file (during preadv) the error was: "
+                 << std::strerror(errno);
+    }
+    CHECK_GT(ret, 0) << "Unexpected end of file during preadv at offset "
+                     << offset + bytes_read;
+    bytes_read += ret;
+    // Skip over fully read entries and advance into a partially read one.
+    size_t remaining = ret;
+    while (iovcnt > 0 && remaining >= iov->iov_len) {
+      remaining -= iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+    if (remaining > 0) {
+      iov->iov_base = static_cast<int8_t*>(iov->iov_base) + remaining;
+      iov->iov_len -= remaining;
+    }
+  }
+  return bytes_read;
+}
+
+size_t pwrite(const int fd, const size_t offset, const size_t size, const int8_t* buf) {
+  if (g_read_only) {
+    LOG(FATAL) << "Error trying to write file descriptor '" << fd
+               << "', running readonly";
+  }
+  size_t bytes_written{0};
+  while (bytes_written < size) {
+    const auto ret =
+        ::pwrite(fd, buf + bytes_written, size - bytes_written, offset + bytes_written);
+    if (ret == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOG(FATAL) << "Error trying to write to file (during pwrite) the error was: "
+                 << std::strerror(errno);
+    }
+    bytes_written += ret;
+  }
+  return bytes_written;
+}
+#endif
+
 size_t append(FILE* f, const size_t size, const int8_t* buf) {
   if (g_read_only) {
     LOG(FATAL) << "Error trying to append file '" << f << "', running readonly";
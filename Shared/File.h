@@ -29,6 +29,10 @@
 #include <iostream>
 #include <string>
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #include "Shared/types.h"
 
 namespace File_Namespace {
@@ -98,6 +102,48 @@ size_t read(FILE* f, const size_t offset, const size_t size, int8_t* buf);
  */
 size_t write(FILE* f, const size_t offset, const size_t size, const int8_t* buf);
 
+#ifndef _WIN32
+/**
+ * @brief Reads the specified number of bytes from the offset position in the file
+ * referenced by fd into buf, without moving the file offset (pread).
+ *
+ * Unlike read(FILE*, ...), this does not share any stream state and can be called
+ * concurrently from multiple threads on the same file descriptor.
+ *
+ * @param fd The file descriptor.
+ * @param offset The location within the file from which to read.
+ * @param size The number of bytes to be read.
+ * @param buf The destination buffer to where data is being read from the file.
+ * @return size_t The number of bytes read.
+ */
+size_t pread(const int fd, const size_t offset, const size_t size, int8_t* buf);
+
+/**
+ * @brief Scatter reads consecutive bytes starting at the offset position in the file
+ * referenced by fd into the given iovec entries, without moving the file offset
+ * (preadv). Short reads are retried until every entry has been filled.
+ *
+ * @param fd The file descriptor.
+ * @param offset The location within the file from which to read.
+ * @param iov The destination buffers, filled in order.
+ * @param iovcnt The number of entries in iov.
+ * @return size_t The total number of bytes read.
+ */
+size_t preadv(const int fd, const size_t offset, struct iovec* iov, int iovcnt);
+
+/**
+ * @brief Writes the specified number of bytes to the offset position in the file
+ * referenced by fd from buf, without moving the file offset (pwrite).
+ *
+ * @param fd The file descriptor.
+ * @param offset The location within the file where data is being written.
+ * @param size The number of bytes to write to the file.
+ * @param buf The source buffer containing the data to be written.
+ * @return size_t The number of bytes written.
+ */
+size_t pwrite(const int fd, const size_t offset, const size_t size, const int8_t* buf);
+#endif
+
 /**
  * @brief Appends the specified number of bytes to the end of the file f from buf.
  *
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    FsstEncoding.h
+ * @brief   Layout of FSST compressed (TEXT ENCODING FSST) chunk buffers.
+ *
+ * The chunks keep the index buffer of none encoded strings, but the data buffer starts
+ * with a symbol table of up to 255 symbols of 1 to 8 bytes, built from the first strings
+ * appended to the chunk. Every string is stored as a sequence of one byte codes, each
+ * standing for the symbol with that index, or for the byte following it when it is the
+ * escape code. The table holds the number of symbols as an int64_t, the symbols as
+ * 64-bit words holding their bytes from the low end, then their lengths, one byte each.
+ * The offsets of the index buffer start right after the table.
+ *
+ * Strings are compressed greedily with the longest matching symbol, so two strings are
+ * equal if and only if their codes are, and a string can be compared with an
+ * uncompressed one a symbol at a time, without being decompressed.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "funcannotations.h"
+
+#ifndef __CUDACC__
+#include <string>
+#endif
+
+namespace fsst_encoding {
+
+constexpr int32_t kMaxSymbols{255};
+constexpr int32_t kMaxSymbolLength{8};
+constexpr uint8_t kEscapeCode{255};
+constexpr int64_t kSymbolsOffset{sizeof(int64_t)};
+constexpr int64_t kLengthsOffset{kSymbolsOffset + kMaxSymbols * sizeof(uint64_t)};
+// The lengths are padded to 8 bytes.
+constexpr int64_t kTableBytes{kLengthsOffset + kMaxSymbols + 1};
+
+DEVICE inline int64_t num_symbols(const int8_t* table) {
+  return reinterpret_cast<const int64_t*>(table)[0];
+}
+
+DEVICE inline uint64_t symbol(const int8_t* table, const uint8_t code) {
+  return reinterpret_cast<const uint64_t*>(table + kSymbolsOffset)[code];
+}
+
+DEVICE inline int32_t symbol_length(const int8_t* table, const uint8_t code) {
+  return reinterpret_cast<const uint8_t*>(table + kLengthsOffset)[code];
+}
+
+DEVICE inline int32_t decompressed_length(const int8_t* table,
+                                          const int8_t* codes,
+                                          const int32_t num_codes) {
+  int32_t length = 0;
+  for (int32_t i = 0; i < num_codes; ++i) {
+    const auto code = static_cast<uint8_t>(codes[i]);
+    if (code == kEscapeCode) {
+      ++i;
+      ++length;
+    } else {
+      length += symbol_length(table, code);
+    }
+  }
+  return length;
+}
+
+// Writes the string held by the codes to dst, which must have room for
+// decompressed_length() bytes. Returns that length.
+DEVICE inline int32_t decompress(const int8_t* table,
+                                 const int8_t* codes,
+                                 const int32_t num_codes,
+                                 int8_t* dst) {
+  int32_t length = 0;
+  for (int32_t i = 0; i < num_codes; ++i) {
+    const auto code = static_cast<uint8_t>(codes[i]);
+    if (code == kEscapeCode) {
+      dst[length++] = codes[++i];
+      continue;
+    }
+    auto bytes = symbol(table, code);
+    for (int32_t j = symbol_length(table, code); j > 0; --j, bytes >>= 8) {
+      dst[length++] = static_cast<int8_t>(bytes & 0xff);
+    }
+  }
+  return length;
+}
+
+// Compares the string held by the codes with str one symbol at a time. Only the first
+// str_len bytes of the string are compared when prefix is set.
+DEVICE inline bool matches(const int8_t* table,
+                           const int8_t* codes,
+                           const int32_t num_codes,
+                           const char* str,
+                           const int32_t str_len,
+                           const bool prefix) {
+  int32_t pos = 0;
+  for (int32_t i = 0; i < num_codes; ++i) {
+    if (prefix && pos == str_len) {
+      return true;
+    }
+    const auto code = static_cast<uint8_t>(codes[i]);
+    if (code == kEscapeCode) {
+      if (pos == str_len || codes[++i] != str[pos]) {
+        return false;
+      }
+      ++pos;
+      continue;
+    }
+    auto length = symbol_length(table, code);
+    if (pos + length > str_len) {
+      if (!prefix) {
+        return false;
+      }
+      length = str_len - pos;
+    }
+    auto bytes = symbol(table, code);
+    for (int32_t j = 0; j < length; ++j, bytes >>= 8) {
+      if (static_cast<char>(bytes & 0xff) != str[pos + j]) {
+        return false;
+      }
+    }
+    pos += length;
+  }
+  return pos == str_len;
+}
+
+#ifndef __CUDACC__
+inline std::string decompress(const int8_t* table,
+                              const int8_t* codes,
+                              const int32_t num_codes) {
+  std::string str(decompressed_length(table, codes, num_codes), '\0');
+  decompress(table, codes, num_codes, reinterpret_cast<int8_t*>(str.data()));
+  return str;
+}
+#endif
+
+}  // namespace fsst_encoding
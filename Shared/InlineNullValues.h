@@ -154,6 +154,13 @@ inline int64_t inline_fixed_encoding_null_val(const SQL_TYPE_INFO& ti) {
   if (ti.get_compression() == kENCODING_NONE) {
     return inline_int_null_val(ti);
   }
+  if (ti.is_block_encoded() && !ti.is_string()) {
+    // Decoding yields values of the logical type, nulls included. Run length encoded
+    // strings decode to 32 bit dictionary ids, handled with the other ones below.
+    auto logical_ti = ti;
+    logical_ti.set_compression(kENCODING_NONE);
+    return inline_int_null_val(logical_ti);
+  }
   if (ti.get_compression() == kENCODING_DATE_IN_DAYS) {
     switch (ti.get_comp_param()) {
       case 0:
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RunLengthEncoding.h
+ * @brief   Layout of run length encoded (ENCODING RL) chunk buffers.
+ *
+ * A buffer starts with the number of runs as an int64_t, followed by one {end, value}
+ * entry per run. The end of a run is the position of the row following it, so ends are
+ * increasing and the last one is the number of rows in the chunk. Both fields of an
+ * entry are int32_t for values up to four bytes wide and int64_t otherwise. Values are
+ * those of the logical type, nulls included, so decoding needs no null translation.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "funcannotations.h"
+
+namespace run_length_encoding {
+
+constexpr int64_t kHeaderBytes{sizeof(int64_t)};
+
+DEVICE inline int64_t entry_bytes(const int32_t value_width) {
+  return value_width > 4 ? 2 * sizeof(int64_t) : 2 * sizeof(int32_t);
+}
+
+DEVICE inline int64_t num_runs(const int8_t* byte_stream) {
+  return *reinterpret_cast<const int64_t*>(byte_stream);
+}
+
+DEVICE inline int64_t run_end(const int8_t* byte_stream,
+                              const int32_t value_width,
+                              const int64_t run) {
+  const auto entry = byte_stream + kHeaderBytes + run * entry_bytes(value_width);
+  return value_width > 4 ? reinterpret_cast<const int64_t*>(entry)[0]
+                         : reinterpret_cast<const int32_t*>(entry)[0];
+}
+
+DEVICE inline int64_t run_value(const int8_t* byte_stream,
+                                const int32_t value_width,
+                                const int64_t run) {
+  const auto entry = byte_stream + kHeaderBytes + run * entry_bytes(value_width);
+  return value_width > 4 ? reinterpret_cast<const int64_t*>(entry)[1]
+                         : reinterpret_cast<const int32_t*>(entry)[1];
+}
+
+// Binary search for the run holding the row at pos.
+DEVICE inline int64_t find_run(const int8_t* byte_stream,
+                               const int32_t value_width,
+                               const int64_t pos) {
+  int64_t lo = 0;
+  int64_t hi = num_runs(byte_stream) - 1;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (run_end(byte_stream, value_width, mid) <= pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+DEVICE inline int64_t decode(const int8_t* byte_stream,
+                             const int32_t value_width,
+                             const int64_t pos) {
+  return run_value(byte_stream, value_width, find_run(byte_stream, value_width, pos));
+}
+
+// Run holding the row at pos, starting from the run a previous lookup returned. Rows read
+// in order stay in that run or move to the next one, other rows fall back to a binary
+// search, so the cursor only needs to be a hint and can be shared across chunks.
+DEVICE inline int64_t find_run_from(const int8_t* byte_stream,
+                                    const int32_t value_width,
+                                    const int64_t pos,
+                                    const int64_t cursor) {
+  const auto runs = num_runs(byte_stream);
+  if (cursor < 0 || cursor >= runs ||
+      (cursor > 0 && run_end(byte_stream, value_width, cursor - 1) > pos)) {
+    return find_run(byte_stream, value_width, pos);
+  }
+  if (run_end(byte_stream, value_width, cursor) > pos) {
+    return cursor;
+  }
+  if (cursor + 1 < runs && run_end(byte_stream, value_width, cursor + 1) > pos) {
+    return cursor + 1;
+  }
+  return find_run(byte_stream, value_width, pos);
+}
+
+// Decodes the row at pos and moves the cursor to its run.
+DEVICE inline int64_t decode_from(const int8_t* byte_stream,
+                                  const int32_t value_width,
+                                  const int64_t pos,
+                                  int64_t* cursor) {
+  *cursor = find_run_from(byte_stream, value_width, pos, *cursor);
+  return run_value(byte_stream, value_width, *cursor);
+}
+
+}  // namespace run_length_encoding
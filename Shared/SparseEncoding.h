@@ -0,0 +1,125 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    SparseEncoding.h
+ * @brief   Layout of sparse (ENCODING SPARSE) chunk buffers.
+ *
+ * A buffer starts with the number of rows and the number of non null values as int64_t,
+ * followed by one {position, value} entry per non null row in increasing position order.
+ * Both fields of an entry are 32 bits wide for values up to four bytes wide and 64 bits
+ * otherwise; narrower values sit at the start of their field. Null rows take no space,
+ * and appending rows only appends entries and rewrites the header. Rows read in order
+ * are found from a cursor on the entry of the previous one, other rows with a binary
+ * search over the positions.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "funcannotations.h"
+
+namespace sparse_encoding {
+
+constexpr int64_t kHeaderBytes{2 * sizeof(int64_t)};
+
+DEVICE inline int64_t num_rows(const int8_t* byte_stream) {
+  return reinterpret_cast<const int64_t*>(byte_stream)[0];
+}
+
+DEVICE inline int64_t num_values(const int8_t* byte_stream) {
+  return reinterpret_cast<const int64_t*>(byte_stream)[1];
+}
+
+DEVICE inline int64_t entry_bytes(const int32_t value_width) {
+  return value_width > 4 ? 2 * sizeof(int64_t) : 2 * sizeof(int32_t);
+}
+
+DEVICE inline int64_t byte_size(const int64_t num_values, const int32_t value_width) {
+  return kHeaderBytes + num_values * entry_bytes(value_width);
+}
+
+DEVICE inline int64_t position(const int8_t* byte_stream,
+                               const int32_t value_width,
+                               const int64_t idx) {
+  const auto entry = byte_stream + kHeaderBytes + idx * entry_bytes(value_width);
+  return value_width > 4 ? reinterpret_cast<const int64_t*>(entry)[0]
+                         : reinterpret_cast<const int32_t*>(entry)[0];
+}
+
+DEVICE inline const int8_t* value_ptr(const int8_t* byte_stream,
+                                      const int32_t value_width,
+                                      const int64_t idx) {
+  return byte_stream + kHeaderBytes + idx * entry_bytes(value_width) +
+         entry_bytes(value_width) / 2;
+}
+
+// Index of the first entry at or after pos.
+DEVICE inline int64_t find_entry(const int8_t* byte_stream,
+                                 const int32_t value_width,
+                                 const int64_t pos) {
+  int64_t lo = 0;
+  int64_t hi = num_values(byte_stream);
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (position(byte_stream, value_width, mid) < pos) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Same as find_entry, starting from the entry a previous lookup returned. Rows read in
+// order find it there or right after it, so a cursor left on another chunk or row only
+// costs the binary search.
+DEVICE inline int64_t find_entry_from(const int8_t* byte_stream,
+                                      const int32_t value_width,
+                                      const int64_t pos,
+                                      const int64_t cursor) {
+  const auto values = num_values(byte_stream);
+  if (cursor < 0 || cursor > values ||
+      (cursor > 0 && position(byte_stream, value_width, cursor - 1) >= pos)) {
+    return find_entry(byte_stream, value_width, pos);
+  }
+  if (cursor == values || position(byte_stream, value_width, cursor) >= pos) {
+    return cursor;
+  }
+  if (cursor + 1 == values || position(byte_stream, value_width, cursor + 1) >= pos) {
+    return cursor + 1;
+  }
+  return find_entry(byte_stream, value_width, pos);
+}
+
+// Index of the value of the row at pos among the entries, -1 if the row is null. Moves
+// the cursor, if given, to the entry the lookup ended on.
+DEVICE inline int64_t value_index(const int8_t* byte_stream,
+                                  const int32_t value_width,
+                                  const int64_t pos,
+                                  int64_t* cursor = nullptr) {
+  const auto idx = cursor ? find_entry_from(byte_stream, value_width, pos, *cursor)
+                          : find_entry(byte_stream, value_width, pos);
+  if (cursor) {
+    *cursor = idx;
+  }
+  return idx < num_values(byte_stream) && position(byte_stream, value_width, idx) == pos
+             ? idx
+             : -1;
+}
+
+}  // namespace sparse_encoding
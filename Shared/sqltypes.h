@@ -310,6 +310,10 @@ inline std::string toString(const EncodingType& type) {
 #define TRANSIENT_DICT_ID 0
 #define TRANSIENT_DICT(ID) (-(ID))
 #define REGULAR_DICT(TRANSIENTID) (-(TRANSIENTID))
+// comp_param of TEXT ENCODING FSST columns, none encoded strings stored compressed.
+#define FSST_COMP_PARAM 1
+// scale of TEXT ENCODING RL columns, dictionary encoded strings stored as runs of ids.
+#define RL_DICT_SCALE 1
 
 constexpr auto is_datetime(SQLTypes type) {
   return type == kTIME || type == kTIMESTAMP || type == kDATE;
@@ -971,6 +975,36 @@ class SQLTypeInfo {
     return SQLTypeInfo(kARRAY, dimension, scale, notnull, compression, comp_param, type);
   }
 
+  // FIXED(n) integers whose n isn't the width of an integer type are bit packed.
+  HOST DEVICE inline bool is_bit_packed() const {
+    return compression == kENCODING_FIXED && type != kARRAY && comp_param > 0 &&
+           comp_param != 8 && comp_param != 16 && comp_param != 32 && comp_param != 64;
+  }
+
+  // Dictionary ids of RL encoded strings are stored as runs, the column keeps the
+  // dictionary encoding so that its strings resolve like those of any other one.
+  HOST DEVICE inline bool is_run_length_dict_string() const {
+    return IS_STRING(type) && compression == kENCODING_DICT && scale == RL_DICT_SCALE;
+  }
+
+  HOST DEVICE inline bool is_run_length_encoded() const {
+    return compression == kENCODING_RL || is_run_length_dict_string();
+  }
+
+  // Run length, differential, sparse and bit packed chunks don't keep row i at
+  // i * get_size(), the value of a row is decoded from the chunk as a whole.
+  inline bool is_block_encoded() const {
+    return is_run_length_encoded() || compression == kENCODING_DIFF ||
+           compression == kENCODING_SPARSE || is_bit_packed();
+  }
+
+  // Strings of FSST chunks are stored as codes of a per chunk symbol table, see
+  // Shared/FsstEncoding.h.
+  HOST DEVICE inline bool is_fsst_string() const {
+    return IS_STRING(type) && compression == kENCODING_NONE &&
+           comp_param == FSST_COMP_PARAM;
+  }
+
   inline bool is_date_in_days() const {
     if (type == kDATE) {
       const auto comp_type = get_compression();
@@ -1022,11 +1056,11 @@ class SQLTypeInfo {
       case kSMALLINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_SPARSE:
             return sizeof(int16_t);
           case kENCODING_FIXED:
-          case kENCODING_SPARSE:
-            return comp_param / 8;
-          case kENCODING_RL:
+            return is_bit_packed() ? sizeof(int16_t) : comp_param / 8;
           case kENCODING_DIFF:
             break;
           default:
@@ -1036,12 +1070,13 @@ class SQLTypeInfo {
       case kINT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_SPARSE:
             return sizeof(int32_t);
           case kENCODING_FIXED:
-          case kENCODING_SPARSE:
+            return is_bit_packed() ? sizeof(int32_t) : comp_param / 8;
           case kENCODING_GEOINT:
             return comp_param / 8;
-          case kENCODING_RL:
           case kENCODING_DIFF:
             break;
           default:
@@ -1053,13 +1088,12 @@ class SQLTypeInfo {
       case kDECIMAL:
         switch (compression) {
           case kENCODING_NONE:
-            return sizeof(int64_t);
-          case kENCODING_FIXED:
-          case kENCODING_SPARSE:
-            return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+          case kENCODING_SPARSE:
+            return sizeof(int64_t);
+          case kENCODING_FIXED:
+            return is_bit_packed() ? sizeof(int64_t) : comp_param / 8;
           default:
             assert(false);
         }
@@ -1067,11 +1101,11 @@ class SQLTypeInfo {
       case kFLOAT:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_SPARSE:
             return sizeof(float);
           case kENCODING_FIXED:
           case kENCODING_RL:
           case kENCODING_DIFF:
-          case kENCODING_SPARSE:
             assert(false);
             break;
           default:
@@ -1081,11 +1115,11 @@ class SQLTypeInfo {
       case kDOUBLE:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_SPARSE:
             return sizeof(double);
           case kENCODING_FIXED:
           case kENCODING_RL:
           case kENCODING_DIFF:
-          case kENCODING_SPARSE:
             assert(false);
             break;
           default:
@@ -1099,17 +1133,15 @@ class SQLTypeInfo {
       case kDATE:
         switch (compression) {
           case kENCODING_NONE:
+          case kENCODING_RL:
+          case kENCODING_DIFF:
+          case kENCODING_SPARSE:
             return sizeof(int64_t);
           case kENCODING_FIXED:
             if (type == kTIMESTAMP && dimension > 0) {
               assert(false);  // disable compression for timestamp precisions
             }
             return comp_param / 8;
-          case kENCODING_RL:
-          case kENCODING_DIFF:
-          case kENCODING_SPARSE:
-            assert(false);
-            break;
           case kENCODING_DATE_IN_DAYS:
             switch (comp_param) {
               case 0:
@@ -1201,13 +1233,14 @@ inline SQLTypes get_int_type_by_size(size_t const nbytes) {
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_DATE_IN_DAYS ||
+  if (encoding == kENCODING_DATE_IN_DAYS || encoding == kENCODING_RL ||
+      encoding == kENCODING_DIFF || encoding == kENCODING_SPARSE ||
       (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
   return SQLTypeInfo(type_info.get_type(),
                      type_info.get_dimension(),
-                     type_info.get_scale(),
+                     type_info.is_run_length_dict_string() ? 0 : type_info.get_scale(),
                      type_info.get_notnull(),
                      encoding,
                      type_info.get_comp_param(),
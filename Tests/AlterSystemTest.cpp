@@ -316,6 +316,25 @@ TEST_F(AlterSystemTest, SET_CURRENT_DATABASE_PERMISSION) {
       "user2 is not allowed to access database db2.)");
 }
 
+TEST_F(AlterSystemTest, SET_CPU_KERNEL_WEIGHT) {
+  login("user1", "HyperInteractive", "db1");
+  sql("ALTER SESSION SET CPU_KERNEL_WEIGHT=4");
+  sql("ALTER SESSION SET CPU_KERNEL_WEIGHT=1");
+  sql("ALTER SESSION SET CPU_KERNEL_WEIGHT=+1000");
+  queryAndAssertPartialException(
+      "ALTER SESSION SET CPU_KERNEL_WEIGHT=0",
+      "The value of session parameter CPU_KERNEL_WEIGHT should be between 1 and 1000.");
+  queryAndAssertPartialException(
+      "ALTER SESSION SET CPU_KERNEL_WEIGHT=-2",
+      "The value of session parameter CPU_KERNEL_WEIGHT should be between 1 and 1000.");
+  queryAndAssertPartialException(
+      "ALTER SESSION SET CPU_KERNEL_WEIGHT=99999999999999999999",
+      "The value of session parameter CPU_KERNEL_WEIGHT should be between 1 and 1000.");
+  queryAndAssertPartialException(
+      "ALTER SESSION SET CPU_KERNEL_WEIGHT='high'",
+      "The value of session parameter CPU_KERNEL_WEIGHT should be a numeric.");
+}
+
 int main(int argc, char** argv) {
   g_enable_fsi = true;
   TestHelpers::init_logger_stderr_only(argc, argv);
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/CpuKernelService.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_TBB
+#include <tbb/parallel_for.h>
+
+namespace {
+
+// Runs num_kernels kernels of the session on the shared arena, counting the runs of each.
+void run_counted_kernels(const std::string& session,
+                         const size_t num_kernels,
+                         std::vector<std::atomic<int>>& runs) {
+  cpu_kernel_service::run_kernels(session, num_kernels, [&runs](const size_t kernel_idx) {
+    // Kernels wait for nested parallel work, which must not start other kernels.
+    std::atomic<int> nested_sum{0};
+    tbb::parallel_for(0, 64, [&nested_sum](const int i) { nested_sum += i; });
+    EXPECT_EQ(nested_sum, 64 * 63 / 2);
+    ++runs[kernel_idx];
+  });
+}
+
+}  // namespace
+
+TEST(CpuKernelServiceTest, RunsEveryKernelOnce) {
+  constexpr size_t num_kernels = 100;
+  std::vector<std::atomic<int>> runs(num_kernels);
+  for (auto& run : runs) {
+    run = 0;
+  }
+  run_counted_kernels("session", num_kernels, runs);
+  for (size_t i = 0; i < num_kernels; ++i) {
+    EXPECT_EQ(runs[i], 1) << "kernel " << i;
+  }
+}
+
+TEST(CpuKernelServiceTest, RunsConcurrentQueries) {
+  constexpr size_t num_queries = 8;
+  constexpr size_t num_kernels = 50;
+  std::vector<std::vector<std::atomic<int>>> runs;
+  for (size_t query = 0; query < num_queries; ++query) {
+    runs.emplace_back(num_kernels);
+    for (auto& run : runs.back()) {
+      run = 0;
+    }
+  }
+  cpu_kernel_service::set_session_weight("session_1", 4);
+  std::vector<std::thread> queries;
+  for (size_t query = 0; query < num_queries; ++query) {
+    queries.emplace_back([query, &runs] {
+      run_counted_kernels(
+          "session_" + std::to_string(query % 2), num_kernels, runs[query]);
+    });
+  }
+  for (auto& query : queries) {
+    query.join();
+  }
+  cpu_kernel_service::remove_session("session_1");
+  for (size_t query = 0; query < num_queries; ++query) {
+    for (size_t i = 0; i < num_kernels; ++i) {
+      EXPECT_EQ(runs[query][i], 1) << "query " << query << ", kernel " << i;
+    }
+  }
+}
+
+TEST(CpuKernelServiceTest, RethrowsKernelException) {
+  EXPECT_THROW(cpu_kernel_service::run_kernels("session",
+                                               16,
+                                               [](const size_t kernel_idx) {
+                                                 if (kernel_idx == 7) {
+                                                   throw std::runtime_error(
+                                                       "kernel failed");
+                                                 }
+                                               }),
+               std::runtime_error);
+  // The failed query leaves nothing queued behind.
+  std::vector<std::atomic<int>> runs(16);
+  for (auto& run : runs) {
+    run = 0;
+  }
+  run_counted_kernels("session", runs.size(), runs);
+  for (size_t i = 0; i < runs.size(); ++i) {
+    EXPECT_EQ(runs[i], 1) << "kernel " << i;
+  }
+}
+
+TEST(CpuKernelServiceTest, SharesThreadsByWeight) {
+  cpu_kernel_service::set_session_weight("heavy", 3);
+  constexpr size_t num_kernels = 60;
+  std::mutex started_mutex;
+  std::vector<std::string> started;
+  const auto run_session = [&started_mutex, &started](const std::string& session) {
+    cpu_kernel_service::run_kernels(
+        session, num_kernels, [&started_mutex, &started, &session](const size_t) {
+          {
+            std::lock_guard<std::mutex> lock(started_mutex);
+            started.push_back(session);
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        });
+  };
+  std::thread heavy(run_session, "heavy");
+  std::thread light(run_session, "light");
+  heavy.join();
+  light.join();
+  cpu_kernel_service::remove_session("heavy");
+
+  ASSERT_EQ(started.size(), 2 * num_kernels);
+  // Either session may start kernels alone before the other one queues its own or once
+  // it has none left. In between, the heavy session gets three of every four kernels,
+  // give or take the threads racing to record their start.
+  const auto both_begin = std::max(
+      std::find(started.begin(), started.end(), "heavy") - started.begin(),
+      std::find(started.begin(), started.end(), "light") - started.begin());
+  const auto both_end =
+      std::min(std::find(started.rbegin(), started.rend(), "heavy").base(),
+               std::find(started.rbegin(), started.rend(), "light").base()) -
+      started.begin();
+  size_t num_heavy{0};
+  size_t num_light{0};
+  for (auto i = both_begin; i < both_end; ++i) {
+    ++(started[i] == "heavy" ? num_heavy : num_light);
+  }
+  ASSERT_GE(num_light, size_t(10));
+  EXPECT_GE(num_heavy, 2 * num_light);
+  EXPECT_LE(num_heavy, 4 * num_light);
+}
+#endif  // HAVE_TBB
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -23,10 +23,13 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <numeric>
+#include <thread>
 
 #include "Catalog/ColumnDescriptor.h"
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBufferMgr.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/TieredCpuBufferMgr.h"
 #include "DataMgr/Chunk/Chunk.h"
 #include "DataMgr/DataMgr.h"
@@ -65,13 +68,16 @@ class DataMgrTest : public testing::Test {
   // Writes some data to disk through the FileMgr and then reads it into a CPU buffer via
   // the Chunk interface.  The Chunk interface is used because it will keep the cpu buffer
   // pinned for the lifetime of the Chunk during which time it is not-evictable.
-  std::shared_ptr<Chunk_NS::Chunk> writeChunkForKey(const ChunkKey& key) {
+  std::shared_ptr<Chunk_NS::Chunk> writeChunkForKey(const ChunkKey& key,
+                                                    const size_t num_bytes = 4) {
     auto disk_buf = data_mgr_->createChunkBuffer(key, MemoryLevel::DISK_LEVEL);
-    disk_buf->append(std::vector<int8_t>{1, 2, 3, 4}.data(), 4U);
+    std::vector<int8_t> data(num_bytes);
+    std::iota(data.begin(), data.end(), 1);
+    disk_buf->append(data.data(), num_bytes);
     auto cd =
         std::make_unique<ColumnDescriptor>(key[1], key[2], "temp", SQLTypeInfo{kTINYINT});
     return Chunk_NS::Chunk::getChunk(
-        cd.get(), data_mgr_.get(), key, MemoryLevel::CPU_LEVEL, 0, 4, 4);
+        cd.get(), data_mgr_.get(), key, MemoryLevel::CPU_LEVEL, 0, num_bytes, num_bytes);
   }
 
  protected:
@@ -96,6 +102,262 @@ TEST_F(DataMgrTest, ReuseWithPinnedGaps) {
   writeChunkForKey({1, 1, 1, 3});                // unpinned
 }
 
+TEST_F(DataMgrTest, ConcurrentCachedChunkFetches) {
+  constexpr int32_t num_chunks{16};
+  resetDataMgr(num_chunks);
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  std::vector<std::thread> threads;
+  for (int32_t thread_idx = 0; thread_idx < 8; ++thread_idx) {
+    threads.emplace_back([this, thread_idx] {
+      for (int32_t i = 0; i < 1000; ++i) {
+        ChunkKey key{1, 1, 1, (thread_idx + i) % num_chunks};
+        auto buffer = data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4);
+        EXPECT_EQ(buffer->getMemoryPtr()[3], 4);
+        buffer->unPin();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+  EXPECT_EQ(cpu_buffer_mgr->getNumChunks(), static_cast<size_t>(num_chunks));
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    EXPECT_EQ(cpu_buffer_mgr->getBuffer({1, 1, 1, i})->unPin(), 0);
+  }
+}
+
+TEST_F(DataMgrTest, GetChunksBatch) {
+  constexpr int32_t num_chunks{4};
+  resetDataMgr(num_chunks);
+  auto cd = std::make_unique<ColumnDescriptor>(1, 1, "temp", SQLTypeInfo{kTINYINT});
+  std::vector<Chunk_NS::ChunkRequest> requests;
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    ChunkKey key{1, 1, 1, i};
+    auto disk_buf = data_mgr_->createChunkBuffer(key, MemoryLevel::DISK_LEVEL);
+    std::vector<int8_t> data(4, static_cast<int8_t>(i + 1));
+    disk_buf->append(data.data(), data.size());
+    requests.push_back({cd.get(), key, 4, 4});
+  }
+  // One of the chunks is already in the buffer pool, the others are fetched together.
+  auto cached_chunk = Chunk_NS::Chunk::getChunk(cd.get(),
+                                                data_mgr_.get(),
+                                                requests[1].chunk_key,
+                                                MemoryLevel::CPU_LEVEL,
+                                                0,
+                                                4,
+                                                4);
+  {
+    auto chunks = Chunk_NS::Chunk::getChunks(
+        requests, data_mgr_.get(), MemoryLevel::CPU_LEVEL, 0);
+    ASSERT_EQ(chunks.size(), requests.size());
+    for (int32_t i = 0; i < num_chunks; ++i) {
+      auto buffer = chunks[i]->getBuffer();
+      ASSERT_EQ(buffer->size(), size_t(4));
+      EXPECT_EQ(buffer->getMemoryPtr()[3], i + 1);
+    }
+  }
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+  EXPECT_EQ(cpu_buffer_mgr->getNumChunks(), static_cast<size_t>(num_chunks));
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    // Only the chunk held outside of the batch stays pinned.
+    EXPECT_EQ(cpu_buffer_mgr->getBuffer({1, 1, 1, i})->unPin(), i == 1 ? 1 : 0);
+  }
+}
+
+TEST_F(DataMgrTest, ConcurrentCreateGetDeleteWithEviction) {
+  // The pool holds a quarter of the chunks, so reads and creates keep evicting each
+  // other's chunks.
+  constexpr int32_t num_chunks{32};
+  constexpr int32_t num_threads{8};
+  resetDataMgr(num_chunks / 4);
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+  std::vector<std::thread> threads;
+  for (int32_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    threads.emplace_back([this, cpu_buffer_mgr, thread_idx] {
+      for (int32_t i = 0; i < 500; ++i) {
+        if (thread_idx % 2 == 0) {
+          // Readers share all chunks and fetch evicted ones back from disk.
+          ChunkKey key{1, 1, 1, (thread_idx + i) % num_chunks};
+          auto buffer = data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4);
+          EXPECT_EQ(buffer->getMemoryPtr()[3], 4);
+          buffer->unPin();
+        } else {
+          // Writers create and delete chunks of their own, which spread over all chunk
+          // index shards.
+          ChunkKey key{1, 2, thread_idx, i};
+          auto buffer = cpu_buffer_mgr->createBuffer(key, 0, 4);
+          EXPECT_EQ(cpu_buffer_mgr->getBuffer(key), buffer);
+          EXPECT_EQ(buffer->unPin(), 1);
+          EXPECT_EQ(buffer->unPin(), 0);
+          cpu_buffer_mgr->deleteBuffer(key);
+          EXPECT_FALSE(cpu_buffer_mgr->isBufferOnDevice(key));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(cpu_buffer_mgr->getNumChunks(), static_cast<size_t>(num_chunks / 4));
+  for (int32_t i = 0; i < num_chunks; ++i) {
+    if (cpu_buffer_mgr->isBufferOnDevice({1, 1, 1, i})) {
+      EXPECT_EQ(cpu_buffer_mgr->getBuffer({1, 1, 1, i})->unPin(), 0);
+    }
+  }
+}
+
+TEST_F(DataMgrTest, ReleaseSlabs) {
+  resetDataMgr(3);
+  auto chunk1 = writeChunkForKey({1, 1, 1, 1});  // pinned
+  writeChunkForKey({1, 1, 1, 2});                // unpinned
+  writeChunkForKey({1, 1, 1, 3});                // unpinned
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+
+  // The floor keeps all but one slab, the least recently used one is released.
+  EXPECT_EQ(cpu_buffer_mgr->releaseSlabs(3 * slab_size_, 2 * slab_size_), slab_size_);
+  EXPECT_FALSE(data_mgr_->isBufferOnDevice({1, 1, 1, 2}, MemoryLevel::CPU_LEVEL, 0));
+  EXPECT_TRUE(data_mgr_->isBufferOnDevice({1, 1, 1, 3}, MemoryLevel::CPU_LEVEL, 0));
+
+  // The slab of the pinned chunk is kept.
+  EXPECT_EQ(cpu_buffer_mgr->releaseSlabs(3 * slab_size_, 0), slab_size_);
+  EXPECT_TRUE(data_mgr_->isBufferOnDevice({1, 1, 1, 1}, MemoryLevel::CPU_LEVEL, 0));
+  EXPECT_EQ(cpu_buffer_mgr->getAllocated(), slab_size_);
+
+  // Released slabs are reused before new slabs are added.
+  writeChunkForKey({1, 1, 1, 4});
+  writeChunkForKey({1, 1, 1, 5});
+  EXPECT_EQ(cpu_buffer_mgr->getAllocated(), 3 * slab_size_);
+  EXPECT_EQ(cpu_buffer_mgr->getSlabSegments().size(), size_t(3));
+}
+
+// Tests for the replacement policies of the BufferMgr. Slabs hold a single page, so every
+// chunk uses a full slab and the pool holds as many chunks as it has slabs.
+class BufferEvictionPolicyTest : public DataMgrTest {
+ public:
+  void TearDown() override {
+    DataMgrTest::TearDown();
+    g_buffer_eviction_policy = "score";
+  }
+
+  void resetDataMgr(const std::string& policy_name, size_t num_slabs) {
+    g_buffer_eviction_policy = policy_name;
+    DataMgrTest::resetDataMgr(num_slabs);
+  }
+
+  void readChunkForKey(const ChunkKey& key) {
+    data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4)->unPin();
+  }
+
+  bool isChunkInCpuBufferPool(const ChunkKey& key) {
+    return data_mgr_->isBufferOnDevice(key, MemoryLevel::CPU_LEVEL, 0);
+  }
+};
+
+TEST_F(BufferEvictionPolicyTest, LruEvictsReusedChunkDuringScan) {
+  resetDataMgr("lru", 3);
+  writeChunkForKey({1, 1, 1, 1});
+  readChunkForKey({1, 1, 1, 1});
+  for (int32_t i = 2; i <= 5; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  EXPECT_FALSE(isChunkInCpuBufferPool({1, 1, 1, 1}));
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 5}));
+}
+
+TEST_F(BufferEvictionPolicyTest, SlruKeepsReusedChunkDuringScan) {
+  resetDataMgr("slru", 3);
+  writeChunkForKey({1, 1, 1, 1});
+  readChunkForKey({1, 1, 1, 1});
+  for (int32_t i = 2; i <= 5; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 1}));
+  EXPECT_FALSE(isChunkInCpuBufferPool({1, 1, 1, 2}));
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 5}));
+}
+
+TEST_F(BufferEvictionPolicyTest, SkipsPinnedChunks) {
+  resetDataMgr("slru", 2);
+  auto chunk1 = writeChunkForKey({1, 1, 1, 1});  // pinned
+  for (int32_t i = 2; i <= 4; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 1}));
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 4}));
+}
+
+TEST_F(BufferEvictionPolicyTest, EvictsContiguousRunForLargerChunk) {
+  // A single slab of four pages, holding four single page chunks.
+  slab_size_ = 4 * 512;
+  resetDataMgr("slru", 1);
+  for (int32_t i = 1; i <= 4; ++i) {
+    writeChunkForKey({1, 1, 1, i});
+  }
+  readChunkForKey({1, 1, 1, 1});
+  readChunkForKey({1, 1, 1, 3});
+  // The least recently used probationary chunk and its neighbour make room for a two
+  // page chunk; the other chunks, including the protected first one, stay cached.
+  writeChunkForKey({1, 1, 1, 5}, 600);
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 1}));
+  EXPECT_FALSE(isChunkInCpuBufferPool({1, 1, 1, 2}));
+  EXPECT_FALSE(isChunkInCpuBufferPool({1, 1, 1, 3}));
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 4}));
+  EXPECT_TRUE(isChunkInCpuBufferPool({1, 1, 1, 5}));
+}
+
+TEST_F(BufferEvictionPolicyTest, UnknownPolicy) {
+  EXPECT_THROW(resetDataMgr("mru", 1), std::runtime_error);
+}
+
+// Tests for CPU buffer pools mapped with huge pages. Slabs are 2MB, the size of the
+// smallest huge pages.
+class HugePageBufferPoolTest : public DataMgrTest {
+ public:
+  void TearDown() override {
+    DataMgrTest::TearDown();
+    g_cpu_buffer_huge_pages = "none";
+    g_prefault_cpu_buffer_pool = false;
+  }
+
+  void resetDataMgr(const std::string& huge_pages,
+                    const bool prefault,
+                    size_t num_slabs) {
+    g_cpu_buffer_huge_pages = huge_pages;
+    g_prefault_cpu_buffer_pool = prefault;
+    slab_size_ = 2 * 1024 * 1024;
+    DataMgrTest::resetDataMgr(num_slabs);
+  }
+};
+
+TEST_F(HugePageBufferPoolTest, PrefaultAllocatesPoolAtStartup) {
+  resetDataMgr("thp", true, 2);
+  auto cpu_buffer_mgr = data_mgr_->getCpuBufferMgr();
+  EXPECT_EQ(cpu_buffer_mgr->getAllocated(), 2 * slab_size_);
+  auto chunk = writeChunkForKey({1, 1, 1, 1});
+  EXPECT_EQ(chunk->getBuffer()->getMemoryPtr()[3], 4);
+  auto memory_info = data_mgr_->getMemoryInfo(MemoryLevel::CPU_LEVEL);
+  ASSERT_EQ(memory_info.size(), size_t(1));
+  EXPECT_LE(memory_info[0].hugePageBytesAllocated, 2 * slab_size_);
+}
+
+TEST_F(HugePageBufferPoolTest, FallsBackToTransparentHugePages) {
+  // Slabs are smaller than a 1GB huge page.
+  resetDataMgr("1gb", false, 1);
+  EXPECT_EQ(data_mgr_->getCpuBufferMgr()->getAllocated(), size_t(0));
+  auto chunk = writeChunkForKey({1, 1, 1, 1});
+  EXPECT_EQ(chunk->getBuffer()->getMemoryPtr()[3], 4);
+}
+
+TEST_F(HugePageBufferPoolTest, UnknownMode) {
+  EXPECT_THROW(resetDataMgr("4kb", false, 1), std::runtime_error);
+}
+
 #ifdef ENABLE_MEMKIND
 // Tests for the TieredCpuBufferMgr class.
 // These tests set the DataMgr to use small slabs (one page) to force situations like
@@ -23,10 +23,22 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 
+#include <cstring>
+#include <optional>
+
+#include "Catalog/ColumnDescriptor.h"
 #include "DataMgr/AbstractBuffer.h"
+#include "DataMgr/BitPackedEncoder.h"
+#include "DataMgr/Chunk/Chunk.h"
+#include "DataMgr/DiffEncoder.h"
 #include "DataMgr/Encoder.h"
+#include "DataMgr/FsstSymbolTable.h"
 #include "DataMgr/MemoryLevel.h"
+#include "DataMgr/RunLengthEncoder.h"
+#include "DataMgr/SparseEncoder.h"
+#include "DataMgr/StringNoneEncoder.h"
 #include "Shared/DatumFetchers.h"
+#include "Shared/FsstEncoding.h"
 #include "TestHelpers.h"
 
 #ifndef BASE_PATH
@@ -36,8 +48,12 @@
 using AbstractBuffer = Data_Namespace::AbstractBuffer;
 using MemoryLevel = Data_Namespace::MemoryLevel;
 
+// Buffer held in host memory, enough for encoders to append to and chunk iterators to
+// read from.
 class TestBuffer : public AbstractBuffer {
  public:
+  TestBuffer() : AbstractBuffer(0) {}
+
   TestBuffer(const SQLTypeInfo sql_type) : AbstractBuffer(0, sql_type) {}
 
   void read(int8_t* const dst,
@@ -45,7 +61,8 @@ class TestBuffer : public AbstractBuffer {
             const size_t offset,
             const MemoryLevel dst_buffer_type,
             const int dst_device_id) override {
-    UNREACHABLE();
+    CHECK_LE(offset + num_bytes, size_);
+    std::memcpy(dst, mem_.data() + offset, num_bytes);
   }
 
   void write(int8_t* src,
@@ -53,22 +70,35 @@ class TestBuffer : public AbstractBuffer {
              const size_t offset,
              const MemoryLevel src_buffer_type,
              const int src_device_id) override {
-    UNREACHABLE();
+    reserve(offset + num_bytes);
+    std::memcpy(mem_.data() + offset, src, num_bytes);
+    setDirty();
+    if (offset < size_) {
+      setUpdated();
+    }
+    if (offset + num_bytes > size_) {
+      setAppended();
+      size_ = offset + num_bytes;
+    }
   }
 
-  void reserve(size_t num_bytes) override { UNREACHABLE(); }
+  void reserve(size_t num_bytes) override {
+    if (num_bytes > mem_.size()) {
+      mem_.resize(num_bytes);
+    }
+  }
 
   void append(int8_t* src,
               const size_t num_bytes,
               const MemoryLevel src_buffer_type,
               const int device_id) override {
-    UNREACHABLE();
+    reserve(size_ + num_bytes);
+    std::memcpy(mem_.data() + size_, src, num_bytes);
+    setAppended();
+    size_ += num_bytes;
   }
 
-  int8_t* getMemoryPtr() override {
-    UNREACHABLE();
-    return nullptr;
-  }
+  int8_t* getMemoryPtr() override { return mem_.data(); }
 
   size_t pageCount() const override {
     UNREACHABLE();
@@ -80,15 +110,12 @@ class TestBuffer : public AbstractBuffer {
     return 0;
   }
 
-  size_t reservedSize() const override {
-    UNREACHABLE();
-    return 0;
-  }
+  size_t reservedSize() const override { return mem_.size(); }
 
-  MemoryLevel getType() const override {
-    UNREACHABLE();
-    return Data_Namespace::CPU_LEVEL;
-  }
+  MemoryLevel getType() const override { return Data_Namespace::CPU_LEVEL; }
+
+ private:
+  std::vector<int8_t> mem_;
 };
 
 class EncoderTest : public testing::Test {
@@ -764,6 +791,854 @@ TYPED_TEST(FixedLengthArrayNoneEncoderUpdateStatsTest, TypedTest) {
   TestFixture::runTest();
 }
 
+class RunLengthEncoderUpdateStatsTest : public EncoderUpdateStatsTest {};
+
+TEST_F(RunLengthEncoderUpdateStatsTest, Int) {
+  std::vector<int32_t> data = {7, 7, -2, inline_int_null_value<int32_t>(), 4};
+  createEncoder(SQLTypeInfo(kINT, false, kENCODING_RL));
+  updateWithData(data);
+  assertExpectedStats<int32_t>(-2, 7, true);
+}
+
+TEST_F(RunLengthEncoderUpdateStatsTest, BigInt) {
+  std::vector<int64_t> data = {3, 3, 3, 9};
+  createEncoder(SQLTypeInfo(kBIGINT, false, kENCODING_RL));
+  updateWithData(data);
+  assertExpectedStats<int64_t>(3, 9, false);
+}
+
+namespace {
+
+// Column of the encoding tests and the values of its rows.
+struct EncodingTestParam {
+  std::string name;
+  SQLTypeInfo type;
+  // Non null rows hold base + k * step, k in [-6, 6], in runs of four rows.
+  int64_t base;
+  int64_t step;
+  // Only one row in nine isn't null, instead of one in eleven being null.
+  bool mostly_null{false};
+};
+
+constexpr size_t kNumEncodingTestRows{1000};
+
+}  // namespace
+
+// Rows are appended to a chunk of each encoding in two batches, then read back through a
+// chunk iterator, in order, with a stride and by position.
+class EncodingTest : public EncoderTest,
+                     public testing::WithParamInterface<EncodingTestParam> {
+ protected:
+  void SetUp() override {
+    const auto& ti = GetParam().type;
+    column_desc_.columnType = ti;
+    createEncoder(ti);
+    if (isNoneEncodedString()) {
+      index_buffer_ = std::make_unique<TestBuffer>();
+      stringEncoder()->setIndexBuffer(index_buffer_.get());
+    }
+  }
+
+  void TearDown() override {
+    EncoderTest::TearDown();
+    index_buffer_.reset();
+  }
+
+  bool isNoneEncodedString() const {
+    return GetParam().type.is_string() &&
+           GetParam().type.get_compression() == kENCODING_NONE;
+  }
+
+  StringNoneEncoder* stringEncoder() const {
+    return static_cast<StringNoneEncoder*>(buffer_->getEncoder());
+  }
+
+  bool isNullRow(const size_t row) const {
+    return GetParam().mostly_null ? row % 9 != 0 : row % 11 == 5;
+  }
+
+  int64_t rowValue(const size_t row) const {
+    return GetParam().base + (static_cast<int64_t>(row / 4 % 13) - 6) * GetParam().step;
+  }
+
+  double rowFpValue(const size_t row) const { return rowValue(row) / 2.0; }
+
+  std::string rowString(const size_t row) const {
+    return isNullRow(row) ? std::string()
+                          : "https://www.example.com/products/" +
+                                std::to_string(rowValue(row)) +
+                                (row % 3 ? "?ref=homepage" : "");
+  }
+
+  void appendRows(const size_t start_row, const size_t num_rows) {
+    const auto& ti = GetParam().type;
+    if (isNoneEncodedString()) {
+      std::vector<std::string> strings;
+      for (size_t row = start_row; row < start_row + num_rows; ++row) {
+        strings.push_back(rowString(row));
+      }
+      stringEncoder()->appendData(&strings, 0, strings.size());
+      return;
+    }
+    const size_t width = ti.get_size();
+    std::vector<int8_t> data(num_rows * width);
+    for (size_t i = 0; i < num_rows; ++i) {
+      const auto row = start_row + i;
+      auto dst = data.data() + i * width;
+      if (ti.get_type() == kDOUBLE) {
+        const double val = isNullRow(row) ? NULL_DOUBLE : rowFpValue(row);
+        std::memcpy(dst, &val, width);
+        continue;
+      }
+      const auto val = isNullRow(row) ? intNull() : rowValue(row);
+      switch (width) {
+        case 2:
+          *reinterpret_cast<int16_t*>(dst) = val;
+          break;
+        case 4:
+          *reinterpret_cast<int32_t*>(dst) = val;
+          break;
+        default:
+          *reinterpret_cast<int64_t*>(dst) = val;
+          break;
+      }
+    }
+    auto data_ptr = data.data();
+    buffer_->getEncoder()->appendData(data_ptr, num_rows, ti);
+  }
+
+  int64_t intNull() const {
+    switch (GetParam().type.get_size()) {
+      case 2:
+        return NULL_SMALLINT;
+      case 4:
+        return NULL_INT;
+      default:
+        return NULL_BIGINT;
+    }
+  }
+
+  void checkRow(const VarlenDatum& vd, const size_t row) const {
+    const auto& ti = GetParam().type;
+    ASSERT_EQ(vd.is_null, isNullRow(row)) << row;
+    if (isNoneEncodedString()) {
+      ASSERT_EQ(fsst_encoding::decompress(buffer_->getMemoryPtr(), vd.pointer, vd.length),
+                rowString(row))
+          << row;
+      return;
+    }
+    ASSERT_EQ(vd.length, size_t(ti.get_size()));
+    if (vd.is_null) {
+      return;
+    }
+    if (ti.get_type() == kDOUBLE) {
+      ASSERT_EQ(*reinterpret_cast<const double*>(vd.pointer), rowFpValue(row)) << row;
+      return;
+    }
+    int64_t val;
+    switch (vd.length) {
+      case 2:
+        val = *reinterpret_cast<const int16_t*>(vd.pointer);
+        break;
+      case 4:
+        val = *reinterpret_cast<const int32_t*>(vd.pointer);
+        break;
+      default:
+        val = *reinterpret_cast<const int64_t*>(vd.pointer);
+        break;
+    }
+    ASSERT_EQ(val, rowValue(row)) << row;
+  }
+
+  std::shared_ptr<ChunkMetadata> getMetadata() const {
+    auto chunk_metadata = std::make_shared<ChunkMetadata>();
+    buffer_->getEncoder()->getMetadata(chunk_metadata);
+    return chunk_metadata;
+  }
+
+  void checkStats() const {
+    const auto& ti = GetParam().type;
+    const auto chunk_metadata = getMetadata();
+    ASSERT_EQ(chunk_metadata->numElements, kNumEncodingTestRows);
+    ASSERT_TRUE(chunk_metadata->chunkStats.has_nulls);
+    if (isNoneEncodedString()) {
+      return;
+    }
+    std::optional<int64_t> min;
+    std::optional<int64_t> max;
+    for (size_t row = 0; row < kNumEncodingTestRows; ++row) {
+      if (!isNullRow(row)) {
+        min = std::min(min.value_or(rowValue(row)), rowValue(row));
+        max = std::max(max.value_or(rowValue(row)), rowValue(row));
+      }
+    }
+    ASSERT_TRUE(min && max);
+    const auto& stats = chunk_metadata->chunkStats;
+    if (ti.get_type() == kDOUBLE) {
+      ASSERT_EQ(extract_fp_type_from_datum(stats.min, ti), *min / 2.0);
+      ASSERT_EQ(extract_fp_type_from_datum(stats.max, ti), *max / 2.0);
+    } else {
+      ASSERT_EQ(extract_int_type_from_datum(stats.min, ti), *min);
+      ASSERT_EQ(extract_int_type_from_datum(stats.max, ti), *max);
+    }
+  }
+
+  // Reads every stride-th row from start_row on with ChunkIter_get_next.
+  void checkRowsInOrder(const size_t start_row, const size_t stride) {
+    Chunk_NS::Chunk chunk(buffer_.get(), index_buffer_.get(), &column_desc_, false);
+    auto it = chunk.begin_iterator(getMetadata(), start_row, stride);
+    VarlenDatum vd;
+    bool is_end;
+    for (size_t row = start_row; row < kNumEncodingTestRows; row += stride) {
+      ChunkIter_get_next(&it, false, &vd, &is_end);
+      ASSERT_FALSE(is_end) << row;
+      checkRow(vd, row);
+    }
+    ChunkIter_get_next(&it, false, &vd, &is_end);
+    ASSERT_TRUE(is_end);
+  }
+
+  ColumnDescriptor column_desc_;
+  std::unique_ptr<TestBuffer> index_buffer_;
+};
+
+TEST_P(EncodingTest, RoundTrip) {
+  // the second batch extends the last run, frame or symbol table of the first
+  appendRows(0, 601);
+  appendRows(601, kNumEncodingTestRows - 601);
+  checkStats();
+  checkRowsInOrder(0, 1);
+  checkRowsInOrder(3, 5);
+  checkRowsInOrder(0, 37);
+  Chunk_NS::Chunk chunk(buffer_.get(), index_buffer_.get(), &column_desc_, false);
+  auto it = chunk.begin_iterator(getMetadata(), 0, 1);
+  VarlenDatum vd;
+  bool is_end;
+  for (size_t i = 0; i < kNumEncodingTestRows; ++i) {
+    // positions all over the chunk, backwards and forwards
+    const auto row = (i * 7919) % kNumEncodingTestRows;
+    ChunkIter_get_nth(&it, row, false, &vd, &is_end);
+    ASSERT_FALSE(is_end) << row;
+    checkRow(vd, row);
+  }
+  ChunkIter_get_nth(&it, kNumEncodingTestRows, false, &vd, &is_end);
+  ASSERT_TRUE(is_end);
+}
+
+TEST_P(EncodingTest, Replicate) {
+  if (isNoneEncodedString()) {
+    GTEST_SKIP() << "none encoded strings are replicated by the caller";
+  }
+  // a chunk of one repeated value, as added by ALTER TABLE ADD COLUMN
+  appendRows(1, 1);
+  const size_t width = GetParam().type.get_size();
+  std::vector<int8_t> value(width);
+  Chunk_NS::Chunk chunk(buffer_.get(), nullptr, &column_desc_, false);
+  auto first = chunk.begin_iterator(getMetadata(), 0, 1);
+  VarlenDatum vd;
+  bool is_end;
+  ChunkIter_get_next(&first, false, &vd, &is_end);
+  std::memcpy(value.data(), vd.pointer, width);
+  createEncoder(GetParam().type);
+  auto value_ptr = value.data();
+  buffer_->getEncoder()->appendData(value_ptr, 100, GetParam().type, true);
+  Chunk_NS::Chunk replicated_chunk(buffer_.get(), nullptr, &column_desc_, false);
+  auto it = replicated_chunk.begin_iterator(getMetadata(), 0, 1);
+  for (size_t row = 0; row < 100; ++row) {
+    ChunkIter_get_next(&it, false, &vd, &is_end);
+    ASSERT_FALSE(is_end);
+    checkRow(vd, 1);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Encodings,
+    EncodingTest,
+    testing::Values(
+        EncodingTestParam{
+            "RunLengthInt", SQLTypeInfo(kINT, false, kENCODING_RL), 0, 1000},
+        EncodingTestParam{"RunLengthBigInt",
+                          SQLTypeInfo(kBIGINT, false, kENCODING_RL),
+                          1LL << 40,
+                          1LL << 33},
+        EncodingTestParam{
+            "RunLengthDictString",
+            SQLTypeInfo(kTEXT, 0, RL_DICT_SCALE, false, kENCODING_DICT, 1, kNULLT),
+            6,
+            1},
+        EncodingTestParam{"DiffBigInt",
+                          SQLTypeInfo(kBIGINT, 0, 0, false, kENCODING_DIFF, 0, kNULLT),
+                          -5000000,
+                          1},
+        EncodingTestParam{
+            "DiffTimestamp",
+            SQLTypeInfo(kTIMESTAMP, 9, 0, false, kENCODING_DIFF, 0, kNULLT),
+            1650000000000000000,
+            104729},
+        EncodingTestParam{
+            "SparseInt", SQLTypeInfo(kINT, false, kENCODING_SPARSE), 0, 12, true},
+        EncodingTestParam{
+            "SparseDouble", SQLTypeInfo(kDOUBLE, false, kENCODING_SPARSE), 0, 3, true},
+        EncodingTestParam{"BitPackedSmallInt",
+                          SQLTypeInfo(kSMALLINT, 0, 0, false, kENCODING_FIXED, 5, kNULLT),
+                          0,
+                          2},
+        EncodingTestParam{"BitPackedInt",
+                          SQLTypeInfo(kINT, 0, 0, false, kENCODING_FIXED, 11, kNULLT),
+                          0,
+                          100},
+        EncodingTestParam{"BitPackedBigInt",
+                          SQLTypeInfo(kBIGINT, 0, 0, false, kENCODING_FIXED, 40, kNULLT),
+                          0,
+                          1000000000},
+        EncodingTestParam{
+            "FsstString",
+            SQLTypeInfo(kTEXT, 0, 0, false, kENCODING_NONE, FSST_COMP_PARAM, kNULLT),
+            0,
+            7919}),
+    [](const auto& param_info) { return param_info.param.name; });
+
+namespace {
+
+template <typename E>
+std::vector<int8_t> make_run_length_buffer(
+    const std::vector<run_length_encoding::Run<E>>& runs) {
+  std::vector<int8_t> buffer(run_length_encoding::kHeaderBytes +
+                             runs.size() * sizeof(run_length_encoding::Run<E>));
+  *reinterpret_cast<int64_t*>(buffer.data()) = runs.size();
+  std::memcpy(buffer.data() + run_length_encoding::kHeaderBytes,
+              runs.data(),
+              runs.size() * sizeof(run_length_encoding::Run<E>));
+  return buffer;
+}
+
+}  // namespace
+
+TEST(RunLengthEncoding, Decode) {
+  const auto buffer = make_run_length_buffer<int32_t>({{3, 5}, {4, -1}, {8, 2}});
+  std::vector<int32_t> expanded(8);
+  run_length_encoding::expand(
+      buffer.data(), sizeof(int32_t), 8, reinterpret_cast<int8_t*>(expanded.data()));
+  ASSERT_EQ(expanded, std::vector<int32_t>({5, 5, 5, -1, 2, 2, 2, 2}));
+  for (int64_t pos = 0; pos < 8; ++pos) {
+    ASSERT_EQ(run_length_encoding::decode(buffer.data(), sizeof(int32_t), pos),
+              expanded[pos]);
+  }
+}
+
+TEST(RunLengthEncoding, RemoveRows) {
+  auto buffer = make_run_length_buffer<int64_t>({{2, 1}, {3, 4}, {5, 1}, {6, 8}});
+  // Removing the only row of the second run merges its neighbours.
+  const auto num_bytes =
+      run_length_encoding::remove_rows(buffer.data(), sizeof(int64_t), {0, 2, 5});
+  ASSERT_EQ(run_length_encoding::num_runs(buffer.data()), 1);
+  ASSERT_EQ(
+      num_bytes,
+      run_length_encoding::kHeaderBytes + sizeof(run_length_encoding::Run<int64_t>));
+  ASSERT_EQ(run_length_encoding::run_end(buffer.data(), sizeof(int64_t), 0), 3);
+  ASSERT_EQ(run_length_encoding::run_value(buffer.data(), sizeof(int64_t), 0), 1);
+}
+
+TEST(RunLengthEncoding, Concatenate) {
+  const auto first = make_run_length_buffer<int32_t>({{2, 1}, {3, 6}});
+  const auto second = make_run_length_buffer<int32_t>({{4, 6}});
+  std::vector<int8_t> buffer(first.size() + second.size());
+  run_length_encoding::concatenate(
+      {first.data(), second.data()}, sizeof(int32_t), buffer.data());
+  std::vector<int32_t> expanded(7);
+  run_length_encoding::expand(
+      buffer.data(), sizeof(int32_t), 7, reinterpret_cast<int8_t*>(expanded.data()));
+  ASSERT_EQ(expanded, std::vector<int32_t>({1, 1, 6, 6, 6, 6, 6}));
+}
+
+class DiffEncoderUpdateStatsTest : public EncoderUpdateStatsTest {};
+
+TEST_F(DiffEncoderUpdateStatsTest, Timestamp) {
+  std::vector<int64_t> data = {
+      1650000000123456789, inline_int_null_value<int64_t>(), 1650000000000000000};
+  createEncoder(SQLTypeInfo(kTIMESTAMP, 9, 0, false, kENCODING_DIFF, 0, kNULLT));
+  updateWithData(data);
+  assertExpectedStats<int64_t>(1650000000000000000, 1650000000123456789, true);
+}
+
+namespace {
+
+std::vector<int64_t> diff_round_trip(const std::vector<int64_t>& values) {
+  const auto [base, bit_width] = diff_encoding::frame_of(values.data(), values.size());
+  std::vector<int8_t> buffer(diff_encoding::byte_size(values.size(), bit_width));
+  diff_encoding::encode(values.data(), values.size(), base, bit_width, buffer.data());
+  std::vector<int64_t> decoded(values.size());
+  diff_encoding::decode_rows(buffer.data(), 0, values.size(), decoded.data());
+  return decoded;
+}
+
+}  // namespace
+
+TEST(DiffEncoding, FrameOfChunk) {
+  const std::vector<int64_t> values = {1000, 1003, 1001, 1002};
+  const auto [base, bit_width] = diff_encoding::frame_of(values.data(), values.size());
+  ASSERT_EQ(base, 1000);
+  // deltas 0 to 3 and the null delta
+  ASSERT_EQ(bit_width, 3);
+  ASSERT_EQ(diff_round_trip(values), values);
+}
+
+TEST(DiffEncoding, DeltasSpanningWords) {
+  // 24 bit deltas, the third one straddles the first two words
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 100; ++i) {
+    values.push_back(i % 7 ? 1650000000000000000 + i * 104729 : NULL_BIGINT);
+  }
+  ASSERT_EQ(diff_round_trip(values), values);
+}
+
+TEST(DiffEncoding, FullRange) {
+  const std::vector<int64_t> values = {std::numeric_limits<int64_t>::max(),
+                                       NULL_BIGINT,
+                                       std::numeric_limits<int64_t>::min() + 1,
+                                       0};
+  const auto [base, bit_width] = diff_encoding::frame_of(values.data(), values.size());
+  ASSERT_EQ(bit_width, 64);
+  ASSERT_EQ(diff_round_trip(values), values);
+}
+
+TEST(DiffEncoding, RemoveRows) {
+  const std::vector<int64_t> values = {5, 1000000, 7, 6};
+  const auto [base, bit_width] = diff_encoding::frame_of(values.data(), values.size());
+  std::vector<int8_t> buffer(diff_encoding::byte_size(values.size(), bit_width));
+  diff_encoding::encode(values.data(), values.size(), base, bit_width, buffer.data());
+  const auto num_bytes = diff_encoding::remove_rows(buffer.data(), values.size(), {1});
+  // the remaining rows get a narrower frame
+  ASSERT_EQ(diff_encoding::bit_width(buffer.data()), 2);
+  ASSERT_EQ(num_bytes, diff_encoding::byte_size(3, 2));
+  std::vector<int64_t> decoded(3);
+  diff_encoding::decode_rows(buffer.data(), 0, 3, decoded.data());
+  ASSERT_EQ(decoded, std::vector<int64_t>({5, 7, 6}));
+}
+
+class SparseEncoderUpdateStatsTest : public EncoderUpdateStatsTest {};
+
+TEST_F(SparseEncoderUpdateStatsTest, Int) {
+  std::vector<int32_t> data = {
+      NULL_INT, NULL_INT, 12, NULL_INT, -3, NULL_INT, NULL_INT, NULL_INT};
+  createEncoder(SQLTypeInfo(kINT, false, kENCODING_SPARSE));
+  updateWithData(data);
+  assertExpectedStats<int32_t>(-3, 12, true);
+}
+
+TEST_F(SparseEncoderUpdateStatsTest, Double) {
+  std::vector<double> data = {NULL_DOUBLE, 2.5, NULL_DOUBLE, -0.5};
+  createEncoder(SQLTypeInfo(kDOUBLE, false, kENCODING_SPARSE));
+  updateWithData(data);
+  assertExpectedStats<double>(-0.5, 2.5, true);
+}
+
+namespace {
+
+template <typename T>
+std::vector<int8_t> make_sparse_buffer(const std::vector<T>& rows) {
+  std::vector<int8_t> buffer(sparse_encoding::byte_size(rows.size(), sizeof(T)));
+  buffer.resize(sparse_encoding::encode(rows.data(), rows.size(), buffer.data()));
+  return buffer;
+}
+
+}  // namespace
+
+TEST(SparseEncoding, Decode) {
+  std::vector<int16_t> rows(150, NULL_SMALLINT);
+  rows[0] = 4;
+  rows[63] = -7;
+  rows[64] = 9;
+  rows[149] = 1;
+  const auto buffer = make_sparse_buffer(rows);
+  ASSERT_EQ(sparse_encoding::num_rows(buffer.data()), 150);
+  ASSERT_EQ(sparse_encoding::num_values(buffer.data()), 4);
+  ASSERT_EQ(buffer.size(), sparse_encoding::byte_size(4, sizeof(int16_t)));
+  std::vector<int16_t> expanded(rows.size());
+  sparse_encoding::expand(buffer.data(),
+                          SQLTypeInfo(kSMALLINT, false, kENCODING_SPARSE),
+                          rows.size(),
+                          reinterpret_cast<int8_t*>(expanded.data()));
+  ASSERT_EQ(expanded, rows);
+  std::vector<int16_t> window(20);
+  sparse_encoding::decode_rows(buffer.data(), 50, window.size(), window.data());
+  ASSERT_EQ(window[13], -7);
+  ASSERT_EQ(window[14], 9);
+  ASSERT_EQ(sparse_encoding::value_index(buffer.data(), sizeof(int16_t), 64), 2);
+  ASSERT_EQ(sparse_encoding::value_index(buffer.data(), sizeof(int16_t), 65), -1);
+}
+
+TEST(SparseEncoding, Cursor) {
+  std::vector<int64_t> rows(1000, NULL_BIGINT);
+  for (size_t row = 3; row < rows.size(); row += 97) {
+    rows[row] = row * 11;
+  }
+  const auto buffer = make_sparse_buffer(rows);
+  int64_t cursor = 0;
+  for (size_t row = 0; row < rows.size(); ++row) {
+    const auto idx =
+        sparse_encoding::value_index(buffer.data(), sizeof(int64_t), row, &cursor);
+    // the cursor is left on the first entry at or after the row
+    ASSERT_EQ(cursor, static_cast<int64_t>((row + 93) / 97)) << row;
+    if (rows[row] == NULL_BIGINT) {
+      ASSERT_EQ(idx, -1) << row;
+    } else {
+      ASSERT_EQ(sparse_encoding::entry_value<int64_t>(buffer.data(), idx), rows[row]);
+    }
+  }
+  // a stale cursor is only a hint
+  cursor = 9;
+  ASSERT_EQ(sparse_encoding::value_index(buffer.data(), sizeof(int64_t), 100, &cursor),
+            1);
+  ASSERT_EQ(cursor, 1);
+}
+
+TEST(SparseEncoding, AppendKeepsEarlierEntries) {
+  const SQLTypeInfo ti(kINT, false, kENCODING_SPARSE);
+  TestBuffer buffer(ti);
+  std::vector<int32_t> first{NULL_INT, 5, NULL_INT, NULL_INT, 8};
+  auto data = reinterpret_cast<int8_t*>(first.data());
+  buffer.getEncoder()->appendData(data, first.size(), ti);
+  const std::vector<int8_t> first_bytes(buffer.getMemoryPtr(),
+                                        buffer.getMemoryPtr() + buffer.size());
+  std::vector<int32_t> second{NULL_INT, NULL_INT, -3};
+  data = reinterpret_cast<int8_t*>(second.data());
+  buffer.getEncoder()->appendData(data, second.size(), ti);
+  ASSERT_EQ(buffer.size(), sparse_encoding::byte_size(3, sizeof(int32_t)));
+  // only the header changes, the entries of the first append stay in place
+  ASSERT_TRUE(std::equal(first_bytes.begin() + sparse_encoding::kHeaderBytes,
+                         first_bytes.end(),
+                         buffer.getMemoryPtr() + sparse_encoding::kHeaderBytes));
+  ASSERT_EQ(sparse_encoding::num_rows(buffer.getMemoryPtr()), 8);
+  std::vector<int32_t> decoded(8);
+  sparse_encoding::decode_rows(buffer.getMemoryPtr(), 0, 8, decoded.data());
+  ASSERT_EQ(decoded,
+            std::vector<int32_t>(
+                {NULL_INT, 5, NULL_INT, NULL_INT, 8, NULL_INT, NULL_INT, -3}));
+  auto metadata = std::make_shared<ChunkMetadata>();
+  buffer.getEncoder()->getMetadata(metadata);
+  ASSERT_TRUE(metadata->chunkStats.has_nulls);
+  ASSERT_EQ(metadata->chunkStats.min.intval, -3);
+  ASSERT_EQ(metadata->chunkStats.max.intval, 8);
+}
+
+TEST(SparseEncoding, Concatenate) {
+  const auto first = make_sparse_buffer<float>({NULL_FLOAT, 1.5f, NULL_FLOAT});
+  const auto second = make_sparse_buffer<float>({2.5f, NULL_FLOAT});
+  const std::vector<const int8_t*> parts{first.data(), second.data()};
+  std::vector<int8_t> buffer(
+      sparse_encoding::concatenated_byte_size(parts, sizeof(float)));
+  ASSERT_EQ(sparse_encoding::concatenate(parts, sizeof(float), buffer.data()),
+            buffer.size());
+  ASSERT_EQ(sparse_encoding::num_rows(buffer.data()), 5);
+  std::vector<float> expanded(5);
+  sparse_encoding::decode_rows(buffer.data(), 0, 5, expanded.data());
+  ASSERT_EQ(expanded,
+            std::vector<float>({NULL_FLOAT, 1.5f, NULL_FLOAT, 2.5f, NULL_FLOAT}));
+}
+
+TEST(SparseEncoding, RemoveRows) {
+  auto buffer = make_sparse_buffer<int64_t>({NULL_BIGINT, 3, 8, NULL_BIGINT, 5});
+  const auto num_bytes =
+      sparse_encoding::remove_rows(buffer.data(), sizeof(int64_t), {1, 3});
+  ASSERT_EQ(num_bytes, sparse_encoding::byte_size(2, sizeof(int64_t)));
+  ASSERT_EQ(sparse_encoding::num_rows(buffer.data()), 3);
+  std::vector<int64_t> decoded(3);
+  sparse_encoding::decode_rows(buffer.data(), 0, 3, decoded.data());
+  ASSERT_EQ(decoded, std::vector<int64_t>({NULL_BIGINT, 8, 5}));
+}
+
+class BitPackedEncoderUpdateStatsTest : public EncoderUpdateStatsTest {};
+
+TEST_F(BitPackedEncoderUpdateStatsTest, Int) {
+  std::vector<int32_t> data = {0, 1000, NULL_INT, 17};
+  createEncoder(SQLTypeInfo(kINT, 0, 0, false, kENCODING_FIXED, 11, kNULLT));
+  updateWithData(data);
+  assertExpectedStats<int32_t>(0, 1000, true);
+}
+
+namespace {
+
+std::vector<int64_t> bit_packing_round_trip(const std::vector<int64_t>& values,
+                                            const int32_t bit_width,
+                                            const size_t start_row) {
+  std::vector<int8_t> buffer(bit_packing::byte_size(values.size(), bit_width));
+  bit_packing::encode(values.data(), values.size(), bit_width, buffer.data());
+  std::vector<int64_t> decoded(values.size() - start_row);
+  bit_packing::decode_rows(
+      buffer.data(), bit_width, start_row, decoded.size(), decoded.data());
+  return decoded;
+}
+
+}  // namespace
+
+TEST(BitPacking, Decode) {
+  for (int32_t bit_width = 1; bit_width < 64; ++bit_width) {
+    // values spanning words, nulls and the whole range of the bit width
+    const auto max_val = (int64_t(1) << (bit_width - 1)) - 1;
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 200; ++i) {
+      const auto val = (i * 7919) % (max_val + 1);
+      values.push_back(i % 5 == 0 ? NULL_BIGINT : i % 2 ? -val : val);
+    }
+    values[1] = -max_val;
+    values[2] = max_val;
+    // the first rows are decoded one at a time, then whole blocks
+    for (const size_t start_row : {0, 3}) {
+      ASSERT_EQ(bit_packing_round_trip(values, bit_width, start_row),
+                std::vector<int64_t>(values.begin() + start_row, values.end()))
+          << bit_width;
+    }
+  }
+}
+
+TEST(BitPacking, Concatenate) {
+  const std::vector<int32_t> first = {3, NULL_INT, -4};
+  const std::vector<int32_t> second = {1, 2};
+  std::vector<int8_t> first_buffer(bit_packing::byte_size(first.size(), 4));
+  bit_packing::encode(first.data(), first.size(), 4, first_buffer.data());
+  std::vector<int8_t> second_buffer(bit_packing::byte_size(second.size(), 4));
+  bit_packing::encode(second.data(), second.size(), 4, second_buffer.data());
+  std::vector<int8_t> buffer(bit_packing::byte_size(5, 4));
+  ASSERT_EQ(bit_packing::concatenate(
+                {first_buffer.data(), second_buffer.data()}, {3, 2}, 4, buffer.data()),
+            buffer.size());
+  std::vector<int32_t> expanded(5);
+  bit_packing::expand(
+      buffer.data(), 4, sizeof(int32_t), 5, reinterpret_cast<int8_t*>(expanded.data()));
+  ASSERT_EQ(expanded, std::vector<int32_t>({3, NULL_INT, -4, 1, 2}));
+}
+
+TEST(BitPacking, RemoveRows) {
+  const std::vector<int16_t> values = {5, -6, NULL_SMALLINT, 7};
+  std::vector<int8_t> buffer(bit_packing::byte_size(values.size(), 5));
+  bit_packing::encode(values.data(), values.size(), 5, buffer.data());
+  const auto num_bytes = bit_packing::remove_rows(buffer.data(), 5, values.size(), {1});
+  ASSERT_EQ(num_bytes, bit_packing::byte_size(3, 5));
+  std::vector<int16_t> decoded(3);
+  bit_packing::decode_rows(buffer.data(), 5, 0, 3, decoded.data());
+  ASSERT_EQ(decoded, std::vector<int16_t>({5, NULL_SMALLINT, 7}));
+}
+
+namespace {
+
+std::vector<std::string> fsst_test_strings() {
+  std::vector<std::string> strings;
+  for (int i = 0; i < 500; ++i) {
+    strings.push_back("https://www.example.com/products/" + std::to_string(i * 7919) +
+                      (i % 3 ? "?ref=homepage" : ""));
+  }
+  strings.push_back("");
+  strings.push_back("\xff\x01 bytes without symbols");
+  return strings;
+}
+
+}  // namespace
+
+TEST(FsstEncoding, RoundTrip) {
+  const auto strings = fsst_test_strings();
+  const auto symbol_table =
+      fsst_encoding::SymbolTable::build(strings.begin(), strings.end());
+  ASSERT_GT(symbol_table.size(), size_t(0));
+  ASSERT_LE(symbol_table.size(), size_t(fsst_encoding::kMaxSymbols));
+  std::vector<int8_t> table(fsst_encoding::kTableBytes);
+  symbol_table.serialize(table.data());
+  // compressing with the serialized table gives the same codes
+  const fsst_encoding::SymbolTable loaded_table(table.data());
+  size_t num_bytes = 0;
+  size_t num_compressed_bytes = 0;
+  for (const auto& str : strings) {
+    const auto codes = symbol_table.compress(str);
+    ASSERT_EQ(codes, loaded_table.compress(str));
+    ASSERT_EQ(codes.empty(), str.empty());
+    ASSERT_EQ(fsst_encoding::decompress(table.data(),
+                                        reinterpret_cast<const int8_t*>(codes.data()),
+                                        codes.size()),
+              str);
+    num_bytes += str.size();
+    num_compressed_bytes += codes.size();
+  }
+  ASSERT_LT(num_compressed_bytes, num_bytes / 2);
+}
+
+TEST(FsstEncoding, Matches) {
+  const auto strings = fsst_test_strings();
+  const auto symbol_table =
+      fsst_encoding::SymbolTable::build(strings.begin(), strings.end());
+  std::vector<int8_t> table(fsst_encoding::kTableBytes);
+  symbol_table.serialize(table.data());
+  const auto matches = [&table, &symbol_table](const std::string& str,
+                                               const std::string& other,
+                                               const bool prefix) {
+    const auto codes = symbol_table.compress(str);
+    return fsst_encoding::matches(table.data(),
+                                  reinterpret_cast<const int8_t*>(codes.data()),
+                                  codes.size(),
+                                  other.data(),
+                                  other.size(),
+                                  prefix);
+  };
+  for (const auto& str : {strings[1], strings[3], strings.back()}) {
+    ASSERT_TRUE(matches(str, str, false));
+    ASSERT_TRUE(matches(str, str, true));
+    ASSERT_FALSE(matches(str, str + "x", false));
+    ASSERT_FALSE(matches(str, str + "x", true));
+    for (size_t length = 0; length < str.size(); ++length) {
+      // prefixes ending within a symbol
+      ASSERT_TRUE(matches(str, str.substr(0, length), true)) << str << " " << length;
+      ASSERT_FALSE(matches(str, str.substr(0, length), false)) << str << " " << length;
+    }
+  }
+  ASSERT_TRUE(matches("", "", false));
+  ASSERT_FALSE(matches("https://www.example.com/products/0",
+                       "https://www.example.com/products/1",
+                       false));
+  ASSERT_FALSE(matches("https://www.example.com/", "https://www.example.org", true));
+}
+
+TEST(ChunkBloomFilter, FalsePositives) {
+  ChunkBloomFilter bloom_filter;
+  for (int64_t val = 0; val < 2000; ++val) {
+    bloom_filter.add(val * 1000);
+  }
+  for (int64_t val = 0; val < 2000; ++val) {
+    ASSERT_TRUE(bloom_filter.mayContain(val * 1000));
+  }
+  ASSERT_FALSE(bloom_filter.isSaturated());
+  size_t false_positives = 0;
+  for (int64_t val = 0; val < 100000; ++val) {
+    false_positives += bloom_filter.mayContain(val * 1000 + 1);
+  }
+  ASSERT_LT(false_positives, size_t(5000));
+  for (int64_t val = 0; val < 100000; ++val) {
+    bloom_filter.add(-val);
+  }
+  ASSERT_TRUE(bloom_filter.isSaturated());
+}
+
+TEST_F(EncoderUpdateStatsTest, ChunkBloomFilter) {
+  createEncoder(kINT);
+  auto data = std::vector<int32_t>{7, 42, -3, inline_int_null_value<int32_t>(), 100000};
+  updateWithData(data);
+  auto encoder = buffer_->getEncoder();
+  auto chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(chunk_metadata);
+  // The rows counted by the encoder aren't all in the filter yet.
+  ASSERT_FALSE(chunk_metadata->bloomFilter);
+  encoder->setNumElems(data.size());
+  encoder->getMetadata(chunk_metadata);
+  ASSERT_TRUE(chunk_metadata->bloomFilter);
+  for (const auto val : {7, 42, -3, 100000}) {
+    ASSERT_TRUE(chunk_metadata->bloomFilter->mayContain(val));
+  }
+  // Updated values are only known through their range.
+  encoder->updateStats(int64_t(5), false);
+  encoder->getMetadata(chunk_metadata);
+  ASSERT_FALSE(chunk_metadata->bloomFilter);
+  encoder->resetChunkStats();
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(data.data()), data.size());
+  encoder->getMetadata(chunk_metadata);
+  ASSERT_TRUE(chunk_metadata->bloomFilter);
+  ASSERT_TRUE(chunk_metadata->bloomFilter->mayContain(42));
+}
+
+TEST(ChunkZoneMap, Ranges) {
+  ChunkZoneMap zone_map;
+  const size_t block_rows = ChunkZoneMap::kMinBlockRows;
+  zone_map.add(0, 1, 10);
+  zone_map.add(1, block_rows - 1, 20);
+  zone_map.add(2 * block_rows, 1, -5);
+  ASSERT_EQ(zone_map.blockRows(), block_rows);
+  ASSERT_EQ(zone_map.getRange(0, block_rows), std::make_pair(int64_t(10), int64_t(20)));
+  // Only null rows in the second block.
+  ASSERT_FALSE(zone_map.getRange(block_rows, 2 * block_rows));
+  ASSERT_EQ(zone_map.getRange(block_rows, 2 * block_rows + 1),
+            std::make_pair(int64_t(-5), int64_t(-5)));
+  // Going past the last zone merges pairs of zones.
+  const size_t num_rows = block_rows * ChunkZoneMap::kMaxZones + 1;
+  zone_map.add(num_rows - 1, 1, 1000);
+  ASSERT_EQ(zone_map.blockRows(), ChunkZoneMap::blockRows(num_rows));
+  ASSERT_EQ(zone_map.blockRows(), 2 * block_rows);
+  ASSERT_EQ(zone_map.getRange(0, 1), std::make_pair(int64_t(10), int64_t(20)));
+  ASSERT_EQ(zone_map.getRange(2 * block_rows, 4 * block_rows),
+            std::make_pair(int64_t(-5), int64_t(-5)));
+  ASSERT_EQ(zone_map.getRange(num_rows - 1, num_rows),
+            std::make_pair(int64_t(1000), int64_t(1000)));
+}
+
+TEST_F(EncoderUpdateStatsTest, ChunkZoneMap) {
+  createEncoder(kBIGINT);
+  const size_t num_rows = 2 * ChunkZoneMap::kMinBlockRows;
+  std::vector<int64_t> data(num_rows);
+  for (size_t i = 0; i < num_rows; ++i) {
+    data[i] = i;
+  }
+  auto encoder = buffer_->getEncoder();
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(data.data()), num_rows);
+  encoder->setNumElems(num_rows);
+  auto chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(chunk_metadata);
+  ASSERT_TRUE(chunk_metadata->zoneMap);
+  ASSERT_EQ(chunk_metadata->zoneMap->getRange(ChunkZoneMap::kMinBlockRows, num_rows),
+            std::make_pair(int64_t(ChunkZoneMap::kMinBlockRows), int64_t(num_rows - 1)));
+  // Updated values are only known through their range.
+  encoder->updateStats(int64_t(5), false);
+  encoder->getMetadata(chunk_metadata);
+  ASSERT_FALSE(chunk_metadata->zoneMap);
+}
+
+TEST_F(EncoderUpdateStatsTest, SharedChunkBloomFilter) {
+  createEncoder(kINT);
+  auto data = std::vector<int32_t>{7, 42, -3};
+  auto encoder = buffer_->getEncoder();
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(data.data()), data.size());
+  encoder->setNumElems(data.size());
+  auto chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(chunk_metadata);
+  auto other_chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(other_chunk_metadata);
+  ASSERT_TRUE(chunk_metadata->bloomFilter);
+  ASSERT_EQ(chunk_metadata->bloomFilter, other_chunk_metadata->bloomFilter);
+  // Rows recorded later don't show in the filter already handed out.
+  const int32_t appended_val{100000};
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(&appended_val), 1);
+  encoder->setNumElems(data.size() + 1);
+  encoder->getMetadata(other_chunk_metadata);
+  ASSERT_NE(chunk_metadata->bloomFilter, other_chunk_metadata->bloomFilter);
+  ASSERT_TRUE(other_chunk_metadata->bloomFilter->mayContain(appended_val));
+  for (const auto val : data) {
+    ASSERT_TRUE(other_chunk_metadata->bloomFilter->mayContain(val));
+  }
+}
+
+TEST_F(EncoderUpdateStatsTest, SharedChunkZoneMap) {
+  createEncoder(kBIGINT);
+  const size_t num_rows = 2 * ChunkZoneMap::kMinBlockRows;
+  std::vector<int64_t> data(num_rows);
+  for (size_t i = 0; i < num_rows; ++i) {
+    data[i] = i;
+  }
+  auto encoder = buffer_->getEncoder();
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(data.data()), num_rows);
+  encoder->setNumElems(num_rows);
+  auto chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(chunk_metadata);
+  auto other_chunk_metadata = std::make_shared<ChunkMetadata>();
+  encoder->getMetadata(other_chunk_metadata);
+  ASSERT_TRUE(chunk_metadata->zoneMap);
+  ASSERT_EQ(chunk_metadata->zoneMap, other_chunk_metadata->zoneMap);
+  // Rows recorded later don't show in the zone map already handed out.
+  const int64_t appended_val{1LL << 40};
+  encoder->updateStatsEncoded(reinterpret_cast<const int8_t*>(&appended_val), 1);
+  encoder->setNumElems(num_rows + 1);
+  encoder->getMetadata(other_chunk_metadata);
+  ASSERT_NE(chunk_metadata->zoneMap, other_chunk_metadata->zoneMap);
+  ASSERT_EQ(chunk_metadata->zoneMap->getRange(0, num_rows + 1),
+            std::make_pair(int64_t(0), int64_t(num_rows - 1)));
+  ASSERT_EQ(other_chunk_metadata->zoneMap->getRange(0, num_rows + 1),
+            std::make_pair(int64_t(0), appended_val));
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
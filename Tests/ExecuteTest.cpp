@@ -16,10 +16,12 @@
 
 #include "TestHelpers.h"
 
+#include "../DataMgr/ChunkZoneMap.h"
 #include "../ImportExport/Importer.h"
 #include "../Parser/ParserNode.h"
 #include "../QueryEngine/ArrowResultSet.h"
 #include "../QueryEngine/CgenState.h"
+#include "../QueryEngine/ChunkPrefetcher.h"
 #include "../QueryEngine/Descriptors/RelAlgExecutionDescriptor.h"
 #include "../QueryEngine/Execute.h"
 #include "../QueryEngine/ExpressionRange.h"
@@ -40,6 +42,7 @@
 
 #include <cmath>
 #include <cstdio>
+#include <optional>
 #include <random>
 
 #ifndef BASE_PATH
@@ -80,6 +83,9 @@ extern size_t g_leaf_count;
 extern bool g_cluster;
 
 extern bool g_is_test_env;
+extern bool g_enable_cpu_sub_tasks;
+extern size_t g_cpu_sub_task_size;
+extern bool g_enable_runtime_join_filters;
 
 using QR = QueryRunner::QueryRunner;
 
@@ -1703,6 +1709,37 @@ TEST(Select, FilterAndSimpleAggregation) {
   }
 }
 
+TEST(Select, ChunkPrefetch) {
+  ScopeGuard reset = [orig_enable = g_enable_chunk_prefetch,
+                      orig_num_kernels = g_chunk_prefetch_num_kernels] {
+    g_enable_chunk_prefetch = orig_enable;
+    g_chunk_prefetch_num_kernels = orig_num_kernels;
+  };
+  auto run_queries = [] {
+    for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+      SKIP_NO_GPU();
+      c("SELECT COUNT(*) FROM test WHERE x > 6;", dt);
+      c("SELECT SUM(x + y), MIN(z), MAX(t) FROM test;", dt);
+      c("SELECT x, COUNT(*) FROM test GROUP BY x ORDER BY x;", dt);
+      c("SELECT COUNT(*) FROM test, test_inner WHERE test.x = test_inner.x;", dt);
+      c("SELECT real_str, COUNT(*) FROM test GROUP BY real_str ORDER BY real_str;", dt);
+    }
+  };
+
+  g_enable_chunk_prefetch = false;
+  auto num_prefetched = ChunkPrefetcher::getTotalNumPrefetchedKernels();
+  run_queries();
+  EXPECT_EQ(ChunkPrefetcher::getTotalNumPrefetchedKernels(), num_prefetched);
+
+  g_enable_chunk_prefetch = true;
+  for (size_t num_kernels : {size_t(1), size_t(8)}) {
+    g_chunk_prefetch_num_kernels = num_kernels;
+    num_prefetched = ChunkPrefetcher::getTotalNumPrefetchedKernels();
+    run_queries();
+    EXPECT_GT(ChunkPrefetcher::getTotalNumPrefetchedKernels(), num_prefetched);
+  }
+}
+
 TEST(Select, AggregateOnEmptyDecimalColumn) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -9049,6 +9086,409 @@ TEST(Select, SkipFragments) {
     ExecutorDeviceType::CPU);
 }
 
+// Ids of the rows of the result, which has the id in its first column. When flag_col is
+// given, only those of the rows which have 1 in that column.
+std::vector<int64_t> get_ordered_ids(
+    const std::string& query,
+    const std::optional<size_t> flag_col = std::nullopt) {
+  const auto rows = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  std::vector<int64_t> ids;
+  for (auto row = rows->getNextRow(true, true); !row.empty();
+       row = rows->getNextRow(true, true)) {
+    if (!flag_col || v<int64_t>(row[*flag_col]) == 1) {
+      ids.push_back(v<int64_t>(row[0]));
+    }
+  }
+  return ids;
+}
+
+// Runs a filter on the qual, checking the number of fragments it fetches and the number
+// of rows it returns. Then evaluates the qual in a projection of every row, which no
+// fragment can be skipped for, and compares the rows it holds for with the filtered ones.
+void check_skip_fragments_qual(const std::string& qual,
+                               const size_t num_frags,
+                               const size_t num_rows) {
+  constexpr size_t num_cols{4};
+  constexpr size_t num_table_frags{4};
+  const auto query = "SELECT id, x, ts, str FROM skip_fragments_quals_test WHERE " +
+                     qual + " ORDER BY id;";
+  const auto unskipped_query = "SELECT id, x, ts, str, CASE WHEN " + qual +
+                               " THEN 1 ELSE 0 END FROM skip_fragments_quals_test "
+                               "ORDER BY id;";
+  run_skip_fragments_query(query, false, num_cols, num_frags);
+  run_skip_fragments_query(unskipped_query, false, num_cols, num_table_frags);
+  const auto ids = get_ordered_ids(query);
+  EXPECT_EQ(ids.size(), num_rows) << qual;
+  EXPECT_EQ(ids, get_ordered_ids(unskipped_query, num_cols)) << qual;
+}
+
+TEST(Select, SkipFragmentsForQuals) {
+  SKIP_WITH_TEMP_TABLES();
+  SKIP_IF_SHARDED();
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS skip_fragments_quals_test;");
+  };
+  ScopeGuard drop_table_guard = [&drop_table] { drop_table(); };
+  drop_table();
+  run_ddl_statement(
+      "CREATE TABLE skip_fragments_quals_test (id INT, x INT, ts TIMESTAMP(0), str TEXT "
+      "ENCODING DICT(32)) WITH (fragment_size = 4);");
+  // Fragment k holds x from 10k to 10k + 2 and a null, timestamps in month k + 1 from
+  // day 10 to 13 and the strings 'frag<k>_<row in fragment>'.
+  for (int64_t id = 0; id < 16; ++id) {
+    const auto frag = id / 4;
+    const auto row = id % 4;
+    const auto x = row == 3 ? std::string("NULL") : std::to_string(10 * frag + row);
+    run_multiple_agg("INSERT INTO skip_fragments_quals_test VALUES (" +
+                         std::to_string(id) + ", " + x + ", '2021-0" +
+                         std::to_string(frag + 1) + "-1" + std::to_string(row) +
+                         " 12:00:00', 'frag" + std::to_string(frag) + "_" +
+                         std::to_string(row) + "');",
+                     ExecutorDeviceType::CPU);
+  }
+
+  // IN lists
+  check_skip_fragments_qual("x IN (1, 32)", 2, 2);
+  check_skip_fragments_qual("x IN (5, 15, 100)", 0, 0);
+  // OR of ranges, only skipped where both sides are
+  check_skip_fragments_qual("x < 5 OR x > 30", 2, 5);
+  check_skip_fragments_qual("x < 5 OR x IS NULL", 4, 7);
+  // BETWEEN, and comparisons with the constant on the left
+  check_skip_fragments_qual("x BETWEEN 12 AND 21", 2, 3);
+  check_skip_fragments_qual("x BETWEEN 3 AND 9", 0, 0);
+  check_skip_fragments_qual("25 <= x", 1, 3);
+  check_skip_fragments_qual("(x < 5 OR x > 30) AND x BETWEEN 1 AND 31", 2, 3);
+  // DATE_TRUNC and EXTRACT bounds from the range of the timestamps
+  check_skip_fragments_qual("DATE_TRUNC(month, ts) = '2021-03-01 00:00:00'", 1, 4);
+  check_skip_fragments_qual("DATE_TRUNC(day, ts) > '2021-03-12 00:00:00'", 2, 5);
+  check_skip_fragments_qual("EXTRACT(MONTH FROM ts) BETWEEN 2 AND 3", 2, 8);
+  check_skip_fragments_qual("EXTRACT(DAY FROM ts) = 20", 0, 0);
+  check_skip_fragments_qual("EXTRACT(HOUR FROM ts) = 12", 4, 16);
+  // Equality on dictionary encoded strings, with literals missing from the dictionary
+  check_skip_fragments_qual("str = 'frag2_1'", 1, 1);
+  check_skip_fragments_qual("str = 'missing'", 0, 0);
+  check_skip_fragments_qual("str IN ('frag0_3', 'missing', 'frag3_0')", 2, 2);
+  check_skip_fragments_qual("str <> 'missing'", 4, 16);
+  check_skip_fragments_qual("str = 'frag1_0' OR x = 31", 2, 2);
+}
+
+namespace {
+
+const size_t g_row_blocks_test_row_count{4 * ChunkZoneMap::kMinBlockRows};
+
+// Loads rows with x equal to their position, so every block of the zone map of x holds
+// its own range, and y cycling through 0 to 6, so every block holds each of its values.
+void import_row_blocks_test() {
+  auto& cat = QR::get()->getSession()->getCatalog();
+  const auto td = cat.getMetadataForTable("skip_row_blocks_test");
+  CHECK(td);
+  auto loader = QR::get()->getLoader(td);
+  std::vector<std::unique_ptr<import_export::TypedImportBuffer>> import_buffers;
+  for (const auto cd :
+       cat.getAllColumnMetadataForTable(td->tableId, false, false, false)) {
+    import_buffers.emplace_back(new import_export::TypedImportBuffer(cd, nullptr));
+  }
+  CHECK_EQ(import_buffers.size(), size_t(2));
+  for (size_t row_idx = 0; row_idx < g_row_blocks_test_row_count; ++row_idx) {
+    import_buffers[0]->addBigint(row_idx);
+    import_buffers[1]->addBigint(row_idx % 7);
+  }
+  loader->load(import_buffers, g_row_blocks_test_row_count, nullptr);
+}
+
+std::shared_ptr<Analyzer::Expr> make_row_blocks_comparison(const std::string& col_name,
+                                                           const SQLOps op,
+                                                           const int64_t value) {
+  auto& cat = QR::get()->getSession()->getCatalog();
+  const auto td = cat.getMetadataForTable("skip_row_blocks_test");
+  CHECK(td);
+  const auto cd = cat.getMetadataForColumn(td->tableId, col_name);
+  CHECK(cd);
+  Datum d;
+  d.bigintval = value;
+  return makeExpr<Analyzer::BinOper>(
+      SQLTypeInfo(kBOOLEAN, false),
+      false,
+      op,
+      kONE,
+      makeExpr<Analyzer::ColumnVar>(cd->columnType, td->tableId, cd->columnId, 0),
+      makeExpr<Analyzer::Constant>(cd->columnType, false, d));
+}
+
+std::shared_ptr<Analyzer::Expr> make_row_blocks_or(
+    const std::shared_ptr<Analyzer::Expr>& lhs,
+    const std::shared_ptr<Analyzer::Expr>& rhs) {
+  return makeExpr<Analyzer::BinOper>(
+      SQLTypeInfo(kBOOLEAN, false), false, kOR, kONE, lhs, rhs);
+}
+
+std::vector<FragmentRowRange> get_row_blocks_scan_ranges(
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals) {
+  auto& cat = QR::get()->getSession()->getCatalog();
+  const auto td = cat.getMetadataForTable("skip_row_blocks_test");
+  CHECK(td);
+  const auto query_info = td->fragmenter->getFragmentsForQuery();
+  CHECK_EQ(query_info.fragments.size(), size_t(1));
+  const auto& fragment = query_info.fragments.front();
+  std::vector<InputDescriptor> input_descs{InputDescriptor(td->tableId, 0)};
+  RelAlgExecutionUnit ra_exe_unit{
+      input_descs, {}, {}, quals, {}, {}, {}, {}, nullptr, SortInfo{}, 0};
+  auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+  return executor->getFragmentScanRanges(
+      ra_exe_unit, fragment, fragment.getNumTuples());
+}
+
+// Compares the count and sum of x over the rows the filter returns with those of the
+// rows the predicate holds for.
+void check_skip_row_blocks_filter(const std::string& filter,
+                                  const std::function<bool(int64_t, int64_t)>& pred) {
+  int64_t count{0};
+  int64_t sum{0};
+  for (int64_t x = 0; x < static_cast<int64_t>(g_row_blocks_test_row_count); ++x) {
+    if (pred(x, x % 7)) {
+      ++count;
+      sum += x;
+    }
+  }
+  const auto rows = run_multiple_agg(
+      "SELECT COUNT(*), SUM(x) FROM skip_row_blocks_test WHERE " + filter + ";",
+      ExecutorDeviceType::CPU);
+  const auto crt_row = rows->getNextRow(true, true);
+  ASSERT_EQ(crt_row.size(), size_t(2));
+  EXPECT_EQ(v<int64_t>(crt_row[0]), count) << filter;
+  if (count) {
+    EXPECT_EQ(v<int64_t>(crt_row[1]), sum) << filter;
+  }
+}
+
+}  // namespace
+
+TEST(Select, SkipRowBlocks) {
+  SKIP_WITH_TEMP_TABLES();
+  SKIP_IF_SHARDED();
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS skip_row_blocks_test;");
+  };
+  ScopeGuard drop_table_guard = [&drop_table] { drop_table(); };
+  drop_table();
+  run_ddl_statement("CREATE TABLE skip_row_blocks_test (x BIGINT, y BIGINT);");
+  import_row_blocks_test();
+
+  const size_t block_rows = ChunkZoneMap::kMinBlockRows;
+  ASSERT_EQ(ChunkZoneMap::blockRows(g_row_blocks_test_row_count), block_rows);
+  using ScanRanges = std::vector<FragmentRowRange>;
+  EXPECT_EQ(get_row_blocks_scan_ranges({}),
+            ScanRanges({{0, g_row_blocks_test_row_count}}));
+  EXPECT_EQ(get_row_blocks_scan_ranges({make_row_blocks_comparison("x", kGE, 200000)}),
+            ScanRanges({{3 * block_rows, 4 * block_rows}}));
+  EXPECT_EQ(get_row_blocks_scan_ranges(
+                {make_row_blocks_or(make_row_blocks_comparison("x", kLT, 1000),
+                                    make_row_blocks_comparison("x", kGE, 200000))}),
+            ScanRanges({{0, block_rows}, {3 * block_rows, 4 * block_rows}}));
+  EXPECT_EQ(get_row_blocks_scan_ranges({make_row_blocks_comparison("x", kGE, 70000),
+                                        make_row_blocks_comparison("x", kLE, 140000)}),
+            ScanRanges({{block_rows, 3 * block_rows}}));
+  EXPECT_EQ(get_row_blocks_scan_ranges({make_row_blocks_comparison("x", kLT, 0)}),
+            ScanRanges());
+  EXPECT_EQ(get_row_blocks_scan_ranges({make_row_blocks_comparison("y", kEQ, 3)}),
+            ScanRanges({{0, g_row_blocks_test_row_count}}));
+
+  const auto enable_cpu_sub_tasks = g_enable_cpu_sub_tasks;
+  const auto cpu_sub_task_size = g_cpu_sub_task_size;
+  ScopeGuard reset_sub_tasks = [enable_cpu_sub_tasks, cpu_sub_task_size] {
+    g_enable_cpu_sub_tasks = enable_cpu_sub_tasks;
+    g_cpu_sub_task_size = cpu_sub_task_size;
+  };
+  for (const bool enable_sub_tasks : {false, true}) {
+    g_enable_cpu_sub_tasks = enable_sub_tasks;
+    // Sub-tasks smaller than the blocks, so they get cut at the ends of scan ranges.
+    g_cpu_sub_task_size = 10000;
+    check_skip_row_blocks_filter("x >= 200000",
+                                 [](int64_t x, int64_t) { return x >= 200000; });
+    check_skip_row_blocks_filter(
+        "x < 1000 OR x >= 200000",
+        [](int64_t x, int64_t) { return x < 1000 || x >= 200000; });
+    check_skip_row_blocks_filter(
+        "x BETWEEN 70000 AND 140000 AND y = 3",
+        [](int64_t x, int64_t y) { return x >= 70000 && x <= 140000 && y == 3; });
+    check_skip_row_blocks_filter("x < 0", [](int64_t x, int64_t) { return x < 0; });
+    check_skip_row_blocks_filter("y = 3", [](int64_t, int64_t y) { return y == 3; });
+    const auto ids = get_ordered_ids(
+        "SELECT x FROM skip_row_blocks_test WHERE x >= 262100 OR x < 3 ORDER BY x "
+        "LIMIT 10 OFFSET 1;");
+    std::vector<int64_t> expected_ids{1, 2};
+    for (int64_t x = 262100; x < 262108; ++x) {
+      expected_ids.push_back(x);
+    }
+    EXPECT_EQ(ids, expected_ids) << "sub-tasks " << enable_sub_tasks;
+  }
+}
+
+namespace {
+
+// Replaces the keys of the build side of the runtime join filter tests.
+void import_skip_join_filters_inner(const std::vector<std::string>& keys) {
+  const std::string drop_inner{"DROP TABLE IF EXISTS skip_join_filters_inner;"};
+  run_ddl_statement(drop_inner);
+  g_sqlite_comparator.query(drop_inner);
+  const std::string create_inner{"CREATE TABLE skip_join_filters_inner (k INT);"};
+  run_ddl_statement(create_inner);
+  g_sqlite_comparator.query(create_inner);
+  for (const auto& key : keys) {
+    const auto insert_query = "INSERT INTO skip_join_filters_inner VALUES (" + key + ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+}
+
+// Runs the join, comparing its result with sqlite and checking the number of fragments
+// of the outer table it fetches. The inner table has a single fragment, always fetched
+// to build the hash table.
+void check_runtime_join_filter_query(const std::string& query,
+                                     const size_t num_outer_frags) {
+  QR::get()->clearCpuMemory();
+  c(query, ExecutorDeviceType::CPU);
+  const auto buffer_pool_stats =
+      QR::get()->getBufferPoolStats(Data_Namespace::MemoryLevel::CPU_LEVEL, true);
+  EXPECT_EQ(buffer_pool_stats.num_tables, size_t(num_outer_frags ? 2 : 1)) << query;
+  EXPECT_EQ(buffer_pool_stats.num_fragments, num_outer_frags + 1) << query;
+}
+
+}  // namespace
+
+TEST(Select, SkipFragmentsForRuntimeJoinFilters) {
+  SKIP_WITH_TEMP_TABLES();
+  SKIP_IF_SHARDED();
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto drop_tables = [] {
+    for (const auto& table : {"skip_join_filters_outer", "skip_join_filters_inner"}) {
+      const auto drop_table = "DROP TABLE IF EXISTS " + std::string(table) + ";";
+      run_ddl_statement(drop_table);
+      g_sqlite_comparator.query(drop_table);
+    }
+  };
+  ScopeGuard drop_tables_guard = [&drop_tables] { drop_tables(); };
+  ScopeGuard reset_runtime_join_filters = [orig = g_enable_runtime_join_filters] {
+    g_enable_runtime_join_filters = orig;
+  };
+  g_enable_runtime_join_filters = true;
+  drop_tables();
+  run_ddl_statement(
+      "CREATE TABLE skip_join_filters_outer (k INT, v INT) WITH (fragment_size = 4);");
+  g_sqlite_comparator.query("CREATE TABLE skip_join_filters_outer (k INT, v INT);");
+  // Fragment f holds the keys 10f, 10f + 2, 10f + 4 and a null, so it has gaps for the
+  // Bloom filter of its key chunk to tell.
+  for (int64_t id = 0; id < 16; ++id) {
+    const auto k = id % 4 == 3 ? std::string("NULL")
+                               : std::to_string(10 * (id / 4) + 2 * (id % 4));
+    const auto insert_query = "INSERT INTO skip_join_filters_outer VALUES (" + k +
+                              ", " + std::to_string(id) + ");";
+    run_multiple_agg(insert_query, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(insert_query);
+  }
+
+  const std::string inner_join{
+      "SELECT COUNT(*), SUM(o.v) FROM skip_join_filters_outer o, skip_join_filters_inner "
+      "i WHERE o.k = i.k;"};
+  const std::string left_join{
+      "SELECT COUNT(*), COUNT(i.k), SUM(o.v) FROM skip_join_filters_outer o LEFT JOIN "
+      "skip_join_filters_inner i ON o.k = i.k;"};
+  // Keys in the first and last fragments
+  import_skip_join_filters_inner({"2", "34"});
+  check_runtime_join_filter_query(inner_join, 2);
+  // Keys outside of the range of every fragment
+  import_skip_join_filters_inner({"5", "100"});
+  check_runtime_join_filter_query(inner_join, 0);
+  // A key in the range of the second fragment which only its Bloom filter rules out
+  import_skip_join_filters_inner({"13", "22"});
+  check_runtime_join_filter_query(inner_join, 1);
+  // Null keys, like the null outer ones, match no row
+  import_skip_join_filters_inner({"NULL", "12"});
+  check_runtime_join_filter_query(inner_join, 1);
+  // Every outer row is kept by left joins
+  import_skip_join_filters_inner({"2", "34"});
+  check_runtime_join_filter_query(left_join, 4);
+  g_enable_runtime_join_filters = false;
+  check_runtime_join_filter_query(inner_join, 4);
+}
+
+namespace {
+
+// Integer columns of the rows of the result, in their order.
+std::vector<std::vector<int64_t>> get_int_rows(const std::string& query) {
+  const auto rows = run_multiple_agg(query, ExecutorDeviceType::CPU);
+  std::vector<std::vector<int64_t>> int_rows;
+  for (auto row = rows->getNextRow(true, true); !row.empty();
+       row = rows->getNextRow(true, true)) {
+    std::vector<int64_t> int_row;
+    for (const auto& col : row) {
+      int_row.push_back(v<int64_t>(col));
+    }
+    int_rows.push_back(int_row);
+  }
+  return int_rows;
+}
+
+}  // namespace
+
+TEST(Select, CpuSubTasks) {
+  SKIP_ALL_ON_AGGREGATOR();
+
+  const auto enable_cpu_sub_tasks = g_enable_cpu_sub_tasks;
+  const auto cpu_sub_task_size = g_cpu_sub_task_size;
+  ScopeGuard reset_sub_tasks = [enable_cpu_sub_tasks, cpu_sub_task_size] {
+    g_enable_cpu_sub_tasks = enable_cpu_sub_tasks;
+    g_cpu_sub_task_size = cpu_sub_task_size;
+  };
+  // Fragments of test hold two rows, so each of them gets two sub-tasks.
+  g_cpu_sub_task_size = 1;
+  const std::vector<std::string> unordered_projections{
+      "SELECT x, y, t FROM test;",
+      "SELECT x, ofd, smallint_nulls FROM test WHERE ofd IS NULL OR y > 42;",
+      "SELECT y, x + t FROM test WHERE z > 0;"};
+  std::vector<std::vector<std::vector<int64_t>>> unordered_projection_rows;
+  g_enable_cpu_sub_tasks = false;
+  for (const auto& query : unordered_projections) {
+    unordered_projection_rows.push_back(get_int_rows(query));
+  }
+  for (const bool enable_sub_tasks : {false, true}) {
+    g_enable_cpu_sub_tasks = enable_sub_tasks;
+    const auto dt = ExecutorDeviceType::CPU;
+    // Projections keep the order of the rows without sub-tasks.
+    for (size_t i = 0; i < unordered_projections.size(); ++i) {
+      EXPECT_EQ(get_int_rows(unordered_projections[i]), unordered_projection_rows[i])
+          << unordered_projections[i] << ", sub-tasks " << enable_sub_tasks;
+    }
+    c("SELECT x, y, str FROM test ORDER BY x, y, str;", dt);
+    c("SELECT x, y, str FROM test ORDER BY x DESC, y, str LIMIT 5;", dt);
+    c("SELECT x, y, str FROM test ORDER BY x, y DESC, str LIMIT 4 OFFSET 3;", dt);
+    c("SELECT x, ofd FROM test WHERE ofd IS NOT NULL ORDER BY x, ofd OFFSET 2;",
+      "SELECT x, ofd FROM test WHERE ofd IS NOT NULL ORDER BY x, ofd LIMIT -1 OFFSET 2;",
+      dt);
+    c("SELECT x + y AS s FROM test WHERE y > 42 ORDER BY s LIMIT 100 OFFSET 1;", dt);
+    // Aggregates without group by over columns with nulls
+    c("SELECT COUNT(*), COUNT(ofd), SUM(ofd), MIN(ofd), MAX(ofd), AVG(ofd) FROM test;",
+      dt);
+    c("SELECT COUNT(smallint_nulls), SUM(smallint_nulls), MIN(smallint_nulls), "
+      "MAX(smallint_nulls), AVG(smallint_nulls) FROM test;",
+      dt);
+    c("SELECT COUNT(fn), SUM(fn), MIN(fn), MAX(fn), AVG(fn), COUNT(dn), SUM(dn), "
+      "MIN(dn), MAX(dn), AVG(dn) FROM test;",
+      dt);
+    c("SELECT COUNT(*), SUM(ofd), MIN(ofd), MAX(ofd), AVG(ofd) FROM test WHERE y > 42;",
+      dt);
+    c("SELECT COUNT(*), COUNT(ofd), SUM(ofd), MIN(ofd), MAX(ofd), AVG(ofd) FROM test "
+      "WHERE ofd IS NULL;",
+      dt);
+    c("SELECT COUNT(*), SUM(x), MIN(x), MAX(x), AVG(x) FROM test WHERE x < 0;", dt);
+  }
+}
+
 TEST(Select, UnsupportedNodes) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -20,6 +20,8 @@
  */
 
 #include <fstream>
+#include <numeric>
+#include <thread>
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
@@ -33,6 +35,10 @@
 
 namespace bf = boost::filesystem;
 
+extern bool g_enable_positional_file_io;
+extern bool g_enable_page_map_snapshot;
+extern size_t g_page_map_snapshot_checkpoint_interval;
+
 class FileInfoTest : public testing::Test {
  public:
   constexpr static const char* test_data_dir = "./test_dir";
@@ -839,6 +845,414 @@ TEST_F(FileMgrTest, buffer_append_and_recovery) {
   }
 }
 
+class PositionalFileIoTest : public FileMgrTest {
+ protected:
+  void SetUp() override {
+    g_enable_positional_file_io = true;
+    FileMgrTest::SetUp();
+  }
+
+  void TearDown() override {
+    FileMgrTest::TearDown();
+    g_enable_positional_file_io = false;
+  }
+};
+
+TEST_F(PositionalFileIoTest, MultiPageAppendAndRecovery) {
+  // Span several pages so that reads go through the multi-threaded preadv path.
+  const size_t num_elements = 3 * DEFAULT_PAGE_SIZE / sizeof(int32_t) + 7;
+  std::vector<int32_t> data(num_elements);
+  std::iota(data.begin(), data.end(), 0);
+  TestHelpers::TestBuffer source_buffer{SQLTypeInfo{kINT}};
+  appendData(&source_buffer, data);
+  {
+    auto file_mgr = getFileMgr();
+    AbstractBuffer* file_buffer =
+        file_mgr->putBuffer(TEST_CHUNK_KEY, &source_buffer, source_buffer.size());
+    file_mgr->checkpoint();
+    compareBuffersAndMetadata(&source_buffer, file_buffer);
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+  {
+    auto file_mgr = getFileMgr();
+    AbstractBuffer* file_buffer = file_mgr->getBuffer(TEST_CHUNK_KEY);
+    compareBuffersAndMetadata(&source_buffer, file_buffer);
+
+    // Read from an offset that does not start on a page boundary.
+    const size_t offset = DEFAULT_PAGE_SIZE + 3 * sizeof(int32_t);
+    const size_t num_bytes = source_buffer.size() - offset;
+    std::vector<int8_t> expected(num_bytes);
+    std::vector<int8_t> actual(num_bytes);
+    source_buffer.read(expected.data(), num_bytes, offset);
+    file_buffer->read(actual.data(), num_bytes, offset);
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+TEST_F(FileMgrTest, fetchBuffers_batch) {
+  const size_t num_elements = 2 * DEFAULT_PAGE_SIZE / sizeof(int32_t) + 11;
+  std::vector<int32_t> data(num_elements);
+  std::iota(data.begin(), data.end(), 0);
+  std::vector<ChunkKey> keys{{1, 1, 2, 0}, {1, 1, 3, 0}};
+  std::vector<std::unique_ptr<TestHelpers::TestBuffer>> source_buffers;
+  auto file_mgr = getFileMgr();
+  for (const auto& key : keys) {
+    source_buffers.emplace_back(
+        std::make_unique<TestHelpers::TestBuffer>(SQLTypeInfo{kINT}));
+    appendData(source_buffers.back().get(), data);
+    std::reverse(data.begin(), data.end());
+    file_mgr->putBuffer(key, source_buffers.back().get());
+  }
+  file_mgr->checkpoint();
+
+  std::vector<std::unique_ptr<TestHelpers::TestBuffer>> dest_buffers;
+  std::vector<AbstractBuffer*> dest_buffer_ptrs;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    dest_buffers.emplace_back(
+        std::make_unique<TestHelpers::TestBuffer>(SQLTypeInfo{kINT}));
+    dest_buffer_ptrs.emplace_back(dest_buffers.back().get());
+  }
+  file_mgr->fetchBuffers(keys, dest_buffer_ptrs, std::vector<size_t>(keys.size(), 0));
+  for (size_t i = 0; i < keys.size(); ++i) {
+    compareBuffersAndMetadata(source_buffers[i].get(), dest_buffers[i].get());
+  }
+}
+
+TEST_F(FileMgrTest, storage_compression_update_and_recovery) {
+  File_Namespace::FileMgrParams file_mgr_params;
+  file_mgr_params.storage_compression = "lz4";
+  global_file_mgr_->setFileMgrParams(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                     TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX],
+                                     file_mgr_params);
+  // Three full pages of low entropy values and a partial tail page.
+  const size_t num_elements = 3 * DEFAULT_PAGE_SIZE / sizeof(int32_t) + 5;
+  std::vector<int32_t> data(num_elements);
+  for (size_t i = 0; i < num_elements; ++i) {
+    data[i] = 1000 + static_cast<int32_t>(i / 64);
+  }
+  TestHelpers::TestBuffer source_buffer{SQLTypeInfo{kINT}};
+  appendData(&source_buffer, data);
+  {
+    auto file_mgr = getFileMgr();
+    auto file_buffer =
+        file_mgr->putBuffer(TEST_CHUNK_KEY, &source_buffer, source_buffer.size());
+    file_mgr->checkpoint();
+    const auto multi_pages = file_buffer->getMultiPage();
+    ASSERT_EQ(multi_pages.size(), 4U);
+    for (size_t page_num = 0; page_num < multi_pages.size(); ++page_num) {
+      const auto page = multi_pages[page_num].current().page;
+      const auto file_page_size = file_mgr->getFileInfoForFileId(page.fileId)->pageSize;
+      if (page_num < 3) {
+        EXPECT_LT(file_page_size, size_t(DEFAULT_PAGE_SIZE));
+      } else {
+        EXPECT_EQ(file_page_size, size_t(DEFAULT_PAGE_SIZE));
+      }
+    }
+    compareBuffersAndMetadata(&source_buffer, file_buffer);
+
+    // Overwrite a range straddling the first two compressed pages.
+    const size_t offset = DEFAULT_PAGE_SIZE - 64;
+    std::vector<int32_t> update(64, -1);
+    file_buffer->write(reinterpret_cast<int8_t*>(update.data()),
+                       update.size() * sizeof(int32_t),
+                       offset);
+    std::memcpy(reinterpret_cast<int8_t*>(data.data()) + offset,
+                update.data(),
+                update.size() * sizeof(int32_t));
+    file_mgr->checkpoint();
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+  {
+    // Compressed pages are self-describing, the setting is not needed to read them.
+    auto file_mgr = getFileMgr();
+    AbstractBuffer* file_buffer = file_mgr->getBuffer(TEST_CHUNK_KEY);
+    std::vector<int32_t> actual(num_elements);
+    file_buffer->read(reinterpret_cast<int8_t*>(actual.data()),
+                      num_elements * sizeof(int32_t));
+    EXPECT_EQ(data, actual);
+  }
+}
+
+class PageMapSnapshotTest : public FileMgrTest {
+ protected:
+  void SetUp() override {
+    g_enable_page_map_snapshot = true;
+    FileMgrTest::SetUp();
+  }
+
+  void TearDown() override {
+    FileMgrTest::TearDown();
+    g_enable_page_map_snapshot = false;
+    g_page_map_snapshot_checkpoint_interval = 0;
+  }
+
+  bf::path getSnapshotPath() {
+    return bf::path(getFileMgr()->getFileMgrBasePath()) /
+           File_Namespace::FileMgr::PAGE_MAP_SNAPSHOT_FILENAME;
+  }
+
+  void closeFileMgr() {
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+
+  // Appends to the chunk written by SetUp() in two checkpoints.
+  void writeTwoVersions(TestHelpers::TestBuffer& source_buffer) {
+    auto file_mgr = getFileMgr();
+    for (int32_t version = 0; version < 2; ++version) {
+      std::vector<int32_t> data(DEFAULT_PAGE_SIZE / sizeof(int32_t) + 3, version);
+      appendData(&source_buffer, data);
+      file_mgr->putBuffer(TEST_CHUNK_KEY, &source_buffer, source_buffer.size());
+      file_mgr->checkpoint();
+    }
+  }
+};
+
+TEST_F(PageMapSnapshotTest, RecoverFromSnapshot) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  const auto snapshot_path = getSnapshotPath();
+  // Checkpoints do not write snapshots, closing the table does.
+  EXPECT_FALSE(bf::exists(snapshot_path));
+  const auto epoch = getFileMgr()->lastCheckpointedEpoch();
+  closeFileMgr();
+  ASSERT_TRUE(bf::exists(snapshot_path));
+  {
+    auto file_mgr = getFileMgr();
+    EXPECT_EQ(file_mgr->lastCheckpointedEpoch(), epoch);
+    auto file_buffer = file_mgr->getBuffer(TEST_CHUNK_KEY);
+    compareBuffersAndMetadata(&source_buffer, file_buffer);
+    EXPECT_EQ(file_mgr->getNumUsedMetadataPagesForChunkKey(TEST_CHUNK_KEY), 3U);
+
+    // The snapshot goes away with the first page change and is rewritten when the
+    // table is closed.
+    std::vector<int32_t> data{4, 5, 6};
+    appendData(file_buffer, data);
+    appendData(&source_buffer, data);
+    EXPECT_FALSE(bf::exists(snapshot_path));
+    file_mgr->checkpoint();
+    EXPECT_FALSE(bf::exists(snapshot_path));
+    closeFileMgr();
+    EXPECT_TRUE(bf::exists(snapshot_path));
+  }
+  {
+    auto file_mgr = getFileMgr();
+    compareBuffersAndMetadata(&source_buffer, file_mgr->getBuffer(TEST_CHUNK_KEY));
+  }
+}
+
+TEST_F(PageMapSnapshotTest, NoSnapshotOnCloseWithUncheckpointedPages) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  std::vector<int32_t> data(DEFAULT_PAGE_SIZE / sizeof(int32_t), 7);
+  appendData(&source_buffer, data);
+  getFileMgr()->putBuffer(TEST_CHUNK_KEY, &source_buffer, source_buffer.size());
+  closeFileMgr();
+  EXPECT_FALSE(bf::exists(getSnapshotPath()));
+}
+
+TEST_F(PageMapSnapshotTest, CheckpointInterval) {
+  g_page_map_snapshot_checkpoint_interval = 2;
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  auto file_mgr = getFileMgr();
+  const auto snapshot_path = getSnapshotPath();
+  for (int32_t version = 1; version <= 4; ++version) {
+    std::vector<int32_t> data(DEFAULT_PAGE_SIZE / sizeof(int32_t) + 3, version);
+    appendData(&source_buffer, data);
+    file_mgr->putBuffer(TEST_CHUNK_KEY, &source_buffer, source_buffer.size());
+    EXPECT_FALSE(bf::exists(snapshot_path));
+    file_mgr->checkpoint();
+    EXPECT_EQ(bf::exists(snapshot_path), version % 2 == 0) << version;
+  }
+  closeFileMgr();
+  compareBuffersAndMetadata(&source_buffer, getFileMgr()->getBuffer(TEST_CHUNK_KEY));
+}
+
+TEST_F(PageMapSnapshotTest, CorruptSnapshotFallsBackToHeaderScan) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  const auto snapshot_path = getSnapshotPath();
+  closeFileMgr();
+  {
+    std::fstream snapshot(snapshot_path.string(),
+                          std::ios::in | std::ios::out | std::ios::binary);
+    const auto offset = bf::file_size(snapshot_path) / 2;
+    snapshot.seekg(offset);
+    const char byte = snapshot.get();
+    snapshot.seekp(offset);
+    snapshot.put(~byte);
+  }
+  {
+    auto file_mgr = getFileMgr();
+    EXPECT_FALSE(bf::exists(snapshot_path));
+    compareBuffersAndMetadata(&source_buffer, file_mgr->getBuffer(TEST_CHUNK_KEY));
+  }
+}
+
+TEST_F(PageMapSnapshotTest, StaleSnapshotAfterRollback) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  const auto epoch = getFileMgr()->lastCheckpointedEpoch();
+  closeFileMgr();
+  global_file_mgr_->setTableEpoch(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                  TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX],
+                                  epoch - 1);
+  auto file_mgr = getFileMgr();
+  EXPECT_EQ(file_mgr->getNumUsedMetadataPagesForChunkKey(TEST_CHUNK_KEY), 2U);
+  EXPECT_FALSE(bf::exists(getSnapshotPath()));
+}
+
+class WriteAheadLogTest : public FileMgrTest {
+ protected:
+  void SetUp() override {
+    g_enable_write_ahead_log = true;
+    FileMgrTest::SetUp();
+  }
+
+  void TearDown() override {
+    global_file_mgr_.reset();
+    FileMgrTest::TearDown();
+    g_enable_write_ahead_log = false;
+    g_write_ahead_log_max_bytes = default_max_bytes_;
+  }
+
+  void closeFileMgr() {
+    global_file_mgr_->closeFileMgr(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                   TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX]);
+  }
+
+  using FileMgrTest::getFileMgr;
+
+  // Opens the data directory the way a restart after a crash does, while checkpoints
+  // of global_file_mgr_ may still only be durable in the log.
+  std::unique_ptr<File_Namespace::GlobalFileMgr> openAfterCrash() {
+    return std::make_unique<File_Namespace::GlobalFileMgr>(
+        0, std::make_shared<ForeignStorageInterface>(), TEST_DATA_DIR, 0);
+  }
+
+  static File_Namespace::FileMgr* getFileMgr(File_Namespace::GlobalFileMgr* gfm,
+                                             const ChunkKey& chunk_key) {
+    return dynamic_cast<File_Namespace::FileMgr*>(
+        gfm->getFileMgr(chunk_key[CHUNK_KEY_DB_IDX], chunk_key[CHUNK_KEY_TABLE_IDX]));
+  }
+
+  void writeTwoVersions(TestHelpers::TestBuffer& source_buffer,
+                        const ChunkKey& chunk_key = TEST_CHUNK_KEY) {
+    auto file_mgr = getFileMgr(global_file_mgr_.get(), chunk_key);
+    for (int32_t version = 0; version < 2; ++version) {
+      std::vector<int32_t> data(DEFAULT_PAGE_SIZE / sizeof(int32_t) + 3, version);
+      appendData(&source_buffer, data);
+      file_mgr->putBuffer(chunk_key, &source_buffer, source_buffer.size());
+      file_mgr->checkpoint();
+    }
+  }
+
+  const size_t default_max_bytes_{g_write_ahead_log_max_bytes};
+};
+
+TEST_F(WriteAheadLogTest, RecoverLoggedCheckpoints) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  // The checkpoints are only durable through the log.
+  EXPECT_FALSE(global_file_mgr_->getWriteAheadLog()->empty());
+  const auto epoch = getFileMgr()->lastCheckpointedEpoch();
+  auto recovered_gfm = openAfterCrash();
+  EXPECT_TRUE(recovered_gfm->getWriteAheadLog()->empty());
+  auto file_mgr = getFileMgr(recovered_gfm.get(), TEST_CHUNK_KEY);
+  EXPECT_EQ(file_mgr->lastCheckpointedEpoch(), epoch);
+  compareBuffersAndMetadata(&source_buffer, file_mgr->getBuffer(TEST_CHUNK_KEY));
+  EXPECT_EQ(file_mgr->getNumUsedMetadataPagesForChunkKey(TEST_CHUNK_KEY), 3U);
+}
+
+TEST_F(WriteAheadLogTest, FullCheckpointWhenLogIsFull) {
+  g_write_ahead_log_max_bytes = 0;
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  EXPECT_TRUE(global_file_mgr_->getWriteAheadLog()->empty());
+  const auto epoch = getFileMgr()->lastCheckpointedEpoch();
+  auto recovered_gfm = openAfterCrash();
+  auto file_mgr = getFileMgr(recovered_gfm.get(), TEST_CHUNK_KEY);
+  EXPECT_EQ(file_mgr->lastCheckpointedEpoch(), epoch);
+  compareBuffersAndMetadata(&source_buffer, file_mgr->getBuffer(TEST_CHUNK_KEY));
+}
+
+TEST_F(WriteAheadLogTest, RollbackDiscardsLoggedCheckpoints) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  const auto epoch = getFileMgr()->lastCheckpointedEpoch();
+  closeFileMgr();
+  global_file_mgr_->setTableEpoch(TEST_CHUNK_KEY[CHUNK_KEY_DB_IDX],
+                                  TEST_CHUNK_KEY[CHUNK_KEY_TABLE_IDX],
+                                  epoch - 1);
+  EXPECT_TRUE(global_file_mgr_->getWriteAheadLog()->empty());
+  auto recovered_gfm = openAfterCrash();
+  auto file_mgr = getFileMgr(recovered_gfm.get(), TEST_CHUNK_KEY);
+  EXPECT_EQ(file_mgr->lastCheckpointedEpoch(), epoch - 1);
+  EXPECT_EQ(file_mgr->getNumUsedMetadataPagesForChunkKey(TEST_CHUNK_KEY), 2U);
+}
+
+TEST_F(WriteAheadLogTest, FlushedTableSkipsOlderRecords) {
+  TestHelpers::TestBuffer source_buffer{std::vector<int32_t>{1}};
+  writeTwoVersions(source_buffer);
+  // Closing the table flushes it, while its records stay in the log shared with other
+  // tables.
+  closeFileMgr();
+  EXPECT_FALSE(global_file_mgr_->getWriteAheadLog()->empty());
+  auto file_mgr = getFileMgr();
+  const auto epoch = file_mgr->lastCheckpointedEpoch();
+  auto recovered_gfm = openAfterCrash();
+  file_mgr = getFileMgr(recovered_gfm.get(), TEST_CHUNK_KEY);
+  EXPECT_EQ(file_mgr->lastCheckpointedEpoch(), epoch);
+  compareBuffersAndMetadata(&source_buffer, file_mgr->getBuffer(TEST_CHUNK_KEY));
+}
+
+TEST_F(WriteAheadLogTest, ConcurrentCheckpointsShareSync) {
+  constexpr size_t num_tables{4};
+  std::vector<ChunkKey> chunk_keys;
+  std::vector<std::unique_ptr<TestHelpers::TestBuffer>> source_buffers;
+  for (size_t i = 0; i < num_tables; ++i) {
+    chunk_keys.emplace_back(ChunkKey{1, 2 + static_cast<int32_t>(i), 1, 0});
+    source_buffers.emplace_back(std::make_unique<TestHelpers::TestBuffer>(
+        std::vector<int32_t>{static_cast<int32_t>(i)}));
+    std::vector<int32_t> data(DEFAULT_PAGE_SIZE / sizeof(int32_t) + 3, i);
+    appendData(source_buffers[i].get(), data);
+    getFileMgr(global_file_mgr_.get(), chunk_keys[i])
+        ->putBuffer(chunk_keys[i], source_buffers[i].get(), source_buffers[i]->size());
+  }
+
+  auto write_ahead_log = global_file_mgr_->getWriteAheadLog();
+  const auto num_records = write_ahead_log->getNumRecords();
+  const auto num_syncs = write_ahead_log->getNumSyncs();
+  write_ahead_log->setBeforeSyncHook([&] {
+    // Hold the first sync until all tables appended their record. The first committer
+    // only syncs its own record, the next one syncs all the others.
+    while (write_ahead_log->getNumRecords() < num_records + num_tables) {
+      std::this_thread::yield();
+    }
+  });
+  std::vector<std::thread> checkpoint_threads;
+  for (const auto& chunk_key : chunk_keys) {
+    checkpoint_threads.emplace_back([this, &chunk_key] {
+      getFileMgr(global_file_mgr_.get(), chunk_key)->checkpoint();
+    });
+  }
+  for (auto& checkpoint_thread : checkpoint_threads) {
+    checkpoint_thread.join();
+  }
+  write_ahead_log->setBeforeSyncHook(nullptr);
+  EXPECT_EQ(write_ahead_log->getNumRecords(), num_records + num_tables);
+  EXPECT_EQ(write_ahead_log->getNumSyncs(), num_syncs + 2);
+
+  auto recovered_gfm = openAfterCrash();
+  for (size_t i = 0; i < num_tables; ++i) {
+    compareBuffersAndMetadata(
+        source_buffers[i].get(),
+        getFileMgr(recovered_gfm.get(), chunk_keys[i])->getBuffer(chunk_keys[i]));
+  }
+}
+
 TEST_F(FileMgrTest, buffer_update_and_recovery) {
   std::vector<int32_t> data_v1 = {
       2,
@@ -1274,6 +1688,33 @@ TEST_F(DataCompactionTest, MultipleChunksPerFile) {
   assertBufferValueAndMetadata(4, 2);
 }
 
+TEST_F(DataCompactionTest, IncrementalCompaction) {
+  File_Namespace::FileMgr::setNumPagesPerDataFile(4);
+
+  auto buffer_1 = createBuffer(1);
+  auto buffer_2 = createBuffer(2);
+  writeValue(buffer_1, 1);
+  writeMultipleValues(buffer_2, 1, 4);
+  setMaxRollbackEpochs(0);
+  assertStorageStats(1, 4094, 2, 6);
+
+  // A single pass moves the page of the last data file and deletes the file
+  auto file_mgr = getFileMgr();
+  EXPECT_GT(file_mgr->compactFilesIncrementally(1), size_t(0));
+  assertStorageStats(1, 4094, 1, 2);
+  assertBufferValueAndMetadata(1, 1);
+  assertBufferValueAndMetadata(4, 2);
+
+  // Nothing is left to compact
+  EXPECT_EQ(file_mgr->compactFilesIncrementally(1), size_t(0));
+
+  // Moved pages are found on restart
+  deleteFileMgr();
+  assertStorageStats(1, 4094, 1, 2);
+  assertBufferValueAndMetadata(1, 1);
+  assertBufferValueAndMetadata(4, 2);
+}
+
 TEST_F(DataCompactionTest, SourceFilePagesCopiedOverMultipleDestinationFiles) {
   File_Namespace::FileMgr::setNumPagesPerDataFile(4);
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 HEAVY.AI, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "OSDependent/heavyai_numa.h"
+#include "QueryEngine/NumaKernelScheduler.h"
+#include "Shared/thread_count.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#ifndef _WIN32
+class NumaNodeDetectionTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    node_dir_ = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("numa_node_test_%%%%-%%%%");
+    boost::filesystem::create_directories(node_dir_);
+  }
+
+  void TearDown() override { boost::filesystem::remove_all(node_dir_); }
+
+  void writeNodeCpuList(const size_t node, const std::string& cpu_list) {
+    const auto dir = node_dir_ / ("node" + std::to_string(node));
+    boost::filesystem::create_directories(dir);
+    std::ofstream((dir / "cpulist").string()) << cpu_list << "\n";
+  }
+
+  std::vector<std::vector<int>> readNodeCpus(const size_t num_online_cpus) {
+    return heavyai::read_numa_node_cpus(node_dir_.string(), num_online_cpus);
+  }
+
+  boost::filesystem::path node_dir_;
+};
+
+TEST_F(NumaNodeDetectionTest, ReadsNodeCpuLists) {
+  writeNodeCpuList(0, "0-3");
+  writeNodeCpuList(1, "4-5,8");
+  std::vector<std::vector<int>> expected{{0, 1, 2, 3}, {4, 5, 8}};
+  EXPECT_EQ(readNodeCpus(16), expected);
+}
+
+TEST_F(NumaNodeDetectionTest, FallsBackWithoutNodeDirectory) {
+  boost::filesystem::remove_all(node_dir_);
+  std::vector<std::vector<int>> expected{{0, 1, 2}};
+  EXPECT_EQ(readNodeCpus(3), expected);
+}
+
+TEST_F(NumaNodeDetectionTest, FallsBackOnNodeWithoutCpus) {
+  writeNodeCpuList(0, "0-1");
+  writeNodeCpuList(1, "");
+  std::vector<std::vector<int>> expected{{0, 1, 2, 3}};
+  EXPECT_EQ(readNodeCpus(4), expected);
+}
+
+TEST_F(NumaNodeDetectionTest, FallsBackOnMalformedCpuList) {
+  writeNodeCpuList(0, "0-x");
+  std::vector<std::vector<int>> expected{{0, 1}};
+  EXPECT_EQ(readNodeCpus(2), expected);
+}
+
+TEST_F(NumaNodeDetectionTest, FallsBackToOneCpu) {
+  boost::filesystem::remove_all(node_dir_);
+  std::vector<std::vector<int>> expected{{0}};
+  EXPECT_EQ(readNodeCpus(0), expected);
+}
+#endif  // _WIN32
+
+TEST(NumaKernelAssignmentTest, KeepsKernelsOnHomeNode) {
+  const auto node_kernels = assign_kernels_to_numa_nodes({1, 0, 1, 3}, 2);
+  std::vector<std::vector<size_t>> expected{{1}, {0, 2, 3}};
+  EXPECT_EQ(node_kernels, expected);
+}
+
+TEST(NumaKernelAssignmentTest, SpreadsKernelsWithoutHomeNode) {
+  const auto node_kernels =
+      assign_kernels_to_numa_nodes({0, std::nullopt, std::nullopt, std::nullopt, 1}, 2);
+  std::vector<std::vector<size_t>> expected{{0, 1, 3}, {2, 4}};
+  EXPECT_EQ(node_kernels, expected);
+}
+
+TEST(NumaKernelAssignmentTest, SingleNode) {
+  const auto node_kernels = assign_kernels_to_numa_nodes({std::nullopt, 2, 0}, 1);
+  std::vector<std::vector<size_t>> expected{{0, 1, 2}};
+  EXPECT_EQ(node_kernels, expected);
+}
+
+TEST(NumaKernelAssignmentTest, NoKernels) {
+  const auto node_kernels = assign_kernels_to_numa_nodes({}, 3);
+  EXPECT_EQ(node_kernels, std::vector<std::vector<size_t>>(3));
+}
+
+class NumaNodeConcurrencyTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    cpu_threads_override_ = g_cpu_threads_override;
+    num_executors_ = g_num_executors;
+  }
+
+  void TearDown() override {
+    g_cpu_threads_override = cpu_threads_override_;
+    g_num_executors = num_executors_;
+  }
+
+  unsigned cpu_threads_override_;
+  size_t num_executors_;
+};
+
+TEST_F(NumaNodeConcurrencyTest, CappedPerExecutor) {
+  g_cpu_threads_override = 8;
+  g_num_executors = 2;
+  EXPECT_EQ(get_numa_node_max_concurrency(16), size_t(4));
+  EXPECT_EQ(get_numa_node_max_concurrency(2), size_t(2));
+}
+
+TEST_F(NumaNodeConcurrencyTest, SingleExecutor) {
+  g_cpu_threads_override = 8;
+  g_num_executors = 1;
+  EXPECT_EQ(get_numa_node_max_concurrency(16), size_t(8));
+  EXPECT_EQ(get_numa_node_max_concurrency(4), size_t(4));
+}
+
+TEST_F(NumaNodeConcurrencyTest, AtLeastOneWorker) {
+  g_cpu_threads_override = 2;
+  g_num_executors = 4;
+  EXPECT_EQ(get_numa_node_max_concurrency(16), size_t(1));
+  g_num_executors = 0;
+  EXPECT_EQ(get_numa_node_max_concurrency(1), size_t(1));
+}
+
+#ifdef HAVE_TBB
+TEST(NumaKernelSchedulerTest, RunsEveryKernelOnce) {
+  constexpr size_t num_kernels = 64;
+  std::vector<std::optional<size_t>> kernel_numa_nodes;
+  for (size_t i = 0; i < num_kernels; ++i) {
+    kernel_numa_nodes.emplace_back(i % 3 ? std::optional<size_t>(i) : std::nullopt);
+  }
+  std::vector<std::atomic<int>> runs(num_kernels);
+  for (auto& run : runs) {
+    run = 0;
+  }
+  run_kernels_on_numa_nodes(kernel_numa_nodes,
+                            [&](const size_t kernel_idx) { ++runs[kernel_idx]; });
+  for (size_t i = 0; i < num_kernels; ++i) {
+    EXPECT_EQ(runs[i], 1) << "kernel " << i;
+  }
+}
+
+TEST(NumaKernelSchedulerTest, RethrowsKernelException) {
+  std::vector<std::optional<size_t>> kernel_numa_nodes(16, std::nullopt);
+  EXPECT_THROW(run_kernels_on_numa_nodes(kernel_numa_nodes,
+                                         [](const size_t kernel_idx) {
+                                           if (kernel_idx == 7) {
+                                             throw std::runtime_error("kernel failed");
+                                           }
+                                         }),
+               std::runtime_error);
+}
+#endif  // HAVE_TBB
+
+int main(int argc, char* argv[]) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  return err;
+}
@@ -24,10 +24,12 @@
 
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
 #include "QueryEngine/Execute.h"
+#include "QueryEngine/GroupByBufferPool.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionary.h"
 #include "Tests/TestHelpers.h"
 
@@ -35,6 +37,11 @@
 #include <algorithm>
 #include <queue>
 #include <random>
+#include <thread>
+
+#ifdef HAVE_TBB
+#include <tbb/parallel_for.h>
+#endif
 
 #ifndef BASE_PATH
 #define BASE_PATH "./tmp"
@@ -72,6 +79,101 @@ TEST(Construct, Allocate) {
   result_set.allocateStorage();
 }
 
+TEST(Construct, ThreadIndexedAllocate) {
+  constexpr size_t num_threads{4};
+  constexpr size_t num_allocations{1000};
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize(), num_threads);
+  std::vector<std::thread> threads;
+  // One allocator per kernel thread plus one for index 0 callers.
+  std::vector<char> valid(num_threads + 1, false);
+  for (size_t thread_idx = 0; thread_idx <= num_threads; ++thread_idx) {
+    threads.emplace_back([&, thread_idx] {
+      bool thread_valid = true;
+      for (size_t i = 0; i < num_allocations; ++i) {
+        auto buffer = row_set_mem_owner->allocateCountDistinctBuffer(64, thread_idx);
+        thread_valid &= std::all_of(buffer, buffer + 64, [](int8_t b) { return b == 0; });
+        std::memset(buffer, 0xFF, 64);
+        const auto str = std::to_string(thread_idx) + "_" + std::to_string(i);
+        thread_valid &= *row_set_mem_owner->addString(str, thread_idx) == str;
+      }
+      valid[thread_idx] = thread_valid;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t thread_idx = 0; thread_idx <= num_threads; ++thread_idx) {
+    EXPECT_TRUE(valid[thread_idx]);
+  }
+}
+
+#ifdef HAVE_TBB
+TEST(Construct, WorkerThreadIdx) {
+  constexpr size_t num_threads{4};
+  constexpr size_t num_strings{1000};
+  auto row_set_mem_owner =
+      std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize(), num_threads);
+  EXPECT_EQ(row_set_mem_owner->getCurrentThreadIdx(), size_t(0));
+  std::vector<std::string*> strings(num_strings);
+  tbb::parallel_for(size_t(0), num_strings, [&](const size_t i) {
+    const auto thread_idx = row_set_mem_owner->getCurrentThreadIdx();
+    ASSERT_LE(thread_idx, num_threads);
+    strings[i] = row_set_mem_owner->addString(std::to_string(i), thread_idx);
+  });
+  for (size_t i = 0; i < num_strings; ++i) {
+    EXPECT_EQ(*strings[i], std::to_string(i));
+  }
+}
+#endif  // HAVE_TBB
+
+TEST(GroupByBufferPool, ReusesInitializedBuffers) {
+  constexpr size_t num_bytes{GroupByBufferPool::kMinBufferBytes};
+  ScopeGuard reset_pool_size = [pool_size = g_group_by_buffer_pool_size] {
+    GroupByBufferPool::instance().clear();
+    g_group_by_buffer_pool_size = pool_size;
+  };
+  g_group_by_buffer_pool_size = 4 * num_bytes;
+  auto& pool = GroupByBufferPool::instance();
+  pool.clear();
+
+  size_t num_inits{0};
+  const auto init_buffer = [&num_inits](int8_t* buffer) {
+    std::memset(buffer, 42, num_bytes);
+    ++num_inits;
+  };
+  const auto is_initialized = [](const int8_t* buffer) {
+    return std::all_of(buffer, buffer + num_bytes, [](int8_t b) { return b == 42; });
+  };
+
+  auto buffer = pool.acquire("layout_a", num_bytes, init_buffer);
+  ASSERT_TRUE(buffer);
+  EXPECT_TRUE(is_initialized(buffer));
+  std::memset(buffer, 0, num_bytes);
+  pool.release(buffer);
+  pool.drain();
+  // The released buffer was reset from the template and is handed out again.
+  auto reused_buffer = pool.acquire("layout_a", num_bytes, init_buffer);
+  EXPECT_EQ(reused_buffer, buffer);
+  buffer = reused_buffer;
+  ASSERT_TRUE(buffer);
+  EXPECT_TRUE(is_initialized(buffer));
+  EXPECT_EQ(num_inits, size_t(1));
+
+  // A new layout needs a template and a buffer, the idle memory of layout_a is evicted.
+  auto other_buffer = pool.acquire("layout_b", num_bytes, init_buffer);
+  ASSERT_TRUE(other_buffer);
+  EXPECT_TRUE(is_initialized(other_buffer));
+  EXPECT_LE(pool.getPoolBytes(), g_group_by_buffer_pool_size);
+  EXPECT_FALSE(pool.acquire("layout_c", 8 * num_bytes, init_buffer));
+
+  pool.release(buffer);
+  pool.release(other_buffer);
+  pool.drain();
+  pool.clear();
+  EXPECT_EQ(pool.getPoolBytes(), size_t(0));
+}
+
 namespace {
 
 using OneRow = std::vector<TargetValue>;
@@ -16,6 +16,9 @@
 
 #include <csignal>
 #include <cstdlib>
+#include <functional>
+#include <map>
+#include <optional>
 
 #include <gtest/gtest.h>
 
@@ -1182,6 +1185,233 @@ TEST_F(TableWithImmediateVacuumTest, FixedLenColumnUpdate) {
   sqlAndCompareResult("select * from test_table;", 2, "a");
 }
 
+// Block encoded column of the tests below, values are written as literals of base + x,
+// after string_prefix for string columns.
+struct BlockEncodedColumnParam {
+  std::string name;
+  std::string column_type;
+  int64_t base;
+  bool is_string;
+  // none encoded strings can't be grouped by
+  bool is_dict_encoded{true};
+  std::string string_prefix{"str"};
+};
+
+// Runs filters, updates, deletes and vacuums over a block encoded column spread over
+// several fragments, checking the column against the rows it was given.
+class BlockEncodedColumnTest : public ::testing::TestWithParam<BlockEncodedColumnParam> {
+ protected:
+  void SetUp() override {
+    run_ddl_statement("drop table if exists test_table;");
+    run_ddl_statement("create table test_table (id int, v " + GetParam().column_type +
+                      ") with (fragment_size = 8);");
+    insertRows(0, 50);
+  }
+
+  void TearDown() override { run_ddl_statement("drop table if exists test_table;"); }
+
+  std::string literal(const std::optional<int64_t>& x) const {
+    if (!x) {
+      return "NULL";
+    }
+    const auto val = std::to_string(GetParam().base + *x);
+    return GetParam().is_string ? "'" + GetParam().string_prefix + val + "'" : val;
+  }
+
+  // Runs of four rows, one row in seven is null.
+  void insertRows(const int64_t start_id, const int64_t num_rows) {
+    for (int64_t id = start_id; id < start_id + num_rows; ++id) {
+      const auto x = id % 7 == 3 ? std::nullopt : std::optional<int64_t>(id / 4 % 5 - 2);
+      run_query("insert into test_table values (" + std::to_string(id) + ", " +
+                literal(x) + ");");
+      rows_[id] = x;
+    }
+  }
+
+  void update(const std::optional<int64_t>& x,
+              const std::string& cond,
+              const std::function<bool(int64_t)>& matches) {
+    run_query("update test_table set v = " + literal(x) + " where " + cond + ";");
+    for (auto& [id, row_x] : rows_) {
+      if (matches(id)) {
+        row_x = x;
+      }
+    }
+  }
+
+  void remove(const std::string& cond, const std::function<bool(int64_t)>& matches) {
+    run_query("delete from test_table where " + cond + ";");
+    for (auto it = rows_.begin(); it != rows_.end();) {
+      it = matches(it->first) ? rows_.erase(it) : std::next(it);
+    }
+  }
+
+  std::string value(const TargetValue& r) const {
+    if (GetParam().is_string) {
+      return boost::get<std::string>(
+          boost::get<NullableString>(boost::get<ScalarTargetValue>(r)));
+    }
+    return std::to_string(v<int64_t>(r));
+  }
+
+  std::string expectedValue(const int64_t x) const {
+    const auto val = std::to_string(GetParam().base + x);
+    return GetParam().is_string ? GetParam().string_prefix + val : val;
+  }
+
+  int64_t count(const std::string& cond) const {
+    auto rows = run_query("select count(*) from test_table where " + cond + ";");
+    return v<int64_t>(rows->getNextRow(true, true)[0]);
+  }
+
+  // Unfiltered aggregates, which are computed from the runs of run length encoded
+  // columns.
+  void assertAggregatesMatch(const int64_t num_values) {
+    auto rows = run_query("select count(*), count(v) from test_table;");
+    auto row = rows->getNextRow(true, true);
+    ASSERT_EQ(v<int64_t>(row[0]), int64_t(rows_.size()));
+    ASSERT_EQ(v<int64_t>(row[1]), num_values);
+    if (GetParam().is_string || !num_values) {
+      return;
+    }
+    std::optional<int64_t> min_x;
+    std::optional<int64_t> max_x;
+    int64_t sum_x{0};
+    for (const auto& [id, x] : rows_) {
+      if (x) {
+        min_x = std::min(min_x.value_or(*x), *x);
+        max_x = std::max(max_x.value_or(*x), *x);
+        sum_x += *x;
+      }
+    }
+    rows = run_query("select min(v), max(v) from test_table;");
+    row = rows->getNextRow(true, true);
+    ASSERT_EQ(value(row[0]), expectedValue(*min_x));
+    ASSERT_EQ(value(row[1]), expectedValue(*max_x));
+    // the sums of the largest bases would overflow
+    if (std::abs(GetParam().base) <= (1LL << 50)) {
+      rows = run_query("select sum(v) from test_table;");
+      row = rows->getNextRow(true, true);
+      ASSERT_EQ(v<int64_t>(row[0]), GetParam().base * num_values + sum_x);
+    }
+  }
+
+  void assertTableMatches() {
+    auto rows =
+        run_query("select id, v from test_table where v is not null order by id;");
+    for (const auto& [id, x] : rows_) {
+      if (!x) {
+        continue;
+      }
+      const auto row = rows->getNextRow(true, true);
+      ASSERT_EQ(row.size(), size_t(2));
+      ASSERT_EQ(v<int64_t>(row[0]), id);
+      ASSERT_EQ(value(row[1]), expectedValue(*x)) << id;
+    }
+    ASSERT_TRUE(rows->getNextRow(true, true).empty());
+
+    std::map<std::optional<int64_t>, int64_t> counts;
+    for (const auto& [id, x] : rows_) {
+      ++counts[x];
+    }
+    ASSERT_EQ(count("v is null"), counts[std::nullopt]);
+    for (const auto& [x, cnt] : counts) {
+      if (x) {
+        ASSERT_EQ(count("v = " + literal(x)), cnt) << *x;
+        ASSERT_EQ(count("v <> " + literal(x)),
+                  int64_t(rows_.size()) - cnt - counts[std::nullopt])
+            << *x;
+      }
+    }
+
+    assertAggregatesMatch(int64_t(rows_.size()) - counts[std::nullopt]);
+
+    if (GetParam().is_string) {
+      // all the values share the prefix
+      ASSERT_EQ(count("v like '" + GetParam().string_prefix + "%'"),
+                int64_t(rows_.size()) - counts[std::nullopt]);
+    }
+
+    if (!GetParam().is_dict_encoded) {
+      return;
+    }
+    auto groups = run_query(
+        "select v, count(*) from test_table where v is not null group by v;");
+    size_t num_groups{0};
+    for (auto row = groups->getNextRow(true, true); !row.empty();
+         row = groups->getNextRow(true, true)) {
+      const auto it = std::find_if(counts.begin(), counts.end(), [&](const auto& c) {
+        return c.first && expectedValue(*c.first) == value(row[0]);
+      });
+      ASSERT_NE(it, counts.end()) << value(row[0]);
+      ASSERT_EQ(v<int64_t>(row[1]), it->second);
+      ++num_groups;
+    }
+    ASSERT_EQ(num_groups, counts.size() - (counts.count(std::nullopt) ? 1 : 0));
+  }
+
+  // Expected value of each row by id.
+  std::map<int64_t, std::optional<int64_t>> rows_;
+};
+
+TEST_P(BlockEncodedColumnTest, Select) {
+  assertTableMatches();
+}
+
+TEST_P(BlockEncodedColumnTest, Update) {
+  update(7, "id < 10", [](const int64_t id) { return id < 10; });
+  assertTableMatches();
+  update(std::nullopt, "mod(id, 5) = 0", [](const int64_t id) { return id % 5 == 0; });
+  assertTableMatches();
+  update(-3, "id >= 20 and id < 30", [](const int64_t id) {
+    return id >= 20 && id < 30;
+  });
+  assertTableMatches();
+}
+
+TEST_P(BlockEncodedColumnTest, DeleteAndVacuum) {
+  remove("mod(id, 3) = 0", [](const int64_t id) { return id % 3 == 0; });
+  assertTableMatches();
+  // every row of the third fragment
+  remove("id >= 16 and id < 24", [](const int64_t id) { return id >= 16 && id < 24; });
+  run_ddl_statement("optimize table test_table with (vacuum = 'true');");
+  assertTableMatches();
+  insertRows(50, 20);
+  update(4, "id > 40", [](const int64_t id) { return id > 40; });
+  assertTableMatches();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Encodings,
+    BlockEncodedColumnTest,
+    testing::Values(
+        BlockEncodedColumnParam{"RunLengthInt", "int encoding rl", 0, false},
+        BlockEncodedColumnParam{
+            "RunLengthBigInt", "bigint encoding rl", 1LL << 40, false},
+        BlockEncodedColumnParam{"RunLengthDictString", "text encoding rl", 0, true},
+        BlockEncodedColumnParam{"DiffBigInt", "bigint encoding diff", 1LL << 50, false},
+        BlockEncodedColumnParam{
+            "DiffNegativeBigInt", "bigint encoding diff", -(1LL << 60), false},
+        BlockEncodedColumnParam{"SparseSmallInt", "smallint encoding sparse", 0, false},
+        BlockEncodedColumnParam{"SparseInt", "int encoding sparse(32)", 1 << 20, false},
+        BlockEncodedColumnParam{
+            "SparseBigInt", "bigint encoding sparse", 1LL << 45, false},
+        // values up to the largest of five bits
+        BlockEncodedColumnParam{
+            "BitPackedSmallInt", "smallint encoding fixed(5)", 8, false},
+        BlockEncodedColumnParam{"BitPackedInt", "int encoding fixed(11)", -1000, false},
+        BlockEncodedColumnParam{
+            "BitPackedBigInt", "bigint encoding fixed(40)", 1LL << 38, false},
+        BlockEncodedColumnParam{"FsstString", "text encoding fsst", 0, true, false},
+        // long enough for the symbol table to cover several bytes per code
+        BlockEncodedColumnParam{"FsstLongString",
+                                "text encoding fsst",
+                                100,
+                                true,
+                                false,
+                                "https://www.example.com/some/shared/path/item?id="}),
+    [](const auto& param_info) { return param_info.param.name; });
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
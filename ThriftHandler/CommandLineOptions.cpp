@@ -743,12 +743,22 @@ void CommandLineOptions::fillAdvancedOptions() {
       po::value<bool>(&g_enable_cpu_sub_tasks)
           ->default_value(g_enable_cpu_sub_tasks)
           ->implicit_value(true),
-      "Enable parallel processing of a single data fragment on CPU. This can improve CPU "
-      "load balance and decrease reduction overhead.");
+      "Enable parallel processing of a single data fragment on CPU, in sub-tasks of "
+      "cpu-sub-task-size rows which idle threads steal from busy ones. This can improve "
+      "CPU load balance and decrease reduction overhead.");
   developer_desc.add_options()(
       "cpu-sub-task-size",
       po::value<size_t>(&g_cpu_sub_task_size)->default_value(g_cpu_sub_task_size),
       "Set CPU sub-task size in rows.");
+  developer_desc.add_options()(
+      "enable-shared-cpu-kernel-pool",
+      po::value<bool>(&g_enable_shared_cpu_kernel_pool)
+          ->default_value(g_enable_shared_cpu_kernel_pool)
+          ->implicit_value(true),
+      "Run the CPU kernels of concurrent queries on one shared thread pool instead of "
+      "one query at a time, sharing the pool between sessions in proportion to their "
+      "CPU_KERNEL_WEIGHT session parameter (ALTER SESSION SET CPU_KERNEL_WEIGHT=n, "
+      "1 by default). Takes precedence over the NUMA placement of kernels.");
   developer_desc.add_options()(
       "cpu-threads",
       po::value<unsigned>(&g_cpu_threads_override)->default_value(g_cpu_threads_override),
@@ -966,6 +976,164 @@ void CommandLineOptions::fillAdvancedOptions() {
                                "deleted rows in a fragment at which to perform "
                                "automatic vacuuming. A number greater than 1 can "
                                "be used to disable automatic vacuuming.");
+#ifndef _WIN32
+  developer_desc.add_options()(
+      "enable-positional-file-io",
+      po::value<bool>(&g_enable_positional_file_io)
+          ->default_value(g_enable_positional_file_io)
+          ->implicit_value(true),
+      "Use lock-free positional reads and writes (pread/pwrite) for data and metadata "
+      "files, allowing concurrent page reads against the same file.");
+#endif
+  developer_desc.add_options()(
+      "file-io-queue-depth",
+      po::value<size_t>(&g_file_io_queue_depth)->default_value(g_file_io_queue_depth),
+      "Maximum number of page run reads kept in flight by the asynchronous file read "
+      "queue (0 uses the number of hardware threads).");
+  developer_desc.add_options()(
+      "enable-page-map-snapshot",
+      po::value<bool>(&g_enable_page_map_snapshot)
+          ->default_value(g_enable_page_map_snapshot)
+          ->implicit_value(true),
+      "Write a snapshot of each table's page map when the table is closed and use it "
+      "to open the table on startup instead of reading every page header.");
+  developer_desc.add_options()(
+      "page-map-snapshot-checkpoint-interval",
+      po::value<size_t>(&g_page_map_snapshot_checkpoint_interval)
+          ->default_value(g_page_map_snapshot_checkpoint_interval),
+      "Also write the page map snapshot of a table every this many checkpoints (0 only "
+      "writes it when the table is closed).");
+  developer_desc.add_options()(
+      "enable-write-ahead-log",
+      po::value<bool>(&g_enable_write_ahead_log)
+          ->default_value(g_enable_write_ahead_log)
+          ->implicit_value(true),
+      "Make table checkpoints durable by appending the written data to a log shared by "
+      "all tables, instead of syncing all data files and the epoch file. Concurrent "
+      "checkpoints share a single sync of the log.");
+  developer_desc.add_options()(
+      "write-ahead-log-max-bytes",
+      po::value<size_t>(&g_write_ahead_log_max_bytes)
+          ->default_value(g_write_ahead_log_max_bytes),
+      "Size of the write ahead log after which a checkpoint syncs the data files of all "
+      "logged tables and empties the log.");
+  developer_desc.add_options()(
+      "enable-background-compaction",
+      po::value<bool>(&g_enable_background_compaction)
+          ->default_value(g_enable_background_compaction)
+          ->implicit_value(true),
+      "Continuously move pages out of sparsely used data and metadata files in the "
+      "background and delete the emptied files.");
+  developer_desc.add_options()(
+      "background-compaction-pages-per-pass",
+      po::value<size_t>(&g_background_compaction_pages_per_pass)
+          ->default_value(g_background_compaction_pages_per_pass),
+      "Maximum number of pages moved by a single background compaction pass.");
+  developer_desc.add_options()(
+      "background-compaction-max-bytes-per-sec",
+      po::value<size_t>(&g_background_compaction_max_bytes_per_sec)
+          ->default_value(g_background_compaction_max_bytes_per_sec),
+      "Maximum disk bandwidth, in bytes per second, used by background compaction.");
+  developer_desc.add_options()(
+      "buffer-eviction-policy",
+      po::value<std::string>(&g_buffer_eviction_policy)
+          ->default_value(g_buffer_eviction_policy),
+      "Replacement policy of the CPU and GPU buffer pools: \"score\" scans the pool "
+      "for the least recently used run of pages, \"lru\" evicts the least recently "
+      "used chunk and \"slru\" (segmented LRU) evicts chunks that were only used once "
+      "before chunks that were reused, so large scans do not flush the pool.");
+  developer_desc.add_options()(
+      "enable-numa-aware-placement",
+      po::value<bool>(&g_enable_numa_aware_placement)
+          ->default_value(g_enable_numa_aware_placement)
+          ->implicit_value(true),
+      "Spread the CPU buffer pool slabs over the NUMA nodes, keep the chunks of a "
+      "fragment on one node and run the CPU kernels of the fragment on threads bound to "
+      "that node.");
+  developer_desc.add_options()(
+      "cpu-buffer-huge-pages",
+      po::value<std::string>(&g_cpu_buffer_huge_pages)
+          ->default_value(g_cpu_buffer_huge_pages),
+      "Back the CPU buffer pool slabs with huge pages: \"none\", \"thp\" (transparent "
+      "huge pages), \"2mb\" or \"1gb\". Explicit huge pages must be reserved, e.g. in "
+      "/sys/kernel/mm/hugepages; slabs fall back to transparent huge pages otherwise.");
+  developer_desc.add_options()(
+      "prefault-cpu-buffer-pool",
+      po::value<bool>(&g_prefault_cpu_buffer_pool)
+          ->default_value(g_prefault_cpu_buffer_pool)
+          ->implicit_value(true),
+      "Allocate the whole CPU buffer pool at startup and fault in its pages, so that the "
+      "first queries do not pay for them.");
+  developer_desc.add_options()(
+      "enable-cpu-buffer-pool-reclaim",
+      po::value<bool>(&g_enable_cpu_buffer_pool_reclaim)
+          ->default_value(g_enable_cpu_buffer_pool_reclaim)
+          ->implicit_value(true),
+      "Free slabs of the CPU buffer pool, least recently used first, when the host or "
+      "the cgroup of the server is under memory pressure.");
+  developer_desc.add_options()(
+      "cpu-buffer-pool-reclaim-floor",
+      po::value<size_t>(&g_cpu_buffer_pool_reclaim_floor)
+          ->default_value(g_cpu_buffer_pool_reclaim_floor),
+      "Size in bytes below which the CPU buffer pool is not shrunk under memory "
+      "pressure.");
+  developer_desc.add_options()(
+      "cpu-buffer-pool-reclaim-stall-percent",
+      po::value<double>(&g_cpu_buffer_pool_reclaim_stall_percent)
+          ->default_value(g_cpu_buffer_pool_reclaim_stall_percent),
+      "Free a CPU buffer pool slab per second while tasks stall waiting for memory at "
+      "least this percent of the time, as reported by PSI.");
+  developer_desc.add_options()(
+      "cpu-buffer-pool-reclaim-min-available-percent",
+      po::value<size_t>(&g_cpu_buffer_pool_reclaim_min_available_percent)
+          ->default_value(g_cpu_buffer_pool_reclaim_min_available_percent),
+      "Free CPU buffer pool slabs until at least this percent of the memory limit of the "
+      "host or cgroup is available.");
+  developer_desc.add_options()(
+      "group-by-buffer-pool-size",
+      po::value<size_t>(&g_group_by_buffer_pool_size)
+          ->default_value(g_group_by_buffer_pool_size),
+      "Size in bytes of the pool of initialized CPU group by output buffers reused "
+      "across queries with the same layout (0 disables the pool).");
+  developer_desc.add_options()(
+      "enable-chunk-bloom-filters",
+      po::value<bool>(&g_enable_chunk_bloom_filters)
+          ->default_value(g_enable_chunk_bloom_filters)
+          ->implicit_value(true),
+      "Keep a Bloom filter of the values of integer, date and dictionary encoded string "
+      "chunks in their metadata, and use it to skip fragments on equality and IN "
+      "predicates.");
+  developer_desc.add_options()(
+      "enable-chunk-zone-maps",
+      po::value<bool>(&g_enable_chunk_zone_maps)
+          ->default_value(g_enable_chunk_zone_maps)
+          ->implicit_value(true),
+      "Keep the min and max of blocks of rows of integer, decimal and date chunks in "
+      "their metadata, and use them to skip the blocks of a fragment on CPU.");
+  developer_desc.add_options()(
+      "enable-runtime-join-filters",
+      po::value<bool>(&g_enable_runtime_join_filters)
+          ->default_value(g_enable_runtime_join_filters)
+          ->implicit_value(true),
+      "Collect the keys of perfect hash tables of inner joins, and use them to skip the "
+      "fragments of the outer table which can't have a match.");
+  developer_desc.add_options()(
+      "enable-chunk-prefetch",
+      po::value<bool>(&g_enable_chunk_prefetch)
+          ->default_value(g_enable_chunk_prefetch)
+          ->implicit_value(true),
+      "Load the outer table chunks of upcoming kernels into the CPU buffer pool in the "
+      "background while earlier kernels execute.");
+  developer_desc.add_options()(
+      "chunk-prefetch-max-bytes",
+      po::value<size_t>(&g_chunk_prefetch_max_bytes)
+          ->default_value(g_chunk_prefetch_max_bytes),
+      "Maximum number of bytes the chunk prefetcher keeps pinned ahead of kernels.");
+  developer_desc.add_options()(
+      "chunk-prefetch-num-kernels",
+      po::value<size_t>(&g_chunk_prefetch_num_kernels)
+          ->default_value(g_chunk_prefetch_num_kernels),
+      "Maximum number of kernels the chunk prefetcher runs ahead of the started ones.");
   developer_desc.add_options()("enable-automatic-ir-metadata",
                                po::value<bool>(&g_enable_automatic_ir_metadata)
                                    ->default_value(g_enable_automatic_ir_metadata)
@@ -1176,6 +1344,7 @@ void CommandLineOptions::validate() {
     LOG(INFO) << "License key path set to '" << license_path << "'";
   }
   g_read_only = read_only;
+  g_num_executors = std::max(system_parameters.num_executors, 1);
   LOG(INFO) << " Server read-only mode is " << read_only << " (--read-only)";
   if (g_multi_instance) {
     LOG(INFO) << " Multiple servers per --data directory is " << g_multi_instance
@@ -225,13 +225,39 @@ extern bool g_enable_interop;
 extern bool g_enable_union;
 extern bool g_enable_cpu_sub_tasks;
 extern size_t g_cpu_sub_task_size;
+extern bool g_enable_shared_cpu_kernel_pool;
 extern unsigned g_cpu_threads_override;
+extern size_t g_num_executors;
 extern bool g_enable_filter_function;
 extern size_t g_max_import_threads;
 extern bool g_enable_auto_metadata_update;
 extern bool g_allow_s3_server_privileges;
 extern float g_vacuum_min_selectivity;
 extern bool g_read_only;
+extern bool g_enable_positional_file_io;
+extern size_t g_file_io_queue_depth;
+extern bool g_enable_page_map_snapshot;
+extern size_t g_page_map_snapshot_checkpoint_interval;
+extern bool g_enable_write_ahead_log;
+extern size_t g_write_ahead_log_max_bytes;
+extern bool g_enable_background_compaction;
+extern size_t g_background_compaction_pages_per_pass;
+extern size_t g_background_compaction_max_bytes_per_sec;
+extern std::string g_buffer_eviction_policy;
+extern bool g_enable_numa_aware_placement;
+extern std::string g_cpu_buffer_huge_pages;
+extern bool g_prefault_cpu_buffer_pool;
+extern bool g_enable_cpu_buffer_pool_reclaim;
+extern size_t g_cpu_buffer_pool_reclaim_floor;
+extern double g_cpu_buffer_pool_reclaim_stall_percent;
+extern size_t g_cpu_buffer_pool_reclaim_min_available_percent;
+extern size_t g_group_by_buffer_pool_size;
+extern bool g_enable_chunk_bloom_filters;
+extern bool g_enable_chunk_zone_maps;
+extern bool g_enable_runtime_join_filters;
+extern bool g_enable_chunk_prefetch;
+extern size_t g_chunk_prefetch_max_bytes;
+extern size_t g_chunk_prefetch_num_kernels;
 extern bool g_enable_automatic_ir_metadata;
 extern size_t g_enable_parallel_linearization;
 extern size_t g_max_log_length;
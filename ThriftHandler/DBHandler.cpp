@@ -54,9 +54,11 @@
 #include "Parser/ReservedKeywords.h"
 #include "QueryEngine/ArrowResultSet.h"
 #include "QueryEngine/CalciteAdapter.h"
+#include "QueryEngine/CpuKernelService.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/ExtensionFunctionsWhitelist.h"
 #include "QueryEngine/GpuMemUtils.h"
+#include "QueryEngine/GroupByBufferPool.h"
 #include "QueryEngine/JoinFilterPushDown.h"
 #include "QueryEngine/JsonAccessors.h"
 #include "QueryEngine/QueryDispatchQueue.h"
@@ -89,6 +91,7 @@
 #include <boost/process/search_path.hpp>
 #include <boost/program_options.hpp>
 #include <boost/tokenizer.hpp>
+#include <charconv>
 #include <chrono>
 #include <cmath>
 #include <csignal>
@@ -576,6 +579,8 @@ void DBHandler::disconnect_impl(Catalog_Namespace::SessionInfoPtr& session_ptr)
     render_handler_->disconnect(session_id);
   }
 
+  cpu_kernel_service::remove_session(session_ptr->get_public_session_id());
+
   if (leaf_exception) {
     std::rethrow_exception(leaf_exception);
   }
@@ -2703,6 +2708,12 @@ void DBHandler::get_memory(std::vector<TNodeMemoryInfo>& _return,
     nodeInfo.max_num_pages = memInfo.maxNumPages;
     nodeInfo.num_pages_allocated = memInfo.numPageAllocated;
     nodeInfo.is_allocation_capped = memInfo.isAllocationCapped;
+    nodeInfo.huge_page_bytes_allocated = memInfo.hugePageBytesAllocated;
+    if (mem_level == Data_Namespace::MemoryLevel::CPU_LEVEL &&
+        g_group_by_buffer_pool_size) {
+      nodeInfo.group_by_buffer_pool_bytes =
+          GroupByBufferPool::instance().getPoolBytes();
+    }
     for (auto gpu : memInfo.nodeMemoryData) {
       TMemoryData md;
       md.slab = gpu.slabNum;
@@ -7554,6 +7565,30 @@ void DBHandler::alterSession(const std::string& session_id,
   } else if (session_parameter.first == "CURRENT_DATABASE") {
     execution_time_ms = measure<>::execution(
         [&]() { switch_database(session_id, session_parameter.second); });
+  } else if (session_parameter.first == "CPU_KERNEL_WEIGHT") {
+    const auto& value = session_parameter.second;
+    // std::from_chars takes a minus sign but no plus sign.
+    const auto value_begin =
+        value.data() + (!value.empty() && value.front() == '+' ? 1 : 0);
+    const auto value_end = value.data() + value.size();
+    int64_t weight{0};
+    const auto [parsed_end, ec] = std::from_chars(value_begin, value_end, weight);
+    if (ec == std::errc::invalid_argument || parsed_end != value_end) {
+      throw std::runtime_error("The value of session parameter " +
+                               session_parameter.first + " should be a numeric.");
+    }
+    if (ec == std::errc::result_out_of_range || weight < 1 ||
+        weight > int64_t(cpu_kernel_service::kMaxSessionWeight)) {
+      throw std::runtime_error("The value of session parameter " +
+                               session_parameter.first + " should be between 1 and " +
+                               std::to_string(cpu_kernel_service::kMaxSessionWeight) +
+                               ".");
+    }
+    execution_time_ms = measure<>::execution([&]() {
+      const auto session_ptr = get_session_ptr(session_id);
+      cpu_kernel_service::set_session_weight(session_ptr->get_public_session_id(),
+                                             weight);
+    });
   }
 }
 
@@ -21,6 +21,11 @@
  */
 
 #include "ChunkIter.h"
+#include "../Shared/BitPacking.h"
+#include "../Shared/DiffEncoding.h"
+#include "../Shared/FsstEncoding.h"
+#include "../Shared/RunLengthEncoding.h"
+#include "../Shared/SparseEncoding.h"
 
 #include <cstdlib>
 
@@ -141,8 +146,104 @@ DEVICE static void decompress(const SQLTypeInfo& ti,
   result->is_null = ti.is_null(*datum);
 }
 
+// Non null values of sparse chunks are read in place, null rows get the null sentinel of
+// the type. The entry lookup starts from cursor when it is given.
+DEVICE static void decode_sparse(ChunkIter* it,
+                                 const int64_t row,
+                                 VarlenDatum* result,
+                                 int64_t* cursor) {
+  result->length = static_cast<size_t>(it->skip_size);
+  const auto idx =
+      sparse_encoding::value_index(it->second_buf, it->skip_size, row, cursor);
+  if (idx >= 0) {
+    result->pointer = const_cast<int8_t*>(
+        sparse_encoding::value_ptr(it->second_buf, it->skip_size, idx));
+    result->is_null = false;
+    return;
+  }
+  if (it->type_info.get_type() == kFLOAT) {
+    it->datum.floatval = NULL_FLOAT;
+    result->pointer = (int8_t*)&it->datum.floatval;
+  } else if (it->type_info.get_type() == kDOUBLE) {
+    it->datum.doubleval = NULL_DOUBLE;
+    result->pointer = (int8_t*)&it->datum.doubleval;
+  } else {
+    switch (it->skip_size) {
+      case 1:
+        it->datum.tinyintval = NULL_TINYINT;
+        result->pointer = (int8_t*)&it->datum.tinyintval;
+        break;
+      case 2:
+        it->datum.smallintval = NULL_SMALLINT;
+        result->pointer = (int8_t*)&it->datum.smallintval;
+        break;
+      case 4:
+        it->datum.intval = NULL_INT;
+        result->pointer = (int8_t*)&it->datum.intval;
+        break;
+      default:
+        it->datum.bigintval = NULL_BIGINT;
+        result->pointer = (int8_t*)&it->datum.bigintval;
+        break;
+    }
+  }
+  result->is_null = true;
+}
+
+// Positions in block encoded chunks only track the row, whose value is decoded from the
+// chunk buffer in second_buf. Run length and sparse encoded rows are looked up from
+// decode_cursor when it is given, which makes reading the rows in order linear in the
+// number of runs or entries.
+DEVICE static void decode_block_encoded(ChunkIter* it,
+                                        const int8_t* pos,
+                                        VarlenDatum* result,
+                                        int64_t* decode_cursor) {
+  const auto row = (pos - it->second_buf) / it->skip_size;
+  if (it->type_info.get_compression() == kENCODING_SPARSE) {
+    decode_sparse(it, row, result, decode_cursor);
+    return;
+  }
+  int64_t val;
+  if (it->type_info.get_compression() == kENCODING_DIFF) {
+    val = diff_encoding::decode(it->second_buf, row, inline_int_null_value<int64_t>());
+  } else if (it->type_info.is_bit_packed()) {
+    // Nulls are decoded to the null of the logical type, whatever the width of the row.
+    const auto null_val = it->skip_size == 2   ? NULL_SMALLINT
+                          : it->skip_size == 4 ? NULL_INT
+                                               : NULL_BIGINT;
+    val = bit_packing::decode(
+        it->second_buf, it->type_info.get_comp_param(), row, null_val);
+  } else if (decode_cursor) {
+    val = run_length_encoding::decode_from(
+        it->second_buf, it->skip_size, row, decode_cursor);
+  } else {
+    val = run_length_encoding::decode(it->second_buf, it->skip_size, row);
+  }
+  switch (it->skip_size) {
+    case 1:
+      it->datum.tinyintval = static_cast<int8_t>(val);
+      result->pointer = (int8_t*)&it->datum.tinyintval;
+      break;
+    case 2:
+      it->datum.smallintval = static_cast<int16_t>(val);
+      result->pointer = (int8_t*)&it->datum.smallintval;
+      break;
+    case 4:
+      it->datum.intval = static_cast<int32_t>(val);
+      result->pointer = (int8_t*)&it->datum.intval;
+      break;
+    default:
+      it->datum.bigintval = val;
+      result->pointer = (int8_t*)&it->datum.bigintval;
+      break;
+  }
+  result->length = static_cast<size_t>(it->skip_size);
+  result->is_null = it->type_info.is_null(result->pointer);
+}
+
 void ChunkIter_reset(ChunkIter* it) {
   it->current_pos = it->start_pos;
+  it->decode_cursor = 0;
 }
 
 DEVICE void ChunkIter_get_next(ChunkIter* it,
@@ -160,7 +261,9 @@ DEVICE void ChunkIter_get_next(ChunkIter* it,
 
   if (it->skip_size > 0) {
     // for fixed-size
-    if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
+    if (it->type_info.is_block_encoded()) {
+      decode_block_encoded(it, it->current_pos, result, &it->decode_cursor);
+    } else if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
       decompress(it->type_info, it->current_pos, result, &it->datum);
     } else {
       result->length = static_cast<size_t>(it->skip_size);
@@ -196,7 +299,10 @@ DEVICE void ChunkIter_get_nth(ChunkIter* it,
   if (it->skip_size > 0) {
     // for fixed-size
     int8_t* current_pos = it->start_pos + n * it->skip_size;
-    if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
+    if (it->type_info.is_block_encoded()) {
+      // Concurrent lazy reads share the iterator, leave its cursor alone.
+      decode_block_encoded(it, current_pos, result, nullptr);
+    } else if (uncompress && (it->type_info.get_compression() != kENCODING_NONE)) {
       decompress(it->type_info, current_pos, result, &it->datum);
     } else {
       result->length = static_cast<size_t>(it->skip_size);
@@ -330,3 +436,31 @@ DEVICE void ChunkIter_get_nth_point_coords(ChunkIter* it,
   }
   result->is_null = is_null;
 }
+
+DEVICE bool ChunkIter_string_matches(ChunkIter* it,
+                                     int n,
+                                     const char* str,
+                                     const int32_t str_len,
+                                     const bool prefix,
+                                     bool* is_null) {
+  VarlenDatum vd;
+  bool is_end;
+  ChunkIter_get_nth(it, n, false, &vd, &is_end);
+  assert(!is_end);
+  *is_null = vd.is_null;
+  const int32_t length = vd.length;
+  if (it->type_info.is_fsst_string()) {
+    return fsst_encoding::matches(
+        it->second_buf, vd.pointer, length, str, str_len, prefix);
+  }
+  // Decompressed by the column fetcher.
+  if (prefix ? length < str_len : length != str_len) {
+    return false;
+  }
+  for (int32_t i = 0; i < str_len; ++i) {
+    if (static_cast<char>(vd.pointer[i]) != str[i]) {
+      return false;
+    }
+  }
+  return true;
+}
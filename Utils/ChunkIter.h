@@ -37,6 +37,8 @@ class ChunkIter {
   int skip_size;
   size_t num_elems;
   Datum datum;  // used to hold uncompressed value
+  // run or entry of the last row ChunkIter_get_next read, for RL and SPARSE chunks
+  int64_t decode_cursor;
 };
 
 void ChunkIter_reset(ChunkIter* it);
@@ -63,4 +65,12 @@ DEVICE void ChunkIter_get_nth_point_coords(ChunkIter* it,
                                            int nth,
                                            ArrayDatum* vd,
                                            bool* is_end);
+// @brief compares the nth string in Chunk with str, only its first str_len bytes when
+// prefix is set, without decompressing FSST encoded chunks
+DEVICE bool ChunkIter_string_matches(ChunkIter* it,
+                                     int nth,
+                                     const char* str,
+                                     const int32_t str_len,
+                                     const bool prefix,
+                                     bool* is_null);
 #endif  // _CHUNK_ITER_H_
@@ -273,24 +273,24 @@ void validate_and_set_fixed_encoding(ColumnDescriptor& cd,
 
   switch (type) {
     case kSMALLINT:
-      if (encoding_size != 8) {
-        throw std::runtime_error(
-            cd.columnName +
-            ": Compression parameter for Fixed encoding on SMALLINT must be 8.");
+      if (encoding_size < 1 || encoding_size > 15) {
+        throw std::runtime_error(cd.columnName +
+                                 ": Compression parameter for Fixed encoding on "
+                                 "SMALLINT must be between 1 and 15.");
       }
       break;
     case kINT:
-      if (encoding_size != 8 && encoding_size != 16) {
-        throw std::runtime_error(
-            cd.columnName +
-            ": Compression parameter for Fixed encoding on INTEGER must be 8 or 16.");
+      if (encoding_size < 1 || encoding_size > 31) {
+        throw std::runtime_error(cd.columnName +
+                                 ": Compression parameter for Fixed encoding on "
+                                 "INTEGER must be between 1 and 31.");
       }
       break;
     case kBIGINT:
-      if (encoding_size != 8 && encoding_size != 16 && encoding_size != 32) {
+      if (encoding_size < 1 || encoding_size > 63) {
         throw std::runtime_error(cd.columnName +
                                  ": Compression parameter for Fixed encoding on "
-                                 "BIGINT must be 8 or 16 or 32.");
+                                 "BIGINT must be between 1 and 63.");
       }
       break;
     case kTIMESTAMP:
@@ -378,21 +378,74 @@ void validate_and_set_none_encoding(ColumnDescriptor& cd) {
   cd.columnType.set_comp_param(0);
 }
 
+void validate_and_set_fsst_encoding(ColumnDescriptor& cd) {
+  // none encoded strings compressed with per chunk symbol tables
+  if (!cd.columnType.is_string()) {
+    throw std::runtime_error(cd.columnName +
+                             ": FSST encoding is only supported on string columns.");
+  }
+  cd.columnType.set_compression(kENCODING_NONE);
+  cd.columnType.set_comp_param(FSST_COMP_PARAM);
+}
+
+void validate_and_set_run_length_encoding(ColumnDescriptor& cd) {
+  // run length encoding
+  const auto type = cd.columnType.get_type();
+  if (IS_STRING(type)) {
+    // runs of 32 bit dictionary ids
+    cd.columnType.set_compression(kENCODING_DICT);
+    cd.columnType.set_comp_param(32);
+    cd.columnType.set_scale(RL_DICT_SCALE);
+    return;
+  }
+  if (!IS_INTEGER(type) && !is_datetime(type) && type != kBOOLEAN &&
+      !(type == kDECIMAL || type == kNUMERIC)) {
+    throw std::runtime_error(cd.columnName +
+                             ": RL encoding is only supported for integer, decimal, "
+                             "boolean, time or string columns.");
+  }
+  cd.columnType.set_compression(kENCODING_RL);
+  cd.columnType.set_comp_param(0);
+}
+
+void validate_and_set_diff_encoding(ColumnDescriptor& cd) {
+  // differential encoding, deltas from the chunk minimum
+  const auto type = cd.columnType.get_type();
+  if (type != kBIGINT && type != kDECIMAL && type != kNUMERIC && type != kTIME &&
+      type != kTIMESTAMP) {
+    throw std::runtime_error(cd.columnName +
+                             ": DIFF encoding is only supported for BIGINT, DECIMAL, "
+                             "TIME or TIMESTAMP columns.");
+  }
+  cd.columnType.set_compression(kENCODING_DIFF);
+  cd.columnType.set_comp_param(0);
+}
+
 void validate_and_set_sparse_encoding(ColumnDescriptor& cd, int encoding_size) {
   // sparse column encoding with mostly NULL values
   if (cd.columnType.get_notnull()) {
     throw std::runtime_error(cd.columnName +
                              ": Cannot do sparse column encoding on a NOT NULL column.");
   }
-  if (encoding_size == 0 || encoding_size % 8 != 0 || encoding_size > 48) {
-    throw std::runtime_error(
-        cd.columnName +
-        "Must specify number of bits as 8, 16, 24, 32 or 48 as the parameter to "
-        "sparse-column encoding.");
+  const auto type = cd.columnType.get_type();
+  if (!IS_INTEGER(type) && !is_datetime(type) && type != kBOOLEAN &&
+      type != kDECIMAL && type != kNUMERIC && type != kFLOAT && type != kDOUBLE) {
+    throw std::runtime_error(cd.columnName +
+                             ": SPARSE encoding is only supported for integer, decimal, "
+                             "floating point, boolean or time columns.");
+  }
+  // The values are stored at the width of the column, the parameter is optional.
+  const auto value_bits = 8 * SQLTypeInfo(type,
+                                          cd.columnType.get_dimension(),
+                                          cd.columnType.get_scale(),
+                                          false)
+                                  .get_size();
+  if (encoding_size != 0 && encoding_size != value_bits) {
+    throw std::runtime_error(cd.columnName + ": Parameter of SPARSE encoding must be " +
+                             std::to_string(value_bits) + " for this column.");
   }
   cd.columnType.set_compression(kENCODING_SPARSE);
-  cd.columnType.set_comp_param(encoding_size);
-  // throw std::runtime_error("SPARSE encoding not supported yet.");
+  cd.columnType.set_comp_param(0);
 }
 
 void validate_and_set_compressed_encoding(ColumnDescriptor& cd, int encoding_size) {
@@ -444,19 +497,15 @@ void validate_and_set_encoding(ColumnDescriptor& cd,
     if (boost::iequals(comp, "fixed")) {
       validate_and_set_fixed_encoding(cd, encoding->get_encoding_param(), column_type);
     } else if (boost::iequals(comp, "rl")) {
-      // run length encoding
-      cd.columnType.set_compression(kENCODING_RL);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
+      validate_and_set_run_length_encoding(cd);
     } else if (boost::iequals(comp, "diff")) {
-      // differential encoding
-      cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      validate_and_set_diff_encoding(cd);
     } else if (boost::iequals(comp, "dict")) {
       validate_and_set_dictionary_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "NONE")) {
       validate_and_set_none_encoding(cd);
+    } else if (boost::iequals(comp, "fsst")) {
+      validate_and_set_fsst_encoding(cd);
     } else if (boost::iequals(comp, "sparse")) {
       validate_and_set_sparse_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "compressed")) {
@@ -116,6 +116,12 @@ void validate_and_set_dictionary_encoding(ColumnDescriptor& cd, int encoding_siz
 
 void validate_and_set_none_encoding(ColumnDescriptor& cd);
 
+void validate_and_set_fsst_encoding(ColumnDescriptor& cd);
+
+void validate_and_set_run_length_encoding(ColumnDescriptor& cd);
+
+void validate_and_set_diff_encoding(ColumnDescriptor& cd);
+
 void validate_and_set_sparse_encoding(ColumnDescriptor& cd, int encoding_size);
 
 void validate_and_set_compressed_encoding(ColumnDescriptor& cd, int encoding_size);
@@ -349,6 +349,8 @@ struct TNodeMemoryInfo {
   4: i64 num_pages_allocated;
   5: bool is_allocation_capped;
   6: list<TMemoryData> node_memory_data;
+  7: i64 huge_page_bytes_allocated;
+  8: i64 group_by_buffer_pool_bytes;
 }
 
 struct TTableMeta {
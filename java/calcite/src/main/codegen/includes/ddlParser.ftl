@@ -106,6 +106,15 @@ Pair<HeavyDBEncoding, Integer> HeavyDBEncodingOpt() :
     | 
         <COMPRESSED> { encoding = HeavyDBEncoding.COMPRESSED; }
         [ <LPAREN> size = IntLiteral() <RPAREN> ]
+    |
+        <FSST> { encoding = HeavyDBEncoding.FSST; }
+    |
+        <RL> { encoding = HeavyDBEncoding.RL; }
+    |
+        <DIFF> { encoding = HeavyDBEncoding.DIFF; }
+    |
+        <SPARSE> { encoding = HeavyDBEncoding.SPARSE; }
+        [ <LPAREN> size = IntLiteral() <RPAREN> ]
     )
     { return new Pair(encoding, size); }
 }
@@ -234,7 +234,7 @@ HeavySqlEncoding Encoding() :
 {
     <ENCODING>
     (
-        type = <NONE>
+        ( type = <NONE> | type = <FSST> )
     |
         ( type = <FIXED> | type = <DAYS> )
         <LPAREN> size = IntLiteral() <RPAREN>
@@ -1,3 +1,13 @@
 package com.mapd.parser.extension.ddl.heavydb;
 
-public enum HeavyDBEncoding { NONE, FIXED, COMPRESSED, DICT, DAYS }
\ No newline at end of file
+public enum HeavyDBEncoding {
+  NONE,
+  FIXED,
+  COMPRESSED,
+  DICT,
+  DAYS,
+  FSST,
+  RL,
+  DIFF,
+  SPARSE
+}